@@ -4,10 +4,33 @@
 
 #pragma once
 
+#include "types/PulseBoundingBox.h"
+#include "types/PulseColumnType.h"
+#include "types/PulseControlCommand.h"
+#include "types/PulseCrossingEvent.h"
+#include "types/PulseDemandTransform.h"
 #include "types/PulseEntityType.h"
 #include "types/PulseEvents.h"
+#include "types/PulseMetricRecord.h"
+#include "types/PulsePersonState.h"
 #include "types/PulsePosition.h"
+#include "types/PulseProfileStage.h"
+#include "types/PulseRoadBinding.h"
+#include "types/PulseRoadTransition.h"
+#include "types/PulseRoute.h"
+#include "types/PulseRoutingAlgorithm.h"
+#include "types/PulseScenarioDescriptor.h"
+#include "types/PulseSignalColor.h"
+#include "types/PulseSignalPlan.h"
+#include "types/PulseSignalProgram.h"
+#include "types/PulseStateChecksum.h"
+#include "types/PulseStateSnapshot.h"
+#include "types/PulseTransitState.h"
+#include "types/PulseTransitStopEvent.h"
+#include "types/PulseTripRecord.h"
+#include "types/PulseVehicleKinematics.h"
 #include "types/PulseVehicleRole.h"
 #include "types/PulseVehicleType.h"
+#include "types/PulseWireFormat.h"
 #include "types/TrafficLightDurations.h"
 #include "types/TrafficLightState.h"
\ No newline at end of file
@@ -7,14 +7,45 @@
 #include "core/IntersectionStatistics.h"
 #include "core/Logger.h"
 #include "core/Observer.h"
+#include "core/PulseChecksumRecorder.h"
+#include "core/PulseCommandQueue.h"
 #include "core/PulseDataManager.h"
+#include "core/PulseDemandFile.h"
+#include "core/PulseDemandForecaster.h"
 #include "core/PulseEntityFactory.h"
+#include "core/PulseEntityViews.h"
+#include "core/PulseLiveServer.h"
+#include "core/PulseMesoSimulation.h"
+#include "core/PulseMetricStore.h"
+#include "core/PulseObjectPool.h"
+#include "core/PulseParquetWriter.h"
+#include "core/PulsePedestrianTable.h"
+#include "core/PulsePlanOptimizer.h"
+#include "core/PulseProfiler.h"
+#include "core/PulseQueueEstimator.h"
+#include "core/PulseReplicationRunner.h"
+#include "core/PulseRouter.h"
+#include "core/PulseScenarioCatalog.h"
+#include "core/PulseScenarioTransformer.h"
+#include "core/PulseSignalProgramTable.h"
+#include "core/PulseSnapshotPublisher.h"
+#include "core/PulseStateEncoder.h"
+#include "core/PulseStateHasher.h"
+#include "core/PulseStatisticsExporter.h"
+#include "core/PulseStepScheduler.h"
+#include "core/PulseTransitPriority.h"
+#include "core/PulseTransitTable.h"
+#include "core/PulseTravelTimeEstimator.h"
+#include "core/SimulationSource.h"
 #include "core/StatisticsCollector.h"
 #include "core/SumoIntegration.h"
 #include "core/TrafficSystem.h"
 
 #include "entities/PulseEntity.h"
+#include "entities/PulseEntityTraits.h"
 #include "entities/PulseIntersection.h"
 #include "entities/PulseRoadConnection.h"
 #include "entities/PulseTrafficLight.h"
-#include "entities/PulseVehicle.h"
\ No newline at end of file
+#include "entities/PulseVehicle.h"
+
+#include "utils/PulseStringHash.h"
\ No newline at end of file
@@ -0,0 +1,8 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef SUMO_SIMULATIONS_PATH
+#define SUMO_SIMULATIONS_PATH "config/sumo/simulations"
+
+#endif //SUMO_SIMULATIONS_PATH
@@ -79,6 +79,15 @@ public:
      */
     [[nodiscard]] double getAveragePedestrianWaitingTime() const;
 
+    /**
+     * @brief Adds the counts and waiting times of another statistics object to this one.
+     *
+     * All metrics are plain sums, so merging is associative and commutative and results of
+     * independent replications can be combined in any order.
+     * @param other Statistics to merge in (typically for the same intersection ID).
+     */
+    void merge(const IntersectionStatistics& other);
+
 private:
     std::string m_intersection_id;          ///< Unique string identifier for the intersection.
 
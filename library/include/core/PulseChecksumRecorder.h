@@ -0,0 +1,82 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSECHECKSUMRECORDER_H
+#define PULSECHECKSUMRECORDER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseStateHasher.h"
+
+#include "types/PulseStateChecksum.h"
+
+/**
+ * @class PulseChecksumRecorder
+ * @brief Computes per-step checksums of the data manager state for determinism checks.
+ *
+ * Each entity is serialized into a fixed binary record keyed by its ID and hashed on its own; a
+ * category hash combines the record hashes by addition, so the checksum depends only on the
+ * state, not on container layout or iteration order, and needs no sorting or copies of the IDs. Two runs
+ * that should be equivalent (serial and parallel, old and new build) write checksum streams with
+ * write(); findFirstDivergence() then names the first step at which they differ, and the
+ * per-category hashes tell which part of the state diverged.
+ *
+ * A stream has one line per step: the step number, then the state, vehicle, traffic light and
+ * statistics hashes as 16 hexadecimal digits, separated by spaces.
+ */
+class PulseChecksumRecorder
+{
+public:
+    /**
+     * @brief Hashes the current state of a data manager.
+     * @param manager The state.
+     * @param step Step number recorded with the checksum.
+     * @return The checksum; valid until the next call.
+     */
+    const PulseStateChecksum& compute(const PulseDataManager& manager, std::uint64_t step);
+
+    /**
+     * @brief Checksum of the last compute() call; all zero before the first.
+     */
+    [[nodiscard]] const PulseStateChecksum& getLast() const;
+
+    /**
+     * @brief Writes one checksum as a line of a checksum stream.
+     */
+    static void write(std::ostream& out, const PulseStateChecksum& checksum);
+
+    /**
+     * @brief Reads the next line of a checksum stream.
+     * @return False at the end of the stream.
+     * @throws std::runtime_error if the line is malformed
+     */
+    static bool read(std::istream& in, PulseStateChecksum& out);
+
+    /**
+     * @brief Compares two checksum streams line by line.
+     * @return Step of the first line that differs, or where the shorter stream ends;
+     *         nothing if the streams are identical.
+     * @throws std::runtime_error if a line is malformed
+     */
+    [[nodiscard]] static std::optional<std::uint64_t> findFirstDivergence(std::istream& expected, std::istream& actual);
+
+private:
+    template <typename Range, typename Serialize>
+    std::uint64_t hashUnordered(Range&& entities, Serialize&& serialize);
+
+private:
+    PulseStateHasher m_hasher;
+    PulseStateChecksum m_last;
+    std::string m_record;   ///< Serialized record of one entity; grows to its peak size and is reused.
+};
+
+#endif //PULSECHECKSUMRECORDER_H
@@ -0,0 +1,115 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSECOMMANDQUEUE_H
+#define PULSECOMMANDQUEUE_H
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "types/PulseControlCommand.h"
+#include "types/PulseSignalPlan.h"
+
+/**
+ * @class PulseCommandQueue
+ * @brief Lock-free multi-producer, single-consumer queue of commands for the simulation thread.
+ *
+ * Any number of threads (APIs, scripts, external controllers) push commands; pushing is a
+ * compare-and-swap loop on the list head and never blocks the simulation. The simulation thread
+ * calls drain() at a step boundary, which takes every pending command at once and coalesces them:
+ * of several commands of the same type for the same light only the one with the highest sequence
+ * is kept, since applying the earlier ones would be overwritten within the same step anyway. The
+ * remaining commands are returned in sequence order and are meant to be applied together (see
+ * TrafficSystem).
+ *
+ * Tickets are taken before the push, so two racing producers may link their nodes in the opposite
+ * order; drain() therefore orders by sequence rather than by position in the list. A producer may
+ * even link its node only after a command with a later ticket was drained, so the queue remembers
+ * the highest sequence it handed out per light and type and drops a command with an older one:
+ * the latest command per light wins across drains, not only within one.
+ */
+class PulseCommandQueue
+{
+public:
+    PulseCommandQueue() = default;
+
+    /**
+     * @brief Frees commands that were never drained.
+     */
+    ~PulseCommandQueue();
+
+    PulseCommandQueue(const PulseCommandQueue&) = delete;
+    PulseCommandQueue& operator=(const PulseCommandQueue&) = delete;
+
+    /**
+     * @brief Queues a manual override of a traffic light's signal state. Thread-safe.
+     * @param traffic_light_id The light.
+     * @param state Signal state string, one character per controlled link.
+     * @return Ticket (sequence) of the command.
+     * @throws std::invalid_argument if the ID or state is empty
+     */
+    std::uint64_t overrideLight(const std::string& traffic_light_id, const std::string& state);
+
+    /**
+     * @brief Queues a change of a traffic light's fixed-time plan. Thread-safe.
+     * @param plan The new plan.
+     * @return Ticket (sequence) of the command.
+     * @throws std::invalid_argument if the plan has no light ID
+     */
+    std::uint64_t changePlan(const PulseSignalPlan& plan);
+
+    /**
+     * @brief Stamps a command with its sequence and issue time and queues it. Thread-safe.
+     * @param command The command; sequence and issued_at are overwritten.
+     * @return Ticket (sequence) of the command.
+     * @throws std::invalid_argument if the command has no light ID
+     */
+    std::uint64_t push(PulseControlCommand command);
+
+    /**
+     * @brief Takes every pending command and coalesces them. Simulation thread only.
+     * @return Commands to apply in sequence order; valid until the next drain().
+     */
+    const std::vector<PulseControlCommand>& drain();
+
+    /**
+     * @brief Checks whether no command is pending. Thread-safe.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @brief Number of commands pushed so far. Thread-safe.
+     */
+    [[nodiscard]] std::uint64_t getIssuedCount() const;
+
+    /**
+     * @brief Number of drained commands dropped because a later one replaced them, in the same
+     *        or an earlier drain. Thread-safe.
+     */
+    [[nodiscard]] std::uint64_t getCoalescedCount() const;
+
+private:
+    struct Node
+    {
+        PulseControlCommand command;
+        Node* next = nullptr;   ///< Command pushed before this one.
+    };
+
+private:
+    std::atomic<Node*> m_head{nullptr};         ///< Most recently pushed command.
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::atomic<std::uint64_t> m_coalesced{0};
+
+    // Consumer only; grow to their peak size and are reused.
+    std::vector<Node*> m_pending;                               ///< Drained nodes, highest sequence first.
+    std::vector<PulseControlCommand> m_batch;                   ///< Result of the last drain().
+    std::unordered_map<std::string, std::uint64_t> m_latest[2]; ///< Highest sequence handed out per light, per command type.
+};
+
+#endif //PULSECOMMANDQUEUE_H
@@ -7,33 +7,59 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <memory_resource>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include "core/SumoIntegration.h"
+#include "core/PulseEntityViews.h"
+#include "core/PulsePedestrianTable.h"
+#include "core/PulseSnapshotPublisher.h"
+#include "core/PulseTransitTable.h"
+#include "core/SimulationSource.h"
 
+#include "entities/PulseEntityTraits.h"
 #include "entities/PulseIntersection.h"
 #include "entities/PulseTrafficLight.h"
 #include "entities/PulseVehicle.h"
 
+#include "types/PulseRoadTransition.h"
+
+#include "utils/PulseStringHash.h"
+
 /**
  * @class PulseDataManager
- * @brief Singleton manager that stores all traffic simulation entities (intersections, traffic lights, vehicles).
+ * @brief Manager that stores all traffic simulation entities (intersections, traffic lights, vehicles).
+ *
+ * It can sync data with a live SUMO simulation via SumoIntegration (or any other SimulationSource),
+ * ensuring that local objects remain consistent with the real-time simulation.
  *
- * It can sync data with a live SUMO simulation via SumoIntegration, ensuring that
- * local objects remain consistent with the real-time simulation.
+ * getInstance() returns the process-wide manager used by the default TrafficSystem; independent
+ * instances can be created for parallel scenario replications.
+ *
+ * All mutating calls and the pointer-returning getters belong to the simulation thread.
+ * Other threads (dashboards, APIs) read state through acquireSnapshot() instead.
  */
 class PulseDataManager
 {
 public:
     /**
-     * @brief Retrieves the singleton instance.
-     * @return Reference to the single PulseDataManager.
+     * @brief Retrieves the process-wide instance.
+     * @return Reference to the shared PulseDataManager.
      */
     static PulseDataManager& getInstance();
 
+    /**
+     * @brief Constructs an empty, independent data manager.
+     */
+    PulseDataManager() = default;
+
     /**
      * @brief Adds a new intersection to the data manager.
      * @throws std::invalid_argument if intersection is null
@@ -63,7 +89,7 @@ public:
     PulseTrafficLight* getTrafficLight(const std::string& traffic_light_id) const;
 
     /**
-     * @brief Adds a new vehicle to the data manager.
+     * @brief Adds a new vehicle to the data manager; buses and trams are also tracked in getTransit().
      * @throws std::invalid_argument if vehicle is null
      * @throws std::runtime_error if a vehicle with the same ID already exists
      */
@@ -71,6 +97,10 @@ public:
 
     /**
      * @brief Retrieves a vehicle by ID.
+     *
+     * The pointer is valid until the vehicle departs. Its storage is then recycled for a later
+     * arrival, so a pointer kept across updates must be checked with PulseVehicle::getGeneration()
+     * or looked up again by ID.
      * @param vehicle_id The ID of the vehicle.
      * @return Pointer to the vehicle, or nullptr if not found.
      */
@@ -78,22 +108,143 @@ public:
 
     /**
      * @brief Retrieves all intersections in the system.
+     *        Builds a new list on every call; prefer viewIntersections() when iterating.
      * @return A list of pointers to all intersections.
      */
     std::vector<PulseIntersection*> getAllIntersections() const;
 
     /**
      * @brief Retrieves all traffic lights in the system.
+     *        Builds a new list on every call; prefer viewTrafficLights() when iterating.
      * @return A list of pointers to all traffic lights.
      */
     std::vector<PulseTrafficLight*> getAllTrafficLights() const;
 
     /**
      * @brief Retrieves all vehicles in the system.
+     *        Builds a new list on every call; prefer viewVehicles() when iterating.
      * @return A list of pointers to all vehicles.
      */
     std::vector<PulseVehicle*> getAllVehicles() const;
 
+    /**
+     * @brief Lazy view of all entities of a kind, read straight from their container.
+     *
+     * Elements are references to the concrete class; iterating allocates nothing and the view
+     * composes with std::views adaptors and the filters of PulseViews. Like any iterator into the
+     * storage, it must not be used across calls that add or remove entities (e.g. updateFromSumo()).
+     * @tparam Type The entity kind.
+     */
+    template <PulseEntityType Type>
+    auto view() const
+    {
+        if constexpr (Type == PulseEntityType::INTERSECTION) {
+            return m_intersections | std::views::values
+                 | std::views::transform([](const std::unique_ptr<PulseIntersection>& intersection) -> PulseIntersection& {
+                       return *intersection;
+                   });
+        }
+        else {
+            const auto& entries = [this]() -> const auto& {
+                if constexpr (Type == PulseEntityType::TRAFFIC_LIGHT) {
+                    return m_traffic_lights;
+                }
+                else {
+                    return m_vehicles;
+                }
+            }();
+            return entries | std::views::values
+                 | std::views::transform([](const Entry<PulseEntityOf<Type>>& entry) -> PulseEntityOf<Type>& {
+                       return *entry.entity;
+                   });
+        }
+    }
+
+    /**
+     * @brief Lazy views of all intersections, traffic lights and vehicles; see view().
+     */
+    auto viewIntersections() const { return view<PulseEntityType::INTERSECTION>(); }
+    auto viewTrafficLights() const { return view<PulseEntityType::TRAFFIC_LIGHT>(); }
+    auto viewVehicles() const { return view<PulseEntityType::VEHICLE>(); }
+
+    /**
+     * @brief Calls a function for every vehicle without building a list.
+     * @param fn Callable taking a const PulseVehicle&.
+     */
+    template <typename Fn>
+    void forEachVehicle(Fn&& fn) const
+    {
+        forEach<PulseEntityType::VEHICLE>(std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Adds an entity of a kind known at compile time.
+     * @tparam Type The entity kind.
+     * @throws std::invalid_argument if entity is null
+     * @throws std::runtime_error if an entity of that kind with the same ID already exists
+     */
+    template <PulseEntityType Type>
+    void add(std::unique_ptr<PulseEntityOf<Type>> entity)
+    {
+        if constexpr (Type == PulseEntityType::INTERSECTION) {
+            addIntersection(std::move(entity));
+        }
+        else if constexpr (Type == PulseEntityType::TRAFFIC_LIGHT) {
+            addTrafficLight(std::move(entity));
+        }
+        else {
+            addVehicle(std::move(entity));
+        }
+    }
+
+    /**
+     * @brief Retrieves an entity of a kind known at compile time, as its concrete class.
+     * @tparam Type The entity kind.
+     * @param id The ID of the entity.
+     * @return Pointer to the entity, or nullptr if not found.
+     */
+    template <PulseEntityType Type>
+    PulseEntityOf<Type>* get(const std::string& id) const
+    {
+        if constexpr (Type == PulseEntityType::INTERSECTION) {
+            return getIntersection(id);
+        }
+        else if constexpr (Type == PulseEntityType::TRAFFIC_LIGHT) {
+            return getTrafficLight(id);
+        }
+        else {
+            return getVehicle(id);
+        }
+    }
+
+    /**
+     * @brief Calls a function for every entity of a kind, directly on its container.
+     * @tparam Type The entity kind.
+     * @param fn Callable taking a const reference to the concrete class.
+     */
+    template <PulseEntityType Type, typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        if constexpr (Type == PulseEntityType::INTERSECTION) {
+            for (const auto& [id, intersection] : m_intersections) {
+                fn(std::as_const(*intersection));
+            }
+        }
+        else {
+            const auto& entries = [this]() -> const auto& {
+                if constexpr (Type == PulseEntityType::TRAFFIC_LIGHT) {
+                    return m_traffic_lights;
+                }
+                else {
+                    return m_vehicles;
+                }
+            }();
+            for (const auto& [id, entry] : entries) {
+                fn(std::as_const(*entry.entity));
+            }
+        }
+    }
+
     /**
      * @brief Clears all stored data (used when resetting or re-syncing).
      */
@@ -102,30 +253,206 @@ public:
     /**
      * @brief Syncs data from SUMO the first time (or after clearing).
      *        This loads all traffic lights as intersections, plus vehicles.
-     * @param sumo Reference to the SumoIntegration instance.
+     * @param sumo Reference to the simulation source (e.g., SumoIntegration).
      */
-    void syncFromSumo(const SumoIntegration &sumo);
+    void syncFromSumo(const SimulationSource &sumo);
 
     /**
      * @brief Updates local data from the current SUMO simulation step.
      *        Typically called each time we step the simulation.
-     * @param sumo Reference to the SumoIntegration instance.
+     *
+     * Departed vehicles are parked and recycled in place for new arrivals, map nodes come from
+     * a pooled resource and all scratch buffers are reused, so once the fleet size has settled
+     * a step performs no heap allocations of its own.
+     * @param sumo Reference to the simulation source (e.g., SumoIntegration).
+     */
+    void updateFromSumo(const SimulationSource &sumo);
+
+    /**
+     * @brief Starts an update pass made of separate sync calls; updateFromSumo() starts its own.
+     *
+     * Within a pass each of syncVehicles(), syncTrafficLights(), syncPedestrians() and syncTransit()
+     * runs at most once, and any of them may be left out, so parts of the state can be refreshed at
+     * different rates (see TrafficSystem::setStageRate()). Entities of a part that was left out keep
+     * their last synced values; road transitions are cleared, so none is reported by two passes.
+     */
+    void beginUpdate();
+
+    /**
+     * @brief Reconciles vehicles (arrivals, departures, positions, kinematics) in the current pass.
+     */
+    void syncVehicles(const SimulationSource &sumo);
+
+    /**
+     * @brief Reconciles traffic lights and their states in the current pass.
+     */
+    void syncTrafficLights(const SimulationSource &sumo);
+
+    /**
+     * @brief Reconciles pedestrians and books crossing waits in the current pass.
+     */
+    void syncPedestrians(const SimulationSource &sumo);
+
+    /**
+     * @brief Reads the schedule position of public-transport vehicles in the current pass.
+     */
+    void syncTransit(const SimulationSource &sumo);
+
+    /**
+     * @brief Enables reading each vehicle's road, lane position and speed during updateFromSumo().
+     *        Off by default, as it costs several extra simulation queries per vehicle and step.
+     * @param enabled Whether kinematics are tracked.
+     */
+    void setKinematicsTracking(bool enabled);
+
+    /**
+     * @brief Checks whether vehicle kinematics are tracked.
+     */
+    [[nodiscard]] bool isKinematicsTrackingEnabled() const;
+
+    /**
+     * @brief Road traversals completed during the current update pass (updateFromSumo() or the
+     *        stages following beginUpdate()). Empty for a pass that did not sync vehicles.
+     *        Only vehicles observed entering a road produce a traversal, so each one covers the whole road.
+     * @return A view that stays valid until the next update.
+     */
+    [[nodiscard]] std::span<const PulseRoadTransition> getRoadTransitions() const;
+
+    /**
+     * @brief Pedestrians of the last update. Each pedestrian stepping onto a crossing adds a
+     *        pedestrian pass, with its waiting time, to the intersection with the junction's ID.
+     * @return The pedestrian table.
+     */
+    [[nodiscard]] const PulsePedestrianTable& getPedestrians() const;
+
+    /**
+     * @brief Buses and trams of the last update with their schedule lateness. Vehicles are added
+     *        when they first appear with a transit type and removed when they leave.
+     * @return The transit table.
+     */
+    [[nodiscard]] const PulseTransitTable& getTransit() const;
+
+    /**
+     * @brief Copies the current state into a new immutable snapshot and publishes it to readers.
+     *        Called by the simulation thread once per step, after updateFromSumo().
+     *
+     * Snapshot objects are recycled, and each remembers which entities its records were written
+     * for. Vehicles keep a stable record slot while they stay in the network, so only the slots of
+     * arrivals and departures get their ID, type and role copied again; the other records only get
+     * their position. Traffic light and intersection IDs are copied only after lights or
+     * intersections were added or removed.
      */
-    void updateFromSumo(const SumoIntegration &sumo);
+    void publishSnapshot();
 
-    // Deleted copy constructor & assignment op for singleton
+    /**
+     * @brief Pins the latest published snapshot. Safe to call from any thread, never blocks the simulation.
+     * @return A guard keeping the snapshot alive; empty if nothing was published yet.
+     */
+    [[nodiscard]] PulseSnapshotPublisher::Guard acquireSnapshot() const;
+
+    // Entities are owned uniquely; managers are neither copied nor moved
     PulseDataManager(const PulseDataManager&) = delete;
     PulseDataManager& operator=(const PulseDataManager&) = delete;
 
 private:
-    // Private constructor for singleton
-    PulseDataManager() = default;
+    /**
+     * @brief Reconciles vehicles (arrivals, departures, positions) with the simulation.
+     */
+    void updateVehicles(const SimulationSource &sumo, std::uint64_t update);
+
+    /**
+     * @brief Applies m_kinematics_buffer to a vehicle, recording a traversal when it changed roads.
+     */
+    void updateKinematics(PulseVehicle &vehicle, double now);
+
+    /**
+     * @brief Reconciles traffic lights and their states with the simulation.
+     */
+    void updateTrafficLights(const SimulationSource &sumo, std::uint64_t update);
+
+    /**
+     * @brief Reconciles the pedestrian table with the persons in the simulation and books
+     *        completed crossing waits at their intersections.
+     * @param sumo Reference to the simulation source.
+     * @param update Counter value identifying this update.
+     */
+    void updatePedestrians(const SimulationSource &sumo, std::uint64_t update);
+
+    /**
+     * @brief Reads the schedule position of the public-transport vehicles only.
+     */
+    void updateTransit(const SimulationSource &sumo);
 
 private:
+    /**
+     * @brief Stored entity plus the update pass in which SUMO last reported it.
+     */
+    template <typename T>
+    struct Entry
+    {
+        std::unique_ptr<T> entity;
+        std::uint64_t last_seen_update = 0;
+        std::size_t slot = 0;           ///< Vehicles only: index in m_vehicle_slots.
+        std::uint64_t serial = 0;       ///< Vehicles only: unique per insertion, never reused.
+    };
+
+    /**
+     * @brief What a recycled snapshot object was last written with.
+     */
+    struct SnapshotLayout
+    {
+        std::vector<std::uint64_t> vehicle_serials;     ///< Serial of the vehicle in each record.
+        std::uint64_t traffic_light_layout = 0;         ///< m_traffic_light_layout at that time.
+        std::uint64_t intersection_layout = 0;          ///< m_intersection_layout at that time.
+    };
+
+    template <typename T>
+    using PooledMap = std::pmr::unordered_map<std::pmr::string, Entry<T>, PulseStringHash, PulseStringEqual>;
+
+    /**
+     * @brief Stores a vehicle under its ID and gives it the last snapshot slot.
+     * @return The stored entry.
+     */
+    Entry<PulseVehicle>& insertVehicle(const std::string& vehicle_id, std::unique_ptr<PulseVehicle> vehicle, std::uint64_t update);
+
+    // Backing store for vehicle and traffic light map nodes and keys; must outlive the maps.
+    std::pmr::unsynchronized_pool_resource m_node_resource;
+
     // Intersection, traffic light, and vehicle storage
     std::unordered_map<std::string, std::unique_ptr<PulseIntersection>> m_intersections;
-    std::unordered_map<std::string, std::unique_ptr<PulseTrafficLight>> m_traffic_lights;
-    std::unordered_map<std::string, std::unique_ptr<PulseVehicle>> m_vehicles;
+    PooledMap<PulseTrafficLight> m_traffic_lights{&m_node_resource};
+    PooledMap<PulseVehicle> m_vehicles{&m_node_resource};
+
+    // Departed vehicles kept for in-place reuse by the next arrivals.
+    std::vector<std::unique_ptr<PulseVehicle>> m_retired_vehicles;
+
+    // Snapshot record order: vehicles keep their slot until they leave, when the last one moves in.
+    std::vector<Entry<PulseVehicle>*> m_vehicle_slots;
+    std::uint64_t m_next_vehicle_serial = 1;
+    std::uint64_t m_traffic_light_layout = 1;   ///< Bumped whenever traffic lights are added or removed.
+    std::uint64_t m_intersection_layout = 1;    ///< Bumped whenever intersections are added or removed.
+    std::unordered_map<const PulseStateSnapshot*, SnapshotLayout> m_snapshot_layouts;
+
+    // Scratch buffers reused across updates.
+    std::vector<std::string> m_vehicle_id_buffer;
+    std::vector<std::string> m_traffic_light_id_buffer;
+    std::string m_traffic_light_state_buffer;
+    PulseVehicleKinematics m_kinematics_buffer;
+
+    // Pedestrians, in their own table, and the reused batch they are read into.
+    PulsePedestrianTable m_pedestrians;
+    std::vector<PulsePersonState> m_person_buffer;
+
+    // Public-transport vehicles, also stored as vehicles, with their schedule state.
+    PulseTransitTable m_transit;
+
+    bool m_track_kinematics = false;
+    std::vector<PulseRoadTransition> m_road_transitions;    ///< Grows to the peak count; entries are reused.
+    std::size_t m_road_transition_count = 0;                ///< Valid entries of the current update pass.
+
+    std::uint64_t m_update_counter = 0; ///< Incremented on every update pass (updateFromSumo or beginUpdate).
+
+    PulseSnapshotPublisher m_snapshots; ///< Per-step snapshots for concurrent readers.
 };
 
 #endif //PULSEDATAMANAGER_H
@@ -0,0 +1,140 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEDEMANDFILE_H
+#define PULSEDEMANDFILE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types/PulseTripRecord.h"
+
+/**
+ * @class PulseDemandFile
+ * @brief A SUMO route or trip file (.rou.xml, .trips.xml, optionally gzipped) parsed into trip records.
+ *
+ * The file is read (and inflated) into one buffer that serves as the arena for every record:
+ * a single forward pass over it locates the demand elements that are children of the root and
+ * records views of their id, type, edges and raw text, so parsing copies no strings. Keeping the
+ * whole text resident is what lets records be views; gzip input is inflated in chunks straight
+ * into that buffer, and gzip output is compressed in 1 MiB chunks as it is written, so neither
+ * direction holds a second full copy. Everything
+ * else at the top level (vTypes, named routes, distributions) is kept as definitions.
+ *
+ * select() and sample() pick a subset that write() turns back into a valid demand file: the
+ * original prolog and root element, all definitions, then the chosen elements verbatim.
+ */
+class PulseDemandFile
+{
+public:
+    /**
+     * @brief Reads and parses a demand file; gzip input is detected from its header.
+     * @throws std::runtime_error if the file cannot be read or is not well-formed
+     */
+    [[nodiscard]] static PulseDemandFile load(const std::string& path);
+
+    /**
+     * @brief Parses demand XML held in memory.
+     * @throws std::runtime_error if the XML is not well-formed
+     */
+    [[nodiscard]] static PulseDemandFile parse(std::string_view xml);
+
+    PulseDemandFile(PulseDemandFile&&) noexcept = default;
+    PulseDemandFile& operator=(PulseDemandFile&&) noexcept = default;
+    PulseDemandFile(const PulseDemandFile&) = delete;
+    PulseDemandFile& operator=(const PulseDemandFile&) = delete;
+
+    /**
+     * @brief Demand elements in file order.
+     */
+    [[nodiscard]] const std::vector<PulseTripRecord>& getTrips() const;
+
+    /**
+     * @brief Top-level elements that are not demand (vType, route, ...), in file order.
+     */
+    [[nodiscard]] const std::vector<std::string_view>& getDefinitions() const;
+
+    /**
+     * @brief Size of the parsed (inflated) XML in bytes.
+     */
+    [[nodiscard]] std::size_t getSize() const;
+
+    /**
+     * @brief Trips accepted by a predicate, in file order.
+     * @param keep Callable taking a const PulseTripRecord& and returning bool.
+     */
+    template <typename Predicate>
+    [[nodiscard]] std::vector<const PulseTripRecord*> select(Predicate&& keep) const
+    {
+        std::vector<const PulseTripRecord*> selected;
+        for (const auto& trip : m_trips) {
+            if (keep(trip)) {
+                selected.push_back(&trip);
+            }
+        }
+        return selected;
+    }
+
+    /**
+     * @brief Deterministic down-sample keeping about fraction of the trips, in file order.
+     *
+     * Each trip is kept by hashing its id with the seed, so a smaller fraction keeps a subset
+     * of what a larger one keeps, and the same trips are chosen on every run.
+     *
+     * @throws std::invalid_argument if fraction is not within [0, 1]
+     */
+    [[nodiscard]] std::vector<const PulseTripRecord*> sample(double fraction, std::uint64_t seed = 0) const;
+
+    /**
+     * @brief Writes a demand file holding the definitions and the given trips, in the given order.
+     * @param trips Records of this file, e.g. from select() or sample().
+     */
+    void write(std::ostream& out, const std::vector<const PulseTripRecord*>& trips) const;
+
+    /**
+     * @brief Writes a demand file to disk, gzip-compressed if the path ends in ".gz".
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path, const std::vector<const PulseTripRecord*>& trips) const;
+
+    /**
+     * @brief Writes a demand file holding the definitions and the given element texts, e.g. rewritten trips.
+     */
+    void write(std::ostream& out, const std::vector<std::string_view>& elements) const;
+
+    /**
+     * @brief Writes element texts to disk, gzip-compressed if the path ends in ".gz".
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path, const std::vector<std::string_view>& elements) const;
+
+    /**
+     * @brief Writes element texts produced one at a time, so they never have to be held together.
+     * @param next Sets the next element and returns true, or returns false after the last one; each
+     *        element only has to stay valid until the following call.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path, const std::function<bool(std::string_view&)>& next) const;
+
+private:
+    PulseDemandFile() = default;
+
+    void parseBuffer();
+
+private:
+    std::vector<char> m_buffer;                     ///< Arena: the XML text every view points into.
+    std::vector<PulseTripRecord> m_trips;
+    std::vector<std::string_view> m_definitions;
+    std::string_view m_prolog;                      ///< Everything up to the root start tag's closing '>' or '/>'.
+    std::string_view m_root;                        ///< Root element name, for the closing tag.
+};
+
+#endif //PULSEDEMANDFILE_H
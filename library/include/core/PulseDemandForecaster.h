@@ -0,0 +1,117 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEDEMANDFORECASTER_H
+#define PULSEDEMANDFORECASTER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+
+#include "entities/PulseIntersection.h"
+
+/**
+ * @brief Model parameters of PulseDemandForecaster.
+ */
+struct PulseForecastConfig {
+    std::size_t season_length = 288;    ///< Intervals per season (one day of 5-minute intervals); 1 disables seasonality.
+    std::size_t horizon = 3;            ///< Intervals forecast ahead (15 minutes with 5-minute intervals).
+    double level_smoothing = 0.3;       ///< Weight of a new observation in the level, in (0, 1].
+    double trend_smoothing = 0.05;      ///< Weight of the latest level change in the trend, in [0, 1].
+    double season_smoothing = 0.1;      ///< Weight of the latest deviation in the seasonal profile, in [0, 1].
+};
+
+/**
+ * @brief Predicted demand at an intersection for one future interval.
+ */
+struct PulseDemandForecast {
+    double vehicles;                    ///< Vehicles passing during the interval.
+    double average_waiting_time;        ///< Mean waiting time per vehicle in seconds.
+};
+
+/**
+ * @class PulseDemandForecaster
+ * @brief Short-horizon forecasts of vehicle flow and waiting time per intersection.
+ *
+ * Once per interval, recordInterval() takes the growth of each intersection's cumulative
+ * IntersectionStatistics as that interval's observation and updates an additive Holt-Winters model
+ * (level, trend and seasonal profile) per series. Model state is stored as flat arrays over all
+ * intersections, so the update and the forecasts for every horizon are one batched pass.
+ */
+class PulseDemandForecaster
+{
+public:
+    /**
+     * @brief Creates a forecaster with no intersections yet.
+     * @throws std::invalid_argument if a parameter is out of range
+     */
+    explicit PulseDemandForecaster(const PulseForecastConfig& config = {});
+
+    /**
+     * @brief Closes an interval for the given intersections and refreshes all forecasts.
+     *
+     * An intersection seen for the first time only sets its baseline; it is forecast from the next interval on.
+     * @param intersections Intersections whose statistics are sampled.
+     * @throws std::invalid_argument if an intersection is null
+     */
+    void recordInterval(const std::vector<PulseIntersection*>& intersections);
+
+    /**
+     * @brief Closes an interval for all intersections of a data manager.
+     */
+    void recordInterval(const PulseDataManager& data_manager);
+
+    /**
+     * @brief Retrieves the forecast for an intersection.
+     * @param intersection_id The intersection.
+     * @param intervals_ahead 1 for the next interval, up to the configured horizon.
+     * @throws std::invalid_argument if the intersection has no forecast yet
+     * @throws std::out_of_range if intervals_ahead is outside [1, horizon]
+     */
+    [[nodiscard]] PulseDemandForecast getForecast(const std::string& intersection_id, std::size_t intervals_ahead) const;
+
+    /**
+     * @brief Number of intervals recorded so far.
+     */
+    [[nodiscard]] std::uint64_t getIntervalCount() const;
+
+    /**
+     * @brief Number of intersections being forecast.
+     */
+    [[nodiscard]] std::size_t getIntersectionCount() const;
+
+private:
+    static constexpr std::size_t kFlow = 0;     ///< Series offset of the vehicle flow.
+    static constexpr std::size_t kWait = 1;     ///< Series offset of the average waiting time.
+    static constexpr std::size_t kSeriesPerIntersection = 2;
+
+    std::size_t addIntersection(PulseIntersection& intersection);
+    void sampleIntersection(PulseIntersection& intersection);
+    void updateModels();
+
+private:
+    PulseForecastConfig m_config;
+    std::uint64_t m_intervals = 0;
+
+    std::unordered_map<std::string, std::size_t> m_index;  ///< Intersection ID to position.
+    std::vector<std::size_t> m_last_vehicles;               ///< Cumulative counts at the previous interval.
+    std::vector<double> m_last_waiting;                     ///< Cumulative waiting time at the previous interval.
+    std::vector<std::uint64_t> m_seen_interval;             ///< Interval in which each intersection was last observed.
+    std::vector<std::uint64_t> m_samples;                   ///< Observations fitted per intersection.
+
+    // Per series (intersection * kSeriesPerIntersection + metric)
+    std::vector<double> m_observation;
+    std::vector<double> m_level;
+    std::vector<double> m_trend;
+    std::vector<double> m_season;                           ///< season_length values per series.
+    std::vector<double> m_forecast;                         ///< horizon values per series.
+};
+
+#endif //PULSEDEMANDFORECASTER_H
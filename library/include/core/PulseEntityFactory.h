@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <concepts>
 #include <memory>
+#include <utility>
 
 #include "entities/PulseEntity.h"
+#include "entities/PulseEntityTraits.h"
 #include "entities/PulseVehicle.h"
 
 #include "types/PulsePosition.h"
@@ -18,10 +21,27 @@
 /**
  * @class PulseEntityFactory
  * @brief Factory class for creating PulseIntersection, PulseTrafficLight, and PulseVehicle objects.
+ *
+ * create<Type>() is resolved at compile time and returns the concrete class, so callers need no
+ * downcast and calls through the result are not virtual. createEntity() serves config-driven
+ * creation where the kind is only known at run time.
  */
 class PulseEntityFactory
 {
 public:
+    /**
+     * @brief Creates an entity of a kind known at compile time.
+     * @tparam Type The kind of entity to create.
+     * @param args Constructor arguments of the concrete class.
+     * @return A unique pointer to the concrete entity.
+     */
+    template <PulseEntityType Type, typename... Args>
+        requires std::constructible_from<PulseEntityOf<Type>, Args...>
+    static std::unique_ptr<PulseEntityOf<Type>> create(Args&&... args)
+    {
+        return std::make_unique<PulseEntityOf<Type>>(std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Creates an entity dynamically based on the requested type.
      * @param type The type of entity to create.
@@ -29,7 +49,7 @@ public:
      * @param position (Optional) The position for intersections.
      * @param vehicle_type (Optional) The type of vehicle.
      * @param vehicle_role (Optional) The role of the vehicle.
-     * @return A unique pointer to the created PulseEntity.
+     * @return A unique pointer to the created PulseEntity, or nullptr for an unknown type.
      */
     static std::unique_ptr<PulseEntity> createEntity(
         PulseEntityType type,
@@ -0,0 +1,54 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEENTITYVIEWS_H
+#define PULSEENTITYVIEWS_H
+
+#pragma once
+
+#include <ranges>
+
+#include "types/PulseBoundingBox.h"
+#include "types/PulseVehicleRole.h"
+#include "types/PulseVehicleType.h"
+
+/**
+ * @class PulseViews
+ * @brief Filters to compose with the entity views of PulseDataManager.
+ *
+ * Each filter is a std::views::filter adaptor, so chaining them evaluates lazily and allocates
+ * nothing, e.g. every bus in the city center:
+ * @code
+ * for (PulseVehicle& bus : manager.viewVehicles() | PulseViews::ofType(PulseVehicleType::BUS)
+ *                                                  | PulseViews::within(center)) { ... }
+ * @endcode
+ */
+struct PulseViews
+{
+    /**
+     * @brief Keeps vehicles of one type.
+     */
+    static auto ofType(PulseVehicleType type)
+    {
+        return std::views::filter([type](const auto& vehicle) { return vehicle.getType() == type; });
+    }
+
+    /**
+     * @brief Keeps vehicles with one role.
+     */
+    static auto withRole(PulseVehicleRole role)
+    {
+        return std::views::filter([role](const auto& vehicle) { return vehicle.getRole() == role; });
+    }
+
+    /**
+     * @brief Keeps entities (vehicles, intersections) positioned inside a box.
+     */
+    static auto within(const PulseBoundingBox& box)
+    {
+        return std::views::filter([box](const auto& entity) { return box.contains(entity.getPosition()); });
+    }
+};
+
+#endif //PULSEENTITYVIEWS_H
@@ -0,0 +1,155 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSELIVESERVER_H
+#define PULSELIVESERVER_H
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseSnapshotPublisher.h"
+#include "core/PulseStateEncoder.h"
+
+#include "types/PulseWireFormat.h"
+
+/**
+ * @brief Settings of the live state server.
+ */
+struct PulseLiveServerConfig {
+    std::string bind_address = "127.0.0.1";         ///< IPv4 address to listen on.
+    std::uint16_t port = 0;                         ///< TCP port; 0 picks a free one (see getPort()).
+    std::chrono::milliseconds poll_interval{20};    ///< How often the server looks for a new snapshot.
+    std::size_t max_clients = 64;                   ///< Connections beyond this are closed right away.
+    std::size_t max_queued_bytes = 1 << 20;         ///< Unsent bytes per stream client before it is resynchronized.
+    int socket_buffer_size = 0;                     ///< Send buffer of client sockets; 0 keeps the system default.
+};
+
+/**
+ * @class PulseLiveServer
+ * @brief Embedded HTTP and WebSocket server publishing the live network state.
+ *
+ * Endpoints (append "?format=binary" for the compact encoding of PulseStateEncoder):
+ * - GET /state returns the latest published snapshot as one message;
+ * - GET /stream upgrades to a WebSocket that first receives the latest state, then one delta
+ *   per new snapshot epoch (text frames for JSON, binary frames otherwise).
+ * - GET /metrics returns the PulseProfiler metrics in the Prometheus text format.
+ *
+ * The server runs on its own thread and reads snapshots through PulseDataManager::acquireSnapshot(),
+ * so the simulation thread only pays for publishing. Each new epoch is diffed and encoded once per
+ * format in use, and the same frame is queued to every client. A client whose unsent data would
+ * exceed max_queued_bytes has its pending deltas dropped and receives the full state of the next
+ * epoch instead, so a slow client never holds back the others or grows memory without bound.
+ *
+ * Sockets are POSIX; the server is meant for monitoring on a trusted network and implements the
+ * parts of HTTP/1.1 and RFC 6455 needed for that (no TLS, no keep-alive, no fragmented messages).
+ */
+class PulseLiveServer
+{
+public:
+    /**
+     * @brief Constructs a stopped server.
+     * @param data_manager Source of the published snapshots; must outlive the server.
+     * @param config Server settings.
+     * @throws std::invalid_argument if the address is not IPv4 or a limit is zero
+     */
+    explicit PulseLiveServer(const PulseDataManager& data_manager, const PulseLiveServerConfig& config = {});
+
+    /**
+     * @brief Stops the server.
+     */
+    ~PulseLiveServer();
+
+    PulseLiveServer(const PulseLiveServer&) = delete;
+    PulseLiveServer& operator=(const PulseLiveServer&) = delete;
+
+    /**
+     * @brief Binds the listening socket and starts the server thread.
+     * @throws std::logic_error if the server is already running
+     * @throws std::runtime_error if the socket cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Closes all connections and joins the server thread; does nothing if stopped.
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether the server thread is running; false once it stopped on an error.
+     */
+    [[nodiscard]] bool isRunning() const;
+
+    /**
+     * @brief errno of the failure that stopped the server thread on its own; 0 if none.
+     */
+    [[nodiscard]] int getError() const;
+
+    /**
+     * @brief Port the server listens on; valid after start().
+     */
+    [[nodiscard]] std::uint16_t getPort() const;
+
+    /**
+     * @brief Number of connected stream (WebSocket) clients.
+     */
+    [[nodiscard]] std::size_t getStreamClientCount() const;
+
+    /**
+     * @brief Epoch of the last snapshot streamed to clients; 0 before the first.
+     */
+    [[nodiscard]] std::uint64_t getStreamedEpoch() const;
+
+    /**
+     * @brief Number of times a slow client had its deltas dropped in favor of a full state.
+     */
+    [[nodiscard]] std::uint64_t getResyncCount() const;
+
+private:
+    struct Client;
+    using Frame = std::shared_ptr<const std::string>;
+
+    void run();
+    void acceptClients();
+    void readClient(Client& client);
+    void handleRequest(Client& client, const std::string& request);
+    void handleFrames(Client& client);
+    void streamSnapshot();
+    void sendState(Client& client, const PulseStateSnapshot& snapshot);
+    void enqueue(Client& client, Frame frame, bool droppable);
+    void flush(Client& client);
+    void closeSockets();
+
+private:
+    const PulseDataManager& m_data_manager;
+    PulseLiveServerConfig m_config;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stop_requested{false};
+    std::atomic<bool> m_running{false};
+    std::atomic<int> m_error{0};
+    int m_listen_fd = -1;
+    int m_wake_fds[2] = {-1, -1};   ///< Pipe written by stop() to interrupt poll().
+    std::uint16_t m_port = 0;
+
+    // Server thread only
+    std::vector<std::unique_ptr<Client>> m_clients;
+    PulseStateEncoder m_encoder;
+    PulseSnapshotPublisher::Guard m_current;    ///< Snapshot the encoder's base comes from; pinned for new clients.
+    std::string m_message_buffer;
+
+    std::atomic<std::size_t> m_stream_clients{0};
+    std::atomic<std::uint64_t> m_streamed_epoch{0};
+    std::atomic<std::uint64_t> m_resyncs{0};
+};
+
+#endif //PULSELIVESERVER_H
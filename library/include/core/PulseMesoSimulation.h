@@ -0,0 +1,255 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEMESOSIMULATION_H
+#define PULSEMESOSIMULATION_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/IntersectionStatistics.h"
+#include "core/SimulationSource.h"
+
+#include "entities/PulseIntersection.h"
+
+#include "types/TrafficLightDurations.h"
+#include "types/TrafficLightState.h"
+
+/**
+ * @brief Model parameters of PulseMesoSimulation.
+ */
+struct PulseMesoConfig {
+    double time_step = 1.0;             ///< Seconds advanced per stepSimulation() call.
+    double free_flow_speed = 13.89;     ///< m/s on every link (50 km/h).
+    double saturation_flow = 0.5;       ///< Vehicles per second a link discharges while green (1800 veh/h).
+    double jam_spacing = 7.5;           ///< Meters of link a stored vehicle occupies.
+    double exit_probability = 0.2;      ///< Chance that a vehicle leaves the network at each intersection it reaches.
+};
+
+/**
+ * @class PulseMesoSimulation
+ * @brief Lightweight, deterministic queue simulation on the intersection graph, a stand-in for SUMO.
+ *
+ * Every road connection is a link that vehicles cross at free-flow speed before joining a FIFO queue
+ * at its downstream end (point-queue dynamics). While the link's traffic light is green, the queue
+ * discharges at the saturation flow into the next link, which must have storage left (spatial queue,
+ * so queues spill back). At each intersection a vehicle leaves the network with the exit probability,
+ * otherwise it takes a uniformly chosen outgoing link. Vehicles enter at intersections with demand,
+ * with exponential headways.
+ *
+ * Lights run fixed-time cycles of green, yellow and red from TrafficLightDurations. Discharged
+ * vehicles are counted in per-intersection IntersectionStatistics with their queueing delay as
+ * waiting time. The graph is copied at construction, so many instances can run in parallel from the
+ * same intersections. With the same seed, demand and plans, every run produces the same result.
+ *
+ * Link IDs (see getLinkId()) serve as road IDs in the reported vehicle kinematics.
+ */
+class PulseMesoSimulation : public SimulationSource
+{
+public:
+    /**
+     * @brief Builds the link network from the road connections of the given intersections.
+     *        Each light starts with the durations of its PulseTrafficLight and no offset.
+     * @throws std::invalid_argument if an intersection is null, a connection leads outside the set
+     *         or a model parameter is out of range
+     */
+    explicit PulseMesoSimulation(const std::vector<PulseIntersection*>& intersections, const PulseMesoConfig& config = {});
+
+    /**
+     * @brief Composes the ID of the link for a road connection.
+     */
+    [[nodiscard]] static std::string getLinkId(const std::string& intersection_id, int road_id);
+
+    /**
+     * @brief Sets the vehicles per hour entering the network at an intersection.
+     * @throws std::invalid_argument if the intersection is unknown, has no outgoing road or the rate is negative
+     */
+    void setDemand(const std::string& intersection_id, double vehicles_per_hour);
+
+    /**
+     * @brief Sets the fixed-time plan of a traffic light and returns it to plan control.
+     * @param traffic_light_id The light.
+     * @param durations Green, yellow and red durations; pedestrian durations are ignored.
+     * @param offset Seconds into the simulation at which the first green starts.
+     * @throws std::invalid_argument if the light is unknown or the cycle is not positive
+     */
+    void setTrafficLightPlan(const std::string& traffic_light_id, const TrafficLightDurations& durations, double offset = 0.0);
+
+    /**
+     * @brief Runs whole steps until at least the given time has passed.
+     * @throws std::runtime_error if the simulation is not running
+     */
+    void advance(double seconds);
+
+    /**
+     * @brief Retrieves the statistics of vehicles discharged into an intersection since the start.
+     * @throws std::invalid_argument if the intersection is unknown
+     */
+    [[nodiscard]] const IntersectionStatistics& getStatistics(const std::string& intersection_id) const;
+
+    /**
+     * @brief Sum of the queueing delay of all discharged vehicles, in seconds.
+     */
+    [[nodiscard]] double getTotalDelay() const;
+
+    /**
+     * @brief Delay accrued but not yet counted in the statistics: the waiting of vehicles still
+     *        queued plus the time generated vehicles spent waiting for a full entry link.
+     *
+     * Adding it to getTotalDelay() keeps plans that hold traffic back from looking better than
+     * plans that serve it.
+     */
+    [[nodiscard]] double getPendingDelay() const;
+
+    /**
+     * @brief Number of vehicles currently on links.
+     */
+    [[nodiscard]] std::size_t getVehicleCount() const;
+
+    /**
+     * @brief Number of vehicles generated but not yet admitted because their first link is full.
+     */
+    [[nodiscard]] std::size_t getBlockedEntries() const;
+
+    /**
+     * @brief Resets traffic, statistics, time and the random stream, then starts the simulation.
+     *        Plans and demand are kept.
+     * @throws std::runtime_error if the simulation is already running
+     */
+    void startSimulation() override;
+
+    /**
+     * @brief Advances one time step.
+     * @throws std::runtime_error if the simulation is not running
+     */
+    void stepSimulation() override;
+
+    /**
+     * @throws std::runtime_error if the simulation is not running
+     */
+    void stopSimulation() override;
+
+    [[nodiscard]] bool isRunning() const override;
+    void setSeed(std::uint64_t seed) override;
+
+    [[nodiscard]] std::vector<std::string> getAllVehicles() const override;
+    [[nodiscard]] std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const override;
+    [[nodiscard]] std::vector<std::string> getAllTrafficLights() const override;
+    [[nodiscard]] std::string getTrafficLightState(const std::string& tl_id) const override;
+
+    /**
+     * @brief Puts a light under external control: 'g'/'G' anywhere in the state means green, else
+     *        'y'/'Y' yellow, else red. The light keeps that state until setTrafficLightPlan() is called.
+     * @throws std::invalid_argument if the light is unknown
+     */
+    void setTrafficLightState(const std::string& tl_id, const std::string& state) override;
+
+    void fillVehicleIds(std::vector<std::string>& out) const override;
+    void fillTrafficLightIds(std::vector<std::string>& out) const override;
+    void fillTrafficLightState(const std::string& tl_id, std::string& out) const override;
+    [[nodiscard]] double getSimulationTime() const override;
+    bool fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const override;
+
+    /**
+     * @brief Same as setTrafficLightPlan() with the durations and offset of the plan.
+     */
+    bool applySignalPlan(const PulseSignalPlan& plan) override;
+
+private:
+    static constexpr std::uint32_t kExit = UINT32_MAX;  ///< Next link of a vehicle leaving the network.
+
+    struct Link
+    {
+        std::string id;
+        std::uint32_t from;             ///< Upstream node.
+        std::uint32_t to;               ///< Downstream node.
+        std::uint32_t light;
+        double length;
+        double travel_time;             ///< Free-flow traversal time.
+        std::size_t storage;            ///< Vehicles the link holds at jam density.
+        std::deque<std::uint32_t> vehicles; ///< Vehicle slots in entry order; the front ones may be queued.
+        double discharge_credit = 0.0;  ///< Fractional vehicles the link may still discharge this green.
+    };
+
+    struct Node
+    {
+        std::string id;
+        double x;
+        double y;
+        std::vector<std::uint32_t> outgoing;
+    };
+
+    struct Light
+    {
+        std::string id;
+        double green;
+        double yellow;
+        double red;
+        double offset = 0.0;
+        bool external = false;          ///< Set through setTrafficLightState(); the plan is suspended.
+        TrafficLightState state = TrafficLightState::RED;
+    };
+
+    struct Vehicle
+    {
+        std::uint64_t serial;           ///< Number in the vehicle ID.
+        std::uint32_t link;
+        std::uint32_t next_link;        ///< Chosen on entry; kExit to leave at the downstream node.
+        double entered_at;
+        double queued_at;               ///< Time the vehicle reaches the back of the queue at free flow.
+    };
+
+    struct Origin
+    {
+        std::uint32_t node;
+        double rate;                    ///< Vehicles per second.
+        double next_arrival;
+        std::size_t blocked = 0;
+    };
+
+    void updateLights();
+    void dischargeLinks();
+    void generateDemand();
+    [[nodiscard]] bool hasStorage(std::uint32_t link) const;
+    void enterLink(std::uint32_t link, std::uint32_t slot, double time);
+    std::uint32_t chooseNextLink(std::uint32_t node);
+    std::uint32_t chooseEntryLink(std::uint32_t node);
+    double nextUniform();
+    double nextHeadway(double rate);
+    std::uint32_t spawnVehicle();
+    void releaseVehicle(std::uint32_t slot);
+    [[nodiscard]] const Vehicle& findVehicle(const std::string& vehicle_id) const;
+    [[nodiscard]] std::uint32_t findLight(const std::string& traffic_light_id) const;
+    void requireRunning() const;
+
+private:
+    PulseMesoConfig m_config;
+    std::vector<Node> m_nodes;
+    std::vector<Link> m_links;
+    std::vector<Light> m_lights;
+    std::unordered_map<std::string, std::uint32_t> m_node_index;
+    std::unordered_map<std::string, std::uint32_t> m_light_index;
+    std::vector<Origin> m_origins;
+
+    std::vector<Vehicle> m_vehicles;                            ///< Slots; freed ones are reused.
+    std::vector<std::uint32_t> m_free_slots;
+    std::unordered_map<std::uint64_t, std::uint32_t> m_slot_by_serial;
+    std::uint64_t m_next_serial = 0;
+    std::vector<IntersectionStatistics> m_statistics;          ///< Per node.
+    double m_total_delay = 0.0;
+    double m_entry_delay = 0.0;                                 ///< Integral of blocked entries over time.
+
+    double m_time = 0.0;
+    std::uint64_t m_seed = 0;
+    std::uint64_t m_draws = 0;                                  ///< Position in the random stream.
+    bool m_running = false;
+};
+
+#endif //PULSEMESOSIMULATION_H
@@ -0,0 +1,194 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEMETRICSTORE_H
+#define PULSEMETRICSTORE_H
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "entities/PulseIntersection.h"
+
+#include "types/PulseMetricRecord.h"
+
+/**
+ * @brief Settings of PulseMetricStore.
+ */
+struct PulseMetricStoreConfig {
+    std::string directory;                      ///< Store directory, created if missing.
+    std::size_t records_per_segment = 1 << 20;  ///< Capacity of an append segment (40 MiB of records).
+    std::size_t compaction_threshold = 8;       ///< Sealed append segments that trigger a background compaction; 0 disables it.
+};
+
+/**
+ * @brief Metrics of one intersection aggregated over a query bucket.
+ */
+struct PulseMetricBucket {
+    std::int64_t start;                     ///< Start of the bucket in simulation seconds.
+    std::uint64_t vehicles;                 ///< Vehicles that passed.
+    double vehicle_waiting_time;            ///< Total vehicle waiting time in seconds.
+    std::uint64_t pedestrians;              ///< Pedestrians that passed.
+    double pedestrian_waiting_time;         ///< Total pedestrian waiting time in seconds.
+    std::uint32_t records;                  ///< Stored intervals that fell into the bucket.
+};
+
+/**
+ * @class PulseMetricStore
+ * @brief Append-only on-disk history of per-intersection interval metrics, read through mmap.
+ *
+ * Records go to fixed-capacity segment files in time order; a full segment is sealed and a new one
+ * started. Each segment keeps a sparse index of every 256th key, so a range query binary-searches a
+ * few index entries and then touches only the mapped pages of the requested range, never loading
+ * whole segments into memory.
+ *
+ * Sealed segments are compacted in the background into one segment sorted by intersection and
+ * interval, where the history of one intersection is contiguous. The compacted file is written
+ * under a temporary name and renamed into place before its sources are removed; on open, sources
+ * already covered by a compacted segment are discarded, so an interrupted compaction neither loses
+ * nor duplicates records.
+ *
+ * Intended for one writer (the simulation thread) and any number of concurrent readers.
+ */
+class PulseMetricStore
+{
+public:
+    /**
+     * @brief Opens the store in the configured directory, creating it if needed.
+     * @throws std::invalid_argument if the directory is empty or the segment capacity is 0
+     * @throws std::runtime_error if a file cannot be created, mapped or is corrupt
+     */
+    explicit PulseMetricStore(const PulseMetricStoreConfig& config);
+
+    /**
+     * @brief Stops background compaction and unmaps all segments.
+     */
+    ~PulseMetricStore();
+
+    PulseMetricStore(const PulseMetricStore&) = delete;
+    PulseMetricStore& operator=(const PulseMetricStore&) = delete;
+
+    /**
+     * @brief Retrieves the handle of an intersection, registering it on first use.
+     * @throws std::invalid_argument if the ID is empty or contains a line break
+     * @throws std::runtime_error if the registry cannot be written
+     */
+    std::uint32_t getHandle(const std::string& intersection_id);
+
+    /**
+     * @brief Looks up the handle of a registered intersection.
+     * @return The handle, or std::nullopt if the intersection was never registered.
+     */
+    [[nodiscard]] std::optional<std::uint32_t> findHandle(const std::string& intersection_id) const;
+
+    /**
+     * @brief Appends one record. Writer thread only.
+     * @throws std::invalid_argument if the handle is unknown or the interval precedes the last appended one
+     * @throws std::runtime_error if a new segment cannot be created
+     */
+    void append(const PulseMetricRecord& record);
+
+    /**
+     * @brief Appends one record per intersection with the growth of its statistics since the previous call.
+     *
+     * An intersection seen for the first time since the store was opened only sets its baseline.
+     * @param intersections Intersections to record.
+     * @param interval Start of the interval in simulation seconds.
+     */
+    void recordInterval(const std::vector<PulseIntersection*>& intersections, std::int64_t interval);
+
+    /**
+     * @brief Aggregates the history of one intersection into fixed-width buckets.
+     * @param intersection_id The intersection.
+     * @param from Start of the range in simulation seconds (inclusive); the first bucket starts here.
+     * @param to End of the range (exclusive).
+     * @param bucket_width Bucket width in seconds.
+     * @return One bucket per width step in [from, to), including empty ones.
+     * @throws std::invalid_argument if the intersection is unknown, the range is reversed or the width is not positive
+     */
+    [[nodiscard]] std::vector<PulseMetricBucket> query(const std::string& intersection_id, std::int64_t from,
+                                                       std::int64_t to, std::int64_t bucket_width) const;
+
+    /**
+     * @brief Schedules the open segment's pages for writing to disk.
+     */
+    void flush();
+
+    /**
+     * @brief Compacts all sealed append segments now, on the calling thread.
+     * @throws std::runtime_error if the compacted segment cannot be written
+     */
+    void compact();
+
+    /**
+     * @brief Waits until no background compaction is pending or running.
+     * @throws std::runtime_error if the last background compaction failed
+     */
+    void waitForCompaction();
+
+    /**
+     * @brief Number of segment files in use.
+     */
+    [[nodiscard]] std::size_t getSegmentCount() const;
+
+    /**
+     * @brief Number of records stored.
+     */
+    [[nodiscard]] std::uint64_t getRecordCount() const;
+
+private:
+    class Segment;
+
+    std::shared_ptr<Segment> createSegment(bool compacted, std::size_t capacity);
+    void sealActiveSegment();
+    void compactSegments();
+    void runCompaction();
+
+private:
+    PulseMetricStoreConfig m_config;
+
+    mutable std::shared_mutex m_registry_mutex;
+    std::unordered_map<std::string, std::uint32_t> m_handles;
+    std::string m_registry_path;
+
+    mutable std::shared_mutex m_segments_mutex;
+    std::vector<std::shared_ptr<Segment>> m_segments;   ///< All segments; the last append segment is the active one.
+    std::shared_ptr<Segment> m_active;
+    std::uint64_t m_next_sequence = 0;                  ///< Guarded by m_segments_mutex.
+    std::int64_t m_last_interval;
+
+    // Writer thread: cumulative totals at the previous recordInterval() call, per handle
+    struct Baseline
+    {
+        bool valid = false;
+        std::size_t vehicles = 0;
+        double vehicle_waiting_time = 0.0;
+        std::size_t pedestrians = 0;
+        double pedestrian_waiting_time = 0.0;
+    };
+    std::vector<Baseline> m_baselines;
+
+    std::mutex m_compaction_mutex;                      ///< Held while a compaction runs.
+    std::mutex m_worker_mutex;
+    std::condition_variable m_worker_wake;
+    std::condition_variable m_worker_idle;
+    bool m_compaction_requested = false;
+    bool m_compaction_running = false;
+    bool m_stopping = false;
+    std::exception_ptr m_compaction_error;
+    std::thread m_worker;
+};
+
+#endif //PULSEMETRICSTORE_H
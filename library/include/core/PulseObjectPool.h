@@ -0,0 +1,166 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEOBJECTPOOL_H
+#define PULSEOBJECTPOOL_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @class PulseObjectPool
+ * @brief Type-specific slab allocator with an intrusive free list.
+ *
+ * Memory is handed out in slabs of @p SlabSize slots. Slabs are never returned while the
+ * pool lives, so every object keeps a stable address, and a released slot is pushed onto
+ * the free list and recycled in place by the next allocation of the same type.
+ *
+ * @tparam T The entity type stored in the pool.
+ * @tparam SlabSize Number of slots allocated at once when the free list runs dry.
+ */
+template <typename T, std::size_t SlabSize = 256>
+class PulseObjectPool
+{
+public:
+    /**
+     * @brief Retrieves the process-wide pool for type T.
+     *
+     * The pool is intentionally never destroyed, so entities owned by other singletons
+     * can still be released safely during static destruction.
+     * @return Reference to the pool.
+     */
+    static PulseObjectPool& getInstance()
+    {
+        static auto* instance = new PulseObjectPool();
+        return *instance;
+    }
+
+    /**
+     * @brief Takes one uninitialized slot from the free list, growing by one slab if needed.
+     * @return Pointer to storage suitable for a T.
+     */
+    void* allocate()
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_free_list) {
+            grow();
+        }
+        Slot* slot = m_free_list;
+        m_free_list = slot->next;
+        ++m_live_count;
+        ++m_allocation_count;
+        return slot->storage;
+    }
+
+    /**
+     * @brief Returns a slot to the free list. The object must already be destroyed.
+     * @param ptr Pointer previously returned by allocate().
+     */
+    void deallocate(void* ptr) noexcept
+    {
+        if (!ptr) {
+            return;
+        }
+        std::lock_guard lock(m_mutex);
+        auto* slot = static_cast<Slot*>(ptr);
+        slot->next = m_free_list;
+        m_free_list = slot;
+        --m_live_count;
+    }
+
+    /**
+     * @brief Number of slots handed out so far, including recycled ones.
+     */
+    [[nodiscard]] std::uint64_t getAllocationCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_allocation_count;
+    }
+
+    /**
+     * @brief Number of slabs requested from the heap so far.
+     */
+    [[nodiscard]] std::size_t getSlabCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_slabs.size();
+    }
+
+    /**
+     * @brief Number of slots currently handed out.
+     */
+    [[nodiscard]] std::size_t getLiveCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_live_count;
+    }
+
+    PulseObjectPool(const PulseObjectPool&) = delete;
+    PulseObjectPool& operator=(const PulseObjectPool&) = delete;
+
+private:
+    PulseObjectPool() = default;
+
+    union Slot
+    {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    void grow()
+    {
+        auto slab = std::make_unique<Slot[]>(SlabSize);
+        for (std::size_t i = 0; i < SlabSize; ++i) {
+            slab[i].next = (i + 1 < SlabSize) ? &slab[i + 1] : m_free_list;
+        }
+        m_free_list = &slab[0];
+        m_slabs.push_back(std::move(slab));
+    }
+
+private:
+    std::vector<std::unique_ptr<Slot[]>> m_slabs; ///< Owned slabs, never shrunk.
+    Slot* m_free_list = nullptr;                 ///< Head of the intrusive free list.
+    std::size_t m_live_count = 0;                ///< Slots currently in use.
+    std::uint64_t m_allocation_count = 0;        ///< Slots handed out since construction.
+    mutable std::mutex m_mutex;                  ///< Guards the free list.
+};
+
+/**
+ * @class PulsePooled
+ * @brief Mixin that routes `new`/`delete` of T through PulseObjectPool<T>.
+ *
+ * Deriving an entity from PulsePooled<Entity> makes `std::make_unique<Entity>` and
+ * PulseEntityFactory draw from the pool without changing any ownership types. Objects of
+ * further derived classes (e.g. test doubles) have a different size and fall back to the
+ * global heap.
+ */
+template <typename T>
+class PulsePooled
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        if (size != sizeof(T)) {
+            return ::operator new(size);
+        }
+        return PulseObjectPool<T>::getInstance().allocate();
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept
+    {
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+        PulseObjectPool<T>::getInstance().deallocate(ptr);
+    }
+};
+
+#endif //PULSEOBJECTPOOL_H
@@ -0,0 +1,150 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPARQUETWRITER_H
+#define PULSEPARQUETWRITER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "types/PulseColumnType.h"
+
+/**
+ * @brief Name and type of one column of an exported table.
+ */
+struct PulseColumnSpec {
+    std::string name;               ///< Column name.
+    PulseColumnType type;           ///< Value type.
+};
+
+/**
+ * @brief Values of one column for a batch of rows; only the vectors of the column's type are used.
+ */
+struct PulseColumn {
+    std::vector<std::int64_t> int64_values;         ///< INT64 values.
+    std::vector<double> double_values;              ///< DOUBLE values.
+    std::vector<std::uint32_t> codes;               ///< STRING values as dictionary codes.
+    std::vector<std::string> dictionary_additions;  ///< STRING entries added to the dictionary since the previous batch.
+};
+
+/**
+ * @brief A batch of rows stored column by column, written as one row group.
+ */
+struct PulseColumnBatch {
+    std::vector<PulseColumn> columns;   ///< One column per schema entry.
+    std::size_t rows = 0;               ///< Number of rows in every column.
+
+    /**
+     * @brief Empties every column, keeping the allocated capacity.
+     */
+    void clear();
+};
+
+/**
+ * @class PulseParquetWriter
+ * @brief Writes a flat table of required columns as an Apache Parquet file.
+ *
+ * Each batch becomes a row group with one GZIP-compressed page per column. Strings are
+ * dictionary-encoded: batches refer to one dictionary per string column for the whole file,
+ * extended by each batch's dictionary additions. Each row group stores a dictionary page with
+ * only the entries its rows use, so readers can decode every row group on its own, and the
+ * values as bit-packed codes into that page.
+ * Output goes through a large stream buffer, so the file is written sequentially in big chunks.
+ * The footer is written by close(); a file that was never closed cannot be read.
+ */
+class PulseParquetWriter
+{
+public:
+    static constexpr int kDefaultCompressionLevel = 6; ///< zlib level.
+
+    /**
+     * @brief Creates the file and writes the Parquet header.
+     * @param path File to create; an existing file is overwritten.
+     * @param schema Columns of the table.
+     * @param compression_level zlib level from 0 (store) to 9.
+     * @throws std::invalid_argument if the schema is empty or the level is out of range
+     * @throws std::runtime_error if the file cannot be created
+     */
+    PulseParquetWriter(const std::string& path, std::vector<PulseColumnSpec> schema,
+                       int compression_level = kDefaultCompressionLevel);
+
+    /**
+     * @brief Closes the file if it is still open; errors are swallowed.
+     */
+    ~PulseParquetWriter();
+
+    PulseParquetWriter(const PulseParquetWriter&) = delete;
+    PulseParquetWriter& operator=(const PulseParquetWriter&) = delete;
+
+    /**
+     * @brief Appends a batch as one row group. Empty batches are ignored.
+     * @throws std::invalid_argument if the batch does not match the schema or uses an unknown dictionary code
+     * @throws std::logic_error if the writer is closed
+     * @throws std::runtime_error on a write or compression error
+     */
+    void writeRowGroup(const PulseColumnBatch& batch);
+
+    /**
+     * @brief Writes the footer and closes the file. Further calls do nothing.
+     * @throws std::runtime_error on a write error
+     */
+    void close();
+
+    /**
+     * @brief Retrieves the columns of the table.
+     */
+    [[nodiscard]] const std::vector<PulseColumnSpec>& getSchema() const;
+
+    /**
+     * @brief Number of rows written so far.
+     */
+    [[nodiscard]] std::int64_t getRowCount() const;
+
+private:
+    struct ChunkInfo
+    {
+        std::int64_t dictionary_page_offset;    ///< -1 if the column has no dictionary page.
+        std::int64_t data_page_offset;
+        std::int64_t uncompressed_size;         ///< Page headers plus uncompressed page data.
+        std::int64_t compressed_size;           ///< Page headers plus stored page data.
+    };
+
+    struct RowGroupInfo
+    {
+        std::int64_t rows;
+        std::vector<ChunkInfo> chunks;
+    };
+
+    void writePage(bool dictionary, std::size_t values, std::string& body, ChunkInfo& chunk);
+    void writeRaw(const std::string& bytes);
+
+private:
+    std::string m_path;
+    std::vector<PulseColumnSpec> m_schema;
+    int m_compression_level;
+
+    std::vector<char> m_stream_buffer;                      ///< Backs the file stream; larger than the default.
+    std::ofstream m_file;
+    std::int64_t m_offset = 0;                              ///< Bytes written so far.
+    std::int64_t m_rows = 0;
+    bool m_closed = false;
+
+    std::vector<std::vector<std::string>> m_dictionaries;   ///< Per column; empty for non-string columns.
+    std::vector<std::uint32_t> m_local_codes;               ///< Row group code of each file code, or unused.
+    std::vector<std::uint32_t> m_used_codes;                ///< File codes used by the row group, by row group code.
+    std::vector<std::uint32_t> m_codes;                     ///< Row group codes of the column's values.
+    std::vector<RowGroupInfo> m_row_groups;
+
+    // Scratch buffers reused for every page
+    std::string m_body;
+    std::string m_compressed;
+    std::string m_header;
+};
+
+#endif //PULSEPARQUETWRITER_H
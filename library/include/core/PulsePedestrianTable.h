@@ -0,0 +1,129 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPEDESTRIANTABLE_H
+#define PULSEPEDESTRIANTABLE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "types/PulseCrossingEvent.h"
+#include "types/PulsePersonState.h"
+#include "types/PulsePosition.h"
+
+#include "utils/PulseStringHash.h"
+
+/**
+ * @class PulsePedestrianTable
+ * @brief Compact storage of the pedestrians currently in the simulation.
+ *
+ * Pedestrians live in slots of parallel arrays (position, speed, waiting time, road) rather than
+ * as individual entities. A departed pedestrian's slot and its string buffers are reused by the
+ * next arrival, so once the population has settled an update performs no heap allocations.
+ *
+ * When a pedestrian moves onto a crossing (SUMO internal edge ":<junction>_c<n>") the table
+ * emits a PulseCrossingEvent with the time it stood waiting on the previous update; these are
+ * the crossing waits attributed to junctions.
+ */
+class PulsePedestrianTable
+{
+public:
+    /**
+     * @brief Reconciles the table with the persons reported in one step.
+     *
+     * Persons not seen before are added, known ones are updated, and those missing from the batch
+     * are removed. Crossing events of this update replace those of the previous one.
+     * @param persons All persons currently in the simulation.
+     * @param update Counter value identifying this update; must differ from the previous one.
+     */
+    void update(std::span<const PulsePersonState> persons, std::uint64_t update);
+
+    /**
+     * @brief Removes all pedestrians and events.
+     */
+    void clear();
+
+    /**
+     * @brief Number of pedestrians in the table.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Number of pedestrians standing still, e.g. waiting at a crossing.
+     */
+    [[nodiscard]] std::size_t getWaitingCount() const;
+
+    /**
+     * @brief Crossings entered during the last update.
+     */
+    [[nodiscard]] std::span<const PulseCrossingEvent> getCrossingEvents() const;
+
+    /**
+     * @brief Looks up a pedestrian's slot.
+     * @return The slot, or std::nullopt if the pedestrian is not in the simulation.
+     */
+    [[nodiscard]] std::optional<std::size_t> find(const std::string& person_id) const;
+
+    /**
+     * @brief Calls a function for every pedestrian with its slot; slots are valid until the next update.
+     * @param fn Callable taking a std::size_t slot.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (std::size_t slot = 0; slot < m_active.size(); ++slot) {
+            if (m_active[slot]) {
+                fn(slot);
+            }
+        }
+    }
+
+    /**
+     * @brief Attributes of an occupied slot, as last reported.
+     */
+    [[nodiscard]] const std::string& getId(std::size_t slot) const { return m_ids[slot]; }
+    [[nodiscard]] PulsePosition getPosition(std::size_t slot) const { return m_positions[slot]; }
+    [[nodiscard]] const std::string& getRoadId(std::size_t slot) const { return m_roads[slot]; }
+    [[nodiscard]] double getSpeed(std::size_t slot) const { return m_speeds[slot]; }
+    [[nodiscard]] double getWaitingTime(std::size_t slot) const { return m_waiting_times[slot]; }
+
+    /**
+     * @brief Extracts the junction of a SUMO crossing edge ID (":<junction>_c<n>").
+     * @return The junction ID, or an empty view if the edge is not a crossing.
+     */
+    [[nodiscard]] static std::string_view crossingJunction(std::string_view road_id);
+
+private:
+    std::uint32_t acquireSlot(const std::string& person_id);
+
+private:
+    // Per slot
+    std::vector<std::string> m_ids;
+    std::vector<PulsePosition> m_positions;
+    std::vector<std::string> m_roads;
+    std::vector<double> m_speeds;
+    std::vector<double> m_waiting_times;
+    std::vector<std::uint64_t> m_last_seen;
+    std::vector<std::uint8_t> m_active;
+
+    // Backing store for index nodes and keys; must outlive the index.
+    std::pmr::unsynchronized_pool_resource m_node_resource;
+    std::pmr::unordered_map<std::pmr::string, std::uint32_t, PulseStringHash, PulseStringEqual> m_slot_by_id{&m_node_resource};
+    std::vector<std::uint32_t> m_free_slots;
+    std::size_t m_waiting_count = 0;
+
+    std::vector<PulseCrossingEvent> m_crossing_events;  ///< Grows to the peak count; entries are reused.
+    std::size_t m_crossing_event_count = 0;             ///< Valid entries from the last update.
+};
+
+#endif //PULSEPEDESTRIANTABLE_H
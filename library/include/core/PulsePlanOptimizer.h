@@ -0,0 +1,183 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPLANOPTIMIZER_H
+#define PULSEPLANOPTIMIZER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/PulseMesoSimulation.h"
+
+#include "types/PulseSignalPlan.h"
+
+/**
+ * @class PulsePlanEvaluator
+ * @brief Scores batches of signal plan sets on independent meso simulations, in parallel.
+ *
+ * The fitness of a plan set is the network delay after the horizon, i.e. the waiting time summed
+ * over all IntersectionStatistics plus the pending delay of vehicles still waiting, averaged over
+ * the replications. Replication r of every candidate uses the same seed (common random numbers), so
+ * candidates are compared on identical demand. Each (candidate, replication) pair is an independent
+ * job; workers pull jobs from a shared counter and reuse one simulation each, so throughput grows
+ * with the number of cores and results do not depend on it.
+ */
+class PulsePlanEvaluator
+{
+public:
+    /**
+     * @brief Creates the simulation of one worker, with network and demand set up.
+     *        Called concurrently from worker threads.
+     */
+    using SimulationFactory = std::function<std::unique_ptr<PulseMesoSimulation>()>;
+
+    /**
+     * @brief Constructs an evaluator.
+     * @param factory Factory for per-worker simulations.
+     * @param horizon Simulated seconds per evaluation.
+     * @param replications Runs per candidate, each with its own seed.
+     * @param seed Base seed of the replication seeds.
+     * @param thread_count Worker threads; 0 uses the hardware concurrency.
+     * @throws std::invalid_argument if the factory is empty, the horizon is not positive or replications is 0
+     */
+    PulsePlanEvaluator(SimulationFactory factory, double horizon, std::size_t replications = 1,
+                       std::uint64_t seed = 0, std::size_t thread_count = 0);
+
+    /**
+     * @brief Scores plan sets; every set should cover the lights whose plans are varied.
+     * @param candidates Plan sets to score.
+     * @return Network delay in seconds per candidate, in input order (lower is better).
+     * @throws Rethrows the first exception raised by a job, after all workers stopped.
+     */
+    [[nodiscard]] std::vector<double> evaluate(const std::vector<std::vector<PulseSignalPlan>>& candidates) const;
+
+private:
+    SimulationFactory m_factory;
+    double m_horizon;
+    std::size_t m_replications;
+    std::uint64_t m_seed;
+    std::size_t m_thread_count;
+};
+
+/**
+ * @brief Settings of PulsePlanOptimizer.
+ */
+struct PulsePlanSearchConfig {
+    std::size_t population_size = 24;   ///< Plan sets per generation.
+    std::size_t elite_count = 2;        ///< Best plan sets carried over unchanged.
+    std::size_t tournament_size = 3;    ///< Plan sets compared to select each parent.
+    double mutation_rate = 0.2;         ///< Chance that a green, red or offset value is mutated.
+    double mutation_step = 10.0;        ///< Largest change in seconds a mutation applies.
+    double min_green = 5.0;             ///< Lower bound of green durations.
+    double max_green = 90.0;            ///< Upper bound of green durations.
+    double min_red = 5.0;               ///< Lower bound of red durations; stands in for the cross traffic's needs.
+    double max_red = 90.0;              ///< Upper bound of red durations.
+    std::uint64_t seed = 1;             ///< Seed of the search; the evaluator seeds the simulations.
+};
+
+/**
+ * @brief A plan set and its fitness.
+ */
+struct PulsePlanCandidate {
+    std::vector<PulseSignalPlan> plans; ///< One plan per searched light.
+    double fitness = 0.0;               ///< Network delay in seconds (lower is better).
+};
+
+/**
+ * @class PulsePlanOptimizer
+ * @brief Genetic search over fixed-time signal plans.
+ *
+ * A genome holds the green and red durations and the offset of every searched light; yellow and
+ * pedestrian durations keep their initial values. Each generation is scored in one batch by
+ * PulsePlanEvaluator. The elite is carried over with its score, the rest is bred by tournament
+ * selection, uniform crossover per light and bounded uniform mutation.
+ *
+ * All random choices come from a counter-based SplitMix64 stream on the calling thread, so a run is
+ * reproducible from the seed regardless of thread count, and the whole search state (generation,
+ * stream position, population, best plan set, history) fits in a checkpoint from which a resumed
+ * search continues exactly as the uninterrupted one.
+ */
+class PulsePlanOptimizer
+{
+public:
+    /**
+     * @brief Constructs an optimizer; the first generation holds the initial plans and mutations of them.
+     * @param evaluator Scores the generations; must outlive the optimizer.
+     * @param initial_plans Starting plan of every light to search.
+     * @param config Search settings.
+     * @throws std::invalid_argument if no plans are given, a light appears twice or a setting is out of range
+     */
+    PulsePlanOptimizer(const PulsePlanEvaluator& evaluator, std::vector<PulseSignalPlan> initial_plans,
+                       const PulsePlanSearchConfig& config = {});
+
+    /**
+     * @brief Scores the current generation and breeds the next one.
+     */
+    void step();
+
+    /**
+     * @brief Runs the given number of generations.
+     * @return The best plan set found so far.
+     */
+    const PulsePlanCandidate& run(std::size_t generations);
+
+    /**
+     * @brief Best plan set of all scored generations.
+     * @throws std::logic_error if no generation was scored yet
+     */
+    [[nodiscard]] const PulsePlanCandidate& getBest() const;
+
+    /**
+     * @brief Number of generations scored.
+     */
+    [[nodiscard]] std::size_t getGeneration() const;
+
+    /**
+     * @brief Best fitness after each scored generation; never increases.
+     */
+    [[nodiscard]] const std::vector<double>& getHistory() const;
+
+    /**
+     * @brief Writes the search state to a file.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveCheckpoint(const std::string& path) const;
+
+    /**
+     * @brief Restores a search state written by saveCheckpoint().
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     * @throws std::invalid_argument if the checkpoint searches different lights or another population size
+     */
+    void loadCheckpoint(const std::string& path);
+
+private:
+    struct Individual
+    {
+        std::vector<PulseSignalPlan> plans;
+        double fitness = 0.0;
+        bool scored = false;
+    };
+
+    double nextUniform();
+    void mutate(std::vector<PulseSignalPlan>& plans);
+    const Individual& selectParent();
+
+private:
+    const PulsePlanEvaluator& m_evaluator;
+    PulsePlanSearchConfig m_config;
+    std::vector<std::string> m_lights;      ///< Searched lights, in genome order.
+    std::vector<Individual> m_population;
+    PulsePlanCandidate m_best;
+    std::vector<double> m_history;
+    std::size_t m_generation = 0;
+    std::uint64_t m_draws = 0;              ///< Position in the random stream.
+};
+
+#endif //PULSEPLANOPTIMIZER_H
@@ -0,0 +1,149 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPROFILER_H
+#define PULSEPROFILER_H
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "types/PulseProfileStage.h"
+
+/**
+ * @class PulseProfiler
+ * @brief Process-wide per-stage latency histograms, entity pool counters and entity gauges.
+ *
+ * Durations are steady clock nanoseconds, the same clock TrafficSystem uses for its stage timings:
+ * each built-in stage is timed once by TrafficSystem and the result is both kept as the step's
+ * PulseStageTiming and recorded here. Histograms have power-of-two buckets and relaxed atomic
+ * counters, so recording never blocks. Metrics are exported as JSON or Prometheus text, to a file
+ * or through the /metrics endpoint of PulseLiveServer.
+ *
+ * Stages are only recorded when the library is built with PULSE_ENABLE_PROFILING.
+ */
+class PulseProfiler
+{
+public:
+    static constexpr std::size_t kBucketCount = 40; ///< Bucket i holds durations in [2^i, 2^(i+1)) ns.
+
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static PulseProfiler& getInstance();
+
+    /**
+     * @brief True if the library was built with PULSE_ENABLE_PROFILING and records its stages.
+     */
+    [[nodiscard]] static bool isEnabled();
+
+    /**
+     * @brief Records one execution of a stage.
+     * @param stage The stage.
+     * @param duration Duration of the execution.
+     */
+    void record(PulseProfileStage stage, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Updates the entity count gauges.
+     */
+    void setEntityCounts(std::size_t vehicles, std::size_t traffic_lights, std::size_t intersections);
+
+    /**
+     * @brief Number of recorded executions of a stage.
+     */
+    [[nodiscard]] std::uint64_t getCount(PulseProfileStage stage) const;
+
+    /**
+     * @brief Total recorded time of a stage in seconds.
+     */
+    [[nodiscard]] double getTotalSeconds(PulseProfileStage stage) const;
+
+    /**
+     * @brief Writes all metrics as a JSON object.
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @brief Writes all metrics in the Prometheus text exposition format.
+     */
+    void writePrometheus(std::ostream& out) const;
+
+    /**
+     * @brief Writes metrics to a file, replacing it atomically (e.g. for a node_exporter textfile collector).
+     * @param path Destination path.
+     * @param prometheus True for Prometheus text, false for JSON.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writeToFile(const std::string& path, bool prometheus) const;
+
+    /**
+     * @brief Clears all histograms and gauges.
+     */
+    void reset();
+
+    PulseProfiler(const PulseProfiler&) = delete;
+    PulseProfiler& operator=(const PulseProfiler&) = delete;
+
+private:
+    PulseProfiler() = default;
+
+    struct StageHistogram
+    {
+        std::array<std::atomic<std::uint64_t>, kBucketCount> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> total_ns{0};
+        std::atomic<std::uint64_t> max_ns{0};
+    };
+
+private:
+    std::array<StageHistogram, PULSE_PROFILE_STAGE_COUNT> m_stages;
+
+    std::atomic<std::size_t> m_vehicles{0};
+    std::atomic<std::size_t> m_traffic_lights{0};
+    std::atomic<std::size_t> m_intersections{0};
+};
+
+/**
+ * @class PulseScopedTimer
+ * @brief Records the lifetime of a scope into PulseProfiler.
+ */
+class PulseScopedTimer
+{
+public:
+    explicit PulseScopedTimer(PulseProfileStage stage) : m_stage(stage), m_start(std::chrono::steady_clock::now()) {}
+    ~PulseScopedTimer() { PulseProfiler::getInstance().record(m_stage, std::chrono::steady_clock::now() - m_start); }
+
+    PulseScopedTimer(const PulseScopedTimer&) = delete;
+    PulseScopedTimer& operator=(const PulseScopedTimer&) = delete;
+
+private:
+    PulseProfileStage m_stage;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define PULSE_PROFILE_CONCAT_INNER(a, b) a##b
+#define PULSE_PROFILE_CONCAT(a, b) PULSE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PULSE_ENABLE_PROFILING
+/// Times the enclosing scope as the given PulseProfileStage.
+#define PULSE_PROFILE_SCOPE(stage) PulseScopedTimer PULSE_PROFILE_CONCAT(pulse_profile_scope_, __LINE__)(stage)
+/// Records a duration that was already measured as the given PulseProfileStage.
+#define PULSE_PROFILE_RECORD(stage, duration) PulseProfiler::getInstance().record(stage, duration)
+/// Updates the entity gauges.
+#define PULSE_PROFILE_ENTITIES(vehicles, traffic_lights, intersections) \
+    PulseProfiler::getInstance().setEntityCounts(vehicles, traffic_lights, intersections)
+#else
+#define PULSE_PROFILE_SCOPE(stage) ((void)0)
+#define PULSE_PROFILE_RECORD(stage, duration) ((void)0)
+#define PULSE_PROFILE_ENTITIES(vehicles, traffic_lights, intersections) ((void)0)
+#endif
+
+#endif //PULSEPROFILER_H
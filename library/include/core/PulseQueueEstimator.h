@@ -0,0 +1,157 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEQUEUEESTIMATOR_H
+#define PULSEQUEUEESTIMATOR_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+
+#include "entities/PulseIntersection.h"
+
+#include "types/PulseRoadBinding.h"
+
+/**
+ * @brief A road connection leading into an intersection, seen from that intersection.
+ */
+struct PulseApproach {
+    std::string intersection_id;            ///< Intersection the approach leads into.
+    std::string upstream_intersection_id;   ///< Intersection the road starts at.
+    int road_id;                            ///< Road connection ID at the upstream intersection.
+    std::string traffic_light_id;           ///< Traffic light controlling the road.
+    std::string source_road_id;             ///< Road (SUMO edge) ID reported by the simulation source.
+    double length;                          ///< Road length in meters; the stop line for lanes the source reports no length for.
+};
+
+/**
+ * @brief Current queue on an approach.
+ */
+struct PulseQueueState {
+    std::size_t queued_vehicles = 0;        ///< Halted vehicles queued back from the stop line, over all lanes.
+    double queue_length = 0.0;              ///< Meters from the stop line to the back of the longest lane queue.
+    double max_queue_length = 0.0;          ///< Longest queue seen so far.
+    bool spillback = false;                 ///< Whether a lane queue reaches back past the start of its lane into the upstream intersection.
+};
+
+/**
+ * @brief Raised when a queue starts or stops spilling back into the upstream intersection.
+ */
+struct PulseSpillbackEvent {
+    std::size_t approach;                   ///< Approach index.
+    const PulseApproach* info;              ///< Approach description, owned by the estimator.
+    bool started;                           ///< True when spillback begins, false when it clears.
+    double queue_length;                    ///< Queue length in meters at the time of the event.
+};
+
+/**
+ * @class PulseQueueEstimator
+ * @brief Queue length and spillback detection per intersection approach.
+ *
+ * Every bound road connection is an approach of the intersection it leads into. Each update makes
+ * one pass over the vehicles of a data manager with kinematics tracking enabled and collects the
+ * vehicles at or below the halting speed. Per lane, the queue is the run of those vehicles that
+ * starts at the stop line, walking upstream in descending lane position, and ends at the first gap
+ * wider than the vehicle spacing plus a tolerance; the approach reports the longest lane queue.
+ * The stop line is the end of the lane as reported in the vehicle kinematics, since the source's
+ * edge can be longer or shorter than the road connection; the connection length is used only for
+ * lanes reported without a length. A lane spills back once its queue is longer than the lane.
+ * Halted vehicles beyond such a gap (parked, at a bus stop) do not extend the queue, so they cannot
+ * raise spillback on their own. Queues are recomputed on every update, sorting only the halted
+ * vehicles on watched roads; only approaches that have or just lost halted vehicles are touched.
+ */
+class PulseQueueEstimator
+{
+public:
+    static constexpr double kDefaultHaltingSpeed = 0.1;     ///< m/s; SUMO's halting threshold.
+    static constexpr double kDefaultVehicleSpacing = 7.5;   ///< Meters of queue per vehicle (length plus gap).
+    static constexpr double kDefaultGapTolerance = 5.0;     ///< Meters a queue gap may exceed the spacing (longer vehicles, creeping).
+
+    using SpillbackListener = std::function<void(const PulseSpillbackEvent&)>;
+
+    /**
+     * @brief Creates an approach for every bound road connection.
+     * @param intersections The road network.
+     * @param bindings Source roads to watch.
+     * @param halting_speed Speed in m/s at or below which a vehicle counts as queued.
+     * @param vehicle_spacing Space a queued vehicle occupies behind its front position.
+     * @param gap_tolerance Extra gap between queued vehicles' fronts before the queue is considered to end.
+     * @throws std::invalid_argument on an unknown or duplicate binding or a negative parameter
+     */
+    PulseQueueEstimator(const std::vector<PulseIntersection*>& intersections,
+                        const std::vector<PulseRoadBinding>& bindings,
+                        double halting_speed = kDefaultHaltingSpeed,
+                        double vehicle_spacing = kDefaultVehicleSpacing,
+                        double gap_tolerance = kDefaultGapTolerance);
+
+    /**
+     * @brief Recomputes queues from the data manager's vehicles and raises spillback events.
+     *        Typically registered as a TrafficSystem step consumer.
+     */
+    void update(const PulseDataManager& data_manager);
+
+    /**
+     * @brief Registers a function called whenever spillback starts or clears on an approach.
+     */
+    void addSpillbackListener(SpillbackListener listener);
+
+    /**
+     * @brief Number of approaches.
+     */
+    [[nodiscard]] std::size_t getApproachCount() const;
+
+    /**
+     * @brief Describes an approach.
+     * @throws std::out_of_range if the index is invalid
+     */
+    [[nodiscard]] const PulseApproach& getApproach(std::size_t approach) const;
+
+    /**
+     * @brief Lists the approaches leading into an intersection.
+     * @return Approach indices; empty if the intersection has no bound approaches.
+     */
+    [[nodiscard]] std::vector<std::size_t> getApproaches(const std::string& intersection_id) const;
+
+    /**
+     * @brief Retrieves the current queue on an approach.
+     * @throws std::out_of_range if the index is invalid
+     */
+    [[nodiscard]] PulseQueueState getQueue(std::size_t approach) const;
+
+private:
+    struct HaltedVehicle
+    {
+        std::uint32_t approach;
+        int lane_index;
+        double lane_position;
+        double lane_length;
+    };
+
+    void setQueue(std::size_t approach, std::size_t queued, double queue_length, bool spillback);
+
+private:
+    std::vector<PulseApproach> m_approaches;
+    std::vector<PulseQueueState> m_queues;
+    std::vector<HaltedVehicle> m_halted;    ///< Halted vehicles on watched roads in this update; grows to its peak and is reused.
+    std::vector<std::uint64_t> m_touched_update;    ///< Last update each approach had halted vehicles.
+    std::unordered_map<std::string, std::uint32_t> m_source_roads;  ///< Source road to approach.
+
+    std::vector<std::uint32_t> m_touched;   ///< Approaches with halted vehicles in this update.
+    std::vector<std::uint32_t> m_active;    ///< Approaches with halted vehicles in the previous update.
+    std::uint64_t m_update = 0;
+
+    double m_halting_speed;
+    double m_vehicle_spacing;
+    double m_gap_tolerance;
+    std::vector<SpillbackListener> m_listeners;
+};
+
+#endif //PULSEQUEUEESTIMATOR_H
@@ -0,0 +1,106 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEREPLICATIONRUNNER_H
+#define PULSEREPLICATIONRUNNER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/IntersectionStatistics.h"
+#include "core/SimulationSource.h"
+#include "core/TrafficSystem.h"
+
+/**
+ * @brief Outcome of a single scenario replication.
+ */
+struct PulseReplicationResult {
+    std::size_t replication = 0;    ///< Replication index in [0, N).
+    std::uint64_t seed = 0;         ///< Seed the replication was started with.
+    std::size_t steps = 0;          ///< Number of steps actually simulated.
+
+    /// Final statistics per intersection ID, ordered for deterministic iteration.
+    std::map<std::string, IntersectionStatistics> intersections;
+};
+
+/**
+ * @class PulseReplicationRunner
+ * @brief Runs N independent replications of a scenario across worker threads.
+ *
+ * Every replication gets its own TrafficSystem, PulseDataManager and simulation source, created
+ * through the supplied factory with a seed derived from the base seed and the replication index.
+ * Seeds and results therefore do not depend on the number of threads or on scheduling.
+ */
+class PulseReplicationRunner
+{
+public:
+    /**
+     * @brief Creates the simulation source for one replication.
+     *        Called concurrently from worker threads.
+     */
+    using SourceFactory = std::function<std::unique_ptr<SimulationSource>(std::uint64_t seed)>;
+
+    /**
+     * @brief Optional per-step callback, e.g. to update statistics or apply a control strategy.
+     *        Called on the worker thread that owns the system.
+     */
+    using StepCallback = std::function<void(TrafficSystem& system, std::size_t step)>;
+
+    /**
+     * @brief Constructs a runner.
+     * @param factory Factory for per-replication simulation sources.
+     * @param steps_per_replication Maximum number of steps per replication.
+     * @param thread_count Worker threads; 0 uses the hardware concurrency.
+     * @throws std::invalid_argument if factory is empty
+     */
+    PulseReplicationRunner(SourceFactory factory, std::size_t steps_per_replication, std::size_t thread_count = 0);
+
+    /**
+     * @brief Sets the callback invoked after every simulation step.
+     * @param callback The callback (may be empty).
+     */
+    void setStepCallback(StepCallback callback);
+
+    /**
+     * @brief Runs the replications and blocks until all are done.
+     * @param replications Number of replications.
+     * @param base_seed Seed from which per-replication seeds are derived.
+     * @return Results ordered by replication index.
+     * @throws Rethrows the first exception raised by a replication, after all workers stopped.
+     */
+    std::vector<PulseReplicationResult> run(std::size_t replications, std::uint64_t base_seed);
+
+    /**
+     * @brief Derives the seed of a replication (SplitMix64 of base seed and index).
+     * @param base_seed The base seed.
+     * @param replication The replication index.
+     * @return The replication seed.
+     */
+    [[nodiscard]] static std::uint64_t deriveSeed(std::uint64_t base_seed, std::size_t replication);
+
+    /**
+     * @brief Merges the per-intersection statistics of several replications.
+     * @param results Replication results.
+     * @return Combined statistics per intersection ID.
+     */
+    [[nodiscard]] static std::map<std::string, IntersectionStatistics> aggregate(const std::vector<PulseReplicationResult>& results);
+
+private:
+    PulseReplicationResult runReplication(std::size_t replication, std::uint64_t seed) const;
+
+private:
+    SourceFactory m_factory;
+    StepCallback m_step_callback;
+    std::size_t m_steps_per_replication;
+    std::size_t m_thread_count;
+};
+
+#endif //PULSEREPLICATIONRUNNER_H
@@ -0,0 +1,203 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEROUTER_H
+#define PULSEROUTER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+
+#include "entities/PulseIntersection.h"
+
+#include "types/PulsePosition.h"
+#include "types/PulseRoute.h"
+#include "types/PulseRoutingAlgorithm.h"
+
+/**
+ * @class PulseRouter
+ * @brief Shortest travel-time routing on the intersection graph.
+ *
+ * The road connections of the given intersections are compiled into a compact adjacency array
+ * when the router is constructed; later topology changes need a new router. Edge weights are
+ * travel times in seconds, starting at free flow and updatable live from measurements.
+ *
+ * preprocess() builds a contraction hierarchy for fast point-to-point queries. Changing a weight
+ * makes the hierarchy stale: AUTO queries fall back to A* until preprocess() is called again, so
+ * weight updates are best applied in batches.
+ *
+ * Queries reuse internal search buffers; a router serves one thread at a time.
+ */
+class PulseRouter
+{
+public:
+    static constexpr double kDefaultFreeFlowSpeed = 13.89; ///< Meters per second (50 km/h).
+
+    /**
+     * @brief Builds the routing graph from a set of intersections.
+     * @param intersections Graph nodes; roads leading to intersections outside the set are ignored.
+     * @param free_flow_speed Speed in m/s used for the initial travel times.
+     * @throws std::invalid_argument if an intersection is null or the speed is not positive
+     */
+    explicit PulseRouter(const std::vector<PulseIntersection*>& intersections, double free_flow_speed = kDefaultFreeFlowSpeed);
+
+    /**
+     * @brief Builds the routing graph from all intersections of a data manager.
+     */
+    explicit PulseRouter(const PulseDataManager& data_manager, double free_flow_speed = kDefaultFreeFlowSpeed);
+
+    /**
+     * @brief Finds the fastest route between two intersections.
+     * @param from_id Origin intersection ID.
+     * @param to_id Destination intersection ID.
+     * @param algorithm Search algorithm.
+     * @return The route, or std::nullopt if the destination is unreachable.
+     * @throws std::invalid_argument if an intersection ID is unknown
+     * @throws std::logic_error if CONTRACTION_HIERARCHY is requested while the hierarchy is stale
+     */
+    std::optional<PulseRoute> findRoute(const std::string& from_id, const std::string& to_id,
+                                        PulseRoutingAlgorithm algorithm = PulseRoutingAlgorithm::AUTO);
+
+    /**
+     * @brief Computes only the fastest travel time, skipping path reconstruction.
+     * @return Travel time in seconds, or std::nullopt if the destination is unreachable.
+     * @throws std::invalid_argument if an intersection ID is unknown
+     * @throws std::logic_error if CONTRACTION_HIERARCHY is requested while the hierarchy is stale
+     */
+    std::optional<double> findTravelTime(const std::string& from_id, const std::string& to_id,
+                                         PulseRoutingAlgorithm algorithm = PulseRoutingAlgorithm::AUTO);
+
+    /**
+     * @brief Sets the travel time of a road, e.g. from measured vehicle traversals.
+     * @param intersection_id Intersection the road starts at.
+     * @param road_id Road ID as passed to PulseIntersection::addRoadConnection.
+     * @param seconds Travel time; infinity closes the road.
+     * @throws std::invalid_argument if the road is unknown or the time is negative or NaN
+     */
+    void setTravelTime(const std::string& intersection_id, int road_id, double seconds);
+
+    /**
+     * @brief Retrieves the current travel time of a road.
+     * @throws std::invalid_argument if the road is unknown
+     */
+    [[nodiscard]] double getTravelTime(const std::string& intersection_id, int road_id) const;
+
+    /**
+     * @brief Restores free-flow travel times on all roads.
+     */
+    void resetTravelTimes();
+
+    /**
+     * @brief Builds the contraction hierarchy for the current travel times.
+     */
+    void preprocess();
+
+    /**
+     * @brief Checks whether the contraction hierarchy matches the current travel times.
+     */
+    [[nodiscard]] bool isPreprocessed() const;
+
+    /**
+     * @brief Number of intersections in the graph.
+     */
+    [[nodiscard]] std::size_t getNodeCount() const;
+
+    /**
+     * @brief Number of roads in the graph.
+     */
+    [[nodiscard]] std::size_t getEdgeCount() const;
+
+    /**
+     * @brief Number of shortcuts added by the last preprocess() call.
+     */
+    [[nodiscard]] std::size_t getShortcutCount() const;
+
+private:
+    static constexpr std::uint32_t kNone = static_cast<std::uint32_t>(-1);
+
+    struct Edge
+    {
+        std::uint32_t source;
+        std::uint32_t target;
+        int road_id;
+        double distance;
+        double weight;                  ///< Current travel time in seconds.
+        std::string traffic_light_id;
+    };
+
+    /**
+     * @brief Hierarchy edge; either an original road or a shortcut over two lower edges.
+     */
+    struct HierarchyEdge
+    {
+        std::uint32_t source;
+        std::uint32_t target;
+        double weight;
+        std::uint32_t first;            ///< First half of a shortcut, kNone for original edges.
+        std::uint32_t second;           ///< Second half of a shortcut.
+        std::uint32_t original;         ///< Index into m_edges for original edges.
+    };
+
+    /**
+     * @brief Per-node search labels, invalidated in O(1) by bumping the stamp.
+     */
+    struct SearchLabels
+    {
+        std::vector<double> distance;
+        std::vector<std::uint32_t> parent;  ///< Edge the node was reached by.
+        std::vector<std::uint32_t> stamp;
+        std::uint32_t current = 0;
+
+        void resize(std::size_t nodes);
+        void clear();
+        [[nodiscard]] double get(std::uint32_t node) const;
+        void set(std::uint32_t node, double value, std::uint32_t edge);
+    };
+
+    std::uint32_t indexOf(const std::string& intersection_id) const;
+    std::uint32_t findEdge(const std::string& intersection_id, int road_id) const;
+    double straightLineTime(std::uint32_t from, std::uint32_t to) const;
+    void updateHeuristicScale();
+
+    // Returns the travel time and fills m_path with original edge indices when requested
+    std::optional<double> search(std::uint32_t from, std::uint32_t to, PulseRoutingAlgorithm algorithm, bool want_path);
+    std::optional<double> searchGraph(std::uint32_t from, std::uint32_t to, bool use_heuristic, bool want_path);
+    std::optional<double> searchHierarchy(std::uint32_t from, std::uint32_t to, bool want_path);
+    void unpack(std::uint32_t hierarchy_edge);
+    PulseRoute buildRoute(std::uint32_t from) const;
+
+private:
+    std::vector<std::string> m_ids;                         ///< Intersection ID per node.
+    std::unordered_map<std::string, std::uint32_t> m_index; ///< Intersection ID to node.
+    std::vector<PulsePosition> m_positions;                 ///< Node coordinates for the A* heuristic.
+
+    std::vector<std::uint32_t> m_edge_begin;                ///< Outgoing edges of node n are [begin[n], begin[n + 1]).
+    std::vector<Edge> m_edges;
+    double m_free_flow_speed;
+    double m_heuristic_scale = 0.0;                         ///< Lower bound on seconds per straight-line meter.
+
+    std::vector<HierarchyEdge> m_hierarchy_edges;
+    std::vector<std::uint32_t> m_up_begin;                  ///< Upward edges leaving node n.
+    std::vector<std::uint32_t> m_up_edges;
+    std::vector<std::uint32_t> m_down_begin;                ///< Upward edges entering node n, searched backwards.
+    std::vector<std::uint32_t> m_down_edges;
+    std::size_t m_shortcut_count = 0;
+    bool m_hierarchy_valid = false;
+
+    SearchLabels m_forward;
+    SearchLabels m_backward;
+    std::vector<std::pair<double, std::uint32_t>> m_forward_queue;   ///< Search heaps, kept to avoid allocating per query.
+    std::vector<std::pair<double, std::uint32_t>> m_backward_queue;
+    std::vector<std::uint32_t> m_path;                      ///< Original edges of the last route.
+};
+
+#endif //PULSEROUTER_H
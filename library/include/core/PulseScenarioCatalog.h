@@ -0,0 +1,109 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESCENARIOCATALOG_H
+#define PULSESCENARIOCATALOG_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "constants/SumoSimulationsPath.h"
+#include "types/PulseScenarioDescriptor.h"
+
+/**
+ * @class PulseScenarioCatalog
+ * @brief Index of every SUMO scenario under a root directory laid out as <city>/<timestamp>/.
+ *
+ * The repository's snapshots live under config/sumo/simulations (SUMO_SIMULATIONS_PATH), which
+ * the build copies next to the binaries; that is the default root.
+ *
+ * scan() walks the tree once and parses each scenario's .sumocfg into a PulseScenarioDescriptor
+ * with absolute input paths, checking that the referenced files exist. With a cache file, the
+ * descriptors are stored in a binary form and a later scan only re-parses configs whose size or
+ * modification time changed, so a batch run over dozens of snapshots starts without reading every
+ * XML file again. Cached descriptors still have their input files checked for existence, so a
+ * deleted network or route file invalidates the entry. Once scanned, all descriptors are in memory and switching scenarios is a lookup
+ * (see SumoIntegration's descriptor constructor).
+ *
+ * A snapshot directory with several .sumocfg files uses "osm.sumocfg" if present, otherwise the
+ * first one in name order. Variants written by PulseScenarioTransformer carry a marker file
+ * (kVariantMarker) naming their source; they are indexed but never returned by findLatest().
+ */
+class PulseScenarioCatalog
+{
+public:
+    static constexpr const char* kVariantMarker = "pulse_variant.txt"; ///< Holds the source scenario's name.
+
+    /**
+     * @brief Constructs an empty catalog; call scan() to index the tree.
+     * @param root_directory Directory holding one subdirectory per city.
+     * @param cache_path Binary descriptor cache; empty to always parse.
+     */
+    explicit PulseScenarioCatalog(std::string root_directory = SUMO_SIMULATIONS_PATH, std::string cache_path = {});
+
+    /**
+     * @brief Indexes the tree, reusing cached descriptors of unchanged configs, and rewrites the
+     *        cache if anything was parsed.
+     * @return Number of scenarios found, valid or not.
+     * @throws std::runtime_error if the root directory does not exist or the cache cannot be written
+     */
+    std::size_t scan();
+
+    /**
+     * @brief All scenarios, sorted by name (city, then timestamp).
+     */
+    [[nodiscard]] const std::vector<PulseScenarioDescriptor>& getScenarios() const;
+
+    /**
+     * @brief Looks up a scenario by "<city>/<timestamp>".
+     * @return The descriptor, or nullptr if not indexed.
+     */
+    [[nodiscard]] const PulseScenarioDescriptor* find(std::string_view name) const;
+
+    /**
+     * @brief Most recent valid recorded snapshot of a city; generated variants are skipped.
+     * @return The descriptor, or nullptr if the city has none.
+     */
+    [[nodiscard]] const PulseScenarioDescriptor* findLatest(std::string_view city) const;
+
+    /**
+     * @brief Names of the indexed cities, sorted.
+     */
+    [[nodiscard]] std::vector<std::string> getCities() const;
+
+    /**
+     * @brief Number of configs parsed and taken from the cache by the last scan().
+     */
+    [[nodiscard]] std::size_t getParsedCount() const;
+    [[nodiscard]] std::size_t getCachedCount() const;
+
+    /**
+     * @brief Parses a single .sumocfg file; relative input paths are resolved against its directory.
+     * @return The descriptor; on failure valid is false and error says why. Name, city and timestamp are left empty;
+     *         variant_of is read from a kVariantMarker file next to the config.
+     */
+    [[nodiscard]] static PulseScenarioDescriptor parseConfig(const std::string& config_path);
+
+private:
+    void loadCache();
+    void saveCache() const;
+
+private:
+    std::string m_root;
+    std::string m_cache_path;
+
+    std::vector<PulseScenarioDescriptor> m_scenarios;
+    std::unordered_map<std::string, std::size_t> m_index;   ///< Name -> position in m_scenarios.
+    std::unordered_map<std::string, PulseScenarioDescriptor> m_cache;   ///< Config path -> cached descriptor.
+
+    std::size_t m_parsed = 0;
+    std::size_t m_cached = 0;
+};
+
+#endif //PULSESCENARIOCATALOG_H
@@ -0,0 +1,73 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESCENARIOTRANSFORMER_H
+#define PULSESCENARIOTRANSFORMER_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "types/PulseDemandTransform.h"
+#include "types/PulseScenarioDescriptor.h"
+
+/**
+ * @brief Outcome of PulseScenarioTransformer::transform().
+ */
+struct PulseTransformResult {
+    PulseScenarioDescriptor scenario;   ///< The generated scenario, parsed like a catalog entry.
+    std::size_t trips_read = 0;         ///< Demand elements in the source route files.
+    std::size_t trips_written = 0;      ///< Demand elements in the generated route files.
+};
+
+/**
+ * @class PulseScenarioTransformer
+ * @brief Writes stress variants of a scenario: scaled, time-sliced and jittered demand with its own .sumocfg.
+ *
+ * A variant of <city>/<timestamp> is written to <output_root>/<city>/<timestamp>-<name>/, so the
+ * output root can itself be indexed by a PulseScenarioCatalog, and may be the catalog root the
+ * source came from: each variant directory carries a PulseScenarioCatalog::kVariantMarker file,
+ * so catalogs index it with variant_of set and findLatest() keeps returning the recorded snapshot. Each route file of the source is
+ * rewritten under the same name, with departures sorted as SUMO expects; the network and additional
+ * files are referenced in place. The config is the source config with its input files and
+ * begin/end replaced, so processing, routing and report options carry over.
+ *
+ * Route files are transformed one at a time. A file is loaded whole, since its trip records are
+ * views into the text, and its trips are expanded by a pool of worker threads in runs of a fixed
+ * number of source trips, so one large file (typically the passenger trips) still uses every
+ * thread. Each run is sorted by departure and spilled to a temporary file next to the output;
+ * the runs are then merged straight into the output file. Memory is therefore bounded by the
+ * source file plus one expanded run per worker, not by the scaled output. A file that fits into
+ * one run is sorted and written from memory.
+ */
+class PulseScenarioTransformer
+{
+public:
+    static constexpr std::size_t kDefaultRunTrips = 16384;  ///< Source trips expanded and sorted per run.
+
+    /**
+     * @brief Constructs a transformer.
+     * @param output_root Directory that receives the variants, e.g. SUMO_SIMULATIONS_PATH.
+     * @param thread_count Worker threads; 0 uses the hardware concurrency.
+     * @param run_trips Source trips per sorted run; bounds the memory of each worker.
+     * @throws std::invalid_argument if run_trips is 0
+     */
+    explicit PulseScenarioTransformer(std::string output_root, std::size_t thread_count = 0,
+                                      std::size_t run_trips = kDefaultRunTrips);
+
+    /**
+     * @brief Generates one variant, replacing any previous output of the same name.
+     * @throws std::invalid_argument if the scenario is invalid or the transform is out of range
+     * @throws std::runtime_error if a file cannot be read or written
+     */
+    PulseTransformResult transform(const PulseScenarioDescriptor& scenario, const PulseDemandTransform& transform) const;
+
+private:
+    std::string m_output_root;
+    std::size_t m_thread_count;
+    std::size_t m_run_trips;
+};
+
+#endif //PULSESCENARIOTRANSFORMER_H
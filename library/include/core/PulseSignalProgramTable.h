@@ -0,0 +1,161 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESIGNALPROGRAMTABLE_H
+#define PULSESIGNALPROGRAMTABLE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/SimulationSource.h"
+
+#include "types/PulseSignalColor.h"
+#include "types/PulseSignalProgram.h"
+#include "types/TrafficLightState.h"
+
+/**
+ * @class PulseSignalProgramTable
+ * @brief Compact per-link model of many traffic lights running their phase programs.
+ *
+ * State strings are parsed once, when a program is added, into one contiguous array of signal
+ * colors (light by light, phase by phase, signal by signal); phase durations, the current phase
+ * and the time to switch of every light are stored in parallel arrays indexed by light handle.
+ * advance() is therefore a tight loop over plain arrays, and the colors of a light's current
+ * phase are a span into the table.
+ */
+class PulseSignalProgramTable
+{
+public:
+    /**
+     * @brief Adds a traffic light and its program.
+     * @param traffic_light_id The light.
+     * @param program Phases, controlled links and the current position in the cycle.
+     * @return The handle of the light.
+     * @throws std::invalid_argument if the program has no phases, a duration is not positive, state
+     *         strings differ in length or contain unknown characters, a link refers to a missing
+     *         signal or the current phase is out of range
+     * @throws std::runtime_error if the light was already added
+     */
+    std::size_t addTrafficLight(const std::string& traffic_light_id, const PulseSignalProgram& program);
+
+    /**
+     * @brief Adds every traffic light of a simulation source that reports its program.
+     * @return Number of lights added.
+     */
+    std::size_t loadFrom(const SimulationSource& source);
+
+    /**
+     * @brief Looks up the handle of a traffic light.
+     * @return The handle, or std::nullopt if the light is unknown.
+     */
+    [[nodiscard]] std::optional<std::size_t> findTrafficLight(const std::string& traffic_light_id) const;
+
+    /**
+     * @brief Advances all lights by the given time, switching phases as their durations run out.
+     * @param seconds Elapsed time; non-positive values do nothing.
+     */
+    void advance(double seconds);
+
+    /**
+     * @brief Moves a light to a phase, e.g. to follow the simulation or an adaptive controller.
+     * @param handle The light.
+     * @param phase The phase index.
+     * @param time_to_switch Seconds until the phase ends; 0 or less runs the full duration.
+     * @throws std::out_of_range if the handle or phase is out of range
+     */
+    void setPhase(std::size_t handle, std::size_t phase, double time_to_switch = 0.0);
+
+    /**
+     * @brief Number of lights in the table.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief ID of a light.
+     * @throws std::out_of_range if the handle is out of range (as all per-light getters)
+     */
+    [[nodiscard]] const std::string& getId(std::size_t handle) const;
+
+    /**
+     * @brief Number of phases in a light's program.
+     */
+    [[nodiscard]] std::size_t getPhaseCount(std::size_t handle) const;
+
+    /**
+     * @brief Index of a light's current phase.
+     */
+    [[nodiscard]] std::size_t getPhaseIndex(std::size_t handle) const;
+
+    /**
+     * @brief Seconds until a light's current phase ends.
+     */
+    [[nodiscard]] double getTimeToSwitch(std::size_t handle) const;
+
+    /**
+     * @brief Signal colors of a light's current phase, one per signal index.
+     */
+    [[nodiscard]] std::span<const PulseSignalColor> getSignalColors(std::size_t handle) const;
+
+    /**
+     * @brief Lane pairs controlled by a light.
+     */
+    [[nodiscard]] std::span<const PulseControlledLink> getControlledLinks(std::size_t handle) const;
+
+    /**
+     * @brief Color currently shown to one controlled lane pair.
+     * @throws std::out_of_range if the handle or link is out of range
+     */
+    [[nodiscard]] PulseSignalColor getLinkColor(std::size_t handle, std::size_t link) const;
+
+    /**
+     * @brief Single-state summary used by PulseTrafficLight: green if any signal is green, else
+     *        yellow if any is yellow or red-yellow, else red.
+     */
+    [[nodiscard]] TrafficLightState getSummaryState(std::size_t handle) const;
+
+    /**
+     * @brief Writes the SUMO state string of a light's current phase, e.g. for setTrafficLightState().
+     * @param handle The light.
+     * @param out Buffer receiving the state; reassigned in place.
+     */
+    void fillStateString(std::size_t handle, std::string& out) const;
+
+    /**
+     * @brief Parses one SUMO state character.
+     * @throws std::invalid_argument if the character is not a signal state
+     */
+    [[nodiscard]] static PulseSignalColor parseStateChar(char state);
+
+private:
+    void requireHandle(std::size_t handle) const;
+
+private:
+    std::vector<std::string> m_ids;
+    std::unordered_map<std::string, std::size_t> m_index;
+
+    // Per light, indexed by handle
+    std::vector<std::uint32_t> m_phase_begin;       ///< First entry in m_phase_durations.
+    std::vector<std::uint32_t> m_phase_count;
+    std::vector<std::uint32_t> m_signal_count;      ///< Signals per phase, i.e. state string length.
+    std::vector<std::size_t> m_color_begin;         ///< First entry in m_colors.
+    std::vector<std::uint32_t> m_link_begin;        ///< First entry in m_links.
+    std::vector<std::uint32_t> m_link_count;
+    std::vector<double> m_cycle_time;
+    std::vector<std::uint32_t> m_current_phase;
+    std::vector<double> m_time_to_switch;
+
+    // Contiguous program data of all lights
+    std::vector<double> m_phase_durations;
+    std::vector<PulseSignalColor> m_colors;
+    std::vector<PulseControlledLink> m_links;
+};
+
+#endif //PULSESIGNALPROGRAMTABLE_H
@@ -0,0 +1,133 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESNAPSHOTPUBLISHER_H
+#define PULSESNAPSHOTPUBLISHER_H
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types/PulseStateSnapshot.h"
+
+/**
+ * @class PulseSnapshotPublisher
+ * @brief Single-writer, multi-reader publication of PulseStateSnapshot using epoch-based reclamation.
+ *
+ * The simulation thread fills a snapshot obtained from beginWrite() and calls publish(). Readers
+ * call pin(), which records the current epoch in a reader slot and returns a Guard to the current
+ * snapshot; neither side takes a lock. A replaced snapshot is retired with the epoch at which it
+ * stopped being current and is only recycled once no reader is pinned at an older epoch. Recycled
+ * snapshots keep their buffers, so steady-state publishing does not allocate.
+ */
+class PulseSnapshotPublisher
+{
+public:
+    static constexpr std::size_t kMaxReaders = 64; ///< Maximum number of simultaneously pinned readers.
+
+    /**
+     * @class Guard
+     * @brief RAII handle that keeps one snapshot alive while a reader uses it.
+     */
+    class Guard
+    {
+    public:
+        Guard() = default;
+        Guard(Guard&& other) noexcept;
+        Guard& operator=(Guard&& other) noexcept;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard();
+
+        /**
+         * @brief Retrieves the pinned snapshot.
+         * @return Pointer to the snapshot, or nullptr if nothing was published yet.
+         */
+        [[nodiscard]] const PulseStateSnapshot* get() const { return m_snapshot; }
+
+        const PulseStateSnapshot* operator->() const { return m_snapshot; }
+        const PulseStateSnapshot& operator*() const { return *m_snapshot; }
+        explicit operator bool() const { return m_snapshot != nullptr; }
+
+        /**
+         * @brief Releases the pin early.
+         */
+        void release();
+
+    private:
+        friend class PulseSnapshotPublisher;
+        Guard(const PulseSnapshotPublisher* publisher, std::size_t slot, const PulseStateSnapshot* snapshot);
+
+        const PulseSnapshotPublisher* m_publisher = nullptr;
+        std::size_t m_slot = 0;
+        const PulseStateSnapshot* m_snapshot = nullptr;
+    };
+
+    PulseSnapshotPublisher();
+
+    PulseSnapshotPublisher(const PulseSnapshotPublisher&) = delete;
+    PulseSnapshotPublisher& operator=(const PulseSnapshotPublisher&) = delete;
+
+    /**
+     * @brief Returns the snapshot the writer should fill next. Writer thread only.
+     *
+     * The returned snapshot may be a recycled one still holding old data; the writer is
+     * expected to overwrite every field.
+     * @return Reference to the pending snapshot.
+     */
+    PulseStateSnapshot& beginWrite();
+
+    /**
+     * @brief Makes the pending snapshot current and reclaims snapshots no reader can see any more.
+     *        Writer thread only.
+     * @throws std::logic_error if beginWrite() was not called first.
+     */
+    void publish();
+
+    /**
+     * @brief Pins the current snapshot for reading. Safe to call from any thread.
+     * @throws std::runtime_error if all kMaxReaders slots are in use.
+     * @return A guard holding the snapshot (empty if nothing was published yet).
+     */
+    [[nodiscard]] Guard pin() const;
+
+    /**
+     * @brief Retrieves the epoch of the current snapshot (0 before the first publish).
+     */
+    [[nodiscard]] std::uint64_t getEpoch() const;
+
+    /**
+     * @brief Number of replaced snapshots still waiting for readers to leave.
+     */
+    [[nodiscard]] std::size_t getRetiredCount() const;
+
+private:
+    void unpin(std::size_t slot) const;
+    void reclaim();
+
+    struct Retired
+    {
+        PulseStateSnapshot* snapshot;
+        std::uint64_t retired_at;
+    };
+
+private:
+    std::vector<std::unique_ptr<PulseStateSnapshot>> m_storage; ///< Owns every snapshot ever created.
+    std::vector<PulseStateSnapshot*> m_free;                    ///< Reclaimed snapshots ready for reuse.
+    std::vector<Retired> m_retired;                             ///< Replaced snapshots awaiting reclamation.
+    PulseStateSnapshot* m_pending = nullptr;                    ///< Snapshot being filled by the writer.
+
+    std::atomic<PulseStateSnapshot*> m_current{nullptr};        ///< Snapshot readers get on pin().
+    std::atomic<std::uint64_t> m_epoch{0};                      ///< Epoch of m_current.
+
+    // 0 marks a free slot; otherwise epoch + 1 of the snapshot generation the reader may hold.
+    mutable std::array<std::atomic<std::uint64_t>, kMaxReaders> m_pinned{};
+};
+
+#endif //PULSESNAPSHOTPUBLISHER_H
@@ -0,0 +1,108 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTATEENCODER_H
+#define PULSESTATEENCODER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "types/PulseStateSnapshot.h"
+#include "types/PulseWireFormat.h"
+
+/**
+ * @class PulseStateEncoder
+ * @brief Serializes state snapshots, and the changes between consecutive ones, for live clients.
+ *
+ * A full message carries every vehicle, traffic light and intersection of a snapshot. A delta
+ * carries what changed since the snapshot last passed to diff(): vehicles that appeared, moved or
+ * changed type or role, IDs of vehicles that left, and traffic lights that switched. Applying the
+ * deltas in order to a full message of their base epoch reproduces the state of each epoch.
+ *
+ * JSON messages are objects with "type" set to "state" or "delta". Binary messages are
+ * little-endian: u8 kind (1 state, 2 delta), u64 epoch, u64 base epoch (0 for a state),
+ * u64 step, then
+ * - u32 count of vehicles, each: u16 ID length, ID bytes, u8 type, u8 role, f32 x, f32 y;
+ * - (delta only) u32 count of removed vehicles, each: u16 ID length, ID bytes;
+ * - u32 count of traffic lights, each: u16 ID length, ID bytes, u8 state;
+ * - (state only) u32 count of intersections, each: u16 ID length, ID bytes, u64 vehicles passed,
+ *   f64 vehicle waiting time, u64 pedestrians passed, f64 pedestrian waiting time.
+ * Enum values are the underlying values of PulseVehicleType, PulseVehicleRole and TrafficLightState.
+ */
+class PulseStateEncoder
+{
+public:
+    static constexpr std::uint8_t kStateMessage = 1;    ///< Binary kind of a full message.
+    static constexpr std::uint8_t kDeltaMessage = 2;    ///< Binary kind of a delta.
+
+    /**
+     * @brief Encodes every record of a snapshot.
+     * @param snapshot The state.
+     * @param format Output encoding.
+     * @param out Buffer receiving the message; overwritten.
+     */
+    static void encodeState(const PulseStateSnapshot& snapshot, PulseWireFormat format, std::string& out);
+
+    /**
+     * @brief Computes the changes from the previous snapshot to this one and makes it the new base.
+     *        The first call reports every vehicle and light as changed, relative to epoch 0.
+     * @param snapshot The new state.
+     */
+    void diff(const PulseStateSnapshot& snapshot);
+
+    /**
+     * @brief Encodes the changes found by the last diff().
+     * @param format Output encoding.
+     * @param out Buffer receiving the message; overwritten.
+     */
+    void encodeDelta(PulseWireFormat format, std::string& out) const;
+
+    /**
+     * @brief Epoch of the snapshot last passed to diff(); 0 before the first call.
+     */
+    [[nodiscard]] std::uint64_t getEpoch() const;
+
+    /**
+     * @brief Number of vehicles and lights in the last delta, and of vehicles it removed.
+     */
+    [[nodiscard]] std::size_t getChangedVehicleCount() const;
+    [[nodiscard]] std::size_t getRemovedVehicleCount() const;
+    [[nodiscard]] std::size_t getChangedTrafficLightCount() const;
+
+    /**
+     * @brief Forgets the base, so the next diff() reports everything again.
+     */
+    void reset();
+
+private:
+    struct VehicleBase
+    {
+        PulseStateSnapshot::VehicleRecord record;
+        std::uint64_t seen = 0;     ///< diff() call in which the vehicle was last present.
+    };
+
+private:
+    std::unordered_map<std::string, VehicleBase> m_vehicles;       ///< Base state of each present vehicle.
+    std::unordered_map<std::string, TrafficLightState> m_lights;   ///< Base state of each light.
+
+    std::uint64_t m_generation = 0;     ///< Number of diff() calls.
+    std::uint64_t m_epoch = 0;
+    std::uint64_t m_base_epoch = 0;
+    std::uint64_t m_step = 0;
+
+    // Last delta; grow to their peak size and are reused.
+    std::vector<PulseStateSnapshot::VehicleRecord> m_changed_vehicles;
+    std::size_t m_changed_vehicle_count = 0;
+    std::vector<std::string> m_removed_vehicles;
+    std::size_t m_removed_vehicle_count = 0;
+    std::vector<PulseStateSnapshot::TrafficLightRecord> m_changed_lights;
+    std::size_t m_changed_light_count = 0;
+};
+
+#endif //PULSESTATEENCODER_H
@@ -0,0 +1,90 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTATEHASHER_H
+#define PULSESTATEHASHER_H
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class PulseStateHasher
+ * @brief Streaming 64-bit hash for checksumming simulation state.
+ *
+ * Input is consumed in 32-byte stripes of four 64-bit lanes. Each lane is combined with a key and
+ * folded into its own accumulator by a 32x32->64 multiply, which maps directly onto SSE2/AVX2
+ * (_mm_mul_epu32), so bulk input is hashed with vector instructions where available. Every 16
+ * stripes the accumulators are scrambled, and the digest mixes them with the total length.
+ *
+ * The vector and scalar paths produce bit-identical digests on every platform, so checksums from
+ * different builds (compiler, instruction set, PULSE_DISABLE_SIMD) can be compared. Not suitable
+ * for security purposes.
+ */
+class PulseStateHasher
+{
+public:
+    /**
+     * @brief Constructs a hasher; equivalent to reset(seed).
+     */
+    explicit PulseStateHasher(std::uint64_t seed = 0);
+
+    /**
+     * @brief Discards all input and starts over.
+     * @param seed Seed mixed into the accumulators.
+     */
+    void reset(std::uint64_t seed = 0);
+
+    /**
+     * @brief Appends raw bytes.
+     */
+    void update(const void* data, std::size_t size);
+
+    /**
+     * @brief Appends the object representation of a trivially copyable value.
+     *        Doubles are hashed bit for bit, so 0.0 and -0.0 differ.
+     */
+    template <typename T>
+    void updateValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed.");
+        update(&value, sizeof(value));
+    }
+
+    /**
+     * @brief Appends a string prefixed with its length, so consecutive strings cannot run together.
+     */
+    void updateString(std::string_view value);
+
+    /**
+     * @brief Hash of everything appended since the last reset; the hasher can keep being updated.
+     */
+    [[nodiscard]] std::uint64_t digest() const;
+
+    /**
+     * @brief One-shot hash of a buffer.
+     */
+    [[nodiscard]] static std::uint64_t hash(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+    /**
+     * @brief Checks whether this build accumulates with vector instructions.
+     */
+    [[nodiscard]] static bool isVectorized();
+
+    static constexpr std::size_t kStripeSize = 32;          ///< Bytes folded per accumulation.
+    static constexpr std::size_t kStripesPerBlock = 16;     ///< Stripes between scrambles.
+    static constexpr std::size_t kBlockSize = kStripeSize * kStripesPerBlock;
+
+private:
+    std::array<std::uint64_t, 4> m_accumulators{};
+    std::array<unsigned char, kBlockSize> m_buffer{};   ///< Input not yet folded into a full block.
+    std::size_t m_buffered = 0;
+    std::uint64_t m_length = 0;                         ///< Total bytes appended.
+};
+
+#endif //PULSESTATEHASHER_H
@@ -0,0 +1,149 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTATISTICSEXPORTER_H
+#define PULSESTATISTICSEXPORTER_H
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseParquetWriter.h"
+
+/**
+ * @brief Settings of PulseStatisticsExporter.
+ */
+struct PulseExportConfig {
+    std::string directory;                  ///< Output directory, created if missing.
+    double sample_interval = 60.0;          ///< Simulation seconds between samples; 0 samples on every call.
+    std::size_t row_group_size = 65536;     ///< Rows buffered per table before they are handed to the writer.
+    std::size_t max_pending_batches = 8;    ///< Full buffers queued for the writer before sample() waits for it.
+    int compression_level = PulseParquetWriter::kDefaultCompressionLevel; ///< zlib level of the column pages.
+};
+
+/**
+ * @class PulseStatisticsExporter
+ * @brief Periodic export of intersection, traffic light and vehicle type metrics to Parquet files.
+ *
+ * Writes three tables to the output directory, one row per entity and sample:
+ * - intersections.parquet: time, intersection_id, vehicles_passed, vehicle_waiting_time,
+ *   pedestrians_passed, pedestrian_waiting_time (cumulative totals);
+ * - traffic_lights.parquet: time, traffic_light_id, state;
+ * - vehicle_types.parquet: time, vehicle_type, vehicles, mean_speed (speed needs kinematics tracking).
+ *
+ * sample() only appends to in-memory column buffers and interns IDs into per-column dictionaries.
+ * Full buffers are passed to a background thread that encodes, compresses and writes them, so the
+ * simulation thread does not wait for the disk. The queue is bounded by max_pending_batches: if the
+ * disk falls that far behind, sample() blocks until the writer catches up instead of buffering
+ * without limit. Buffers are recycled, and the files are complete once close() has written their footers.
+ */
+class PulseStatisticsExporter
+{
+public:
+    /**
+     * @brief Creates the output files and starts the writer thread.
+     * @throws std::invalid_argument if the directory is empty or a setting is out of range
+     * @throws std::runtime_error if the output files cannot be created
+     */
+    explicit PulseStatisticsExporter(const PulseExportConfig& config);
+
+    /**
+     * @brief Closes the files if still open; errors are swallowed.
+     */
+    ~PulseStatisticsExporter();
+
+    PulseStatisticsExporter(const PulseStatisticsExporter&) = delete;
+    PulseStatisticsExporter& operator=(const PulseStatisticsExporter&) = delete;
+
+    /**
+     * @brief Records one row per entity if the sample interval has elapsed since the last sample.
+     *        Typically registered as a non-critical TrafficSystem step consumer.
+     * @param data_manager Source of the metrics.
+     * @param simulation_time Current simulation time in seconds.
+     * @return True if a sample was recorded.
+     * @note Blocks while max_pending_batches buffers are waiting for the writer.
+     * @throws std::logic_error if the exporter is closed
+     * @throws std::runtime_error if the writer thread failed
+     */
+    bool sample(const PulseDataManager& data_manager, double simulation_time);
+
+    /**
+     * @brief Hands all buffered rows to the writer and waits until they are on disk.
+     * @throws std::runtime_error if the writer thread failed
+     */
+    void flush();
+
+    /**
+     * @brief Flushes, writes the file footers and stops the writer thread. Further calls do nothing.
+     * @throws std::runtime_error if the writer thread failed
+     */
+    void close();
+
+    /**
+     * @brief Number of samples recorded.
+     */
+    [[nodiscard]] std::uint64_t getSampleCount() const;
+
+private:
+    enum Table : std::size_t { INTERSECTIONS, TRAFFIC_LIGHTS, VEHICLE_TYPES, TABLE_COUNT };
+
+    struct Job
+    {
+        Table table = INTERSECTIONS;
+        std::unique_ptr<PulseColumnBatch> batch;
+    };
+
+    /**
+     * @brief Maps the IDs of one string column to dictionary codes on the simulation thread.
+     */
+    struct Dictionary
+    {
+        std::unordered_map<std::string, std::uint32_t> codes;
+
+        std::uint32_t intern(const std::string& value, PulseColumn& column);
+    };
+
+    PulseColumnBatch& batch(Table table);
+    void submit(Table table);
+    void rethrowWriterError();
+    void runWriter();
+
+private:
+    PulseExportConfig m_config;
+    std::array<std::unique_ptr<PulseParquetWriter>, TABLE_COUNT> m_writers;
+
+    // Simulation thread
+    std::array<std::unique_ptr<PulseColumnBatch>, TABLE_COUNT> m_batches;
+    std::array<Dictionary, TABLE_COUNT> m_dictionaries;     ///< Dictionary of the ID column of each table.
+    Dictionary m_states;                                    ///< Dictionary of traffic light states.
+    double m_next_sample = 0.0;
+    std::uint64_t m_samples = 0;
+    bool m_closed = false;
+
+    // Shared with the writer thread
+    std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_work_done;
+    std::deque<Job> m_jobs;
+    std::array<std::vector<std::unique_ptr<PulseColumnBatch>>, TABLE_COUNT> m_free;
+    std::size_t m_in_flight = 0;                            ///< Jobs queued or being written.
+    bool m_stopping = false;
+    std::exception_ptr m_error;
+
+    std::thread m_writer;
+};
+
+#endif //PULSESTATISTICSEXPORTER_H
@@ -0,0 +1,127 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTEPSCHEDULER_H
+#define PULSESTEPSCHEDULER_H
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/TrafficSystem.h"
+
+/**
+ * @brief Aggregated timing of one TrafficSystem stage over a scheduler run.
+ */
+struct PulseStageReport {
+    std::string name;           ///< Stage name.
+    std::size_t runs = 0;       ///< Steps in which the stage ran.
+    std::size_t skipped = 0;    ///< Steps in which the stage was due but skipped while degraded.
+    double mean_ms = 0.0;       ///< Mean duration of the runs (ms).
+    double max_ms = 0.0;        ///< Longest run (ms).
+};
+
+/**
+ * @brief Summary of a scheduler run.
+ */
+struct PulseSchedulerReport {
+    std::size_t steps = 0;              ///< Steps executed.
+    std::size_t overruns = 0;           ///< Steps that took longer than the step period.
+    std::size_t degraded_steps = 0;     ///< Steps executed with non-critical consumers disabled.
+    std::size_t resynchronizations = 0; ///< Times the schedule was re-anchored after falling behind.
+
+    double mean_step_ms = 0.0;          ///< Mean step duration (ms).
+    double max_step_ms = 0.0;           ///< Longest step (ms).
+
+    double mean_jitter_ms = 0.0;        ///< Mean lateness of step starts against the schedule (ms).
+    double max_jitter_ms = 0.0;         ///< Largest lateness (ms).
+    double jitter_stddev_ms = 0.0;      ///< Standard deviation of the lateness (ms).
+
+    std::vector<PulseStageReport> stages; ///< Per-stage timings, in TrafficSystem stage order.
+};
+
+/**
+ * @class PulseStepScheduler
+ * @brief Drives TrafficSystem::stepSimulation at a fixed real-time rate and tracks deadlines.
+ *
+ * Step k is scheduled at start + k * period, where period = step_length / real_time_factor.
+ * A real-time factor of AS_FAST_AS_POSSIBLE disables pacing. When a step takes longer than the
+ * period, non-critical step consumers are switched off until a number of consecutive steps finish
+ * comfortably within the budget again. If the loop falls more than one period behind, the schedule
+ * is re-anchored instead of bursting through the backlog.
+ */
+class PulseStepScheduler
+{
+public:
+    static constexpr double AS_FAST_AS_POSSIBLE = 0.0; ///< Real-time factor that disables pacing.
+
+    /**
+     * @brief Constructs a scheduler.
+     * @param system The system to step.
+     * @param step_length Simulated seconds per step (SUMO step length).
+     * @param real_time_factor Simulated seconds per wall-clock second (1 = real time, 10 = ten times faster).
+     * @throws std::invalid_argument if step_length is not positive or real_time_factor is negative
+     */
+    PulseStepScheduler(TrafficSystem& system, double step_length, double real_time_factor = 1.0);
+
+    /**
+     * @brief Sets when a degraded scheduler restores non-critical consumers.
+     * @param budget_fraction Step duration, as a fraction of the period, considered comfortable.
+     * @param steps Number of consecutive comfortable steps required.
+     */
+    void setRecoveryPolicy(double budget_fraction, std::size_t steps);
+
+    /**
+     * @brief Runs steps until max_steps are done, stop is requested or the simulation stops.
+     * @param max_steps Maximum number of steps.
+     * @return Number of steps executed.
+     */
+    std::size_t run(std::size_t max_steps);
+
+    /**
+     * @brief Asks a running run() call to return after the current step. Thread-safe.
+     */
+    void requestStop();
+
+    /**
+     * @brief Retrieves the wall-clock budget of one step (zero when not paced).
+     */
+    [[nodiscard]] std::chrono::nanoseconds getStepPeriod() const;
+
+    /**
+     * @brief Builds the report of everything run so far. Call from the thread that runs the scheduler.
+     */
+    [[nodiscard]] PulseSchedulerReport getReport() const;
+
+private:
+    void recordStep(std::chrono::nanoseconds step_duration, std::chrono::nanoseconds lateness);
+
+    struct StageAccumulator
+    {
+        std::size_t runs = 0;
+        std::size_t skipped = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+private:
+    TrafficSystem& m_system;
+    std::chrono::nanoseconds m_period;
+    double m_recovery_fraction = 0.8;
+    std::size_t m_recovery_steps = 3;
+    std::size_t m_comfortable_steps = 0;
+    std::atomic<bool> m_stop_requested{false};
+
+    PulseSchedulerReport m_report;
+    double m_total_step_ms = 0.0;
+    double m_total_jitter_ms = 0.0;
+    double m_total_jitter_sq = 0.0;
+    std::vector<StageAccumulator> m_stages;
+};
+
+#endif //PULSESTEPSCHEDULER_H
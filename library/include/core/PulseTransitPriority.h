@@ -0,0 +1,76 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRANSITPRIORITY_H
+#define PULSETRANSITPRIORITY_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "core/PulseTransitTable.h"
+#include "core/SimulationSource.h"
+
+/**
+ * @brief Settings of conditional transit signal priority.
+ */
+struct PulseTransitPriorityConfig {
+    double min_lateness = 60.0;         ///< Seconds behind schedule from which a vehicle gets priority.
+    double max_extension = 15.0;        ///< Longest green extension in seconds; farther vehicles are ignored.
+    double clearance = 2.0;             ///< Seconds added to the arrival estimate to clear the stop line.
+    double min_approach_speed = 2.0;    ///< m/s assumed for slower vehicles when estimating arrival.
+    double recovery_time = 120.0;       ///< Seconds after an extension before the same light is extended again.
+};
+
+/**
+ * @class PulseTransitPriority
+ * @brief Extends the green of a traffic light for a late bus or tram about to pass it.
+ *
+ * Priority is conditional: a vehicle qualifies only when it runs at least min_lateness behind
+ * schedule, currently sees green at its next light and can reach the stop line within
+ * max_extension. The green is then held until the estimated arrival plus clearance. A light that
+ * was extended recovers for recovery_time before it is extended again, so the cross traffic
+ * loses at most one extension per recovery period.
+ *
+ * apply() reads only the vehicles in the transit table, so it is cheap to run every step, e.g. as
+ * a critical TrafficSystem step consumer after the data manager was updated.
+ */
+class PulseTransitPriority
+{
+public:
+    /**
+     * @brief Constructs the controller.
+     * @param config Priority settings.
+     * @throws std::invalid_argument if a setting is negative or max_extension is not positive
+     */
+    explicit PulseTransitPriority(const PulseTransitPriorityConfig& config = {});
+
+    /**
+     * @brief Grants green extensions to the qualifying vehicles of one step.
+     * @param transit Public-transport vehicles and their lateness, as of this step.
+     * @param source The simulation whose lights are extended.
+     * @param now Current simulation time in seconds.
+     * @return Number of extensions granted.
+     */
+    std::size_t apply(const PulseTransitTable& transit, SimulationSource& source, double now);
+
+    /**
+     * @brief Total number of extensions granted so far.
+     */
+    [[nodiscard]] std::size_t getExtensionCount() const;
+
+    /**
+     * @brief Retrieves the settings.
+     */
+    [[nodiscard]] const PulseTransitPriorityConfig& getConfig() const;
+
+private:
+    PulseTransitPriorityConfig m_config;
+    std::unordered_map<std::string, double> m_recovered_at;  ///< Per light, when it may be extended again.
+    std::size_t m_extension_count = 0;
+};
+
+#endif //PULSETRANSITPRIORITY_H
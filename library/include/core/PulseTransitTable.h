@@ -0,0 +1,133 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRANSITTABLE_H
+#define PULSETRANSITTABLE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/SimulationSource.h"
+
+#include "types/PulseTransitState.h"
+#include "types/PulseTransitStopEvent.h"
+#include "types/PulseVehicleType.h"
+
+#include "utils/PulseStringHash.h"
+
+/**
+ * @class PulseTransitTable
+ * @brief Schedule adherence of the public-transport vehicles currently in the simulation.
+ *
+ * Buses and trams are added when they appear and removed when they leave; every other vehicle is
+ * never looked at, so an update costs one fillTransitState() query per public-transport vehicle
+ * regardless of the size of the fleet. Slots and their string buffers are reused by later arrivals.
+ *
+ * A vehicle's lateness is set each time it leaves a stop with a scheduled departure ("until"), as
+ * the time past that departure. Between stops it only grows: once the scheduled departure from
+ * the next stop has passed, the vehicle is at least that late.
+ */
+class PulseTransitTable
+{
+public:
+    /**
+     * @brief Checks whether vehicles of a type run on a schedule and are tracked here.
+     */
+    [[nodiscard]] static constexpr bool isTransit(PulseVehicleType type)
+    {
+        return type == PulseVehicleType::BUS || type == PulseVehicleType::TRAM;
+    }
+
+    /**
+     * @brief Starts tracking a vehicle; does nothing if it is already tracked.
+     * @param vehicle_id The vehicle.
+     */
+    void add(const std::string& vehicle_id);
+
+    /**
+     * @brief Stops tracking a vehicle; does nothing if it is not tracked.
+     * @param vehicle_id The vehicle.
+     */
+    void remove(std::string_view vehicle_id);
+
+    /**
+     * @brief Reads the schedule position of every tracked vehicle and updates its lateness.
+     *        Stop events of this update replace those of the previous one.
+     * @param source The simulation; vehicles it reports no transit state for keep their last state.
+     * @param now Current simulation time in seconds.
+     */
+    void update(const SimulationSource& source, double now);
+
+    /**
+     * @brief Removes all vehicles and events.
+     */
+    void clear();
+
+    /**
+     * @brief Number of tracked vehicles.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Stops left during the last update, with their lateness.
+     */
+    [[nodiscard]] std::span<const PulseTransitStopEvent> getStopEvents() const;
+
+    /**
+     * @brief Looks up a vehicle's slot.
+     * @return The slot, or std::nullopt if the vehicle is not tracked.
+     */
+    [[nodiscard]] std::optional<std::size_t> find(std::string_view vehicle_id) const;
+
+    /**
+     * @brief Calls a function for every tracked vehicle with its slot; slots are valid until the next add() or remove().
+     * @param fn Callable taking a std::size_t slot.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (std::size_t slot = 0; slot < m_active.size(); ++slot) {
+            if (m_active[slot]) {
+                fn(slot);
+            }
+        }
+    }
+
+    /**
+     * @brief Attributes of an occupied slot, as of the last update.
+     */
+    [[nodiscard]] const std::string& getId(std::size_t slot) const { return m_ids[slot]; }
+    [[nodiscard]] const PulseTransitState& getState(std::size_t slot) const { return m_states[slot]; }
+    [[nodiscard]] double getLateness(std::size_t slot) const { return m_lateness[slot]; }
+
+private:
+    void recordStopEvent(std::size_t slot, double lateness);
+
+private:
+    // Per slot
+    std::vector<std::string> m_ids;
+    std::vector<PulseTransitState> m_states;
+    std::vector<double> m_lateness;
+    std::vector<std::uint8_t> m_active;
+
+    // Backing store for index nodes and keys; must outlive the index.
+    std::pmr::unsynchronized_pool_resource m_node_resource;
+    std::pmr::unordered_map<std::pmr::string, std::uint32_t, PulseStringHash, PulseStringEqual> m_slot_by_id{&m_node_resource};
+    std::vector<std::uint32_t> m_free_slots;
+
+    PulseTransitState m_state_buffer;                       ///< Receives each vehicle's state, then swapped into its slot.
+    std::vector<PulseTransitStopEvent> m_stop_events;       ///< Grows to the peak count; entries are reused.
+    std::size_t m_stop_event_count = 0;                     ///< Valid entries from the last update.
+};
+
+#endif //PULSETRANSITTABLE_H
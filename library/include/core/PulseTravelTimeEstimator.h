@@ -0,0 +1,130 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRAVELTIMEESTIMATOR_H
+#define PULSETRAVELTIMEESTIMATOR_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseRouter.h"
+
+#include "entities/PulseIntersection.h"
+
+#include "types/PulseRoadBinding.h"
+
+/**
+ * @brief Current estimate for one road connection.
+ */
+struct PulseEdgeEstimate {
+    double travel_time;             ///< Smoothed travel time in seconds (free flow until measured).
+    double speed;                   ///< Smoothed speed in m/s.
+    std::uint64_t samples;          ///< Number of traversals measured.
+};
+
+/**
+ * @class PulseTravelTimeEstimator
+ * @brief Exponentially smoothed travel time and speed per road connection, from vehicle traversals.
+ *
+ * Feeds on PulseDataManager::getRoadTransitions(), so an update costs O(vehicles that changed road)
+ * and requires kinematics tracking on the data manager. Estimates live in a flat array indexed like
+ * the road connections of the intersections (intersection order, then road ID), which never moves
+ * after construction: any thread can read it without locks while the simulation thread updates it.
+ * Each field is atomic on its own, so a reader may combine values from consecutive updates.
+ */
+class PulseTravelTimeEstimator
+{
+public:
+    static constexpr double kDefaultSmoothing = 0.2; ///< Weight of a new measurement.
+
+    /**
+     * @brief Creates estimates for all road connections between the given intersections.
+     * @param intersections The road network.
+     * @param bindings Source roads to measure; connections without a binding keep their free-flow estimate.
+     * @param smoothing Weight in (0, 1] of each new measurement.
+     * @param free_flow_speed Speed in m/s for the initial estimates.
+     * @throws std::invalid_argument on an unknown or duplicate binding or an out-of-range parameter
+     */
+    PulseTravelTimeEstimator(const std::vector<PulseIntersection*>& intersections,
+                             const std::vector<PulseRoadBinding>& bindings,
+                             double smoothing = kDefaultSmoothing,
+                             double free_flow_speed = PulseRouter::kDefaultFreeFlowSpeed);
+
+    /**
+     * @brief Folds the traversals of the data manager's last update into the estimates.
+     *        Typically registered as a TrafficSystem step consumer.
+     */
+    void update(const PulseDataManager& data_manager);
+
+    /**
+     * @brief Folds one measured traversal into an edge estimate.
+     * @param edge Edge index.
+     * @param travel_time Measured travel time in seconds; non-positive values are ignored.
+     * @throws std::out_of_range if the index is invalid
+     */
+    void recordTraversal(std::size_t edge, double travel_time);
+
+    /**
+     * @brief Number of road connections tracked.
+     */
+    [[nodiscard]] std::size_t getEdgeCount() const;
+
+    /**
+     * @brief Finds the edge index of a road connection.
+     * @return The index, or std::nullopt if the connection is not part of the network.
+     */
+    [[nodiscard]] std::optional<std::size_t> findEdge(const std::string& intersection_id, int road_id) const;
+
+    /**
+     * @brief Finds the edge index bound to a source road.
+     * @return The index, or std::nullopt if the source road is not bound.
+     */
+    [[nodiscard]] std::optional<std::size_t> findSourceRoad(const std::string& source_road_id) const;
+
+    /**
+     * @brief Reads the current estimate of an edge. Safe to call from any thread.
+     * @throws std::out_of_range if the index is invalid
+     */
+    [[nodiscard]] PulseEdgeEstimate getEstimate(std::size_t edge) const;
+
+    /**
+     * @brief Copies all measured travel times into a router built from the same intersections.
+     * @throws std::invalid_argument if the router does not know a measured road
+     */
+    void applyTo(PulseRouter& router) const;
+
+private:
+    struct EdgeInfo
+    {
+        std::string intersection_id;
+        int road_id;
+        double length;
+    };
+
+    struct EdgeState
+    {
+        std::atomic<double> travel_time{0.0};
+        std::atomic<double> speed{0.0};
+        std::atomic<std::uint64_t> samples{0};
+    };
+
+private:
+    std::vector<EdgeInfo> m_edges;
+    std::unique_ptr<EdgeState[]> m_state;                           ///< Fixed-size, read lock-free.
+    std::unordered_map<std::string, std::uint32_t> m_node_index;    ///< Intersection ID to node.
+    std::vector<std::uint32_t> m_edge_begin;                        ///< Edges of node n are [begin[n], begin[n + 1]).
+    std::unordered_map<std::string, std::uint32_t> m_source_roads;  ///< Bound source road to edge.
+    double m_smoothing;
+};
+
+#endif //PULSETRAVELTIMEESTIMATOR_H
@@ -0,0 +1,172 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef SIMULATIONSOURCE_H
+#define SIMULATIONSOURCE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types/PulsePersonState.h"
+#include "types/PulseSignalPlan.h"
+#include "types/PulseSignalProgram.h"
+#include "types/PulseTransitState.h"
+#include "types/PulseVehicleKinematics.h"
+#include "types/PulseVehicleType.h"
+
+/**
+ * @class SimulationSource
+ * @brief Data interface of a running traffic simulation.
+ *
+ * PulseDataManager and TrafficSystem only talk to this interface, so a SumoIntegration,
+ * a lightweight model or a test double can drive them interchangeably. Each TrafficSystem
+ * instance owns its own source.
+ */
+class SimulationSource
+{
+public:
+    virtual ~SimulationSource() = default;
+
+    /**
+     * @brief Starts the simulation.
+     */
+    virtual void startSimulation() = 0;
+
+    /**
+     * @brief Steps the simulation forward by one timestep.
+     */
+    virtual void stepSimulation() = 0;
+
+    /**
+     * @brief Stops the simulation.
+     */
+    virtual void stopSimulation() = 0;
+
+    /**
+     * @brief Checks if the simulation is running.
+     */
+    [[nodiscard]] virtual bool isRunning() const = 0;
+
+    /**
+     * @brief Sets the random seed used by the next startSimulation() call.
+     * @param seed The seed value.
+     */
+    virtual void setSeed(std::uint64_t seed) { (void)seed; }
+
+    /**
+     * @brief Retrieves all vehicle IDs.
+     */
+    [[nodiscard]] virtual std::vector<std::string> getAllVehicles() const = 0;
+
+    /**
+     * @brief Retrieves the (x,y) position of a given vehicle by ID.
+     */
+    [[nodiscard]] virtual std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const = 0;
+
+    /**
+     * @brief Retrieves a list of traffic light IDs.
+     */
+    [[nodiscard]] virtual std::vector<std::string> getAllTrafficLights() const = 0;
+
+    /**
+     * @brief Retrieves a traffic light's state as a string (e.g., "rGrG").
+     */
+    [[nodiscard]] virtual std::string getTrafficLightState(const std::string& tl_id) const = 0;
+
+    /**
+     * @brief Sets the state (e.g., "rGrG") of the specified traffic light.
+     */
+    virtual void setTrafficLightState(const std::string& tl_id, const std::string& state) = 0;
+
+    /**
+     * @brief Writes all vehicle IDs into a caller-owned buffer.
+     *        Strings already in the buffer are reassigned in place, so a reused buffer keeps its capacity.
+     * @param out Buffer receiving the IDs.
+     */
+    virtual void fillVehicleIds(std::vector<std::string>& out) const;
+
+    /**
+     * @brief Writes all traffic light IDs into a caller-owned buffer.
+     * @param out Buffer receiving the IDs.
+     */
+    virtual void fillTrafficLightIds(std::vector<std::string>& out) const;
+
+    /**
+     * @brief Writes a traffic light's state string into a caller-owned buffer.
+     * @param tl_id The traffic light ID.
+     * @param out Buffer receiving the state (e.g., "rGrG").
+     */
+    virtual void fillTrafficLightState(const std::string& tl_id, std::string& out) const;
+
+    /**
+     * @brief Retrieves the current simulation time.
+     * @return Seconds since the simulation started; 0 if the source does not keep time.
+     */
+    [[nodiscard]] virtual double getSimulationTime() const;
+
+    /**
+     * @brief Writes a vehicle's road, lane position and speed into a caller-owned buffer.
+     * @param vehicle_id The vehicle ID.
+     * @param out Buffer receiving the kinematics; the road ID is reassigned in place.
+     * @return False if the source does not report kinematics.
+     */
+    virtual bool fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const;
+
+    /**
+     * @brief Writes the active signal program of a traffic light into a caller-owned buffer.
+     * @param tl_id The traffic light ID.
+     * @param out Buffer receiving phases, controlled links and the current phase.
+     * @return False if the source does not report signal programs.
+     */
+    virtual bool fillSignalProgram(const std::string& tl_id, PulseSignalProgram& out) const;
+
+    /**
+     * @brief Retrieves the type of a vehicle; called once per vehicle, when it first appears.
+     * @param vehicle_id The vehicle ID.
+     * @return The vehicle type; CAR if the source does not report types.
+     */
+    [[nodiscard]] virtual PulseVehicleType getVehicleType(const std::string& vehicle_id) const;
+
+    /**
+     * @brief Writes the state of every person (pedestrian) into a caller-owned buffer in one call.
+     *        Entries are reassigned in place and the buffer only grows, so a reused buffer keeps
+     *        its capacity; entries past the returned count are stale.
+     * @param out Buffer receiving the states.
+     * @return Number of valid entries; 0 if the source does not report persons.
+     */
+    virtual std::size_t fillPersonStates(std::vector<PulsePersonState>& out) const;
+
+    /**
+     * @brief Writes the line, next stop and next traffic light of a public-transport vehicle
+     *        into a caller-owned buffer; strings are reassigned in place.
+     * @param vehicle_id The vehicle ID.
+     * @param out Buffer receiving the state.
+     * @return False if the source does not report schedules.
+     */
+    virtual bool fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const;
+
+    /**
+     * @brief Keeps the current phase of a traffic light running for at least the given time.
+     *        A phase that already lasts longer is left unchanged.
+     * @param tl_id The traffic light ID.
+     * @param seconds Minimum remaining duration of the current phase.
+     * @return False if the source does not support phase extensions.
+     */
+    virtual bool extendGreen(const std::string& tl_id, double seconds);
+
+    /**
+     * @brief Replaces the fixed-time plan of a traffic light and returns it to plan control.
+     * @param plan The new plan.
+     * @return False if the source does not support plan changes.
+     * @throws std::invalid_argument if the source rejects the light or the plan
+     */
+    virtual bool applySignalPlan(const PulseSignalPlan& plan);
+};
+
+#endif //SIMULATIONSOURCE_H
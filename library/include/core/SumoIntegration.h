@@ -7,14 +7,22 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "core/SimulationSource.h"
+#include "types/PulseScenarioDescriptor.h"
+
 /**
  * @class SumoIntegration
  * @brief Demonstrates using libsumo for starting, stepping, and controlling SUMO from C++.
+ *
+ * libsumo hosts a single simulation per process, so only one SumoIntegration may be running at a time.
  */
-class SumoIntegration
+class SumoIntegration : public SimulationSource
 {
 public:
     /**
@@ -23,54 +31,137 @@ public:
      */
     explicit SumoIntegration(std::string  sumo_config);
 
+    /**
+     * @brief Constructs a SumoIntegration object for a scenario indexed by PulseScenarioCatalog.
+     * @param scenario Descriptor whose config path is used as is; its inputs were checked by the catalog.
+     * @throws std::invalid_argument if the descriptor is not valid
+     */
+    explicit SumoIntegration(const PulseScenarioDescriptor& scenario);
+
     /**
      * @brief Starts the SUMO simulation using libsumo.
      */
-    void startSimulation();
+    void startSimulation() override;
 
     /**
      * @brief Steps the simulation forward by one timestep.
      */
-    void stepSimulation() const;
+    void stepSimulation() override;
 
     /**
      * @brief Stops the SUMO simulation.
      */
-    void stopSimulation();
+    void stopSimulation() override;
+
+    /**
+     * @brief Passes "--seed" to SUMO on the next start, for reproducible replications.
+     */
+    void setSeed(std::uint64_t seed) override;
 
     /**
      * @brief Checks if the simulation is running.
      */
-    [[nodiscard]] virtual bool isRunning() const;
+    [[nodiscard]] bool isRunning() const override;
 
     /**
      * @brief Retrieves all vehicle IDs.
      */
-    [[nodiscard]] virtual std::vector<std::string> getAllVehicles() const;
+    [[nodiscard]] std::vector<std::string> getAllVehicles() const override;
 
     /**
      * @brief Retrieves the (x,y) position of a given vehicle by ID.
      */
-    [[nodiscard]] virtual std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const;
+    [[nodiscard]] std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const override;
 
     /**
      * @brief Retrieves a list of traffic light IDs.
      */
-    [[nodiscard]] virtual std::vector<std::string> getAllTrafficLights() const;
+    [[nodiscard]] std::vector<std::string> getAllTrafficLights() const override;
 
     /**
      * @brief Retrieves a traffic light's state as a string (e.g., "rGrG").
      */
-    [[nodiscard]] virtual std::string getTrafficLightState(const std::string& tl_id) const;
+    [[nodiscard]] std::string getTrafficLightState(const std::string& tl_id) const override;
 
     /**
      * @brief Sets the state (e.g., "rGrG") of the specified traffic light.
      */
-    void setTrafficLightState(const std::string& tl_id, const std::string& state) const;
+    void setTrafficLightState(const std::string& tl_id, const std::string& state) override;
+
+    /**
+     * @brief Copies the vehicle IDs tracked from SUMO's departures and arrivals into the reused buffer.
+     */
+    void fillVehicleIds(std::vector<std::string>& out) const override;
+
+    /**
+     * @brief Copies the traffic light IDs read once at start into the reused buffer.
+     */
+    void fillTrafficLightIds(std::vector<std::string>& out) const override;
+
+    /**
+     * @brief Copies a traffic light's state, querying SUMO only once its phase may have switched.
+     */
+    void fillTrafficLightState(const std::string& tl_id, std::string& out) const override;
+
+    /**
+     * @brief Retrieves the current simulation time in seconds.
+     */
+    [[nodiscard]] double getSimulationTime() const override;
+
+    /**
+     * @brief Reads a vehicle's road, lane index, lane position, speed and lane length.
+     */
+    bool fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const override;
+
+    /**
+     * @brief Reads the phases of the light's active program, its controlled lane pairs and the
+     *        current phase with the time left until it switches.
+     */
+    bool fillSignalProgram(const std::string& tl_id, PulseSignalProgram& out) const override;
+
+    /**
+     * @brief Maps the SUMO vehicle class (passenger, bus, bicycle, ...) to a PulseVehicleType.
+     */
+    [[nodiscard]] PulseVehicleType getVehicleType(const std::string& vehicle_id) const override;
+
+    /**
+     * @brief Reads position, road, speed and waiting time of every person.
+     */
+    std::size_t fillPersonStates(std::vector<PulsePersonState>& out) const override;
+
+    /**
+     * @brief Reads the line, the next stop with its "until" time and the next traffic light.
+     */
+    bool fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const override;
+
+    /**
+     * @brief Stretches the remaining duration of the current phase.
+     */
+    bool extendGreen(const std::string& tl_id, double seconds) override;
+
+private:
+    struct CachedSignal
+    {
+        std::string state;
+        double next_switch = 0.0;   ///< Simulation time at which the state may change.
+    };
+
+    void loadVehicleIds() const;
+    void addVehicleId(const std::string& vehicle_id) const;
+    void removeVehicleId(const std::string& vehicle_id) const;
 
 private:
     std::string m_sumo_config;
     bool m_running;
+    std::optional<std::uint64_t> m_seed;
+
+    // Kept in step with SUMO so the per-step reads copy into reused buffers instead of
+    // receiving fresh vectors of strings from libsumo
+    mutable std::vector<std::string> m_vehicle_ids;                         ///< Vehicles in the network.
+    mutable std::unordered_map<std::string, std::size_t> m_vehicle_index;   ///< Position in m_vehicle_ids.
+    std::vector<std::string> m_traffic_light_ids;                           ///< Read at start; lights do not change.
+    mutable std::unordered_map<std::string, CachedSignal> m_signals;        ///< Last state of each light.
+    mutable std::unordered_map<std::string, double> m_lane_lengths;         ///< Lane lengths by lane ID; the network does not change.
 };
 
 #endif // SUMOINTEGRATION_H
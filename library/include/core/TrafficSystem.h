@@ -7,23 +7,86 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/PulseChecksumRecorder.h"
+#include "core/PulseCommandQueue.h"
 #include "core/PulseDataManager.h"
-#include "core/SumoIntegration.h"
+#include "core/SimulationSource.h"
+
+/**
+ * @brief Wall-clock duration of one stage of the last simulation step.
+ */
+struct PulseStageTiming {
+    std::chrono::nanoseconds duration{0}; ///< Time spent in the stage.
+    bool skipped = false;                 ///< True if the stage was skipped (non-critical consumer while degraded).
+    bool idle = false;                    ///< True if the stage was not due this step (see TrafficSystem::setStageRate()).
+};
+
+/**
+ * @brief How often a stage runs: on every step s with s % period == phase, counting steps from 0.
+ */
+struct PulseStageRate {
+    std::uint32_t period = 1;             ///< Steps between runs; 1 runs every step.
+    std::uint32_t phase = 0;              ///< Offset of the first run, in [0, period).
+};
 
 /**
  * @class TrafficSystem
  * @brief Controls the overall traffic simulation, handling initialization, SUMO interaction, and updates.
+ *
+ * getInstance() returns the process-wide system driving SUMO through the shared PulseDataManager.
+ * Additional instances, each with its own simulation source and data manager, can be created to
+ * run several scenarios or seeds side by side (see PulseReplicationRunner).
+ *
+ * A step runs the built-in stages (commands, simulation, vehicle_sync, traffic_light_sync,
+ * pedestrian_sync, transit_sync, snapshot, checksum) followed by the registered step consumers in
+ * registration order. The commands stage applies, as one batch, everything
+ * other threads queued through getCommandQueue() since the previous step. The checksum stage only does
+ * work in checksum mode (see enableChecksums()). Every stage is timed; non-critical consumers such as logging or
+ * statistics flushes can be switched off when a step overruns its deadline (see PulseStepScheduler).
+ *
+ * Every stage except the simulation itself can run at a lower rate than the step (see setStageRate()):
+ * at 0.1 s steps, light states may only need syncing every 10 steps and statistics every 50. Stages
+ * given a period but no phase are spread over the phases other periodic stages use least, so their
+ * work is distributed across steps rather than landing on the same one.
  */
 class TrafficSystem
 {
 public:
+    /**
+     * @brief Callback run once per step after the simulation state was updated.
+     */
+    using StepConsumer = std::function<void(TrafficSystem& system)>;
+
     /**
      * @brief Retrieves the singleton instance of TrafficSystem.
      * @return Reference to the singleton TrafficSystem.
      */
     static TrafficSystem& getInstance();
 
+    /**
+     * @brief Creates an independent system that owns its simulation source and data manager.
+     * @param source The simulation driving this system.
+     * @throws std::invalid_argument if source is null
+     */
+    explicit TrafficSystem(std::unique_ptr<SimulationSource> source);
+
+    /**
+     * @brief Creates a system that feeds an externally owned data manager.
+     * @param source The simulation driving this system.
+     * @param data_manager Manager receiving the simulation state; must outlive the system.
+     * @throws std::invalid_argument if source is null
+     */
+    TrafficSystem(std::unique_ptr<SimulationSource> source, PulseDataManager& data_manager);
+
     /**
      * @brief Initializes the traffic simulation using SUMO.
      * This function starts SUMO and loads intersections, roads, and traffic lights.
@@ -42,16 +105,107 @@ public:
     void stopSimulation();
 
     /**
-     * @brief Retrieves the system-wide data manager.
+     * @brief Registers a callback that runs at the end of every step.
+     * @param name Stage name used in timings and reports.
+     * @param consumer The callback.
+     * @param critical Critical consumers always run; others may be skipped when degraded.
+     * @throws std::invalid_argument if consumer is empty
+     */
+    void addStepConsumer(const std::string& name, StepConsumer consumer, bool critical = false);
+
+    /**
+     * @brief Enables or disables non-critical step consumers.
+     * @param enabled False to skip non-critical consumers until re-enabled.
+     */
+    void setNonCriticalConsumersEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether non-critical consumers currently run.
+     */
+    [[nodiscard]] bool areNonCriticalConsumersEnabled() const;
+
+    /**
+     * @brief Runs a stage only every period steps.
+     * @param name Stage name, built-in or consumer (see getStageNames()).
+     * @param period Steps between runs; 1 runs the stage every step.
+     * @param phase Step offset in [0, period); if omitted, the phase shared with the fewest other
+     *        periodic stages is chosen, so that their runs fall on different steps.
+     * @throws std::invalid_argument if the stage is unknown, the period is 0, the phase is out of range,
+     *         or the stage is "simulation", which must run every step
+     */
+    void setStageRate(const std::string& name, std::uint32_t period, std::optional<std::uint32_t> phase = std::nullopt);
+
+    /**
+     * @brief Rates of all stages, indexed like getStageNames().
+     */
+    [[nodiscard]] const std::vector<PulseStageRate>& getStageRates() const;
+
+    /**
+     * @brief Names of all stages, built-in stages first, in execution order.
+     */
+    [[nodiscard]] const std::vector<std::string>& getStageNames() const;
+
+    /**
+     * @brief Timings of the last step, indexed like getStageNames().
+     */
+    [[nodiscard]] const std::vector<PulseStageTiming>& getStageTimings() const;
+
+    /**
+     * @brief Queue through which other threads send light overrides and plan changes.
+     *        Commands are applied at the start of the next step.
+     */
+    PulseCommandQueue& getCommandQueue();
+
+    /**
+     * @brief Number of queued commands applied so far.
+     */
+    [[nodiscard]] std::uint64_t getAppliedCommandCount() const;
+
+    /**
+     * @brief Number of queued commands the simulation rejected (unknown light, invalid state or plan,
+     *        plan changes the source does not support).
+     */
+    [[nodiscard]] std::uint64_t getRejectedCommandCount() const;
+
+    /**
+     * @brief Turns on checksum mode: after every step the whole data manager state is hashed and,
+     *        if a stream is given, written to it (see PulseChecksumRecorder for the format).
+     * @param stream Receives one line per step; may be null to only keep getLastChecksum().
+     *        Must stay valid until checksums are disabled.
+     */
+    void enableChecksums(std::ostream* stream = nullptr);
+
+    /**
+     * @brief Turns off checksum mode.
+     */
+    void disableChecksums();
+
+    /**
+     * @brief Checks whether checksum mode is on.
+     */
+    [[nodiscard]] bool areChecksumsEnabled() const;
+
+    /**
+     * @brief Checksum of the state after the last step run in checksum mode.
+     */
+    [[nodiscard]] const PulseStateChecksum& getLastChecksum() const;
+
+    /**
+     * @brief Number of steps run since construction.
+     */
+    [[nodiscard]] std::uint64_t getStepCount() const;
+
+    /**
+     * @brief Retrieves the data manager fed by this system.
      * @return Reference to the PulseDataManager.
      */
     PulseDataManager& getDataManager();
 
-private:
     /**
-     * @brief Private constructor for singleton pattern.
+     * @brief Retrieves the simulation source driving this system.
+     * @return Reference to the SimulationSource.
      */
-    TrafficSystem();
+    SimulationSource& getSimulationSource();
 
     /**
      * @brief Deleted copy constructor and assignment operator.
@@ -60,7 +214,38 @@ private:
     TrafficSystem& operator=(const TrafficSystem&) = delete;
 
 private:
-    std::unique_ptr<SumoIntegration> m_sumoIntegration; ///< SUMO integration handler.
+    struct Consumer
+    {
+        StepConsumer callback;
+        bool critical;
+    };
+
+    template <typename Stage>
+    void runStage(std::size_t index, Stage&& stage);
+
+    [[nodiscard]] bool isDue(std::size_t index, std::uint64_t step) const;
+
+    void applyCommands();
+
+private:
+    std::unique_ptr<SimulationSource> m_simulationSource; ///< Simulation handler (SUMO or a substitute).
+    std::unique_ptr<PulseDataManager> m_ownedDataManager; ///< Set when the system owns its manager.
+    PulseDataManager* m_dataManager;                      ///< Manager fed by this system.
+
+    std::vector<Consumer> m_consumers;                    ///< Registered step consumers.
+    std::vector<std::string> m_stageNames;                ///< Built-in stages followed by consumers.
+    std::vector<PulseStageTiming> m_stageTimings;         ///< Timings of the last step.
+    std::vector<PulseStageRate> m_stageRates;             ///< Period and phase of every stage.
+    bool m_nonCriticalEnabled = true;                     ///< Whether non-critical consumers run.
+
+    PulseCommandQueue m_commands;                         ///< Commands from other threads.
+    std::uint64_t m_appliedCommands = 0;
+    std::uint64_t m_rejectedCommands = 0;
+
+    std::uint64_t m_steps = 0;                            ///< Steps run so far.
+    bool m_checksumsEnabled = false;
+    std::ostream* m_checksumStream = nullptr;             ///< Optional destination of checksum lines.
+    PulseChecksumRecorder m_checksums;
 };
 
 #endif //TRAFFICSYSTEM_H
@@ -0,0 +1,44 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEENTITYTRAITS_H
+#define PULSEENTITYTRAITS_H
+
+#pragma once
+
+#include "entities/PulseIntersection.h"
+#include "entities/PulseTrafficLight.h"
+#include "entities/PulseVehicle.h"
+
+#include "types/PulseEntityType.h"
+
+/**
+ * @brief Maps an entity kind to its concrete class at compile time.
+ * @tparam Type The entity kind.
+ */
+template <PulseEntityType Type>
+struct PulseEntityTraits;
+
+template <>
+struct PulseEntityTraits<PulseEntityType::INTERSECTION> {
+    using type = PulseIntersection;
+};
+
+template <>
+struct PulseEntityTraits<PulseEntityType::TRAFFIC_LIGHT> {
+    using type = PulseTrafficLight;
+};
+
+template <>
+struct PulseEntityTraits<PulseEntityType::VEHICLE> {
+    using type = PulseVehicle;
+};
+
+/**
+ * @brief Concrete class of an entity kind, e.g. PulseEntityOf<PulseEntityType::VEHICLE> is PulseVehicle.
+ */
+template <PulseEntityType Type>
+using PulseEntityOf = typename PulseEntityTraits<Type>::type;
+
+#endif //PULSEENTITYTRAITS_H
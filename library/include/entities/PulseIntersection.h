@@ -11,6 +11,7 @@
 #include <unordered_map>
 
 #include "core/IntersectionStatistics.h"
+#include "core/PulseObjectPool.h"
 
 #include "entities/PulseEntity.h"
 #include "entities/PulseTrafficLight.h"
@@ -22,7 +23,7 @@
  * @class PulseIntersection
  * @brief Represents a traffic intersection in a graph-based model.
  */
-class PulseIntersection : public PulseEntity
+class PulseIntersection : public PulseEntity, public PulsePooled<PulseIntersection>
 {
 public:
     /**
@@ -36,7 +37,7 @@ public:
      * @brief Retrieves the intersection ID as int.
      * @return The unique identifier of the intersection as a string.
      */
-    [[nodiscard]] std::string getId() const override;
+    [[nodiscard]] const std::string& getId() const final;
 
     /**
      * @brief Retrieves the position of the intersection.
@@ -73,5 +74,16 @@ private:
     IntersectionStatistics m_statistics; ///< Stores traffic data for this intersection.
 };
 
+// Per-step accessors are defined inline so the update loops can inline them
+inline const std::string& PulseIntersection::getId() const
+{
+    return m_intersection_id;
+}
+
+inline PulsePosition PulseIntersection::getPosition() const
+{
+    return m_position;
+}
+
 
 #endif // PULSE_INTERSECTION_H
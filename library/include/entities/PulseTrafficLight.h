@@ -9,6 +9,7 @@
 
 #include <string>
 
+#include "core/PulseObjectPool.h"
 #include "entities/PulseEntity.h"
 #include "types/TrafficLightState.h"
 #include "types/TrafficLightDurations.h"
@@ -17,7 +18,7 @@
  * @class PulseTrafficLight
  * @brief Represents a traffic light in the simulation.
  */
-class PulseTrafficLight : public PulseEntity
+class PulseTrafficLight : public PulseEntity, public PulsePooled<PulseTrafficLight>
 {
 public:
     /**
@@ -31,7 +32,7 @@ public:
      * @brief Retrieves the traffic light ID.
      * @return The unique string identifier.
      */
-    [[nodiscard]] std::string getId() const;
+    [[nodiscard]] const std::string& getId() const final;
 
     /**
      * @brief Sets the current state of the traffic light.
@@ -63,4 +64,20 @@ private:
     TrafficLightDurations m_durations; ///< Durations for each state.
 };
 
+// Per-step accessors are defined inline so the update loops can inline them
+inline const std::string& PulseTrafficLight::getId() const
+{
+    return m_traffic_light_id;
+}
+
+inline void PulseTrafficLight::setState(TrafficLightState state)
+{
+    m_current_state = state;
+}
+
+inline TrafficLightState PulseTrafficLight::getState() const
+{
+    return m_current_state;
+}
+
 #endif // PULSE_TRAFFIC_LIGHT_H
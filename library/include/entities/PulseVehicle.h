@@ -7,18 +7,21 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "PulseEntity.h"
+#include "core/PulseObjectPool.h"
 #include "types/PulseVehicleType.h"
 #include "types/PulseVehicleRole.h"
 #include "types/PulsePosition.h"
+#include "types/PulseVehicleKinematics.h"
 
 /**
  * @class PulseVehicle
  * @brief Represents a vehicle moving through the traffic system.
  */
-class PulseVehicle: public PulseEntity
+class PulseVehicle: public PulseEntity, public PulsePooled<PulseVehicle>
 {
 public:
     /**
@@ -34,7 +37,7 @@ public:
      * @brief Retrieves the vehicle ID.
      * @return The unique string identifier.
      */
-    [[nodiscard]] std::string getId() const;
+    [[nodiscard]] const std::string& getId() const final;
 
     /**
      * @brief Retrieves the type of the vehicle.
@@ -60,12 +63,106 @@ public:
      */
     void updatePosition(const PulsePosition& new_position);
 
+    /**
+     * @brief Retrieves the vehicle's road, lane position and speed.
+     * @return The last reported kinematics; the road ID is empty until tracking reports one.
+     */
+    [[nodiscard]] const PulseVehicleKinematics& getKinematics() const;
+
+    /**
+     * @brief Updates the vehicle's road, lane position and speed, reusing the road ID buffer.
+     * @param kinematics The new kinematics.
+     */
+    void updateKinematics(const PulseVehicleKinematics& kinematics);
+
+    /**
+     * @brief Retrieves the simulation time at which the vehicle entered its current road.
+     * @return Time in seconds, or NaN if the vehicle was already on the road when first observed.
+     */
+    [[nodiscard]] double getRoadEntryTime() const;
+
+    /**
+     * @brief Sets the simulation time at which the vehicle entered its current road.
+     * @param time Time in seconds, or NaN if unknown.
+     */
+    void setRoadEntryTime(double time);
+
+    /**
+     * @brief Retrieves how many times this object has been recycled for another vehicle.
+     *
+     * PulseDataManager reuses the storage of departed vehicles, so a pointer kept across updates
+     * can end up referring to a different vehicle at the same address. Holders compare the
+     * generation they saw with the current one to detect that.
+     * @return 0 for a new object, incremented by every reset().
+     */
+    [[nodiscard]] std::uint32_t getGeneration() const;
+
+    /**
+     * @brief Re-initializes a departed vehicle in place so its storage can be recycled.
+     *        The ID buffer keeps its capacity, so reuse does not touch the heap.
+     *        Increments the generation, invalidating handles to the previous vehicle.
+     * @param vehicle_id New unique string identifier.
+     * @param type New vehicle type.
+     * @param role New vehicle role.
+     * @param position New position.
+     */
+    void reset(const std::string& vehicle_id, PulseVehicleType type, PulseVehicleRole role, const PulsePosition& position);
+
 private:
     std::string m_vehicle_id; ///< Unique identifier.
     PulseVehicleType m_type; ///< Type of vehicle.
     PulseVehicleRole m_role; ///< Role of vehicle.
     PulsePosition m_position; ///< Current position of the vehicle.
+    PulseVehicleKinematics m_kinematics; ///< Current road, lane position and speed.
+    double m_road_entry_time; ///< Simulation time the current road was entered, NaN if unknown.
+    std::uint32_t m_generation = 0; ///< Number of times the object was recycled.
 };
 
+// Per-step accessors are defined inline so the update loops can inline them
+inline const std::string& PulseVehicle::getId() const
+{
+    return m_vehicle_id;
+}
+
+inline PulseVehicleType PulseVehicle::getType() const
+{
+    return m_type;
+}
+
+inline PulseVehicleRole PulseVehicle::getRole() const
+{
+    return m_role;
+}
+
+inline PulsePosition PulseVehicle::getPosition() const
+{
+    return m_position;
+}
+
+inline void PulseVehicle::updatePosition(const PulsePosition& new_position)
+{
+    m_position = new_position;
+}
+
+inline const PulseVehicleKinematics& PulseVehicle::getKinematics() const
+{
+    return m_kinematics;
+}
+
+inline double PulseVehicle::getRoadEntryTime() const
+{
+    return m_road_entry_time;
+}
+
+inline void PulseVehicle::setRoadEntryTime(double time)
+{
+    m_road_entry_time = time;
+}
+
+inline std::uint32_t PulseVehicle::getGeneration() const
+{
+    return m_generation;
+}
+
 
 #endif //PULSEVEHICLE_H
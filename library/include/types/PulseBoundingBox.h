@@ -0,0 +1,28 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEBOUNDINGBOX_H
+#define PULSEBOUNDINGBOX_H
+
+#pragma once
+
+#include "types/PulsePosition.h"
+
+/**
+ * @brief Axis-aligned rectangle in network coordinates; the edges belong to the box.
+ */
+struct PulseBoundingBox {
+    PulsePosition min; ///< Corner with the smallest coordinates.
+    PulsePosition max; ///< Corner with the largest coordinates.
+
+    /**
+     * @brief Checks whether a position lies inside the box or on its edge.
+     */
+    [[nodiscard]] bool contains(const PulsePosition& position) const
+    {
+        return position.x >= min.x && position.x <= max.x && position.y >= min.y && position.y <= max.y;
+    }
+};
+
+#endif //PULSEBOUNDINGBOX_H
@@ -0,0 +1,19 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSECOLUMNTYPE_H
+#define PULSECOLUMNTYPE_H
+
+#pragma once
+
+/**
+ * @brief Enum of the value types of an exported column.
+ */
+enum class PulseColumnType {
+    INT64,      ///< Signed 64-bit integer.
+    DOUBLE,     ///< 64-bit floating point.
+    STRING,     ///< UTF-8 string, dictionary-encoded.
+};
+
+#endif //PULSECOLUMNTYPE_H
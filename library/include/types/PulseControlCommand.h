@@ -0,0 +1,48 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSECONTROLCOMMAND_H
+#define PULSECONTROLCOMMAND_H
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "types/PulseSignalPlan.h"
+
+/**
+ * @brief Kind of a command sent to the simulation from outside its thread.
+ */
+enum class PulseControlCommandType {
+    LIGHT_OVERRIDE, ///< Force a signal state string (manual override by a dispatcher).
+    PLAN_CHANGE,    ///< Replace the fixed-time plan of a light.
+};
+
+/**
+ * @brief Returns the snake_case name used for a command type in exported data.
+ */
+constexpr const char* toString(PulseControlCommandType type)
+{
+    switch (type) {
+        case PulseControlCommandType::LIGHT_OVERRIDE: return "light_override";
+        case PulseControlCommandType::PLAN_CHANGE: return "plan_change";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Command queued by an external thread and applied by the simulation at a step boundary.
+ */
+struct PulseControlCommand {
+    PulseControlCommandType type = PulseControlCommandType::LIGHT_OVERRIDE; ///< Command kind.
+    std::string traffic_light_id;                   ///< Target light.
+    std::string state;                              ///< Signal state string (LIGHT_OVERRIDE only).
+    PulseSignalPlan plan;                           ///< New plan (PLAN_CHANGE only); its ID equals traffic_light_id.
+    std::uint64_t sequence = 0;                     ///< Unique ticket assigned by the queue, starting at 1.
+    std::chrono::steady_clock::time_point issued_at;    ///< When the command was queued.
+};
+
+#endif //PULSECONTROLCOMMAND_H
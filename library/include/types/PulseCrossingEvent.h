@@ -0,0 +1,20 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSECROSSINGEVENT_H
+#define PULSECROSSINGEVENT_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief A pedestrian stepping onto a crossing of a junction.
+ */
+struct PulseCrossingEvent {
+    std::string junction_id;    ///< Junction the crossing belongs to.
+    double waiting_time;        ///< Seconds the pedestrian stood waiting before the crossing.
+};
+
+#endif //PULSECROSSINGEVENT_H
@@ -0,0 +1,30 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEDEMANDTRANSFORM_H
+#define PULSEDEMANDTRANSFORM_H
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+ * @brief How PulseScenarioTransformer derives a stress variant from a scenario's demand.
+ *
+ * A trip with multiplier m is written floor(m) times, plus once more with probability frac(m),
+ * so 2.5 doubles every trip and adds a third copy to half of them, and 0.3 keeps about 30%.
+ */
+struct PulseDemandTransform {
+    std::string name;                           ///< Variant name; output goes to "<timestamp>-<name>".
+    double scale = 1.0;                         ///< Demand multiplier for every vehicle class.
+    std::map<std::string, double> class_scales; ///< vClass -> multiplier replacing scale, e.g. {"truck", 3.0}.
+    double begin = 0.0;                         ///< Trips departing earlier are dropped; also the new simulation begin.
+    double end = -1.0;                          ///< Trips departing at or after it are dropped; -1 keeps the rest of the day.
+    double jitter = 0.0;                        ///< Departures move by up to this many seconds either way.
+    std::uint64_t seed = 0;                     ///< Copies and jitter are a pure function of seed and trip id.
+};
+
+#endif //PULSEDEMANDTRANSFORM_H
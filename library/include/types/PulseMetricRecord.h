@@ -0,0 +1,29 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEMETRICRECORD_H
+#define PULSEMETRICRECORD_H
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Metrics of one intersection over one interval, stored as-is in PulseMetricStore segments.
+ */
+struct PulseMetricRecord {
+    std::int64_t interval = 0;              ///< Start of the interval in simulation seconds.
+    std::uint32_t intersection = 0;         ///< Intersection handle (see PulseMetricStore::getHandle).
+    std::uint32_t vehicles = 0;             ///< Vehicles that passed during the interval.
+    double vehicle_waiting_time = 0.0;      ///< Total waiting time of those vehicles in seconds.
+    std::uint32_t pedestrians = 0;          ///< Pedestrians that passed during the interval.
+    std::uint32_t reserved = 0;             ///< Padding, always 0; keeps the on-disk layout explicit.
+    double pedestrian_waiting_time = 0.0;   ///< Total waiting time of those pedestrians in seconds.
+};
+
+static_assert(std::is_trivially_copyable_v<PulseMetricRecord> && sizeof(PulseMetricRecord) == 40,
+              "PulseMetricRecord is an on-disk format");
+
+#endif //PULSEMETRICRECORD_H
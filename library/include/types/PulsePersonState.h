@@ -0,0 +1,25 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPERSONSTATE_H
+#define PULSEPERSONSTATE_H
+
+#pragma once
+
+#include <string>
+
+#include "types/PulsePosition.h"
+
+/**
+ * @brief State of one person (pedestrian) as reported by a simulation source in a single step.
+ */
+struct PulsePersonState {
+    std::string id;                 ///< Person ID.
+    PulsePosition position;         ///< Position in network coordinates.
+    std::string road_id;            ///< Edge, walking area (":J_w0") or crossing (":J_c0") the person is on.
+    double speed = 0.0;             ///< Walking speed in m/s.
+    double waiting_time = 0.0;      ///< Seconds the person has been standing still, reset when it moves on.
+};
+
+#endif //PULSEPERSONSTATE_H
@@ -0,0 +1,54 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEPROFILESTAGE_H
+#define PULSEPROFILESTAGE_H
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Enum of the instrumented stages of a simulation step.
+ */
+enum class PulseProfileStage {
+    STEP,               ///< Whole TrafficSystem::stepSimulation call.
+    COMMANDS,           ///< Applying queued external commands.
+    SUMO_STEP,          ///< Advancing the simulation source (SUMO).
+    VEHICLE_SYNC,       ///< Reconciling vehicles with the simulation.
+    TRAFFIC_LIGHT_SYNC, ///< Reading traffic light states.
+    PEDESTRIAN_SYNC,    ///< Reconciling pedestrians and their crossing waits.
+    TRANSIT_SYNC,       ///< Reading public-transport schedules and lateness.
+    SNAPSHOT,           ///< Publishing the reader snapshot.
+    CHECKSUM,           ///< Hashing the state in checksum mode.
+    CONSUMERS,          ///< Step consumers (statistics, logging, controllers).
+    COUNT               ///< Number of stages, not a stage.
+};
+
+/**
+ * @brief Number of instrumented stages.
+ */
+constexpr std::size_t PULSE_PROFILE_STAGE_COUNT = static_cast<std::size_t>(PulseProfileStage::COUNT);
+
+/**
+ * @brief Returns the snake_case name used for a stage in exported metrics.
+ */
+constexpr const char* toString(PulseProfileStage stage)
+{
+    switch (stage) {
+        case PulseProfileStage::STEP: return "step";
+        case PulseProfileStage::COMMANDS: return "commands";
+        case PulseProfileStage::SUMO_STEP: return "sumo_step";
+        case PulseProfileStage::VEHICLE_SYNC: return "vehicle_sync";
+        case PulseProfileStage::TRAFFIC_LIGHT_SYNC: return "traffic_light_sync";
+        case PulseProfileStage::PEDESTRIAN_SYNC: return "pedestrian_sync";
+        case PulseProfileStage::TRANSIT_SYNC: return "transit_sync";
+        case PulseProfileStage::SNAPSHOT: return "snapshot";
+        case PulseProfileStage::CHECKSUM: return "checksum";
+        case PulseProfileStage::CONSUMERS: return "consumers";
+        default: return "unknown";
+    }
+}
+
+#endif //PULSEPROFILESTAGE_H
@@ -0,0 +1,21 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEROADBINDING_H
+#define PULSEROADBINDING_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Associates a road reported by the simulation source with a PulseRoadConnection.
+ */
+struct PulseRoadBinding {
+    std::string source_road_id;     ///< Road (SUMO edge) ID reported by the simulation source.
+    std::string intersection_id;    ///< Intersection the road connection starts at.
+    int road_id;                    ///< Road connection ID at that intersection.
+};
+
+#endif //PULSEROADBINDING_H
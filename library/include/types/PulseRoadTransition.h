@@ -0,0 +1,21 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEROADTRANSITION_H
+#define PULSEROADTRANSITION_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief A vehicle leaving a road it was observed entering, i.e. one complete traversal.
+ */
+struct PulseRoadTransition {
+    std::string road_id;    ///< Road that was left.
+    double entered_at;      ///< Simulation time in seconds when the vehicle entered the road.
+    double exited_at;       ///< Simulation time in seconds when the vehicle was first seen elsewhere.
+};
+
+#endif //PULSEROADTRANSITION_H
@@ -0,0 +1,33 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEROUTE_H
+#define PULSEROUTE_H
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief A traffic light passed along a route.
+ */
+struct PulseRouteSignal {
+    std::string traffic_light_id;   ///< Traffic light controlling the road.
+    std::string intersection_id;    ///< Intersection the road leads into.
+    double arrival_time;            ///< Seconds from departure until the signal is reached.
+};
+
+/**
+ * @brief Result of a PulseRouter query.
+ */
+struct PulseRoute {
+    std::vector<std::string> intersections; ///< Visited intersections, origin and destination included.
+    std::vector<int> roads;                 ///< Road IDs taken, one per hop.
+    std::vector<PulseRouteSignal> signals;  ///< Signals met along the route, in order.
+    double travel_time = 0.0;               ///< Expected travel time in seconds.
+    double distance = 0.0;                  ///< Route length in meters.
+};
+
+#endif //PULSEROUTE_H
@@ -0,0 +1,20 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEROUTINGALGORITHM_H
+#define PULSEROUTINGALGORITHM_H
+
+#pragma once
+
+/**
+ * @brief Enum to select the shortest-path algorithm used by PulseRouter.
+ */
+enum class PulseRoutingAlgorithm {
+    AUTO,                   ///< Contraction hierarchy when it is up to date, A* otherwise.
+    DIJKSTRA,               ///< Plain Dijkstra search.
+    A_STAR,                 ///< A* with a straight-line travel time heuristic.
+    CONTRACTION_HIERARCHY,  ///< Bidirectional search on the preprocessed hierarchy.
+};
+
+#endif //PULSEROUTINGALGORITHM_H
@@ -0,0 +1,39 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESCENARIODESCRIPTOR_H
+#define PULSESCENARIODESCRIPTOR_H
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parsed SUMO configuration of one city snapshot (<root>/<city>/<timestamp>/<name>.sumocfg).
+ *
+ * File paths are absolute, so a descriptor can start a simulation without further lookups.
+ */
+struct PulseScenarioDescriptor {
+    std::string name;                           ///< "<city>/<timestamp>", unique within a catalog.
+    std::string city;                           ///< City directory name.
+    std::string timestamp;                      ///< Snapshot directory name; sorts chronologically.
+    std::string config_path;                    ///< The .sumocfg file.
+    std::string net_file;                       ///< Road network.
+    std::vector<std::string> route_files;       ///< Demand (routes and trips).
+    std::vector<std::string> additional_files;  ///< Stops, polygons, detectors.
+    double begin = 0.0;                         ///< Simulation start time in seconds.
+    double end = -1.0;                          ///< Simulation end time in seconds; -1 if open-ended.
+    double step_length = 1.0;                   ///< Seconds per simulation step.
+    std::string variant_of;                     ///< Scenario a generated variant was derived from; empty for recorded snapshots.
+
+    std::int64_t config_modified = 0;           ///< Modification time of config_path, for cache validation.
+    std::uint64_t config_size = 0;              ///< Size of config_path in bytes, for cache validation.
+
+    bool valid = false;                         ///< True if the config parsed and every referenced file exists.
+    std::string error;                          ///< Why the scenario is invalid; empty if valid.
+};
+
+#endif //PULSESCENARIODESCRIPTOR_H
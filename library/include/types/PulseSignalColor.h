@@ -0,0 +1,43 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESIGNALCOLOR_H
+#define PULSESIGNALCOLOR_H
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Signal shown to one controlled link, one per character of a SUMO state string.
+ */
+enum class PulseSignalColor : std::uint8_t {
+    RED,            ///< 'r': stop.
+    RED_YELLOW,     ///< 'u': red and yellow, about to turn green.
+    YELLOW,         ///< 'y': stop if possible.
+    GREEN_MINOR,    ///< 'g': go, yielding to priority streams.
+    GREEN_MAJOR,    ///< 'G': go with priority.
+    GREEN_RIGHT,    ///< 's': right turn on red after stopping.
+    OFF_BLINKING,   ///< 'o': off, blinking yellow.
+    OFF             ///< 'O': off, no signal.
+};
+
+/**
+ * @brief Returns the SUMO state character of a signal color.
+ */
+constexpr char toStateChar(PulseSignalColor color)
+{
+    switch (color) {
+        case PulseSignalColor::RED: return 'r';
+        case PulseSignalColor::RED_YELLOW: return 'u';
+        case PulseSignalColor::YELLOW: return 'y';
+        case PulseSignalColor::GREEN_MINOR: return 'g';
+        case PulseSignalColor::GREEN_MAJOR: return 'G';
+        case PulseSignalColor::GREEN_RIGHT: return 's';
+        case PulseSignalColor::OFF_BLINKING: return 'o';
+        default: return 'O';
+    }
+}
+
+#endif //PULSESIGNALCOLOR_H
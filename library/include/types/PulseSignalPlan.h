@@ -0,0 +1,23 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESIGNALPLAN_H
+#define PULSESIGNALPLAN_H
+
+#pragma once
+
+#include <string>
+
+#include "types/TrafficLightDurations.h"
+
+/**
+ * @brief Fixed-time plan of one traffic light: its phase durations and the start of its first green.
+ */
+struct PulseSignalPlan {
+    std::string traffic_light_id;       ///< Light the plan applies to.
+    TrafficLightDurations durations;    ///< Phase durations in seconds.
+    double offset = 0.0;                ///< Seconds into the simulation at which the first green starts.
+};
+
+#endif //PULSESIGNALPLAN_H
@@ -0,0 +1,41 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESIGNALPROGRAM_H
+#define PULSESIGNALPROGRAM_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One phase of a signal program.
+ */
+struct PulseSignalPhase {
+    std::string state;      ///< One SUMO state character per signal, e.g. "GGrryy".
+    double duration = 0.0;  ///< Seconds the phase lasts.
+};
+
+/**
+ * @brief A lane pair whose movement is governed by one signal of a traffic light.
+ */
+struct PulseControlledLink {
+    std::size_t signal = 0;     ///< Index into the phase state strings.
+    std::string from_lane;      ///< Incoming lane.
+    std::string to_lane;        ///< Outgoing lane.
+};
+
+/**
+ * @brief Signal program of one traffic light as reported by a simulation source.
+ */
+struct PulseSignalProgram {
+    std::vector<PulseSignalPhase> phases;   ///< Phases in cycle order.
+    std::vector<PulseControlledLink> links; ///< Controlled lane pairs; several may share a signal.
+    std::size_t current_phase = 0;          ///< Phase running now.
+    double time_to_switch = 0.0;            ///< Seconds until the current phase ends; 0 starts it in full.
+};
+
+#endif //PULSESIGNALPROGRAM_H
@@ -0,0 +1,25 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTATECHECKSUM_H
+#define PULSESTATECHECKSUM_H
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Hashes of the data manager state after one step; equal checksums mean bit-identical state.
+ */
+struct PulseStateChecksum {
+    std::uint64_t step = 0;             ///< Step the state was taken after.
+    std::uint64_t state = 0;            ///< Combination of the hashes below.
+    std::uint64_t vehicles = 0;         ///< IDs, types, roles, positions and kinematics of all vehicles.
+    std::uint64_t traffic_lights = 0;   ///< IDs, states and durations of all traffic lights.
+    std::uint64_t statistics = 0;       ///< Cumulative statistics of all intersections.
+
+    bool operator==(const PulseStateChecksum&) const = default;
+};
+
+#endif //PULSESTATECHECKSUM_H
@@ -0,0 +1,64 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTATESNAPSHOT_H
+#define PULSESTATESNAPSHOT_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "types/PulsePosition.h"
+#include "types/PulseVehicleRole.h"
+#include "types/PulseVehicleType.h"
+#include "types/TrafficLightState.h"
+
+/**
+ * @brief Immutable copy of the simulation state published once per step.
+ *
+ * Snapshots are plain values, so reader threads can walk them freely while the
+ * simulation thread keeps mutating PulseDataManager.
+ */
+struct PulseStateSnapshot {
+    /**
+     * @brief State of a single vehicle.
+     */
+    struct VehicleRecord {
+        std::string id;             ///< Vehicle ID.
+        PulseVehicleType type;      ///< Vehicle type.
+        PulseVehicleRole role;      ///< Vehicle role.
+        PulsePosition position;     ///< Position at the end of the step.
+    };
+
+    /**
+     * @brief State of a single traffic light.
+     */
+    struct TrafficLightRecord {
+        std::string id;             ///< Traffic light ID.
+        TrafficLightState state;    ///< Current state.
+    };
+
+    /**
+     * @brief Cumulative statistics of a single intersection.
+     */
+    struct IntersectionRecord {
+        std::string id;                     ///< Intersection ID.
+        std::size_t vehicles_passed;        ///< Total vehicles passed.
+        double vehicle_waiting_time;        ///< Total vehicle waiting time (s).
+        std::size_t pedestrians_passed;     ///< Total pedestrians passed.
+        double pedestrian_waiting_time;     ///< Total pedestrian waiting time (s).
+    };
+
+    std::uint64_t epoch = 0;    ///< Publication epoch, strictly increasing.
+    std::uint64_t step = 0;     ///< Data manager update counter the snapshot was taken at.
+
+    std::vector<VehicleRecord> vehicles;             ///< All vehicles.
+    std::vector<TrafficLightRecord> traffic_lights;  ///< All traffic lights.
+    std::vector<IntersectionRecord> intersections;   ///< All intersections.
+};
+
+#endif //PULSESTATESNAPSHOT_H
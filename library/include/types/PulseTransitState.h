@@ -0,0 +1,26 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRANSITSTATE_H
+#define PULSETRANSITSTATE_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Schedule position of one public-transport vehicle as reported by a simulation source in a single step.
+ */
+struct PulseTransitState {
+    std::string line;                   ///< Line the vehicle serves, e.g. "12".
+    std::string next_stop_id;           ///< Stop the vehicle is at or heading to; empty after its last stop.
+    double next_stop_until = -1.0;      ///< Scheduled departure from the next stop; negative if unscheduled.
+    bool at_stop = false;               ///< Whether the vehicle is halted at the next stop.
+    std::string next_traffic_light_id;  ///< Next traffic light on the route; empty if none.
+    char next_signal_state = 'r';       ///< SUMO state character the vehicle sees at that light.
+    double next_traffic_light_distance = 0.0;   ///< Meters to that light's stop line.
+    double speed = 0.0;                 ///< Current speed in m/s.
+};
+
+#endif //PULSETRANSITSTATE_H
@@ -0,0 +1,22 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRANSITSTOPEVENT_H
+#define PULSETRANSITSTOPEVENT_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief A public-transport vehicle leaving a scheduled stop.
+ */
+struct PulseTransitStopEvent {
+    std::string vehicle_id;     ///< The vehicle.
+    std::string line;           ///< Line the vehicle serves.
+    std::string stop_id;        ///< Stop it left.
+    double lateness;            ///< Seconds past the scheduled departure; negative if early.
+};
+
+#endif //PULSETRANSITSTOPEVENT_H
@@ -0,0 +1,53 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSETRIPRECORD_H
+#define PULSETRIPRECORD_H
+
+#pragma once
+
+#include <string_view>
+
+/**
+ * @brief Demand element of a SUMO route or trip file.
+ */
+enum class PulseTripKind {
+    TRIP,       ///< <trip>: origin and destination edges, routed by SUMO.
+    VEHICLE,    ///< <vehicle>: explicit route.
+    FLOW,       ///< <flow>: repeated departures starting at "begin".
+    PERSON,     ///< <person>: walks, rides and stops.
+};
+
+/**
+ * @brief Returns the snake_case name used for a trip kind in exported data.
+ */
+constexpr const char* toString(PulseTripKind kind)
+{
+    switch (kind) {
+        case PulseTripKind::TRIP: return "trip";
+        case PulseTripKind::VEHICLE: return "vehicle";
+        case PulseTripKind::FLOW: return "flow";
+        case PulseTripKind::PERSON: return "person";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief One demand element of a parsed PulseDemandFile.
+ *
+ * Every view points into the file's buffer and is valid as long as the file object lives.
+ * Attribute values are raw: XML entities are not decoded.
+ */
+struct PulseTripRecord {
+    std::string_view id;            ///< Element id.
+    std::string_view type;          ///< vType id; empty for SUMO's default type.
+    std::string_view vclass;        ///< vClass of the type; "passenger" (or "pedestrian" for persons) by default.
+    std::string_view from;          ///< Origin edge: "from", or the first edge of the route or first walk/ride.
+    std::string_view to;            ///< Destination edge: "to", or the last edge of the route or last walk/ride.
+    std::string_view element;       ///< The whole element including children, written back verbatim.
+    double depart = -1.0;           ///< Departure ("begin" for flows) in seconds; -1 for non-numeric values like "triggered".
+    PulseTripKind kind = PulseTripKind::TRIP;   ///< Element kind.
+};
+
+#endif //PULSETRIPRECORD_H
@@ -0,0 +1,23 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEVEHICLEKINEMATICS_H
+#define PULSEVEHICLEKINEMATICS_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Where a vehicle is on the road network and how fast it moves.
+ */
+struct PulseVehicleKinematics {
+    std::string road_id;        ///< Road (SUMO edge) the vehicle is on; empty if unknown.
+    int lane_index = 0;         ///< Lane index on the road, 0 being the rightmost lane.
+    double lane_position = 0.0; ///< Distance in meters from the start of the lane.
+    double speed = 0.0;         ///< Speed in m/s.
+    double lane_length = 0.0;   ///< Length in meters of the lane the vehicle is on; 0 if unknown.
+};
+
+#endif //PULSEVEHICLEKINEMATICS_H
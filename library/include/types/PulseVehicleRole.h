@@ -15,5 +15,17 @@ enum class PulseVehicleRole {
     EMERGENCY,  ///< Emergency vehicle.
 };
 
+/**
+ * @brief Returns the snake_case name used for a role in exported data.
+ */
+constexpr const char* toString(PulseVehicleRole role)
+{
+    switch (role) {
+        case PulseVehicleRole::NORMAL: return "normal";
+        case PulseVehicleRole::EMERGENCY: return "emergency";
+        default: return "unknown";
+    }
+}
+
 
 #endif //PULSEVEHICLEROLE_H
@@ -21,4 +21,22 @@ enum class PulseVehicleType {
     PEDESTRIAN, ///< Pedestrian.
 };
 
+/**
+ * @brief Returns the snake_case name used for a vehicle type in exported data.
+ */
+constexpr const char* toString(PulseVehicleType type)
+{
+    switch (type) {
+        case PulseVehicleType::CAR: return "car";
+        case PulseVehicleType::BUS: return "bus";
+        case PulseVehicleType::MOTORCYCLE: return "motorcycle";
+        case PulseVehicleType::TRUCK: return "truck";
+        case PulseVehicleType::TRAM: return "tram";
+        case PulseVehicleType::E_SCOOTER: return "e_scooter";
+        case PulseVehicleType::BICYCLE: return "bicycle";
+        case PulseVehicleType::PEDESTRIAN: return "pedestrian";
+        default: return "unknown";
+    }
+}
+
 #endif //PULSEVEHICLETYPE_H
@@ -0,0 +1,18 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSEWIREFORMAT_H
+#define PULSEWIREFORMAT_H
+
+#pragma once
+
+/**
+ * @brief Encoding of state sent to live monitoring clients.
+ */
+enum class PulseWireFormat {
+    JSON,   ///< UTF-8 JSON text.
+    BINARY, ///< Compact little-endian records (see PulseStateEncoder).
+};
+
+#endif //PULSEWIREFORMAT_H
@@ -19,4 +19,19 @@ enum class TrafficLightState {
     DONT_WALK   ///< Pedestrian don't walk signal.
 };
 
+/**
+ * @brief Returns the snake_case name used for a state in exported data.
+ */
+constexpr const char* toString(TrafficLightState state)
+{
+    switch (state) {
+        case TrafficLightState::RED: return "red";
+        case TrafficLightState::YELLOW: return "yellow";
+        case TrafficLightState::GREEN: return "green";
+        case TrafficLightState::WALK: return "walk";
+        case TrafficLightState::DONT_WALK: return "dont_walk";
+        default: return "unknown";
+    }
+}
+
 #endif //TRAFFICLIGHTSTATE_H
@@ -0,0 +1,33 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef PULSESTRINGHASH_H
+#define PULSESTRINGHASH_H
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+/**
+ * @brief Transparent hash for string-keyed maps: lookups by std::string, std::string_view or a
+ *        literal hash the characters directly, so no temporary key (pooled or not) is built.
+ */
+struct PulseStringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
+
+/**
+ * @brief Transparent equality to pair with PulseStringHash.
+ */
+struct PulseStringEqual {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const { return lhs == rhs; }
+};
+
+#endif //PULSESTRINGHASH_H
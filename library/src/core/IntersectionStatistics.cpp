@@ -59,3 +59,11 @@ double IntersectionStatistics::getAveragePedestrianWaitingTime() const
 {
     return (m_total_pedestrians_passed == 0) ? 0.0 : (m_total_pedestrian_waiting / static_cast<double>(m_total_pedestrians_passed));
 }
+
+void IntersectionStatistics::merge(const IntersectionStatistics& other)
+{
+    m_total_vehicles_passed += other.m_total_vehicles_passed;
+    m_total_vehicle_waiting += other.m_total_vehicle_waiting;
+    m_total_pedestrians_passed += other.m_total_pedestrians_passed;
+    m_total_pedestrian_waiting += other.m_total_pedestrian_waiting;
+}
@@ -0,0 +1,162 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseChecksumRecorder.h"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+    template <typename T>
+    void append(std::string& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void appendString(std::string& out, std::string_view value)
+    {
+        append(out, static_cast<std::uint64_t>(value.size()));
+        out.append(value);
+    }
+
+    void appendHex(std::string& out, std::uint64_t value)
+    {
+        char digits[16];
+        const auto end = std::to_chars(digits, digits + sizeof(digits), value, 16).ptr;
+        out.append(16 - static_cast<std::size_t>(end - digits), '0');
+        out.append(digits, end);
+    }
+}
+
+template <typename Range, typename Serialize>
+std::uint64_t PulseChecksumRecorder::hashUnordered(Range&& entities, Serialize&& serialize)
+{
+    // Sum of per-entity hashes: independent of iteration order without sorting, and unlike xor a
+    // repeated record does not cancel out
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    for (auto& entity : entities) {
+        m_record.clear();
+        appendString(m_record, entity.getId());
+        serialize(m_record, entity);
+        sum += PulseStateHasher::hash(m_record.data(), m_record.size());
+        ++count;
+    }
+
+    m_hasher.reset();
+    m_hasher.updateValue(count);
+    m_hasher.updateValue(sum);
+    return m_hasher.digest();
+}
+
+const PulseStateChecksum& PulseChecksumRecorder::compute(const PulseDataManager& manager, std::uint64_t step)
+{
+    m_last.step = step;
+
+    m_last.vehicles = hashUnordered(manager.viewVehicles(), [](std::string& out, const PulseVehicle& vehicle) {
+        append(out, vehicle.getType());
+        append(out, vehicle.getRole());
+        const auto position = vehicle.getPosition();
+        append(out, position.x);
+        append(out, position.y);
+        const auto& kinematics = vehicle.getKinematics();
+        appendString(out, kinematics.road_id);
+        append(out, kinematics.lane_index);
+        append(out, kinematics.lane_position);
+        append(out, kinematics.speed);
+    });
+
+    m_last.traffic_lights = hashUnordered(manager.viewTrafficLights(), [](std::string& out, const PulseTrafficLight& traffic_light) {
+        append(out, traffic_light.getState());
+        const auto durations = traffic_light.getDurations();
+        append(out, durations.red);
+        append(out, durations.yellow);
+        append(out, durations.green);
+        append(out, durations.walk);
+        append(out, durations.dont_walk);
+    });
+
+    m_last.statistics = hashUnordered(manager.viewIntersections(), [](std::string& out, PulseIntersection& intersection) {
+        const auto& statistics = intersection.getStatistics();
+        append(out, static_cast<std::uint64_t>(statistics.getTotalVehiclesPassed()));
+        append(out, statistics.getTotalVehicleWaitingTime());
+        append(out, static_cast<std::uint64_t>(statistics.getTotalPedestriansPassed()));
+        append(out, statistics.getTotalPedestrianWaitingTime());
+    });
+
+    const std::uint64_t parts[] = {m_last.step, m_last.vehicles, m_last.traffic_lights, m_last.statistics};
+    m_last.state = PulseStateHasher::hash(parts, sizeof(parts));
+    return m_last;
+}
+
+const PulseStateChecksum& PulseChecksumRecorder::getLast() const
+{
+    return m_last;
+}
+
+void PulseChecksumRecorder::write(std::ostream& out, const PulseStateChecksum& checksum)
+{
+    std::string line = std::to_string(checksum.step);
+    for (const std::uint64_t hash : {checksum.state, checksum.vehicles, checksum.traffic_lights, checksum.statistics}) {
+        line.push_back(' ');
+        appendHex(line, hash);
+    }
+    line.push_back('\n');
+    out << line;
+}
+
+bool PulseChecksumRecorder::read(std::istream& in, PulseStateChecksum& out)
+{
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        const char* position = line.data();
+        const char* const end = line.data() + line.size();
+        const auto parse = [&](std::uint64_t& value, int base) {
+            while (position != end && *position == ' ') {
+                ++position;
+            }
+            const auto result = std::from_chars(position, end, value, base);
+            if (result.ec != std::errc{}) {
+                throw std::runtime_error("Malformed checksum line: " + line);
+            }
+            position = result.ptr;
+        };
+
+        parse(out.step, 10);
+        parse(out.state, 16);
+        parse(out.vehicles, 16);
+        parse(out.traffic_lights, 16);
+        parse(out.statistics, 16);
+        return true;
+    }
+    return false;
+}
+
+std::optional<std::uint64_t> PulseChecksumRecorder::findFirstDivergence(std::istream& expected, std::istream& actual)
+{
+    PulseStateChecksum a;
+    PulseStateChecksum b;
+    while (true) {
+        const bool has_a = read(expected, a);
+        const bool has_b = read(actual, b);
+        if (!has_a && !has_b) {
+            return std::nullopt;
+        }
+        if (has_a != has_b) {
+            return has_a ? a.step : b.step;
+        }
+        if (a != b) {
+            return std::min(a.step, b.step);
+        }
+    }
+}
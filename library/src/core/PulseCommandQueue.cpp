@@ -0,0 +1,115 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseCommandQueue.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+PulseCommandQueue::~PulseCommandQueue()
+{
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+std::uint64_t PulseCommandQueue::overrideLight(const std::string& traffic_light_id, const std::string& state)
+{
+    if (state.empty()) {
+        throw std::invalid_argument("Cannot override traffic light " + traffic_light_id + " with an empty state.");
+    }
+
+    PulseControlCommand command;
+    command.type = PulseControlCommandType::LIGHT_OVERRIDE;
+    command.traffic_light_id = traffic_light_id;
+    command.state = state;
+    return push(std::move(command));
+}
+
+std::uint64_t PulseCommandQueue::changePlan(const PulseSignalPlan& plan)
+{
+    PulseControlCommand command;
+    command.type = PulseControlCommandType::PLAN_CHANGE;
+    command.traffic_light_id = plan.traffic_light_id;
+    command.plan = plan;
+    return push(std::move(command));
+}
+
+std::uint64_t PulseCommandQueue::push(PulseControlCommand command)
+{
+    if (command.traffic_light_id.empty()) {
+        throw std::invalid_argument("Cannot queue a command without a traffic light ID.");
+    }
+
+    command.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+    command.issued_at = std::chrono::steady_clock::now();
+    const std::uint64_t sequence = command.sequence;
+
+    auto* node = new Node{std::move(command), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return sequence;
+}
+
+const std::vector<PulseControlCommand>& PulseCommandQueue::drain()
+{
+    m_batch.clear();
+    m_pending.clear();
+
+    for (Node* node = m_head.exchange(nullptr, std::memory_order_acquire); node; node = node->next) {
+        m_pending.push_back(node);
+    }
+    if (m_pending.empty()) {
+        return m_batch;
+    }
+
+    // Highest sequence first: the first command seen for a light and type is the one that wins,
+    // unless a newer one for it was already handed out by an earlier drain
+    std::sort(m_pending.begin(), m_pending.end(), [](const Node* a, const Node* b) {
+        return a->command.sequence > b->command.sequence;
+    });
+
+    std::uint64_t coalesced = 0;
+    for (auto& node : m_pending) {
+        auto& latest = m_latest[static_cast<std::size_t>(node->command.type)];
+        auto [it, inserted] = latest.try_emplace(node->command.traffic_light_id, node->command.sequence);
+        if (!inserted) {
+            if (it->second >= node->command.sequence) {
+                delete node;
+                node = nullptr;
+                ++coalesced;
+                continue;
+            }
+            it->second = node->command.sequence;
+        }
+    }
+
+    for (auto it = m_pending.rbegin(); it != m_pending.rend(); ++it) {
+        if (*it) {
+            m_batch.push_back(std::move((*it)->command));
+            delete *it;
+        }
+    }
+
+    m_coalesced.fetch_add(coalesced, std::memory_order_relaxed);
+    return m_batch;
+}
+
+bool PulseCommandQueue::empty() const
+{
+    return m_head.load(std::memory_order_acquire) == nullptr;
+}
+
+std::uint64_t PulseCommandQueue::getIssuedCount() const
+{
+    return m_sequence.load(std::memory_order_relaxed);
+}
+
+std::uint64_t PulseCommandQueue::getCoalescedCount() const
+{
+    return m_coalesced.load(std::memory_order_relaxed);
+}
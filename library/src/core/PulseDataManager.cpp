@@ -2,10 +2,12 @@
 // Created by andrii on 2/25/25.
 //
 
+#include <cmath>
+#include <limits>
 #include <stdexcept>
-#include <unordered_set>
 
 #include "core/PulseDataManager.h"
+#include "core/PulseProfiler.h"
 
 PulseDataManager& PulseDataManager::getInstance()
 {
@@ -24,6 +26,7 @@ void PulseDataManager::addIntersection(std::unique_ptr<PulseIntersection> inters
         throw std::runtime_error("Intersection with this ID already exists: " + id);
     }
     m_intersections[id] = std::move(intersection);
+    ++m_intersection_layout;
 }
 
 PulseIntersection* PulseDataManager::getIntersection(const std::string& intersection_id) const
@@ -42,13 +45,14 @@ void PulseDataManager::addTrafficLight(std::unique_ptr<PulseTrafficLight> traffi
     if (m_traffic_lights.contains(id)) {
         throw std::runtime_error("Traffic light with this ID already exists: " + id);
     }
-    m_traffic_lights[id] = std::move(traffic_light);
+    m_traffic_lights.try_emplace(std::pmr::string(id, &m_node_resource), Entry<PulseTrafficLight>{std::move(traffic_light), m_update_counter});
+    ++m_traffic_light_layout;
 }
 
 PulseTrafficLight* PulseDataManager::getTrafficLight(const std::string& traffic_light_id) const
 {
     auto it = m_traffic_lights.find(traffic_light_id);
-    return (it != m_traffic_lights.end()) ? it->second.get() : nullptr;
+    return (it != m_traffic_lights.end()) ? it->second.entity.get() : nullptr;
 }
 
 void PulseDataManager::addVehicle(std::unique_ptr<PulseVehicle> vehicle)
@@ -61,13 +65,16 @@ void PulseDataManager::addVehicle(std::unique_ptr<PulseVehicle> vehicle)
     if (m_vehicles.contains(id)) {
         throw std::runtime_error("Vehicle with this ID already exists: " + id);
     }
-    m_vehicles[id] = std::move(vehicle);
+    if (PulseTransitTable::isTransit(vehicle->getType())) {
+        m_transit.add(id);
+    }
+    insertVehicle(id, std::move(vehicle), m_update_counter);
 }
 
 PulseVehicle* PulseDataManager::getVehicle(const std::string& vehicle_id) const
 {
     auto it = m_vehicles.find(vehicle_id);
-    return (it != m_vehicles.end()) ? it->second.get() : nullptr;
+    return (it != m_vehicles.end()) ? it->second.entity.get() : nullptr;
 }
 
 std::vector<PulseIntersection*> PulseDataManager::getAllIntersections() const
@@ -84,8 +91,8 @@ std::vector<PulseTrafficLight*> PulseDataManager::getAllTrafficLights() const
 {
     std::vector<PulseTrafficLight*> results;
     results.reserve(m_traffic_lights.size());
-    for (const auto& [id, light] : m_traffic_lights) {
-        results.push_back(light.get());
+    for (const auto& [id, entry] : m_traffic_lights) {
+        results.push_back(entry.entity.get());
     }
     return results;
 }
@@ -94,8 +101,8 @@ std::vector<PulseVehicle*> PulseDataManager::getAllVehicles() const
 {
     std::vector<PulseVehicle*> results;
     results.reserve(m_vehicles.size());
-    for (const auto& [id, vehicle] : m_vehicles) {
-        results.push_back(vehicle.get());
+    for (const auto& [id, entry] : m_vehicles) {
+        results.push_back(entry.entity.get());
     }
     return results;
 }
@@ -105,9 +112,16 @@ void PulseDataManager::clearAll()
     m_intersections.clear();
     m_traffic_lights.clear();
     m_vehicles.clear();
+    m_retired_vehicles.clear();
+    m_vehicle_slots.clear();
+    ++m_traffic_light_layout;
+    ++m_intersection_layout;
+    m_road_transition_count = 0;
+    m_pedestrians.clear();
+    m_transit.clear();
 }
 
-void PulseDataManager::syncFromSumo(const SumoIntegration &sumo)
+void PulseDataManager::syncFromSumo(const SimulationSource &sumo)
 {
     // First-time load or re-sync: clear old data
     clearAll();
@@ -131,7 +145,7 @@ void PulseDataManager::syncFromSumo(const SumoIntegration &sumo)
         auto [x, y] = sumo.getVehiclePosition(veh_id);
         auto newVehicle = std::make_unique<PulseVehicle>(
             veh_id,
-            PulseVehicleType::CAR,       // could refine from SUMO data if desired
+            sumo.getVehicleType(veh_id),
             PulseVehicleRole::NORMAL,    // likewise
             PulsePosition{x, y}
         );
@@ -139,80 +153,285 @@ void PulseDataManager::syncFromSumo(const SumoIntegration &sumo)
     }
 }
 
-void PulseDataManager::updateFromSumo(const SumoIntegration &sumo)
+void PulseDataManager::updateFromSumo(const SimulationSource &sumo)
 {
+    beginUpdate();
+
     // --- Vehicles ---
-    auto sumoVehicleIDs = sumo.getAllVehicles();
-    std::unordered_set<std::string> sumoVehSet(sumoVehicleIDs.begin(), sumoVehicleIDs.end());
-
-    // Remove local vehicles not in SUMO
-    std::vector<std::string> toRemoveVeh;
-    for (const auto& [id, vehPtr] : m_vehicles) {
-        if (!sumoVehSet.count(id)) {
-            toRemoveVeh.push_back(id);
+    syncVehicles(sumo);
+
+    // --- Traffic Lights ---
+    syncTrafficLights(sumo);
+
+    // --- Pedestrians ---
+    syncPedestrians(sumo);
+
+    // --- Public transport ---
+    syncTransit(sumo);
+
+    // Intersections: if mostly static, skip or do the same approach. Typically they don't vanish or appear dynamically.
+}
+
+void PulseDataManager::beginUpdate()
+{
+    ++m_update_counter;
+    // Transitions belong to one pass, also when that pass does not sync vehicles
+    m_road_transition_count = 0;
+}
+
+void PulseDataManager::syncVehicles(const SimulationSource &sumo)
+{
+    updateVehicles(sumo, m_update_counter);
+    PULSE_PROFILE_ENTITIES(m_vehicles.size(), m_traffic_lights.size(), m_intersections.size());
+}
+
+void PulseDataManager::syncTrafficLights(const SimulationSource &sumo)
+{
+    updateTrafficLights(sumo, m_update_counter);
+}
+
+void PulseDataManager::syncPedestrians(const SimulationSource &sumo)
+{
+    updatePedestrians(sumo, m_update_counter);
+}
+
+void PulseDataManager::syncTransit(const SimulationSource &sumo)
+{
+    updateTransit(sumo);
+}
+
+void PulseDataManager::updateVehicles(const SimulationSource &sumo, std::uint64_t update)
+{
+    sumo.fillVehicleIds(m_vehicle_id_buffer);
+
+    const double now = m_track_kinematics ? sumo.getSimulationTime() : 0.0;
+
+    // Add new vehicles from SUMO and update positions of existing ones
+    for (const auto& veh_id : m_vehicle_id_buffer) {
+        auto [x, y] = sumo.getVehiclePosition(veh_id);
+        const PulsePosition position{x, y};
+
+        auto it = m_vehicles.find(veh_id);
+        Entry<PulseVehicle>* entry;
+        if (it == m_vehicles.end()) {
+            const PulseVehicleType type = sumo.getVehicleType(veh_id);
+            std::unique_ptr<PulseVehicle> vehicle;
+            if (!m_retired_vehicles.empty()) {
+                // Recycle a departed vehicle in place instead of allocating a new one
+                vehicle = std::move(m_retired_vehicles.back());
+                m_retired_vehicles.pop_back();
+                vehicle->reset(veh_id, type, PulseVehicleRole::NORMAL, position);
+            }
+            else {
+                vehicle = std::make_unique<PulseVehicle>(veh_id, type, PulseVehicleRole::NORMAL, position);
+            }
+            if (PulseTransitTable::isTransit(type)) {
+                m_transit.add(veh_id);
+            }
+            entry = &insertVehicle(veh_id, std::move(vehicle), update);
         }
-    }
-    for (const auto& id : toRemoveVeh) {
-        m_vehicles.erase(id);
-    }
-
-    // Add new vehicles from SUMO
-    for (const auto& veh_id : sumoVehicleIDs) {
-        if (!m_vehicles.count(veh_id)) {
-            auto [x, y] = sumo.getVehiclePosition(veh_id);
-            auto newVeh = std::make_unique<PulseVehicle>(
-                veh_id,
-                PulseVehicleType::CAR,
-                PulseVehicleRole::NORMAL,
-                PulsePosition{x, y}
-            );
-            m_vehicles[veh_id] = std::move(newVeh);
+        else {
+            entry = &it->second;
+            entry->entity->updatePosition(position);
         }
-    }
+        entry->last_seen_update = update;
 
-    // Update positions of existing vehicles
-    for (auto& [id, vehPtr] : m_vehicles) {
-        auto [x, y] = sumo.getVehiclePosition(id);
-        vehPtr->updatePosition(PulsePosition{x, y});
+        if (m_track_kinematics && sumo.fillVehicleKinematics(veh_id, m_kinematics_buffer)) {
+            updateKinematics(*entry->entity, now);
+        }
     }
 
-    // --- Traffic Lights ---
-    auto tlIDs = sumo.getAllTrafficLights();
-    std::unordered_set<std::string> sumoTlSet(tlIDs.begin(), tlIDs.end());
+    // Remove local vehicles not in SUMO, parking them for reuse
+    for (auto it = m_vehicles.begin(); it != m_vehicles.end();) {
+        if (it->second.last_seen_update != update) {
+            if (PulseTransitTable::isTransit(it->second.entity->getType())) {
+                m_transit.remove(it->first);
+            }
+            // The last slot moves into the freed one, so the other vehicles keep their records
+            const std::size_t slot = it->second.slot;
+            m_vehicle_slots[slot] = m_vehicle_slots.back();
+            m_vehicle_slots[slot]->slot = slot;
+            m_vehicle_slots.pop_back();
 
-    // Remove local TLs not in SUMO
-    std::vector<std::string> toRemoveTL;
-    for (const auto& [id, tlPtr] : m_traffic_lights) {
-        if (!sumoTlSet.count(id)) {
-            toRemoveTL.push_back(id);
+            m_retired_vehicles.push_back(std::move(it->second.entity));
+            it = m_vehicles.erase(it);
+        }
+        else {
+            ++it;
         }
     }
-    for (const auto& id : toRemoveTL) {
-        m_traffic_lights.erase(id);
+}
+
+void PulseDataManager::updateKinematics(PulseVehicle &vehicle, double now)
+{
+    const auto& current = vehicle.getKinematics();
+    if (current.road_id != m_kinematics_buffer.road_id) {
+        // A traversal counts only if the vehicle was seen entering the road
+        if (!current.road_id.empty() && !std::isnan(vehicle.getRoadEntryTime())) {
+            if (m_road_transition_count == m_road_transitions.size()) {
+                m_road_transitions.emplace_back();
+            }
+            auto& transition = m_road_transitions[m_road_transition_count++];
+            transition.road_id.assign(current.road_id);
+            transition.entered_at = vehicle.getRoadEntryTime();
+            transition.exited_at = now;
+        }
+        vehicle.setRoadEntryTime(current.road_id.empty() ? std::numeric_limits<double>::quiet_NaN() : now);
     }
+    vehicle.updateKinematics(m_kinematics_buffer);
+}
+
+void PulseDataManager::setKinematicsTracking(bool enabled)
+{
+    m_track_kinematics = enabled;
+}
+
+bool PulseDataManager::isKinematicsTrackingEnabled() const
+{
+    return m_track_kinematics;
+}
+
+std::span<const PulseRoadTransition> PulseDataManager::getRoadTransitions() const
+{
+    return {m_road_transitions.data(), m_road_transition_count};
+}
+
+void PulseDataManager::updateTrafficLights(const SimulationSource &sumo, std::uint64_t update)
+{
+    sumo.fillTrafficLightIds(m_traffic_light_id_buffer);
 
-    // Add newly discovered traffic lights
-    for (const auto& tl_id : tlIDs) {
-        if (!m_traffic_lights.count(tl_id)) {
+    // Add newly discovered traffic lights and retrieve the current state from SUMO
+    for (const auto& tl_id : m_traffic_light_id_buffer) {
+        auto it = m_traffic_lights.find(tl_id);
+        if (it == m_traffic_lights.end()) {
             auto tl = std::make_unique<PulseTrafficLight>(tl_id);
-            m_traffic_lights[tl_id] = std::move(tl);
+            it = m_traffic_lights.try_emplace(std::pmr::string(tl_id, &m_node_resource), Entry<PulseTrafficLight>{std::move(tl)}).first;
+            ++m_traffic_light_layout;
         }
-    }
+        it->second.last_seen_update = update;
 
-    // Optionally retrieve the current state from SUMO:
-    for (auto& [id, tlPtr] : m_traffic_lights) {
-        auto sumoState = sumo.getTrafficLightState(id);
+        sumo.fillTrafficLightState(tl_id, m_traffic_light_state_buffer);
+        const auto& sumoState = m_traffic_light_state_buffer;
         // Convert sumoState to a local enum:
         if (sumoState.find('g') != std::string::npos) {
-            tlPtr->setState(TrafficLightState::GREEN);
+            it->second.entity->setState(TrafficLightState::GREEN);
         }
         else if (sumoState.find('r') != std::string::npos) {
-            tlPtr->setState(TrafficLightState::RED);
+            it->second.entity->setState(TrafficLightState::RED);
         }
         else {
-            tlPtr->setState(TrafficLightState::YELLOW);
+            it->second.entity->setState(TrafficLightState::YELLOW);
         }
     }
 
-    // Intersections: if mostly static, skip or do the same approach. Typically they don't vanish or appear dynamically.
+    // Remove local TLs not in SUMO
+    const auto removed = std::erase_if(m_traffic_lights, [update](const auto& item) {
+        return item.second.last_seen_update != update;
+    });
+    if (removed > 0) {
+        ++m_traffic_light_layout;
+    }
+}
+
+void PulseDataManager::updatePedestrians(const SimulationSource &sumo, std::uint64_t update)
+{
+    const std::size_t count = sumo.fillPersonStates(m_person_buffer);
+    m_pedestrians.update({m_person_buffer.data(), count}, update);
+
+    // Junction IDs match intersection IDs wherever the junction is signalized
+    for (const auto& crossing : m_pedestrians.getCrossingEvents()) {
+        auto it = m_intersections.find(crossing.junction_id);
+        if (it != m_intersections.end()) {
+            it->second->getStatistics().addPedestrianPass(crossing.waiting_time);
+        }
+    }
+}
+
+const PulsePedestrianTable& PulseDataManager::getPedestrians() const
+{
+    return m_pedestrians;
+}
+
+void PulseDataManager::updateTransit(const SimulationSource &sumo)
+{
+    if (m_transit.size() == 0) {
+        return;
+    }
+    m_transit.update(sumo, sumo.getSimulationTime());
+}
+
+const PulseTransitTable& PulseDataManager::getTransit() const
+{
+    return m_transit;
+}
+
+void PulseDataManager::publishSnapshot()
+{
+    PulseStateSnapshot& snapshot = m_snapshots.beginWrite();
+    snapshot.step = m_update_counter;
+    auto& layout = m_snapshot_layouts[&snapshot];
+
+    // Records are assigned in place so a recycled snapshot keeps its buffers, and the IDs it
+    // already holds are kept unless the entity in that record changed
+    snapshot.vehicles.resize(m_vehicle_slots.size());
+    layout.vehicle_serials.resize(m_vehicle_slots.size(), 0);
+    for (std::size_t slot = 0; slot < m_vehicle_slots.size(); ++slot) {
+        const auto& entry = *m_vehicle_slots[slot];
+        auto& record = snapshot.vehicles[slot];
+        if (layout.vehicle_serials[slot] != entry.serial) {
+            layout.vehicle_serials[slot] = entry.serial;
+            record.id.assign(entry.entity->getId());
+            record.type = entry.entity->getType();
+            record.role = entry.entity->getRole();
+        }
+        record.position = entry.entity->getPosition();
+    }
+
+    // An unchanged map iterates in the same order, so the records still hold the same IDs
+    const bool lights_changed = layout.traffic_light_layout != m_traffic_light_layout;
+    layout.traffic_light_layout = m_traffic_light_layout;
+    snapshot.traffic_lights.resize(m_traffic_lights.size());
+    std::size_t index = 0;
+    for (const auto& [id, entry] : m_traffic_lights) {
+        auto& record = snapshot.traffic_lights[index++];
+        if (lights_changed) {
+            record.id.assign(id);
+        }
+        record.state = entry.entity->getState();
+    }
+
+    const bool intersections_changed = layout.intersection_layout != m_intersection_layout;
+    layout.intersection_layout = m_intersection_layout;
+    snapshot.intersections.resize(m_intersections.size());
+    index = 0;
+    for (const auto& [id, intersection] : m_intersections) {
+        const auto& stats = intersection->getStatistics();
+        auto& record = snapshot.intersections[index++];
+        if (intersections_changed) {
+            record.id.assign(id);
+        }
+        record.vehicles_passed = stats.getTotalVehiclesPassed();
+        record.vehicle_waiting_time = stats.getTotalVehicleWaitingTime();
+        record.pedestrians_passed = stats.getTotalPedestriansPassed();
+        record.pedestrian_waiting_time = stats.getTotalPedestrianWaitingTime();
+    }
+
+    m_snapshots.publish();
+}
+
+PulseSnapshotPublisher::Guard PulseDataManager::acquireSnapshot() const
+{
+    return m_snapshots.pin();
+}
+
+PulseDataManager::Entry<PulseVehicle>& PulseDataManager::insertVehicle(const std::string& vehicle_id,
+                                                                      std::unique_ptr<PulseVehicle> vehicle,
+                                                                      std::uint64_t update)
+{
+    auto& entry = m_vehicles.try_emplace(std::pmr::string(vehicle_id, &m_node_resource),
+                                         Entry<PulseVehicle>{std::move(vehicle), update}).first->second;
+    entry.slot = m_vehicle_slots.size();
+    entry.serial = m_next_vehicle_serial++;
+    m_vehicle_slots.push_back(&entry);
+    return entry;
 }
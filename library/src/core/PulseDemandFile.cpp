@@ -0,0 +1,626 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseDemandFile.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "core/PulseStateHasher.h"
+
+namespace
+{
+    constexpr std::size_t kInflateChunk = std::size_t{1} << 30;   // Limit of a single zlib call (uInt)
+    constexpr std::size_t kStreamChunk = std::size_t{1} << 20;    // zlib stream buffer and write chunk
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    [[noreturn]] void fail(std::size_t offset, const std::string& what)
+    {
+        throw std::runtime_error("Malformed demand XML at byte " + std::to_string(offset) + ": " + what);
+    }
+
+    std::string_view firstEdge(std::string_view edges)
+    {
+        const std::size_t begin = edges.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        const std::size_t end = edges.find(' ', begin);
+        return edges.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+    }
+
+    std::string_view lastEdge(std::string_view edges)
+    {
+        const std::size_t end = edges.find_last_not_of(' ');
+        if (end == std::string_view::npos) {
+            return {};
+        }
+        const std::size_t begin = edges.rfind(' ', end);
+        const std::size_t first = begin == std::string_view::npos ? 0 : begin + 1;
+        return edges.substr(first, end + 1 - first);
+    }
+
+    double parseTime(std::string_view value)
+    {
+        double seconds = 0.0;
+        const auto result = std::from_chars(value.data(), value.data() + value.size(), seconds);
+        if (result.ec != std::errc{} || result.ptr != value.data() + value.size()) {
+            return -1.0;
+        }
+        return seconds;
+    }
+
+    /**
+     * @brief Inflates a gzip file straight into the buffer, so the compressed bytes are never held whole.
+     */
+    void readGzip(const std::string& path, std::size_t compressed_size, std::vector<char>& buffer)
+    {
+        gzFile in = gzopen(path.c_str(), "rb");
+        if (in == nullptr) {
+            throw std::runtime_error("Failed to open demand file: " + path);
+        }
+        gzbuffer(in, kStreamChunk);
+
+        // Demand XML typically compresses 8-15x; start at 8x and double as needed
+        buffer.resize(std::max<std::size_t>(compressed_size * 8, kStreamChunk));
+        std::size_t produced = 0;
+        while (true) {
+            if (produced == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            const auto chunk = static_cast<unsigned>(std::min(buffer.size() - produced, kInflateChunk));
+            const int read = gzread(in, buffer.data() + produced, chunk);
+            if (read < 0) {
+                gzclose(in);
+                throw std::runtime_error("Corrupt gzip demand file: " + path);
+            }
+            if (read == 0) {
+                break;
+            }
+            produced += static_cast<std::size_t>(read);
+        }
+        // gzread stops quietly at a truncated member; only gzclose reports it
+        if (gzclose(in) != Z_OK) {
+            throw std::runtime_error("Corrupt gzip demand file: " + path);
+        }
+        buffer.resize(produced);
+    }
+
+    /**
+     * @brief Collects output into a fixed-size chunk and hands full chunks to a gzip stream.
+     */
+    class GzipWriter
+    {
+    public:
+        explicit GzipWriter(const std::string& path)
+            : m_path(path), m_file(gzopen(path.c_str(), "wb"))
+        {
+            if (m_file == nullptr) {
+                throw std::runtime_error("Failed to write demand file: " + path);
+            }
+            gzbuffer(m_file, kStreamChunk);
+            m_chunk.reserve(kStreamChunk);
+        }
+
+        ~GzipWriter()
+        {
+            if (m_file != nullptr) {
+                gzclose(m_file);
+            }
+        }
+
+        GzipWriter(const GzipWriter&) = delete;
+        GzipWriter& operator=(const GzipWriter&) = delete;
+
+        void append(std::string_view text)
+        {
+            if (m_chunk.size() + text.size() > kStreamChunk) {
+                flush();
+            }
+            if (text.size() >= kStreamChunk) {
+                compress(text);
+            }
+            else {
+                m_chunk.append(text);
+            }
+        }
+
+        void close()
+        {
+            flush();
+            const int result = gzclose(m_file);
+            m_file = nullptr;
+            if (result != Z_OK) {
+                throw std::runtime_error("Failed to write demand file: " + m_path);
+            }
+        }
+
+    private:
+        void flush()
+        {
+            compress(m_chunk);
+            m_chunk.clear();
+        }
+
+        void compress(std::string_view text)
+        {
+            for (std::size_t offset = 0; offset < text.size(); offset += kInflateChunk) {
+                const auto size = static_cast<unsigned>(std::min(text.size() - offset, kInflateChunk));
+                if (gzwrite(m_file, text.data() + offset, size) != static_cast<int>(size)) {
+                    throw std::runtime_error("Failed to write demand file: " + m_path);
+                }
+            }
+        }
+
+    private:
+        std::string m_path;
+        gzFile m_file;
+        std::string m_chunk;
+    };
+
+    /**
+     * @brief Emits a demand file piece by piece: prolog, definitions, elements, closing tag.
+     * @param next Sets the next element and returns true, or returns false after the last one.
+     */
+    template <typename Emit, typename Next>
+    void writeDemand(Emit&& emit, std::string_view prolog, const std::vector<std::string_view>& definitions,
+                     Next&& next, std::string_view root)
+    {
+        emit(prolog);
+        emit(">\n");
+        for (const auto definition : definitions) {
+            emit("    ");
+            emit(definition);
+            emit("\n");
+        }
+        std::string_view element;
+        while (next(element)) {
+            emit("    ");
+            emit(element);
+            emit("\n");
+        }
+        emit("</");
+        emit(root);
+        emit(">\n");
+    }
+
+    auto elementsFrom(const std::vector<std::string_view>& elements)
+    {
+        return [&elements, index = std::size_t{0}](std::string_view& element) mutable {
+            if (index == elements.size()) {
+                return false;
+            }
+            element = elements[index++];
+            return true;
+        };
+    }
+
+    std::string_view peekName(std::string_view text, std::size_t position)
+    {
+        const std::size_t begin = position;
+        while (position < text.size() && !isSpace(text[position]) && text[position] != '/' && text[position] != '>') {
+            ++position;
+        }
+        return text.substr(begin, position - begin);
+    }
+
+    /**
+     * @brief Element start tag split into name and attributes; the attribute callback sees raw values.
+     */
+    template <typename OnAttribute>
+    std::size_t parseStartTag(std::string_view text, std::size_t position, std::string_view& name, bool& self_closing, OnAttribute&& on_attribute)
+    {
+        name = peekName(text, position);
+        if (name.empty()) {
+            fail(position, "missing element name");
+        }
+        position += name.size();
+
+        while (true) {
+            while (position < text.size() && isSpace(text[position])) {
+                ++position;
+            }
+            if (position >= text.size()) {
+                fail(position, "unterminated <" + std::string(name) + ">");
+            }
+            if (text[position] == '>') {
+                self_closing = false;
+                return position + 1;
+            }
+            if (text[position] == '/') {
+                if (position + 1 >= text.size() || text[position + 1] != '>') {
+                    fail(position, "expected '/>'");
+                }
+                self_closing = true;
+                return position + 2;
+            }
+
+            const std::size_t attribute_begin = position;
+            while (position < text.size() && text[position] != '=' && !isSpace(text[position]) && text[position] != '>') {
+                ++position;
+            }
+            const std::string_view attribute = text.substr(attribute_begin, position - attribute_begin);
+            while (position < text.size() && isSpace(text[position])) {
+                ++position;
+            }
+            if (position >= text.size() || text[position] != '=') {
+                fail(position, "expected '=' after " + std::string(attribute));
+            }
+            ++position;
+            while (position < text.size() && isSpace(text[position])) {
+                ++position;
+            }
+            if (position >= text.size() || (text[position] != '"' && text[position] != '\'')) {
+                fail(position, "expected quoted value of " + std::string(attribute));
+            }
+            const char quote = text[position];
+            const void* close = std::memchr(text.data() + position + 1, quote, text.size() - position - 1);
+            if (close == nullptr) {
+                fail(position, "unterminated value of " + std::string(attribute));
+            }
+            const std::size_t value_end = static_cast<const char*>(close) - text.data();
+            on_attribute(attribute, text.substr(position + 1, value_end - position - 1));
+            position = value_end + 1;
+        }
+    }
+
+    std::vector<std::string_view> elementsOf(const std::vector<const PulseTripRecord*>& trips)
+    {
+        std::vector<std::string_view> elements;
+        elements.reserve(trips.size());
+        for (const auto* trip : trips) {
+            elements.push_back(trip->element);
+        }
+        return elements;
+    }
+
+    std::size_t findOrFail(std::string_view text, std::string_view pattern, std::size_t from, const char* what)
+    {
+        const std::size_t position = text.find(pattern, from);
+        if (position == std::string_view::npos) {
+            fail(from, what);
+        }
+        return position;
+    }
+}
+
+PulseDemandFile PulseDemandFile::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Failed to open demand file: " + path);
+    }
+    const std::streamsize size = in.tellg();
+    in.seekg(0);
+
+    char magic[2] = {};
+    const bool gzip = in.read(magic, sizeof(magic)) && static_cast<unsigned char>(magic[0]) == 0x1f
+                      && static_cast<unsigned char>(magic[1]) == 0x8b;
+    in.clear();
+    in.seekg(0);
+
+    PulseDemandFile file;
+    if (gzip) {
+        in.close();
+        readGzip(path, static_cast<std::size_t>(size), file.m_buffer);
+    }
+    else {
+        file.m_buffer.resize(static_cast<std::size_t>(size));
+        if (!in.read(file.m_buffer.data(), size)) {
+            throw std::runtime_error("Failed to read demand file: " + path);
+        }
+    }
+
+    file.parseBuffer();
+    return file;
+}
+
+PulseDemandFile PulseDemandFile::parse(std::string_view xml)
+{
+    PulseDemandFile file;
+    file.m_buffer.assign(xml.begin(), xml.end());
+    file.parseBuffer();
+    return file;
+}
+
+void PulseDemandFile::parseBuffer()
+{
+    const std::string_view text(m_buffer.data(), m_buffer.size());
+
+    std::unordered_map<std::string_view, std::string_view> vclasses;   // vType id -> vClass
+    std::unordered_map<std::string_view, std::string_view> routes;     // route id -> edges
+    std::vector<std::string_view> route_refs;                           // Per trip: referenced route id
+
+    std::size_t position = 0;
+    std::size_t depth = 0;
+    std::size_t element_begin = 0;      // Start of the current top-level element
+    bool in_trip = false;               // The current top-level element is m_trips.back()
+    bool closed = false;
+
+    const auto finishElement = [&](std::size_t end) {
+        const std::string_view element = text.substr(element_begin, end - element_begin);
+        if (in_trip) {
+            m_trips.back().element = element;
+        }
+        else {
+            m_definitions.push_back(element);
+        }
+        in_trip = false;
+    };
+
+    while (!closed) {
+        // memchr is vectorized by the C library, so text between tags is skipped 16-32 bytes at a time
+        const void* next = std::memchr(text.data() + position, '<', text.size() - position);
+        if (next == nullptr) {
+            break;
+        }
+        const std::size_t open = static_cast<const char*>(next) - text.data();
+        if (open + 1 >= text.size()) {
+            fail(open, "unexpected end of input");
+        }
+
+        const char marker = text[open + 1];
+        if (marker == '?') {
+            position = findOrFail(text, "?>", open + 2, "unterminated processing instruction") + 2;
+            continue;
+        }
+        if (marker == '!') {
+            if (text.substr(open, 4) == "<!--") {
+                position = findOrFail(text, "-->", open + 4, "unterminated comment") + 3;
+            }
+            else if (text.substr(open, 9) == "<![CDATA[") {
+                position = findOrFail(text, "]]>", open + 9, "unterminated CDATA section") + 3;
+            }
+            else {
+                position = findOrFail(text, ">", open + 2, "unterminated declaration") + 1;
+            }
+            continue;
+        }
+        if (marker == '/') {
+            const std::size_t end = findOrFail(text, ">", open + 2, "unterminated end tag") + 1;
+            if (depth == 0) {
+                fail(open, "unexpected end tag");
+            }
+            --depth;
+            if (depth == 1) {
+                finishElement(end);
+            }
+            else if (depth == 0) {
+                closed = true;
+            }
+            position = end;
+            continue;
+        }
+
+        std::string_view name;
+        bool self_closing = false;
+
+        if (depth == 0) {
+            position = parseStartTag(text, open + 1, name, self_closing, [](std::string_view, std::string_view) {});
+            m_root = name;
+            // Without the tag's '>' or '/>', so a self-closing root can be reopened for writing
+            m_prolog = text.substr(0, position - (self_closing ? 2 : 1));
+            closed = self_closing;
+            depth = 1;
+            continue;
+        }
+
+        if (depth == 1) {
+            element_begin = open;
+            const std::string_view tag = peekName(text, open + 1);
+            PulseTripKind kind = PulseTripKind::TRIP;
+            in_trip = true;
+            if (tag == "vehicle") {
+                kind = PulseTripKind::VEHICLE;
+            }
+            else if (tag == "flow") {
+                kind = PulseTripKind::FLOW;
+            }
+            else if (tag == "person" || tag == "personFlow") {
+                kind = PulseTripKind::PERSON;
+            }
+            else if (tag != "trip") {
+                in_trip = false;
+            }
+
+            if (in_trip) {
+                PulseTripRecord trip;
+                trip.kind = kind;
+                std::string_view route;
+                position = parseStartTag(text, open + 1, name, self_closing, [&](std::string_view attribute, std::string_view value) {
+                    if (attribute == "id") {
+                        trip.id = value;
+                    }
+                    else if (attribute == "type") {
+                        trip.type = value;
+                    }
+                    else if (attribute == "from") {
+                        trip.from = value;
+                    }
+                    else if (attribute == "to") {
+                        trip.to = value;
+                    }
+                    else if (attribute == "depart" || attribute == "begin") {
+                        trip.depart = parseTime(value);
+                    }
+                    else if (attribute == "route") {
+                        route = value;
+                    }
+                });
+                m_trips.push_back(trip);
+                route_refs.push_back(route);
+            }
+            else {
+                std::string_view id;
+                std::string_view vclass;
+                std::string_view edges;
+                position = parseStartTag(text, open + 1, name, self_closing, [&](std::string_view attribute, std::string_view value) {
+                    if (attribute == "id") {
+                        id = value;
+                    }
+                    else if (attribute == "vClass") {
+                        vclass = value;
+                    }
+                    else if (attribute == "edges") {
+                        edges = value;
+                    }
+                });
+                if (name == "vType" && !vclass.empty()) {
+                    vclasses.emplace(id, vclass);
+                }
+                else if (name == "route" && !id.empty()) {
+                    routes.emplace(id, edges);
+                }
+            }
+
+            if (self_closing) {
+                finishElement(position);
+            }
+            else {
+                depth = 2;
+            }
+            continue;
+        }
+
+        // Children: an embedded route, or the walks and rides of a person, give the trip's edges
+        std::string_view from;
+        std::string_view to;
+        std::string_view edges;
+        position = parseStartTag(text, open + 1, name, self_closing, [&](std::string_view attribute, std::string_view value) {
+            if (attribute == "from") {
+                from = value;
+            }
+            else if (attribute == "to") {
+                to = value;
+            }
+            else if (attribute == "edges") {
+                edges = value;
+            }
+        });
+        if (in_trip && depth == 2) {
+            PulseTripRecord& trip = m_trips.back();
+            if (from.empty()) {
+                from = firstEdge(edges);
+            }
+            if (to.empty()) {
+                to = lastEdge(edges);
+            }
+            if (trip.from.empty()) {
+                trip.from = from;
+            }
+            if (!to.empty() && (trip.kind == PulseTripKind::PERSON || trip.to.empty())) {
+                trip.to = to;
+            }
+        }
+        if (!self_closing) {
+            ++depth;
+        }
+    }
+
+    if (m_root.empty()) {
+        fail(position, "no root element");
+    }
+    if (!closed) {
+        fail(text.size(), "missing </" + std::string(m_root) + ">");
+    }
+
+    for (std::size_t i = 0; i < m_trips.size(); ++i) {
+        PulseTripRecord& trip = m_trips[i];
+        const auto vclass = vclasses.find(trip.type);
+        if (vclass != vclasses.end()) {
+            trip.vclass = vclass->second;
+        }
+        else {
+            trip.vclass = trip.kind == PulseTripKind::PERSON ? "pedestrian" : "passenger";
+        }
+
+        if (!route_refs[i].empty()) {
+            const auto route = routes.find(route_refs[i]);
+            if (route != routes.end()) {
+                trip.from = firstEdge(route->second);
+                trip.to = lastEdge(route->second);
+            }
+        }
+    }
+}
+
+const std::vector<PulseTripRecord>& PulseDemandFile::getTrips() const
+{
+    return m_trips;
+}
+
+const std::vector<std::string_view>& PulseDemandFile::getDefinitions() const
+{
+    return m_definitions;
+}
+
+std::size_t PulseDemandFile::getSize() const
+{
+    return m_buffer.size();
+}
+
+std::vector<const PulseTripRecord*> PulseDemandFile::sample(double fraction, std::uint64_t seed) const
+{
+    if (!(fraction >= 0.0 && fraction <= 1.0)) {
+        throw std::invalid_argument("Sample fraction must be within [0, 1].");
+    }
+    if (fraction == 1.0) {
+        return select([](const PulseTripRecord&) { return true; });
+    }
+
+    const auto threshold = static_cast<std::uint64_t>(std::ldexp(fraction, 64));
+    return select([&](const PulseTripRecord& trip) {
+        return PulseStateHasher::hash(trip.id.data(), trip.id.size(), seed) < threshold;
+    });
+}
+
+void PulseDemandFile::write(std::ostream& out, const std::vector<const PulseTripRecord*>& trips) const
+{
+    write(out, elementsOf(trips));
+}
+
+void PulseDemandFile::write(const std::string& path, const std::vector<const PulseTripRecord*>& trips) const
+{
+    write(path, elementsOf(trips));
+}
+
+void PulseDemandFile::write(std::ostream& out, const std::vector<std::string_view>& elements) const
+{
+    writeDemand([&](std::string_view text) { out.write(text.data(), static_cast<std::streamsize>(text.size())); },
+                m_prolog, m_definitions, elementsFrom(elements), m_root);
+}
+
+void PulseDemandFile::write(const std::string& path, const std::vector<std::string_view>& elements) const
+{
+    write(path, std::function<bool(std::string_view&)>(elementsFrom(elements)));
+}
+
+void PulseDemandFile::write(const std::string& path, const std::function<bool(std::string_view&)>& next) const
+{
+    const bool compressed = path.size() >= 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+    if (!compressed) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        writeDemand([&](std::string_view text) { out.write(text.data(), static_cast<std::streamsize>(text.size())); },
+                    m_prolog, m_definitions, next, m_root);
+        if (!out) {
+            throw std::runtime_error("Failed to write demand file: " + path);
+        }
+        return;
+    }
+
+    GzipWriter out(path);
+    writeDemand([&](std::string_view text) { out.append(text); }, m_prolog, m_definitions, next, m_root);
+    out.close();
+}
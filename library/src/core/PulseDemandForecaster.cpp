@@ -0,0 +1,175 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseDemandForecaster.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    bool isWeight(double value)
+    {
+        return value >= 0.0 && value <= 1.0;
+    }
+}
+
+PulseDemandForecaster::PulseDemandForecaster(const PulseForecastConfig& config)
+    : m_config(config)
+{
+    if (config.season_length == 0 || config.horizon == 0) {
+        throw std::invalid_argument("Season length and horizon must be positive.");
+    }
+    if (!(config.level_smoothing > 0.0) || !isWeight(config.level_smoothing)
+        || !isWeight(config.trend_smoothing) || !isWeight(config.season_smoothing)) {
+        throw std::invalid_argument("Smoothing weights must be in [0, 1], the level weight above 0.");
+    }
+}
+
+void PulseDemandForecaster::recordInterval(const std::vector<PulseIntersection*>& intersections)
+{
+    for (auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot forecast a null intersection.");
+        }
+    }
+
+    ++m_intervals;
+    for (auto* intersection : intersections) {
+        sampleIntersection(*intersection);
+    }
+    updateModels();
+}
+
+void PulseDemandForecaster::recordInterval(const PulseDataManager& data_manager)
+{
+    ++m_intervals;
+    for (auto& intersection : data_manager.viewIntersections()) {
+        sampleIntersection(intersection);
+    }
+    updateModels();
+}
+
+void PulseDemandForecaster::sampleIntersection(PulseIntersection& intersection)
+{
+    auto it = m_index.find(intersection.getId());
+    if (it == m_index.end()) {
+        addIntersection(intersection);
+        return;
+    }
+
+    const std::size_t index = it->second;
+    const auto& statistics = intersection.getStatistics();
+    const std::size_t vehicles = statistics.getTotalVehiclesPassed();
+    const double waiting = statistics.getTotalVehicleWaitingTime();
+
+    // Counters only grow; a smaller value means the statistics were reset in between
+    const bool reset = vehicles < m_last_vehicles[index];
+    const std::size_t passed = reset ? vehicles : vehicles - m_last_vehicles[index];
+    const double waited = reset ? waiting : waiting - m_last_waiting[index];
+
+    const std::size_t series = index * kSeriesPerIntersection;
+    m_observation[series + kFlow] = static_cast<double>(passed);
+    if (passed > 0) {
+        m_observation[series + kWait] = waited / static_cast<double>(passed);
+    }
+    else {
+        // No vehicle, no waiting time sample: feed the model its own expectation
+        m_observation[series + kWait] = m_samples[index] ? m_forecast[(series + kWait) * m_config.horizon] : 0.0;
+    }
+
+    m_last_vehicles[index] = vehicles;
+    m_last_waiting[index] = waiting;
+    m_seen_interval[index] = m_intervals;
+}
+
+PulseDemandForecast PulseDemandForecaster::getForecast(const std::string& intersection_id, std::size_t intervals_ahead) const
+{
+    auto it = m_index.find(intersection_id);
+    if (it == m_index.end() || m_samples[it->second] == 0) {
+        throw std::invalid_argument("No forecast yet for intersection: " + intersection_id);
+    }
+    if (intervals_ahead == 0 || intervals_ahead > m_config.horizon) {
+        throw std::out_of_range("Forecast horizon out of range.");
+    }
+
+    const std::size_t series = it->second * kSeriesPerIntersection;
+    const std::size_t step = intervals_ahead - 1;
+    return PulseDemandForecast{
+        m_forecast[(series + kFlow) * m_config.horizon + step],
+        m_forecast[(series + kWait) * m_config.horizon + step]
+    };
+}
+
+std::uint64_t PulseDemandForecaster::getIntervalCount() const
+{
+    return m_intervals;
+}
+
+std::size_t PulseDemandForecaster::getIntersectionCount() const
+{
+    return m_index.size();
+}
+
+std::size_t PulseDemandForecaster::addIntersection(PulseIntersection& intersection)
+{
+    const std::size_t index = m_index.size();
+    m_index.emplace(intersection.getId(), index);
+
+    const auto& statistics = intersection.getStatistics();
+    m_last_vehicles.push_back(statistics.getTotalVehiclesPassed());
+    m_last_waiting.push_back(statistics.getTotalVehicleWaitingTime());
+    m_seen_interval.push_back(0);
+    m_samples.push_back(0);
+
+    const std::size_t series = (index + 1) * kSeriesPerIntersection;
+    m_observation.resize(series, 0.0);
+    m_level.resize(series, 0.0);
+    m_trend.resize(series, 0.0);
+    m_season.resize(series * m_config.season_length, 0.0);
+    m_forecast.resize(series * m_config.horizon, 0.0);
+    return index;
+}
+
+void PulseDemandForecaster::updateModels()
+{
+    const std::size_t season_length = m_config.season_length;
+    const std::size_t horizon = m_config.horizon;
+    const bool seasonal = season_length > 1;
+    const std::size_t slot = (m_intervals - 1) % season_length;
+
+    const double alpha = m_config.level_smoothing;
+    const double beta = m_config.trend_smoothing;
+    const double gamma = seasonal ? m_config.season_smoothing : 0.0;
+
+    for (std::size_t index = 0; index < m_samples.size(); ++index) {
+        if (m_seen_interval[index] != m_intervals) {
+            continue;
+        }
+
+        for (std::size_t series = index * kSeriesPerIntersection; series < (index + 1) * kSeriesPerIntersection; ++series) {
+            const double observation = m_observation[series];
+            double* season = &m_season[series * season_length];
+
+            if (m_samples[index] == 0) {
+                m_level[series] = observation - season[slot];
+                m_trend[series] = 0.0;
+            }
+            else {
+                const double previous_level = m_level[series];
+                m_level[series] = alpha * (observation - season[slot]) + (1.0 - alpha) * (previous_level + m_trend[series]);
+                m_trend[series] = beta * (m_level[series] - previous_level) + (1.0 - beta) * m_trend[series];
+            }
+            season[slot] = gamma * (observation - m_level[series]) + (1.0 - gamma) * season[slot];
+
+            double* forecast = &m_forecast[series * horizon];
+            for (std::size_t step = 0; step < horizon; ++step) {
+                const double ahead = static_cast<double>(step + 1);
+                const double profile = season[(slot + step + 1) % season_length];
+                forecast[step] = std::max(0.0, m_level[series] + ahead * m_trend[series] + profile);
+            }
+        }
+        ++m_samples[index];
+    }
+}
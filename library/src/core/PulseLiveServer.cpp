@@ -0,0 +1,662 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseLiveServer.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "core/PulseProfiler.h"
+
+namespace
+{
+    constexpr std::size_t kMaxRequestSize = 8192;       ///< Longest accepted HTTP request head.
+    constexpr std::size_t kMaxFramePayload = 65536;     ///< Longest accepted client frame.
+    constexpr char kWebSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+    enum Opcode : std::uint8_t { TEXT = 0x1, BINARY = 0x2, CLOSE = 0x8, PING = 0x9, PONG = 0xA };
+
+    /**
+     * @brief SHA-1 digest (FIPS 180-4), used only for the WebSocket handshake.
+     */
+    std::array<std::uint8_t, 20> sha1(std::string_view message)
+    {
+        std::uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+        std::string data(message);
+        const std::uint64_t bit_length = static_cast<std::uint64_t>(message.size()) * 8;
+        data.push_back(static_cast<char>(0x80));
+        while (data.size() % 64 != 56) {
+            data.push_back('\0');
+        }
+        for (int i = 7; i >= 0; --i) {
+            data.push_back(static_cast<char>(bit_length >> (8 * i) & 0xFF));
+        }
+
+        const auto rotate = [](std::uint32_t value, int bits) { return value << bits | value >> (32 - bits); };
+        for (std::size_t chunk = 0; chunk < data.size(); chunk += 64) {
+            std::uint32_t w[80];
+            for (int i = 0; i < 16; ++i) {
+                const auto* bytes = reinterpret_cast<const unsigned char*>(data.data() + chunk + 4 * i);
+                w[i] = static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16
+                     | static_cast<std::uint32_t>(bytes[2]) << 8 | bytes[3];
+            }
+            for (int i = 16; i < 80; ++i) {
+                w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+
+            std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+            for (int i = 0; i < 80; ++i) {
+                std::uint32_t f, k;
+                if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+                else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+                else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+                else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+                const std::uint32_t temp = rotate(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = rotate(b, 30);
+                b = a;
+                a = temp;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+        }
+
+        std::array<std::uint8_t, 20> digest{};
+        for (int i = 0; i < 20; ++i) {
+            digest[i] = static_cast<std::uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+        }
+        return digest;
+    }
+
+    std::string base64(const std::uint8_t* data, std::size_t size)
+    {
+        static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (std::size_t i = 0; i < size; i += 3) {
+            const std::uint32_t group = static_cast<std::uint32_t>(data[i]) << 16
+                                      | (i + 1 < size ? static_cast<std::uint32_t>(data[i + 1]) << 8 : 0)
+                                      | (i + 2 < size ? data[i + 2] : 0);
+            out.push_back(kAlphabet[group >> 18 & 0x3F]);
+            out.push_back(kAlphabet[group >> 12 & 0x3F]);
+            out.push_back(i + 1 < size ? kAlphabet[group >> 6 & 0x3F] : '=');
+            out.push_back(i + 2 < size ? kAlphabet[group & 0x3F] : '=');
+        }
+        return out;
+    }
+
+    std::shared_ptr<const std::string> makeFrame(std::uint8_t opcode, std::string_view payload)
+    {
+        auto frame = std::make_shared<std::string>();
+        frame->reserve(payload.size() + 10);
+        frame->push_back(static_cast<char>(0x80 | opcode));
+        if (payload.size() < 126) {
+            frame->push_back(static_cast<char>(payload.size()));
+        }
+        else if (payload.size() <= 0xFFFF) {
+            frame->push_back(static_cast<char>(126));
+            frame->push_back(static_cast<char>(payload.size() >> 8 & 0xFF));
+            frame->push_back(static_cast<char>(payload.size() & 0xFF));
+        }
+        else {
+            frame->push_back(static_cast<char>(127));
+            for (int i = 7; i >= 0; --i) {
+                frame->push_back(static_cast<char>(static_cast<std::uint64_t>(payload.size()) >> (8 * i) & 0xFF));
+            }
+        }
+        frame->append(payload);
+        return frame;
+    }
+
+    std::shared_ptr<const std::string> makeResponse(std::string_view status, std::string_view content_type, std::string_view body)
+    {
+        auto response = std::make_shared<std::string>();
+        response->append("HTTP/1.1 ").append(status).append("\r\n");
+        response->append("Content-Type: ").append(content_type).append("\r\n");
+        response->append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+        response->append("Access-Control-Allow-Origin: *\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n");
+        response->append(body);
+        return response;
+    }
+
+    /**
+     * @brief Value of a header in a request head, matched case-insensitively; empty if absent.
+     */
+    std::string_view findHeader(std::string_view request, std::string_view name)
+    {
+        std::size_t line = request.find("\r\n");
+        while (line != std::string_view::npos && line + 2 < request.size()) {
+            const std::size_t begin = line + 2;
+            const std::size_t end = request.find("\r\n", begin);
+            const std::string_view header = request.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+            const std::size_t colon = header.find(':');
+            if (colon == name.size() && std::equal(name.begin(), name.end(), header.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                })) {
+                std::string_view value = header.substr(colon + 1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+                    value.remove_prefix(1);
+                }
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+                    value.remove_suffix(1);
+                }
+                return value;
+            }
+            line = end;
+        }
+        return {};
+    }
+
+    bool containsToken(std::string_view value, std::string_view token)
+    {
+        const auto it = std::search(value.begin(), value.end(), token.begin(), token.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+        return it != value.end();
+    }
+
+    void closeFd(int& fd)
+    {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+/**
+ * @brief One connection; HTTP until it upgrades to a WebSocket stream.
+ */
+struct PulseLiveServer::Client
+{
+    int fd = -1;
+    std::string input;                      ///< Received bytes not yet processed.
+    struct QueuedFrame
+    {
+        Frame data;
+        bool droppable;                     ///< A stream frame that a later full state replaces.
+    };
+
+    std::deque<QueuedFrame> output;         ///< Queued responses and frames.
+    std::size_t output_offset = 0;          ///< Bytes of output.front() already sent.
+    std::size_t queued_bytes = 0;           ///< Unsent bytes in output.
+    bool stream = false;                    ///< Upgraded to a WebSocket.
+    PulseWireFormat format = PulseWireFormat::JSON;
+    bool needs_state = false;               ///< Gets a full state instead of the next delta.
+    bool close_after_flush = false;
+    bool closed = false;
+
+    ~Client() { closeFd(fd); }
+};
+
+PulseLiveServer::PulseLiveServer(const PulseDataManager& data_manager, const PulseLiveServerConfig& config)
+    : m_data_manager(data_manager), m_config(config)
+{
+    in_addr address{};
+    if (::inet_pton(AF_INET, config.bind_address.c_str(), &address) != 1) {
+        throw std::invalid_argument("Live server bind address is not an IPv4 address: " + config.bind_address);
+    }
+    if (config.max_clients == 0 || config.max_queued_bytes == 0 || config.poll_interval.count() <= 0) {
+        throw std::invalid_argument("Live server limits must be positive.");
+    }
+}
+
+PulseLiveServer::~PulseLiveServer()
+{
+    stop();
+}
+
+void PulseLiveServer::start()
+{
+    if (m_running) {
+        throw std::logic_error("Live server is already running.");
+    }
+    // A server thread that failed on its own still has to be joined and its sockets closed
+    stop();
+
+    m_listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0 || ::pipe2(m_wake_fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        closeSockets();
+        throw std::runtime_error(std::string("Cannot create live server socket: ") + std::strerror(errno));
+    }
+
+    const int reuse = 1;
+    ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_config.port);
+    ::inet_pton(AF_INET, m_config.bind_address.c_str(), &address.sin_addr);
+    socklen_t length = sizeof(address);
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(m_listen_fd, SOMAXCONN) != 0
+        || ::getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        const std::string reason = std::strerror(errno);
+        closeSockets();
+        throw std::runtime_error("Cannot listen on " + m_config.bind_address + ":" + std::to_string(m_config.port) + ": " + reason);
+    }
+    m_port = ntohs(address.sin_port);
+
+    m_encoder.reset();
+    m_current.release();
+    m_streamed_epoch = 0;
+    m_error = 0;
+    m_stop_requested = false;
+    m_running = true;
+    m_thread = std::thread([this] { run(); });
+}
+
+void PulseLiveServer::stop()
+{
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    m_stop_requested = true;
+    const char wake = 1;
+    (void)::write(m_wake_fds[1], &wake, 1);
+    m_thread.join();
+
+    m_clients.clear();
+    m_current.release();
+    m_stream_clients = 0;
+    closeSockets();
+    m_running = false;
+}
+
+bool PulseLiveServer::isRunning() const
+{
+    return m_running;
+}
+
+int PulseLiveServer::getError() const
+{
+    return m_error;
+}
+
+std::uint16_t PulseLiveServer::getPort() const
+{
+    return m_port;
+}
+
+std::size_t PulseLiveServer::getStreamClientCount() const
+{
+    return m_stream_clients;
+}
+
+std::uint64_t PulseLiveServer::getStreamedEpoch() const
+{
+    return m_streamed_epoch;
+}
+
+std::uint64_t PulseLiveServer::getResyncCount() const
+{
+    return m_resyncs;
+}
+
+void PulseLiveServer::run()
+{
+    std::vector<pollfd> fds;
+    const int timeout = static_cast<int>(m_config.poll_interval.count());
+
+    while (!m_stop_requested) {
+        fds.clear();
+        fds.push_back(pollfd{m_wake_fds[0], POLLIN, 0});
+        fds.push_back(pollfd{m_listen_fd, POLLIN, 0});
+        for (const auto& client : m_clients) {
+            fds.push_back(pollfd{client->fd, static_cast<short>(POLLIN | (client->output.empty() ? 0 : POLLOUT)), 0});
+        }
+
+        if (::poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+            // Not recoverable from this thread; callers see it through getError() and isRunning()
+            m_error = errno;
+            m_running = false;
+            return;
+        }
+        if (m_stop_requested) {
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            acceptClients();
+        }
+
+        // fds and m_clients line up until acceptClients() appended new clients, which were not polled
+        for (std::size_t i = 2; i < fds.size(); ++i) {
+            auto& client = *m_clients[i - 2];
+            if (fds[i].revents & (POLLERR | POLLNVAL)) {
+                client.closed = true;
+            }
+            else if (fds[i].revents & (POLLIN | POLLHUP)) {
+                readClient(client);
+            }
+        }
+
+        streamSnapshot();
+
+        for (auto& client : m_clients) {
+            if (!client->closed && !client->output.empty()) {
+                flush(*client);
+            }
+        }
+
+        std::erase_if(m_clients, [this](const std::unique_ptr<Client>& client) {
+            if (!client->closed) {
+                return false;
+            }
+            if (client->stream) {
+                --m_stream_clients;
+            }
+            return true;
+        });
+    }
+}
+
+void PulseLiveServer::acceptClients()
+{
+    while (true) {
+        const int fd = ::accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (m_clients.size() >= m_config.max_clients) {
+            ::close(fd);
+            continue;
+        }
+
+        const int no_delay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        if (m_config.socket_buffer_size > 0) {
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &m_config.socket_buffer_size, sizeof(m_config.socket_buffer_size));
+        }
+
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        m_clients.push_back(std::move(client));
+    }
+}
+
+void PulseLiveServer::readClient(Client& client)
+{
+    char buffer[4096];
+    while (true) {
+        const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            client.input.append(buffer, static_cast<std::size_t>(received));
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            client.closed = true;
+            return;
+        }
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (client.close_after_flush) {
+        client.input.clear();
+        return;
+    }
+    if (client.stream) {
+        handleFrames(client);
+        return;
+    }
+
+    const std::size_t head_end = client.input.find("\r\n\r\n");
+    if (head_end == std::string::npos) {
+        if (client.input.size() > kMaxRequestSize) {
+            enqueue(client, makeResponse("431 Request Header Fields Too Large", "text/plain", "Request too large\n"), false);
+            client.close_after_flush = true;
+        }
+        return;
+    }
+    const std::string request = client.input.substr(0, head_end + 2);
+    client.input.erase(0, head_end + 4);
+    handleRequest(client, request);
+}
+
+void PulseLiveServer::handleRequest(Client& client, const std::string& request)
+{
+    // Request line: METHOD SP target SP version
+    const std::string_view head(request);
+    const std::size_t method_end = head.find(' ');
+    const std::size_t target_end = method_end == std::string_view::npos ? method_end : head.find(' ', method_end + 1);
+    if (target_end == std::string_view::npos) {
+        enqueue(client, makeResponse("400 Bad Request", "text/plain", "Malformed request\n"), false);
+        client.close_after_flush = true;
+        return;
+    }
+
+    const std::string_view method = head.substr(0, method_end);
+    const std::string_view target = head.substr(method_end + 1, target_end - method_end - 1);
+    const std::size_t query_begin = target.find('?');
+    const std::string_view path = target.substr(0, query_begin);
+    const std::string_view query = query_begin == std::string_view::npos ? std::string_view{} : target.substr(query_begin + 1);
+    const PulseWireFormat format = containsToken(query, "format=binary") ? PulseWireFormat::BINARY : PulseWireFormat::JSON;
+
+    if (method != "GET") {
+        enqueue(client, makeResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n"), false);
+        client.close_after_flush = true;
+        return;
+    }
+
+    if (path == "/state") {
+        const auto snapshot = m_data_manager.acquireSnapshot();
+        if (!snapshot) {
+            enqueue(client, makeResponse("503 Service Unavailable", "text/plain", "No state published yet\n"), false);
+        }
+        else {
+            PulseStateEncoder::encodeState(*snapshot, format, m_message_buffer);
+            enqueue(client, makeResponse("200 OK", format == PulseWireFormat::BINARY ? "application/octet-stream" : "application/json",
+                                         m_message_buffer), false);
+        }
+        client.close_after_flush = true;
+        return;
+    }
+
+    if (path == "/metrics") {
+        std::ostringstream metrics;
+        PulseProfiler::getInstance().writePrometheus(metrics);
+        enqueue(client, makeResponse("200 OK", "text/plain; version=0.0.4", metrics.str()), false);
+        client.close_after_flush = true;
+        return;
+    }
+
+    if (path == "/stream") {
+        const std::string_view key = findHeader(head, "Sec-WebSocket-Key");
+        if (!containsToken(findHeader(head, "Upgrade"), "websocket") || key.empty()) {
+            enqueue(client, makeResponse("426 Upgrade Required", "text/plain", "WebSocket upgrade required\n"), false);
+            client.close_after_flush = true;
+            return;
+        }
+
+        const auto digest = sha1(std::string(key) + kWebSocketGuid);
+        auto response = std::make_shared<std::string>("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n");
+        response->append("Sec-WebSocket-Accept: ").append(base64(digest.data(), digest.size())).append("\r\n\r\n");
+        enqueue(client, std::move(response), false);
+
+        client.stream = true;
+        client.format = format;
+        ++m_stream_clients;
+
+        // Start from the state the next delta is based on; without one, the first epoch sends a full state
+        if (m_current) {
+            sendState(client, *m_current);
+        }
+        else {
+            client.needs_state = true;
+        }
+        handleFrames(client);
+        return;
+    }
+
+    enqueue(client, makeResponse("404 Not Found", "text/plain", "Not found\n"), false);
+    client.close_after_flush = true;
+}
+
+void PulseLiveServer::handleFrames(Client& client)
+{
+    auto& input = client.input;
+    while (input.size() >= 2 && !client.close_after_flush) {
+        const auto byte0 = static_cast<std::uint8_t>(input[0]);
+        const auto byte1 = static_cast<std::uint8_t>(input[1]);
+        const std::uint8_t opcode = byte0 & 0x0F;
+        std::uint64_t length = byte1 & 0x7F;
+        std::size_t position = 2;
+
+        if (length == 126 || length == 127) {
+            const std::size_t bytes = length == 126 ? 2 : 8;
+            if (input.size() < position + bytes) {
+                return;
+            }
+            length = 0;
+            for (std::size_t i = 0; i < bytes; ++i) {
+                length = length << 8 | static_cast<std::uint8_t>(input[position + i]);
+            }
+            position += bytes;
+        }
+
+        // Clients must mask their frames
+        if (!(byte1 & 0x80) || length > kMaxFramePayload) {
+            client.closed = true;
+            return;
+        }
+        if (input.size() < position + 4 + length) {
+            return;
+        }
+
+        const char* mask = input.data() + position;
+        std::string payload = input.substr(position + 4, static_cast<std::size_t>(length));
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+        }
+        input.erase(0, position + 4 + static_cast<std::size_t>(length));
+
+        if (opcode == CLOSE) {
+            enqueue(client, makeFrame(CLOSE, payload.substr(0, std::min<std::size_t>(payload.size(), 2))), false);
+            client.close_after_flush = true;
+        }
+        else if (opcode == PING) {
+            enqueue(client, makeFrame(PONG, payload), false);
+        }
+        // Data and pong frames from clients carry nothing the server needs
+    }
+}
+
+void PulseLiveServer::streamSnapshot()
+{
+    auto snapshot = m_data_manager.acquireSnapshot();
+    if (!snapshot || snapshot->epoch == m_encoder.getEpoch()) {
+        return;
+    }
+
+    m_encoder.diff(*snapshot);
+
+    // Each message is encoded at most once per format and shared by all clients
+    Frame deltas[2];
+    Frame states[2];
+    for (auto& client : m_clients) {
+        if (!client->stream || client->closed || client->close_after_flush) {
+            continue;
+        }
+
+        const std::size_t format = static_cast<std::size_t>(client->format);
+        const std::uint8_t opcode = client->format == PulseWireFormat::BINARY ? BINARY : TEXT;
+        if (client->needs_state) {
+            if (!states[format]) {
+                PulseStateEncoder::encodeState(*snapshot, client->format, m_message_buffer);
+                states[format] = makeFrame(opcode, m_message_buffer);
+            }
+            client->needs_state = false;
+            enqueue(*client, states[format], true);
+        }
+        else {
+            if (!deltas[format]) {
+                m_encoder.encodeDelta(client->format, m_message_buffer);
+                deltas[format] = makeFrame(opcode, m_message_buffer);
+            }
+            enqueue(*client, deltas[format], true);
+        }
+    }
+
+    m_streamed_epoch = snapshot->epoch;
+    m_current = std::move(snapshot);
+}
+
+void PulseLiveServer::sendState(Client& client, const PulseStateSnapshot& snapshot)
+{
+    PulseStateEncoder::encodeState(snapshot, client.format, m_message_buffer);
+    enqueue(client, makeFrame(client.format == PulseWireFormat::BINARY ? BINARY : TEXT, m_message_buffer), false);
+}
+
+void PulseLiveServer::enqueue(Client& client, Frame frame, bool droppable)
+{
+    if (droppable && client.queued_bytes > 0 && client.queued_bytes + frame->size() > m_config.max_queued_bytes) {
+        // Too far behind: drop the stream frames not started yet, and this one, and resend the full state
+        // next epoch. Handshakes, the initial state and control frames stay queued, so the stream is
+        // never left without its upgrade response or base state
+        const auto started = client.output_offset > 0 ? client.output.begin() + 1 : client.output.begin();
+        const auto kept = std::remove_if(started, client.output.end(), [&](const Client::QueuedFrame& queued) {
+            if (queued.droppable) {
+                client.queued_bytes -= queued.data->size();
+            }
+            return queued.droppable;
+        });
+        client.output.erase(kept, client.output.end());
+        client.needs_state = true;
+        ++m_resyncs;
+        return;
+    }
+
+    client.queued_bytes += frame->size();
+    client.output.push_back(Client::QueuedFrame{std::move(frame), droppable});
+}
+
+void PulseLiveServer::flush(Client& client)
+{
+    while (!client.output.empty()) {
+        const std::string& data = *client.output.front().data;
+        const ssize_t sent = ::send(client.fd, data.data() + client.output_offset, data.size() - client.output_offset,
+                                    MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                client.closed = true;
+            }
+            return;
+        }
+
+        client.output_offset += static_cast<std::size_t>(sent);
+        client.queued_bytes -= static_cast<std::size_t>(sent);
+        if (client.output_offset == data.size()) {
+            client.output.pop_front();
+            client.output_offset = 0;
+        }
+    }
+
+    if (client.close_after_flush) {
+        client.closed = true;
+    }
+}
+
+void PulseLiveServer::closeSockets()
+{
+    closeFd(m_listen_fd);
+    closeFd(m_wake_fds[0]);
+    closeFd(m_wake_fds[1]);
+}
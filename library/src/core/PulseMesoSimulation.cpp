@@ -0,0 +1,528 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseMesoSimulation.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include "core/PulseReplicationRunner.h"
+
+namespace
+{
+    constexpr const char* kVehiclePrefix = "meso.";
+    constexpr std::size_t kVehiclePrefixLength = 5;
+
+    bool isPlan(const TrafficLightDurations& durations)
+    {
+        return durations.green >= 0.0 && durations.yellow >= 0.0 && durations.red >= 0.0
+            && durations.green + durations.yellow + durations.red > 0.0;
+    }
+}
+
+PulseMesoSimulation::PulseMesoSimulation(const std::vector<PulseIntersection*>& intersections, const PulseMesoConfig& config)
+    : m_config(config)
+{
+    if (!(config.time_step > 0.0) || !(config.free_flow_speed > 0.0) || !(config.saturation_flow > 0.0)
+        || !(config.jam_spacing > 0.0) || !(config.exit_probability >= 0.0 && config.exit_probability <= 1.0)) {
+        throw std::invalid_argument("Meso simulation parameters out of range.");
+    }
+
+    m_nodes.reserve(intersections.size());
+    for (const auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot simulate a null intersection.");
+        }
+        const auto position = intersection->getPosition();
+        m_node_index.emplace(intersection->getId(), static_cast<std::uint32_t>(m_nodes.size()));
+        m_nodes.push_back(Node{intersection->getId(), position.x, position.y, {}});
+    }
+
+    // Links in intersection order, then road ID, so runs do not depend on hash map iteration
+    for (std::uint32_t node = 0; node < intersections.size(); ++node) {
+        const std::map<int, const PulseRoadConnection*> roads = [&] {
+            std::map<int, const PulseRoadConnection*> sorted;
+            for (const auto& [road_id, road] : intersections[node]->getConnectedRoads()) {
+                sorted.emplace(road_id, &road);
+            }
+            return sorted;
+        }();
+
+        for (const auto& [road_id, road] : roads) {
+            auto target = m_node_index.find(road->getConnectedIntersection().getId());
+            if (target == m_node_index.end()) {
+                throw std::invalid_argument("Road " + std::to_string(road_id) + " of " + m_nodes[node].id + " leads outside the network.");
+            }
+
+            const auto& traffic_light = road->getTrafficLight();
+            auto [light, inserted] = m_light_index.try_emplace(traffic_light.getId(), static_cast<std::uint32_t>(m_lights.size()));
+            if (inserted) {
+                const auto durations = traffic_light.getDurations();
+                if (!isPlan(durations)) {
+                    throw std::invalid_argument("Traffic light " + traffic_light.getId() + " has no positive cycle.");
+                }
+                m_lights.push_back(Light{traffic_light.getId(), durations.green, durations.yellow, durations.red});
+            }
+
+            const double length = std::max(road->getDistance(), 0.0);
+            Link link{getLinkId(m_nodes[node].id, road_id), node, target->second, light->second, length,
+                      length / config.free_flow_speed,
+                      std::max<std::size_t>(1, static_cast<std::size_t>(length / config.jam_spacing)), {}};
+            m_nodes[node].outgoing.push_back(static_cast<std::uint32_t>(m_links.size()));
+            m_links.push_back(std::move(link));
+        }
+    }
+
+    for (const auto& node : m_nodes) {
+        m_statistics.emplace_back(node.id);
+    }
+}
+
+std::string PulseMesoSimulation::getLinkId(const std::string& intersection_id, int road_id)
+{
+    return intersection_id + "#" + std::to_string(road_id);
+}
+
+void PulseMesoSimulation::setDemand(const std::string& intersection_id, double vehicles_per_hour)
+{
+    auto node = m_node_index.find(intersection_id);
+    if (node == m_node_index.end()) {
+        throw std::invalid_argument("Unknown intersection: " + intersection_id);
+    }
+    if (m_nodes[node->second].outgoing.empty() || !(vehicles_per_hour >= 0.0)) {
+        throw std::invalid_argument("Demand needs an intersection with outgoing roads and a non-negative rate.");
+    }
+
+    auto origin = std::find_if(m_origins.begin(), m_origins.end(), [&](const Origin& o) { return o.node == node->second; });
+    if (origin == m_origins.end()) {
+        origin = m_origins.insert(m_origins.end(), Origin{node->second, 0.0, 0.0});
+    }
+    origin->rate = vehicles_per_hour / 3600.0;
+    origin->next_arrival = m_time + nextHeadway(origin->rate);
+}
+
+void PulseMesoSimulation::setTrafficLightPlan(const std::string& traffic_light_id, const TrafficLightDurations& durations, double offset)
+{
+    auto& light = m_lights[findLight(traffic_light_id)];
+    if (!isPlan(durations)) {
+        throw std::invalid_argument("Traffic light plan needs a positive cycle.");
+    }
+    light.green = durations.green;
+    light.yellow = durations.yellow;
+    light.red = durations.red;
+    light.offset = offset;
+    light.external = false;
+    updateLights();
+}
+
+void PulseMesoSimulation::advance(double seconds)
+{
+    requireRunning();
+    const double until = m_time + seconds;
+    while (m_time < until) {
+        stepSimulation();
+    }
+}
+
+const IntersectionStatistics& PulseMesoSimulation::getStatistics(const std::string& intersection_id) const
+{
+    auto node = m_node_index.find(intersection_id);
+    if (node == m_node_index.end()) {
+        throw std::invalid_argument("Unknown intersection: " + intersection_id);
+    }
+    return m_statistics[node->second];
+}
+
+double PulseMesoSimulation::getTotalDelay() const
+{
+    return m_total_delay;
+}
+
+double PulseMesoSimulation::getPendingDelay() const
+{
+    double delay = m_entry_delay;
+    for (const auto& link : m_links) {
+        for (const auto slot : link.vehicles) {
+            delay += std::max(0.0, m_time - m_vehicles[slot].queued_at);
+        }
+    }
+    return delay;
+}
+
+std::size_t PulseMesoSimulation::getVehicleCount() const
+{
+    return m_slot_by_serial.size();
+}
+
+std::size_t PulseMesoSimulation::getBlockedEntries() const
+{
+    std::size_t blocked = 0;
+    for (const auto& origin : m_origins) {
+        blocked += origin.blocked;
+    }
+    return blocked;
+}
+
+void PulseMesoSimulation::startSimulation()
+{
+    if (m_running) {
+        throw std::runtime_error("Meso simulation already running.");
+    }
+
+    for (auto& link : m_links) {
+        link.vehicles.clear();
+        link.discharge_credit = 0.0;
+    }
+    m_vehicles.clear();
+    m_free_slots.clear();
+    m_slot_by_serial.clear();
+    m_next_serial = 0;
+    m_statistics.clear();
+    for (const auto& node : m_nodes) {
+        m_statistics.emplace_back(node.id);
+    }
+    m_total_delay = 0.0;
+    m_entry_delay = 0.0;
+
+    m_time = 0.0;
+    m_draws = 0;
+    for (auto& origin : m_origins) {
+        origin.blocked = 0;
+        origin.next_arrival = nextHeadway(origin.rate);
+    }
+    updateLights();
+    m_running = true;
+}
+
+void PulseMesoSimulation::stepSimulation()
+{
+    requireRunning();
+    m_time += m_config.time_step;
+    updateLights();
+    dischargeLinks();
+    generateDemand();
+}
+
+void PulseMesoSimulation::stopSimulation()
+{
+    requireRunning();
+    m_running = false;
+}
+
+bool PulseMesoSimulation::isRunning() const
+{
+    return m_running;
+}
+
+void PulseMesoSimulation::setSeed(std::uint64_t seed)
+{
+    m_seed = seed;
+}
+
+std::vector<std::string> PulseMesoSimulation::getAllVehicles() const
+{
+    std::vector<std::string> ids;
+    fillVehicleIds(ids);
+    return ids;
+}
+
+std::pair<double, double> PulseMesoSimulation::getVehiclePosition(const std::string& vehicle_id) const
+{
+    const auto& vehicle = findVehicle(vehicle_id);
+    const auto& link = m_links[vehicle.link];
+    const auto& from = m_nodes[link.from];
+    const auto& to = m_nodes[link.to];
+
+    const double progress = link.travel_time > 0.0 ? std::min(1.0, (m_time - vehicle.entered_at) / link.travel_time) : 1.0;
+    return {from.x + (to.x - from.x) * progress, from.y + (to.y - from.y) * progress};
+}
+
+std::vector<std::string> PulseMesoSimulation::getAllTrafficLights() const
+{
+    std::vector<std::string> ids;
+    fillTrafficLightIds(ids);
+    return ids;
+}
+
+std::string PulseMesoSimulation::getTrafficLightState(const std::string& tl_id) const
+{
+    std::string state;
+    fillTrafficLightState(tl_id, state);
+    return state;
+}
+
+void PulseMesoSimulation::setTrafficLightState(const std::string& tl_id, const std::string& state)
+{
+    auto& light = m_lights[findLight(tl_id)];
+    light.external = true;
+    if (state.find_first_of("gG") != std::string::npos) {
+        light.state = TrafficLightState::GREEN;
+    }
+    else if (state.find_first_of("yY") != std::string::npos) {
+        light.state = TrafficLightState::YELLOW;
+    }
+    else {
+        light.state = TrafficLightState::RED;
+    }
+}
+
+void PulseMesoSimulation::fillVehicleIds(std::vector<std::string>& out) const
+{
+    std::size_t count = 0;
+    for (const auto& link : m_links) {
+        for (const auto slot : link.vehicles) {
+            if (count == out.size()) {
+                out.emplace_back();
+            }
+            auto& id = out[count++];
+            id.assign(kVehiclePrefix);
+            id.append(std::to_string(m_vehicles[slot].serial));
+        }
+    }
+    out.resize(count);
+}
+
+void PulseMesoSimulation::fillTrafficLightIds(std::vector<std::string>& out) const
+{
+    out.resize(m_lights.size());
+    for (std::size_t light = 0; light < m_lights.size(); ++light) {
+        out[light].assign(m_lights[light].id);
+    }
+}
+
+void PulseMesoSimulation::fillTrafficLightState(const std::string& tl_id, std::string& out) const
+{
+    // Lowercase SUMO signal characters, as PulseDataManager interprets them
+    switch (m_lights[findLight(tl_id)].state) {
+        case TrafficLightState::GREEN: out.assign("g"); break;
+        case TrafficLightState::YELLOW: out.assign("y"); break;
+        default: out.assign("r"); break;
+    }
+}
+
+double PulseMesoSimulation::getSimulationTime() const
+{
+    return m_time;
+}
+
+bool PulseMesoSimulation::fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const
+{
+    const auto& vehicle = findVehicle(vehicle_id);
+    const auto& link = m_links[vehicle.link];
+    out.road_id.assign(link.id);
+    out.lane_index = 0;
+    out.lane_length = link.length;
+
+    if (vehicle.queued_at > m_time) {
+        out.lane_position = link.length * (m_time - vehicle.entered_at) / link.travel_time;
+        out.speed = m_config.free_flow_speed;
+        return true;
+    }
+
+    // Queued vehicles stand one jam spacing apart, back from the stop line
+    std::size_t ahead = 0;
+    for (const auto slot : link.vehicles) {
+        if (m_vehicles[slot].serial == vehicle.serial) {
+            break;
+        }
+        ++ahead;
+    }
+    out.lane_position = std::max(0.0, link.length - static_cast<double>(ahead) * m_config.jam_spacing);
+    out.speed = 0.0;
+    return true;
+}
+
+bool PulseMesoSimulation::applySignalPlan(const PulseSignalPlan& plan)
+{
+    setTrafficLightPlan(plan.traffic_light_id, plan.durations, plan.offset);
+    return true;
+}
+
+void PulseMesoSimulation::updateLights()
+{
+    for (auto& light : m_lights) {
+        if (light.external) {
+            continue;
+        }
+        const double cycle = light.green + light.yellow + light.red;
+        double t = std::fmod(m_time - light.offset, cycle);
+        if (t < 0.0) {
+            t += cycle;
+        }
+        light.state = t < light.green ? TrafficLightState::GREEN
+                    : t < light.green + light.yellow ? TrafficLightState::YELLOW
+                    : TrafficLightState::RED;
+    }
+}
+
+void PulseMesoSimulation::dischargeLinks()
+{
+    const double capacity = m_config.saturation_flow * m_config.time_step;
+
+    for (std::uint32_t index = 0; index < m_links.size(); ++index) {
+        auto& link = m_links[index];
+        if (m_lights[link.light].state != TrafficLightState::GREEN) {
+            link.discharge_credit = 0.0;
+            continue;
+        }
+        link.discharge_credit = std::min(link.discharge_credit + capacity, std::max(capacity, 1.0));
+
+        while (link.discharge_credit >= 1.0 && !link.vehicles.empty()) {
+            const std::uint32_t slot = link.vehicles.front();
+            const Vehicle& vehicle = m_vehicles[slot];
+            if (vehicle.queued_at > m_time) {
+                break;
+            }
+            // Spillback: a full downstream link blocks the whole queue behind this vehicle
+            const std::uint32_t next = vehicle.next_link;
+            if (next != kExit && !hasStorage(next)) {
+                break;
+            }
+
+            link.vehicles.pop_front();
+            link.discharge_credit -= 1.0;
+            const double delay = m_time - vehicle.queued_at;
+            m_statistics[link.to].addVehiclePass(delay);
+            m_total_delay += delay;
+
+            if (next == kExit) {
+                releaseVehicle(slot);
+            }
+            else {
+                enterLink(next, slot, m_time);
+            }
+        }
+    }
+}
+
+void PulseMesoSimulation::generateDemand()
+{
+    for (auto& origin : m_origins) {
+        // Vehicles held back by a full entry link go first, in arrival order
+        while (origin.blocked > 0) {
+            const std::uint32_t link = chooseEntryLink(origin.node);
+            if (!hasStorage(link)) {
+                break;
+            }
+            enterLink(link, spawnVehicle(), m_time);
+            --origin.blocked;
+        }
+
+        while (origin.next_arrival <= m_time) {
+            const std::uint32_t link = chooseEntryLink(origin.node);
+            if (origin.blocked == 0 && hasStorage(link)) {
+                enterLink(link, spawnVehicle(), origin.next_arrival);
+            }
+            else {
+                ++origin.blocked;
+            }
+            origin.next_arrival += nextHeadway(origin.rate);
+        }
+        m_entry_delay += static_cast<double>(origin.blocked) * m_config.time_step;
+    }
+}
+
+bool PulseMesoSimulation::hasStorage(std::uint32_t link) const
+{
+    return m_links[link].vehicles.size() < m_links[link].storage;
+}
+
+void PulseMesoSimulation::enterLink(std::uint32_t link, std::uint32_t slot, double time)
+{
+    auto& vehicle = m_vehicles[slot];
+    vehicle.link = link;
+    vehicle.next_link = chooseNextLink(m_links[link].to);
+    vehicle.entered_at = time;
+    vehicle.queued_at = time + m_links[link].travel_time;
+    m_links[link].vehicles.push_back(slot);
+}
+
+std::uint32_t PulseMesoSimulation::chooseNextLink(std::uint32_t node)
+{
+    const auto& outgoing = m_nodes[node].outgoing;
+    if (outgoing.empty() || nextUniform() < m_config.exit_probability) {
+        return kExit;
+    }
+    return chooseEntryLink(node);
+}
+
+std::uint32_t PulseMesoSimulation::chooseEntryLink(std::uint32_t node)
+{
+    const auto& outgoing = m_nodes[node].outgoing;
+    const auto choice = static_cast<std::size_t>(nextUniform() * static_cast<double>(outgoing.size()));
+    return outgoing[std::min(choice, outgoing.size() - 1)];
+}
+
+double PulseMesoSimulation::nextUniform()
+{
+    // Element m_draws of the shared SplitMix64 stream: the same on every platform, unlike the standard distributions
+    return static_cast<double>(PulseReplicationRunner::deriveSeed(m_seed, m_draws++) >> 11) * 0x1.0p-53;
+}
+
+double PulseMesoSimulation::nextHeadway(double rate)
+{
+    if (rate <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return -std::log1p(-nextUniform()) / rate;
+}
+
+std::uint32_t PulseMesoSimulation::spawnVehicle()
+{
+    std::uint32_t slot;
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else {
+        slot = static_cast<std::uint32_t>(m_vehicles.size());
+        m_vehicles.emplace_back();
+    }
+    m_vehicles[slot].serial = m_next_serial++;
+    m_slot_by_serial.emplace(m_vehicles[slot].serial, slot);
+    return slot;
+}
+
+void PulseMesoSimulation::releaseVehicle(std::uint32_t slot)
+{
+    m_slot_by_serial.erase(m_vehicles[slot].serial);
+    m_free_slots.push_back(slot);
+}
+
+const PulseMesoSimulation::Vehicle& PulseMesoSimulation::findVehicle(const std::string& vehicle_id) const
+{
+    std::uint64_t serial = 0;
+    if (vehicle_id.compare(0, kVehiclePrefixLength, kVehiclePrefix) == 0) {
+        const char* begin = vehicle_id.data() + kVehiclePrefixLength;
+        const char* end = vehicle_id.data() + vehicle_id.size();
+        auto [last, error] = std::from_chars(begin, end, serial);
+        if (error == std::errc() && last == end) {
+            auto it = m_slot_by_serial.find(serial);
+            if (it != m_slot_by_serial.end()) {
+                return m_vehicles[it->second];
+            }
+        }
+    }
+    throw std::invalid_argument("Unknown vehicle: " + vehicle_id);
+}
+
+std::uint32_t PulseMesoSimulation::findLight(const std::string& traffic_light_id) const
+{
+    auto it = m_light_index.find(traffic_light_id);
+    if (it == m_light_index.end()) {
+        throw std::invalid_argument("Unknown traffic light: " + traffic_light_id);
+    }
+    return it->second;
+}
+
+void PulseMesoSimulation::requireRunning() const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot advance: meso simulation not running.");
+    }
+}
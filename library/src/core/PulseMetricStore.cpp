@@ -0,0 +1,660 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseMetricStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char kSegmentMagic[8] = "PULSEMS";
+    constexpr std::uint32_t kSegmentVersion = 1;
+    constexpr std::size_t kIndexStride = 256;       ///< Records per sparse index entry.
+    constexpr const char* kSegmentPrefix = "segment-";
+    constexpr const char* kSegmentExtension = ".pms";
+    constexpr const char* kRegistryFile = "intersections.txt";
+
+    /**
+     * @brief Fixed header at the start of every segment file.
+     */
+    struct SegmentHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_size;
+        std::uint32_t compacted;        ///< 1 if sorted by intersection, then interval; 0 if in append order.
+        std::uint32_t reserved;
+        std::uint64_t capacity;
+        std::uint64_t count;
+        std::uint64_t sequence;
+        std::uint64_t first_source;     ///< Compacted segments: sequence range of the segments merged into it.
+        std::uint64_t last_source;
+        std::int64_t min_interval;      ///< Compacted segments only.
+        std::int64_t max_interval;
+    };
+    static_assert(sizeof(SegmentHeader) % alignof(PulseMetricRecord) == 0);
+
+    /**
+     * @brief Sort key of a record: append segments are ordered by interval only.
+     */
+    struct Key
+    {
+        std::uint32_t intersection;
+        std::int64_t interval;
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(intersection, interval) < std::tie(other.intersection, other.interval);
+        }
+    };
+
+    std::string segmentName(std::uint64_t sequence)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%s%010llu%s", kSegmentPrefix, static_cast<unsigned long long>(sequence), kSegmentExtension);
+        return name;
+    }
+
+    std::runtime_error fileError(const std::string& action, const std::string& path)
+    {
+        return std::runtime_error("Failed to " + action + " " + path + ": " + std::strerror(errno));
+    }
+}
+
+/**
+ * @brief One memory-mapped segment file.
+ */
+class PulseMetricStore::Segment
+{
+public:
+    static std::shared_ptr<Segment> create(const std::string& path, std::uint64_t sequence, bool compacted, std::size_t capacity)
+    {
+        const std::size_t size = sizeof(SegmentHeader) + capacity * sizeof(PulseMetricRecord);
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw fileError("create", path);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const auto error = fileError("resize", path);
+            ::close(fd);
+            throw error;
+        }
+        auto segment = map(path, fd, size);
+
+        auto& header = *segment->m_header;
+        std::memcpy(header.magic, kSegmentMagic, sizeof(header.magic));
+        header.version = kSegmentVersion;
+        header.record_size = sizeof(PulseMetricRecord);
+        header.compacted = compacted ? 1 : 0;
+        header.capacity = capacity;
+        header.sequence = sequence;
+        segment->m_index = std::make_unique<Key[]>(capacity / kIndexStride + 1);
+        return segment;
+    }
+
+    static std::shared_ptr<Segment> open(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            throw fileError("open", path);
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(SegmentHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Corrupt segment: " + path);
+        }
+        auto segment = map(path, fd, static_cast<std::size_t>(status.st_size));
+
+        const auto& header = *segment->m_header;
+        if (std::memcmp(header.magic, kSegmentMagic, sizeof(header.magic)) != 0 || header.version != kSegmentVersion
+            || header.record_size != sizeof(PulseMetricRecord) || header.count > header.capacity
+            || segment->m_size < sizeof(SegmentHeader) + header.capacity * sizeof(PulseMetricRecord)) {
+            throw std::runtime_error("Corrupt segment: " + path);
+        }
+
+        segment->m_index = std::make_unique<Key[]>(header.capacity / kIndexStride + 1);
+        for (std::size_t i = 0; i < header.count; i += kIndexStride) {
+            segment->m_index[i / kIndexStride] = segment->keyOf(segment->m_records[i]);
+        }
+        segment->m_count.store(header.count, std::memory_order_release);
+        return segment;
+    }
+
+    ~Segment()
+    {
+        ::munmap(m_mapping, m_size);
+    }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    /**
+     * @brief Appends a record; the caller guarantees non-decreasing intervals. Writer thread only.
+     */
+    void append(const PulseMetricRecord& record)
+    {
+        const std::size_t count = m_count.load(std::memory_order_relaxed);
+        m_records[count] = record;
+        if (count % kIndexStride == 0) {
+            m_index[count / kIndexStride] = keyOf(record);
+        }
+        m_header->count = count + 1;
+        m_count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Calls fn for every record of the intersection with an interval in [from, to).
+     */
+    template <typename Fn>
+    void scan(std::uint32_t intersection, std::int64_t from, std::int64_t to, Fn&& fn) const
+    {
+        const std::size_t count = m_count.load(std::memory_order_acquire);
+        if (count == 0 || (isCompacted() && (m_header->max_interval < from || m_header->min_interval >= to))) {
+            return;
+        }
+
+        for (std::size_t i = lowerBound(Key{isCompacted() ? intersection : 0, from}, count); i < count; ++i) {
+            const auto& record = m_records[i];
+            if (record.interval >= to || (isCompacted() && record.intersection != intersection)) {
+                break;
+            }
+            if (record.intersection == intersection) {
+                fn(record);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies the records of the given append segments, sorts them by intersection and interval
+     *        and writes the header. Only for a segment created as compacted and not yet shared.
+     */
+    void fillFrom(const std::vector<std::shared_ptr<Segment>>& sources)
+    {
+        std::size_t count = 0;
+        for (const auto& source : sources) {
+            const std::size_t records = source->getCount();
+            std::copy_n(source->m_records, records, m_records + count);
+            count += records;
+        }
+        std::sort(m_records, m_records + count, [this](const PulseMetricRecord& lhs, const PulseMetricRecord& rhs) {
+            return keyOf(lhs) < keyOf(rhs);
+        });
+
+        auto& header = *m_header;
+        header.count = count;
+        header.first_source = std::numeric_limits<std::uint64_t>::max();
+        header.last_source = 0;
+        header.min_interval = std::numeric_limits<std::int64_t>::max();
+        header.max_interval = std::numeric_limits<std::int64_t>::min();
+        for (const auto& source : sources) {
+            header.first_source = std::min(header.first_source, source->getSequence());
+            header.last_source = std::max(header.last_source, source->getSequence());
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            header.min_interval = std::min(header.min_interval, m_records[i].interval);
+            header.max_interval = std::max(header.max_interval, m_records[i].interval);
+            if (i % kIndexStride == 0) {
+                m_index[i / kIndexStride] = keyOf(m_records[i]);
+            }
+        }
+        m_count.store(count, std::memory_order_release);
+    }
+
+    void sync(bool wait) const
+    {
+        ::msync(m_mapping, m_size, wait ? MS_SYNC : MS_ASYNC);
+    }
+
+    void setPath(std::string path) { m_path = std::move(path); }
+    [[nodiscard]] const std::string& getPath() const { return m_path; }
+    [[nodiscard]] std::uint64_t getSequence() const { return m_header->sequence; }
+    [[nodiscard]] bool isCompacted() const { return m_header->compacted != 0; }
+    [[nodiscard]] std::size_t getCount() const { return m_count.load(std::memory_order_acquire); }
+    [[nodiscard]] bool isFull() const { return getCount() == m_header->capacity; }
+    [[nodiscard]] std::uint64_t getFirstSource() const { return m_header->first_source; }
+    [[nodiscard]] std::uint64_t getLastSource() const { return m_header->last_source; }
+
+    /**
+     * @brief Latest interval stored, or the lowest value if empty.
+     */
+    [[nodiscard]] std::int64_t getMaxInterval() const
+    {
+        const std::size_t count = getCount();
+        if (count == 0) {
+            return std::numeric_limits<std::int64_t>::min();
+        }
+        return isCompacted() ? m_header->max_interval : m_records[count - 1].interval;
+    }
+
+private:
+    Segment(std::string path, void* mapping, std::size_t size)
+        : m_path(std::move(path)), m_mapping(mapping), m_size(size),
+          m_header(static_cast<SegmentHeader*>(mapping)),
+          m_records(reinterpret_cast<PulseMetricRecord*>(static_cast<char*>(mapping) + sizeof(SegmentHeader)))
+    {
+    }
+
+    static std::shared_ptr<Segment> map(const std::string& path, int fd, std::size_t size)
+    {
+        void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const auto error = fileError("map", path);
+            ::close(fd);
+            throw error;
+        }
+        ::close(fd);
+        return std::shared_ptr<Segment>(new Segment(path, mapping, size));
+    }
+
+    [[nodiscard]] Key keyOf(const PulseMetricRecord& record) const
+    {
+        return Key{isCompacted() ? record.intersection : 0, record.interval};
+    }
+
+    // The sparse index narrows the search to one stride of records
+    [[nodiscard]] std::size_t lowerBound(const Key& key, std::size_t count) const
+    {
+        const std::size_t entries = (count + kIndexStride - 1) / kIndexStride;
+        const std::size_t block = std::partition_point(m_index.get(), m_index.get() + entries,
+                                                       [&key](const Key& entry) { return entry < key; }) - m_index.get();
+        if (block == 0) {
+            return 0;
+        }
+        const std::size_t begin = (block - 1) * kIndexStride;
+        const std::size_t end = std::min(block * kIndexStride, count);
+        return std::partition_point(m_records + begin, m_records + end,
+                                    [this, &key](const PulseMetricRecord& record) { return keyOf(record) < key; }) - m_records;
+    }
+
+    std::string m_path;
+    void* m_mapping;
+    std::size_t m_size;
+    SegmentHeader* m_header;
+    PulseMetricRecord* m_records;
+    std::unique_ptr<Key[]> m_index;         ///< Fixed-size, so readers never see it move.
+    std::atomic<std::size_t> m_count{0};
+};
+
+PulseMetricStore::PulseMetricStore(const PulseMetricStoreConfig& config)
+    : m_config(config), m_last_interval(std::numeric_limits<std::int64_t>::min())
+{
+    if (config.directory.empty() || config.records_per_segment == 0) {
+        throw std::invalid_argument("Metric store needs a directory and a non-zero segment capacity.");
+    }
+
+    namespace fs = std::filesystem;
+    const fs::path directory(config.directory);
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        throw std::runtime_error("Failed to create metric store directory: " + config.directory);
+    }
+
+    m_registry_path = (directory / kRegistryFile).string();
+    {
+        std::ifstream registry(m_registry_path);
+        std::string id;
+        while (std::getline(registry, id)) {
+            m_handles.emplace(id, static_cast<std::uint32_t>(m_handles.size()));
+        }
+    }
+
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        const auto name = entry.path().filename().string();
+        if (!name.starts_with(kSegmentPrefix)) {
+            continue;
+        }
+        if (entry.path().extension() == ".tmp") {
+            fs::remove(entry.path());   // Unfinished compaction; its sources are still in place
+        }
+        else if (entry.path().extension() == kSegmentExtension) {
+            m_segments.push_back(Segment::open(entry.path().string()));
+        }
+    }
+
+    // Drop append segments that an interrupted compaction already merged
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> merged;
+    for (const auto& segment : m_segments) {
+        if (segment->isCompacted()) {
+            merged.emplace_back(segment->getFirstSource(), segment->getLastSource());
+        }
+    }
+    std::erase_if(m_segments, [&merged](const std::shared_ptr<Segment>& segment) {
+        const bool covered = !segment->isCompacted() && std::any_of(merged.begin(), merged.end(), [&segment](const auto& range) {
+            return segment->getSequence() >= range.first && segment->getSequence() <= range.second;
+        });
+        if (covered) {
+            std::filesystem::remove(segment->getPath());
+        }
+        return covered;
+    });
+
+    std::sort(m_segments.begin(), m_segments.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs->getSequence() < rhs->getSequence();
+    });
+    for (const auto& segment : m_segments) {
+        m_next_sequence = std::max(m_next_sequence, segment->getSequence() + 1);
+        m_last_interval = std::max(m_last_interval, segment->getMaxInterval());
+        if (!segment->isCompacted()) {
+            m_active = segment->isFull() ? nullptr : segment;
+        }
+    }
+
+    if (config.compaction_threshold > 0) {
+        m_worker = std::thread(&PulseMetricStore::runCompaction, this);
+    }
+}
+
+PulseMetricStore::~PulseMetricStore()
+{
+    if (m_worker.joinable()) {
+        {
+            std::lock_guard lock(m_worker_mutex);
+            m_stopping = true;
+        }
+        m_worker_wake.notify_one();
+        m_worker.join();
+    }
+    flush();
+}
+
+std::uint32_t PulseMetricStore::getHandle(const std::string& intersection_id)
+{
+    if (auto handle = findHandle(intersection_id)) {
+        return *handle;
+    }
+    if (intersection_id.empty() || intersection_id.find_first_of("\r\n") != std::string::npos) {
+        throw std::invalid_argument("Invalid intersection ID for the metric store.");
+    }
+
+    std::unique_lock lock(m_registry_mutex);
+    auto [it, inserted] = m_handles.try_emplace(intersection_id, static_cast<std::uint32_t>(m_handles.size()));
+    if (inserted) {
+        std::ofstream registry(m_registry_path, std::ios::app);
+        registry << intersection_id << '\n';
+        registry.flush();
+        if (!registry) {
+            m_handles.erase(it);
+            throw std::runtime_error("Failed to write " + m_registry_path);
+        }
+    }
+    return it->second;
+}
+
+std::optional<std::uint32_t> PulseMetricStore::findHandle(const std::string& intersection_id) const
+{
+    std::shared_lock lock(m_registry_mutex);
+    auto it = m_handles.find(intersection_id);
+    if (it == m_handles.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void PulseMetricStore::append(const PulseMetricRecord& record)
+{
+    {
+        std::shared_lock lock(m_registry_mutex);
+        if (record.intersection >= m_handles.size()) {
+            throw std::invalid_argument("Unknown intersection handle: " + std::to_string(record.intersection));
+        }
+    }
+    if (record.interval < m_last_interval) {
+        throw std::invalid_argument("Metric records must be appended in interval order.");
+    }
+
+    if (!m_active) {
+        m_active = createSegment(false, m_config.records_per_segment);
+    }
+    m_active->append(record);
+    m_last_interval = record.interval;
+
+    if (m_active->isFull()) {
+        sealActiveSegment();
+    }
+}
+
+void PulseMetricStore::recordInterval(const std::vector<PulseIntersection*>& intersections, std::int64_t interval)
+{
+    for (auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot record a null intersection.");
+        }
+        const std::uint32_t handle = getHandle(intersection->getId());
+        if (handle >= m_baselines.size()) {
+            m_baselines.resize(handle + 1);
+        }
+
+        const auto& statistics = intersection->getStatistics();
+        Baseline current{true, statistics.getTotalVehiclesPassed(), statistics.getTotalVehicleWaitingTime(),
+                         statistics.getTotalPedestriansPassed(), statistics.getTotalPedestrianWaitingTime()};
+        Baseline& previous = m_baselines[handle];
+        if (!previous.valid) {
+            previous = current;
+            continue;
+        }
+        // Counters only grow; smaller values mean the statistics were reset in between
+        if (current.vehicles < previous.vehicles || current.pedestrians < previous.pedestrians) {
+            previous = Baseline{true};
+        }
+
+        PulseMetricRecord record;
+        record.interval = interval;
+        record.intersection = handle;
+        record.vehicles = static_cast<std::uint32_t>(current.vehicles - previous.vehicles);
+        record.vehicle_waiting_time = current.vehicle_waiting_time - previous.vehicle_waiting_time;
+        record.pedestrians = static_cast<std::uint32_t>(current.pedestrians - previous.pedestrians);
+        record.pedestrian_waiting_time = current.pedestrian_waiting_time - previous.pedestrian_waiting_time;
+        append(record);
+        previous = current;
+    }
+}
+
+std::vector<PulseMetricBucket> PulseMetricStore::query(const std::string& intersection_id, std::int64_t from,
+                                                       std::int64_t to, std::int64_t bucket_width) const
+{
+    const auto handle = findHandle(intersection_id);
+    if (!handle) {
+        throw std::invalid_argument("Unknown intersection: " + intersection_id);
+    }
+    if (to < from || bucket_width <= 0) {
+        throw std::invalid_argument("Query needs a non-reversed range and a positive bucket width.");
+    }
+
+    const auto bucket_count = static_cast<std::size_t>((to - from + bucket_width - 1) / bucket_width);
+    std::vector<PulseMetricBucket> buckets(bucket_count, PulseMetricBucket{0, 0, 0.0, 0, 0.0, 0});
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        buckets[i].start = from + static_cast<std::int64_t>(i) * bucket_width;
+    }
+
+    std::vector<std::shared_ptr<Segment>> segments;
+    {
+        std::shared_lock lock(m_segments_mutex);
+        segments = m_segments;
+    }
+    for (const auto& segment : segments) {
+        segment->scan(*handle, from, to, [&](const PulseMetricRecord& record) {
+            auto& bucket = buckets[static_cast<std::size_t>((record.interval - from) / bucket_width)];
+            bucket.vehicles += record.vehicles;
+            bucket.vehicle_waiting_time += record.vehicle_waiting_time;
+            bucket.pedestrians += record.pedestrians;
+            bucket.pedestrian_waiting_time += record.pedestrian_waiting_time;
+            ++bucket.records;
+        });
+    }
+    return buckets;
+}
+
+void PulseMetricStore::flush()
+{
+    if (m_active) {
+        m_active->sync(false);
+    }
+}
+
+void PulseMetricStore::compact()
+{
+    compactSegments();
+}
+
+void PulseMetricStore::waitForCompaction()
+{
+    std::unique_lock lock(m_worker_mutex);
+    m_worker_idle.wait(lock, [this] { return !m_compaction_requested && !m_compaction_running; });
+    if (m_compaction_error) {
+        std::rethrow_exception(std::exchange(m_compaction_error, nullptr));
+    }
+}
+
+std::size_t PulseMetricStore::getSegmentCount() const
+{
+    std::shared_lock lock(m_segments_mutex);
+    return m_segments.size();
+}
+
+std::uint64_t PulseMetricStore::getRecordCount() const
+{
+    std::shared_lock lock(m_segments_mutex);
+    std::uint64_t count = 0;
+    for (const auto& segment : m_segments) {
+        count += segment->getCount();
+    }
+    return count;
+}
+
+std::shared_ptr<PulseMetricStore::Segment> PulseMetricStore::createSegment(bool compacted, std::size_t capacity)
+{
+    std::uint64_t sequence;
+    {
+        std::unique_lock lock(m_segments_mutex);
+        sequence = m_next_sequence++;
+    }
+
+    // Compacted segments only become visible under their final name once complete
+    auto path = std::filesystem::path(m_config.directory) / segmentName(sequence);
+    if (compacted) {
+        path += ".tmp";
+    }
+    auto segment = Segment::create(path.string(), sequence, compacted, capacity);
+    if (!compacted) {
+        std::unique_lock lock(m_segments_mutex);
+        m_segments.push_back(segment);
+    }
+    return segment;
+}
+
+void PulseMetricStore::sealActiveSegment()
+{
+    m_active->sync(false);
+    m_active.reset();
+
+    if (!m_worker.joinable()) {
+        return;
+    }
+    std::size_t sealed = 0;
+    {
+        std::shared_lock lock(m_segments_mutex);
+        for (const auto& segment : m_segments) {
+            sealed += segment->isCompacted() ? 0 : 1;
+        }
+    }
+    if (sealed >= m_config.compaction_threshold) {
+        {
+            std::lock_guard lock(m_worker_mutex);
+            m_compaction_requested = true;
+        }
+        m_worker_wake.notify_one();
+    }
+}
+
+void PulseMetricStore::compactSegments()
+{
+    std::lock_guard compaction(m_compaction_mutex);
+
+    std::vector<std::shared_ptr<Segment>> sources;
+    std::size_t records = 0;
+    {
+        std::shared_lock lock(m_segments_mutex);
+        for (const auto& segment : m_segments) {
+            // Sealed append segments are full and no longer written to
+            if (!segment->isCompacted() && segment->isFull()) {
+                sources.push_back(segment);
+                records += segment->getCount();
+            }
+        }
+    }
+    if (sources.empty()) {
+        return;
+    }
+
+    auto target = createSegment(true, records);
+    const std::string temporary = target->getPath();
+    try {
+        target->fillFrom(sources);
+        target->sync(true);
+        auto final_path = temporary.substr(0, temporary.size() - 4);
+        std::filesystem::rename(temporary, final_path);
+        target->setPath(std::move(final_path));
+    }
+    catch (...) {
+        std::filesystem::remove(temporary);
+        throw;
+    }
+
+    {
+        std::unique_lock lock(m_segments_mutex);
+        std::erase_if(m_segments, [&sources](const std::shared_ptr<Segment>& segment) {
+            return std::find(sources.begin(), sources.end(), segment) != sources.end();
+        });
+        m_segments.push_back(target);
+    }
+    // Readers still holding a source keep its mapping until they let go
+    for (const auto& source : sources) {
+        std::filesystem::remove(source->getPath());
+    }
+}
+
+void PulseMetricStore::runCompaction()
+{
+    std::unique_lock lock(m_worker_mutex);
+    while (true) {
+        m_worker_wake.wait(lock, [this] { return m_stopping || m_compaction_requested; });
+        if (m_stopping) {
+            return;
+        }
+        m_compaction_requested = false;
+        m_compaction_running = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            compactSegments();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        m_compaction_running = false;
+        if (error) {
+            m_compaction_error = error;
+        }
+        m_worker_idle.notify_all();
+    }
+}
@@ -0,0 +1,468 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseParquetWriter.h"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+namespace
+{
+    constexpr char kMagic[] = "PAR1";
+    constexpr std::size_t kStreamBufferSize = 1 << 20;
+    constexpr std::size_t kMaxGroupsPerRun = 63;    ///< Bit-packed groups of 8 values per run header.
+    constexpr std::uint32_t kUnused = UINT32_MAX;   ///< Dictionary entry not used by the current row group.
+
+    // Enum values from parquet.thrift
+    enum ParquetType : std::int32_t { INT64 = 2, DOUBLE = 5, BYTE_ARRAY = 6 };
+    enum ParquetEncoding : std::int32_t { PLAIN = 0, RLE = 3, RLE_DICTIONARY = 8 };
+    enum ParquetPageType : std::int32_t { DATA_PAGE = 0, DICTIONARY_PAGE = 2 };
+    constexpr std::int32_t kRequired = 0;
+    constexpr std::int32_t kConvertedUtf8 = 0;
+    constexpr std::int32_t kCodecGzip = 2;
+
+    void appendVarint(std::string& out, std::uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    /**
+     * @brief Minimal writer for the Thrift compact protocol used by Parquet metadata.
+     */
+    class CompactWriter
+    {
+    public:
+        enum FieldType : std::uint8_t { I32 = 5, I64 = 6, BINARY = 8, LIST = 9, STRUCT = 12 };
+
+        explicit CompactWriter(std::string& out) : m_out(out) { m_last_field.push_back(0); }
+
+        void i32(std::int16_t id, std::int32_t value)
+        {
+            field(id, I32);
+            appendVarint(m_out, zigzag(value));
+        }
+
+        void i64(std::int16_t id, std::int64_t value)
+        {
+            field(id, I64);
+            appendVarint(m_out, zigzag(value));
+        }
+
+        void binary(std::int16_t id, const std::string& value)
+        {
+            field(id, BINARY);
+            binaryElement(value);
+        }
+
+        void beginStructField(std::int16_t id)
+        {
+            field(id, STRUCT);
+            beginStruct();
+        }
+
+        void beginListField(std::int16_t id, FieldType element_type, std::size_t size)
+        {
+            field(id, LIST);
+            if (size < 15) {
+                m_out.push_back(static_cast<char>((size << 4) | element_type));
+            }
+            else {
+                m_out.push_back(static_cast<char>(0xF0 | element_type));
+                appendVarint(m_out, size);
+            }
+        }
+
+        void beginStruct() { m_last_field.push_back(0); }
+
+        void endStruct()
+        {
+            m_out.push_back(0);
+            m_last_field.pop_back();
+        }
+
+        void i32Element(std::int32_t value) { appendVarint(m_out, zigzag(value)); }
+
+        void binaryElement(const std::string& value)
+        {
+            appendVarint(m_out, value.size());
+            m_out.append(value);
+        }
+
+    private:
+        static std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        void field(std::int16_t id, FieldType type)
+        {
+            const int delta = id - m_last_field.back();
+            if (delta > 0 && delta <= 15) {
+                m_out.push_back(static_cast<char>((delta << 4) | type));
+            }
+            else {
+                m_out.push_back(static_cast<char>(type));
+                appendVarint(m_out, zigzag(id));
+            }
+            m_last_field.back() = id;
+        }
+
+        std::string& m_out;
+        std::vector<std::int16_t> m_last_field;
+    };
+
+    template <typename T>
+    void appendPlain(std::string& out, const std::vector<T>& values)
+    {
+        static_assert(sizeof(T) == 8);
+        if constexpr (std::endian::native == std::endian::little) {
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+        else {
+            for (const T value : values) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                for (int byte = 0; byte < 8; ++byte) {
+                    out.push_back(static_cast<char>(bits >> (8 * byte)));
+                }
+            }
+        }
+    }
+
+    void appendUint32(std::string& out, std::uint32_t value)
+    {
+        for (int byte = 0; byte < 4; ++byte) {
+            out.push_back(static_cast<char>(value >> (8 * byte)));
+        }
+    }
+
+    // Bit-packed runs of the RLE/bit-packing hybrid; the last group is padded with zeros
+    void appendBitPacked(std::string& out, const std::vector<std::uint32_t>& codes, int width)
+    {
+        for (std::size_t begin = 0; begin < codes.size();) {
+            const std::size_t values = std::min(codes.size() - begin, kMaxGroupsPerRun * 8);
+            const std::size_t groups = (values + 7) / 8;
+            appendVarint(out, (groups << 1) | 1);
+
+            std::uint64_t bits = 0;
+            int pending = 0;
+            for (std::size_t i = 0; i < groups * 8; ++i) {
+                const std::uint64_t code = i < values ? codes[begin + i] : 0;
+                bits |= code << pending;
+                pending += width;
+                while (pending >= 8) {
+                    out.push_back(static_cast<char>(bits & 0xFF));
+                    bits >>= 8;
+                    pending -= 8;
+                }
+            }
+            begin += values;
+        }
+    }
+
+    void gzip(const std::string& input, std::string& output, int level)
+    {
+        z_stream stream{};
+        if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Failed to initialize GZIP compression.");
+        }
+        output.resize(deflateBound(&stream, input.size()));
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        const int result = deflate(&stream, Z_FINISH);
+        output.resize(stream.total_out);
+        deflateEnd(&stream);
+        if (result != Z_STREAM_END) {
+            throw std::runtime_error("GZIP compression failed.");
+        }
+    }
+}
+
+void PulseColumnBatch::clear()
+{
+    for (auto& column : columns) {
+        column.int64_values.clear();
+        column.double_values.clear();
+        column.codes.clear();
+        column.dictionary_additions.clear();
+    }
+    rows = 0;
+}
+
+PulseParquetWriter::PulseParquetWriter(const std::string& path, std::vector<PulseColumnSpec> schema, int compression_level)
+    : m_path(path), m_schema(std::move(schema)), m_compression_level(compression_level),
+      m_stream_buffer(kStreamBufferSize)
+{
+    if (m_schema.empty()) {
+        throw std::invalid_argument("A Parquet file needs at least one column.");
+    }
+    if (compression_level < 0 || compression_level > 9) {
+        throw std::invalid_argument("Compression level must be between 0 and 9.");
+    }
+
+    m_file.rdbuf()->pubsetbuf(m_stream_buffer.data(), static_cast<std::streamsize>(m_stream_buffer.size()));
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        throw std::runtime_error("Failed to create file: " + path);
+    }
+    m_dictionaries.resize(m_schema.size());
+    writeRaw(kMagic);
+}
+
+PulseParquetWriter::~PulseParquetWriter()
+{
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+void PulseParquetWriter::writeRowGroup(const PulseColumnBatch& batch)
+{
+    if (m_closed) {
+        throw std::logic_error("Cannot write to a closed Parquet file.");
+    }
+    if (batch.columns.size() != m_schema.size()) {
+        throw std::invalid_argument("Batch does not match the schema of " + m_path);
+    }
+
+    // Validate everything first so a bad batch leaves the file untouched
+    for (std::size_t column = 0; column < m_schema.size(); ++column) {
+        const auto& values = batch.columns[column];
+        std::size_t count = 0;
+        switch (m_schema[column].type) {
+            case PulseColumnType::INT64: count = values.int64_values.size(); break;
+            case PulseColumnType::DOUBLE: count = values.double_values.size(); break;
+            case PulseColumnType::STRING: {
+                count = values.codes.size();
+                const std::size_t dictionary_size = m_dictionaries[column].size() + values.dictionary_additions.size();
+                for (const auto code : values.codes) {
+                    if (code >= dictionary_size) {
+                        throw std::invalid_argument("Unknown dictionary code in column " + m_schema[column].name);
+                    }
+                }
+                break;
+            }
+        }
+        if (count != batch.rows) {
+            throw std::invalid_argument("Column " + m_schema[column].name + " does not have one value per row.");
+        }
+    }
+    if (batch.rows == 0) {
+        return;
+    }
+    if (batch.rows > INT32_MAX) {
+        throw std::invalid_argument("Too many rows for one row group.");
+    }
+
+    RowGroupInfo row_group{static_cast<std::int64_t>(batch.rows), {}};
+    row_group.chunks.reserve(m_schema.size());
+
+    for (std::size_t column = 0; column < m_schema.size(); ++column) {
+        const auto& values = batch.columns[column];
+        ChunkInfo chunk{-1, 0, 0, 0};
+        m_body.clear();
+
+        switch (m_schema[column].type) {
+            case PulseColumnType::INT64:
+                appendPlain(m_body, values.int64_values);
+                break;
+            case PulseColumnType::DOUBLE:
+                appendPlain(m_body, values.double_values);
+                break;
+            case PulseColumnType::STRING: {
+                auto& dictionary = m_dictionaries[column];
+                dictionary.insert(dictionary.end(), values.dictionary_additions.begin(), values.dictionary_additions.end());
+                if (m_local_codes.size() < dictionary.size()) {
+                    m_local_codes.resize(dictionary.size(), kUnused);
+                }
+
+                // The page holds only the entries this row group uses, numbered in order of first use
+                m_used_codes.clear();
+                m_codes.clear();
+                for (const auto code : values.codes) {
+                    auto& local = m_local_codes[code];
+                    if (local == kUnused) {
+                        local = static_cast<std::uint32_t>(m_used_codes.size());
+                        m_used_codes.push_back(code);
+                    }
+                    m_codes.push_back(local);
+                }
+                for (const auto code : m_used_codes) {
+                    const auto& entry = dictionary[code];
+                    appendUint32(m_body, static_cast<std::uint32_t>(entry.size()));
+                    m_body.append(entry);
+                    m_local_codes[code] = kUnused;
+                }
+                writePage(true, m_used_codes.size(), m_body, chunk);
+
+                const int width = std::max(1, static_cast<int>(std::bit_width(m_used_codes.size() - 1)));
+                m_body.clear();
+                m_body.push_back(static_cast<char>(width));
+                appendBitPacked(m_body, m_codes, width);
+                break;
+            }
+        }
+        writePage(false, batch.rows, m_body, chunk);
+        row_group.chunks.push_back(chunk);
+    }
+
+    if (!m_file) {
+        throw std::runtime_error("Failed to write file: " + m_path);
+    }
+    m_rows += row_group.rows;
+    m_row_groups.push_back(std::move(row_group));
+}
+
+void PulseParquetWriter::close()
+{
+    if (m_closed) {
+        return;
+    }
+    m_closed = true;
+
+    std::string footer;
+    CompactWriter out(footer);
+    out.i32(1, 1);
+
+    out.beginListField(2, CompactWriter::STRUCT, m_schema.size() + 1);
+    out.beginStruct();
+    out.binary(4, "schema");
+    out.i32(5, static_cast<std::int32_t>(m_schema.size()));
+    out.endStruct();
+    for (const auto& column : m_schema) {
+        out.beginStruct();
+        out.i32(1, column.type == PulseColumnType::INT64 ? INT64 : column.type == PulseColumnType::DOUBLE ? DOUBLE : BYTE_ARRAY);
+        out.i32(3, kRequired);
+        out.binary(4, column.name);
+        if (column.type == PulseColumnType::STRING) {
+            out.i32(6, kConvertedUtf8);
+        }
+        out.endStruct();
+    }
+
+    out.i64(3, m_rows);
+
+    out.beginListField(4, CompactWriter::STRUCT, m_row_groups.size());
+    for (const auto& row_group : m_row_groups) {
+        out.beginStruct();
+        std::int64_t uncompressed = 0;
+        std::int64_t compressed = 0;
+
+        out.beginListField(1, CompactWriter::STRUCT, row_group.chunks.size());
+        for (std::size_t column = 0; column < row_group.chunks.size(); ++column) {
+            const auto& chunk = row_group.chunks[column];
+            const bool dictionary = chunk.dictionary_page_offset >= 0;
+            const auto& spec = m_schema[column];
+            uncompressed += chunk.uncompressed_size;
+            compressed += chunk.compressed_size;
+
+            out.beginStruct();
+            out.i64(2, dictionary ? chunk.dictionary_page_offset : chunk.data_page_offset);
+            out.beginStructField(3);
+            out.i32(1, spec.type == PulseColumnType::INT64 ? INT64 : spec.type == PulseColumnType::DOUBLE ? DOUBLE : BYTE_ARRAY);
+            out.beginListField(2, CompactWriter::I32, dictionary ? 3 : 2);
+            out.i32Element(PLAIN);
+            out.i32Element(RLE);
+            if (dictionary) {
+                out.i32Element(RLE_DICTIONARY);
+            }
+            out.beginListField(3, CompactWriter::BINARY, 1);
+            out.binaryElement(spec.name);
+            out.i32(4, kCodecGzip);
+            out.i64(5, row_group.rows);
+            out.i64(6, chunk.uncompressed_size);
+            out.i64(7, chunk.compressed_size);
+            out.i64(9, chunk.data_page_offset);
+            if (dictionary) {
+                out.i64(11, chunk.dictionary_page_offset);
+            }
+            out.endStruct();
+            out.endStruct();
+        }
+
+        const auto& first = row_group.chunks.front();
+        out.i64(2, uncompressed);
+        out.i64(3, row_group.rows);
+        out.i64(5, first.dictionary_page_offset >= 0 ? first.dictionary_page_offset : first.data_page_offset);
+        out.i64(6, compressed);
+        out.endStruct();
+    }
+
+    out.binary(6, "traffic_pulse_library");
+    out.endStruct();
+
+    appendUint32(footer, static_cast<std::uint32_t>(footer.size()));
+    footer.append(kMagic);
+    writeRaw(footer);
+
+    m_file.close();
+    if (!m_file) {
+        throw std::runtime_error("Failed to write file: " + m_path);
+    }
+}
+
+const std::vector<PulseColumnSpec>& PulseParquetWriter::getSchema() const
+{
+    return m_schema;
+}
+
+std::int64_t PulseParquetWriter::getRowCount() const
+{
+    return m_rows;
+}
+
+void PulseParquetWriter::writePage(bool dictionary, std::size_t values, std::string& body, ChunkInfo& chunk)
+{
+    if (body.size() > INT32_MAX) {
+        throw std::runtime_error("Page too large for " + m_path);
+    }
+    gzip(body, m_compressed, m_compression_level);
+
+    m_header.clear();
+    CompactWriter out(m_header);
+    out.i32(1, dictionary ? DICTIONARY_PAGE : DATA_PAGE);
+    out.i32(2, static_cast<std::int32_t>(body.size()));
+    out.i32(3, static_cast<std::int32_t>(m_compressed.size()));
+    if (dictionary) {
+        out.beginStructField(7);
+        out.i32(1, static_cast<std::int32_t>(values));
+        out.i32(2, PLAIN);
+        out.endStruct();
+    }
+    else {
+        out.beginStructField(5);
+        out.i32(1, static_cast<std::int32_t>(values));
+        out.i32(2, chunk.dictionary_page_offset >= 0 ? RLE_DICTIONARY : PLAIN);
+        out.i32(3, RLE);
+        out.i32(4, RLE);
+        out.endStruct();
+    }
+    out.endStruct();
+
+    (dictionary ? chunk.dictionary_page_offset : chunk.data_page_offset) = m_offset;
+    chunk.uncompressed_size += static_cast<std::int64_t>(m_header.size() + body.size());
+    chunk.compressed_size += static_cast<std::int64_t>(m_header.size() + m_compressed.size());
+    writeRaw(m_header);
+    writeRaw(m_compressed);
+}
+
+void PulseParquetWriter::writeRaw(const std::string& bytes)
+{
+    m_file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    m_offset += static_cast<std::int64_t>(bytes.size());
+}
@@ -0,0 +1,133 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulsePedestrianTable.h"
+
+#include <algorithm>
+
+void PulsePedestrianTable::update(std::span<const PulsePersonState> persons, std::uint64_t update)
+{
+    m_crossing_event_count = 0;
+
+    for (const auto& person : persons) {
+        auto it = m_slot_by_id.find(person.id);
+        const std::uint32_t slot = it != m_slot_by_id.end() ? it->second : acquireSlot(person.id);
+
+        if (m_roads[slot] != person.road_id) {
+            // Entering a crossing from anywhere but another crossing completes a crossing wait
+            const auto junction = crossingJunction(person.road_id);
+            if (!junction.empty() && crossingJunction(m_roads[slot]).empty()) {
+                if (m_crossing_event_count == m_crossing_events.size()) {
+                    m_crossing_events.emplace_back();
+                }
+                auto& event = m_crossing_events[m_crossing_event_count++];
+                event.junction_id.assign(junction);
+                event.waiting_time = std::max(m_waiting_times[slot], person.waiting_time);
+            }
+            m_roads[slot].assign(person.road_id);
+        }
+
+        m_positions[slot] = person.position;
+        m_speeds[slot] = person.speed;
+        m_waiting_times[slot] = person.waiting_time;
+        m_last_seen[slot] = update;
+    }
+
+    // Free the slots of departed pedestrians, keeping their buffers for the next arrivals
+    m_waiting_count = 0;
+    for (std::uint32_t slot = 0; slot < m_active.size(); ++slot) {
+        if (!m_active[slot]) {
+            continue;
+        }
+        if (m_last_seen[slot] != update) {
+            m_slot_by_id.erase(m_slot_by_id.find(m_ids[slot]));
+            m_active[slot] = 0;
+            m_free_slots.push_back(slot);
+        }
+        else if (m_waiting_times[slot] > 0.0) {
+            ++m_waiting_count;
+        }
+    }
+}
+
+void PulsePedestrianTable::clear()
+{
+    m_slot_by_id.clear();
+    m_free_slots.clear();
+    for (std::uint32_t slot = 0; slot < m_active.size(); ++slot) {
+        m_active[slot] = 0;
+        m_free_slots.push_back(slot);
+    }
+    m_waiting_count = 0;
+    m_crossing_event_count = 0;
+}
+
+std::size_t PulsePedestrianTable::size() const
+{
+    return m_slot_by_id.size();
+}
+
+std::size_t PulsePedestrianTable::getWaitingCount() const
+{
+    return m_waiting_count;
+}
+
+std::span<const PulseCrossingEvent> PulsePedestrianTable::getCrossingEvents() const
+{
+    return {m_crossing_events.data(), m_crossing_event_count};
+}
+
+std::optional<std::size_t> PulsePedestrianTable::find(const std::string& person_id) const
+{
+    auto it = m_slot_by_id.find(person_id);
+    if (it == m_slot_by_id.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::string_view PulsePedestrianTable::crossingJunction(std::string_view road_id)
+{
+    // Internal edges are ":<junction>_<kind><index>"; the junction ID may itself contain '_'
+    if (road_id.size() < 4 || road_id.front() != ':') {
+        return {};
+    }
+    const auto separator = road_id.rfind('_');
+    if (separator == std::string_view::npos || separator < 2 || separator + 2 >= road_id.size()
+        || road_id[separator + 1] != 'c') {
+        return {};
+    }
+    for (std::size_t i = separator + 2; i < road_id.size(); ++i) {
+        if (road_id[i] < '0' || road_id[i] > '9') {
+            return {};
+        }
+    }
+    return road_id.substr(1, separator - 1);
+}
+
+std::uint32_t PulsePedestrianTable::acquireSlot(const std::string& person_id)
+{
+    std::uint32_t slot;
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else {
+        slot = static_cast<std::uint32_t>(m_ids.size());
+        m_ids.emplace_back();
+        m_positions.emplace_back();
+        m_roads.emplace_back();
+        m_speeds.push_back(0.0);
+        m_waiting_times.push_back(0.0);
+        m_last_seen.push_back(0);
+        m_active.push_back(0);
+    }
+
+    m_ids[slot].assign(person_id);
+    m_roads[slot].clear();
+    m_waiting_times[slot] = 0.0;
+    m_active[slot] = 1;
+    m_slot_by_id.try_emplace(std::pmr::string(person_id, &m_node_resource), slot);
+    return slot;
+}
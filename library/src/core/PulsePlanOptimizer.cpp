@@ -0,0 +1,366 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulsePlanOptimizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+#include "core/PulseReplicationRunner.h"
+
+namespace
+{
+    constexpr const char* kCheckpointMagic = "pulse-plan-checkpoint";
+    constexpr int kCheckpointVersion = 1;
+
+    void writePlans(std::ostream& out, const std::vector<PulseSignalPlan>& plans)
+    {
+        for (const auto& plan : plans) {
+            const auto& d = plan.durations;
+            out << ' ' << d.red << ' ' << d.yellow << ' ' << d.green << ' ' << d.walk << ' ' << d.dont_walk << ' ' << plan.offset;
+        }
+        out << '\n';
+    }
+
+    void readPlans(std::istream& in, std::vector<PulseSignalPlan>& plans)
+    {
+        for (auto& plan : plans) {
+            auto& d = plan.durations;
+            in >> d.red >> d.yellow >> d.green >> d.walk >> d.dont_walk >> plan.offset;
+        }
+    }
+
+    void expect(std::istream& in, const char* keyword, const std::string& path)
+    {
+        std::string token;
+        if (!(in >> token) || token != keyword) {
+            throw std::runtime_error("Malformed plan search checkpoint " + path + ": expected " + keyword);
+        }
+    }
+}
+
+PulsePlanEvaluator::PulsePlanEvaluator(SimulationFactory factory, double horizon, std::size_t replications,
+                                       std::uint64_t seed, std::size_t thread_count)
+    : m_factory(std::move(factory)),
+      m_horizon(horizon),
+      m_replications(replications),
+      m_seed(seed),
+      m_thread_count(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency()))
+{
+    if (!m_factory) {
+        throw std::invalid_argument("Cannot create a plan evaluator without a simulation factory.");
+    }
+    if (!(horizon > 0.0) || replications == 0) {
+        throw std::invalid_argument("Plan evaluation needs a positive horizon and at least one replication.");
+    }
+}
+
+std::vector<double> PulsePlanEvaluator::evaluate(const std::vector<std::vector<PulseSignalPlan>>& candidates) const
+{
+    const std::size_t jobs = candidates.size() * m_replications;
+    std::vector<double> delays(jobs);
+    std::vector<std::exception_ptr> errors(jobs);
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&] {
+        std::unique_ptr<PulseMesoSimulation> simulation;
+        for (std::size_t job = next++; job < jobs; job = next++) {
+            try {
+                if (!simulation) {
+                    simulation = m_factory();
+                    if (!simulation) {
+                        throw std::runtime_error("Simulation factory returned no simulation.");
+                    }
+                }
+                for (const auto& plan : candidates[job / m_replications]) {
+                    simulation->setTrafficLightPlan(plan.traffic_light_id, plan.durations, plan.offset);
+                }
+                simulation->setSeed(PulseReplicationRunner::deriveSeed(m_seed, job % m_replications));
+                simulation->startSimulation();
+                simulation->advance(m_horizon);
+                delays[job] = simulation->getTotalDelay() + simulation->getPendingDelay();
+                simulation->stopSimulation();
+            }
+            catch (...) {
+                errors[job] = std::current_exception();
+                simulation.reset();     // Might be left running; the next job starts from a fresh one
+            }
+        }
+    };
+
+    const std::size_t thread_count = std::min(m_thread_count, std::max<std::size_t>(jobs, 1));
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Summed in replication order, so the result is independent of scheduling
+    std::vector<double> fitness(candidates.size(), 0.0);
+    for (std::size_t candidate = 0; candidate < candidates.size(); ++candidate) {
+        for (std::size_t replication = 0; replication < m_replications; ++replication) {
+            fitness[candidate] += delays[candidate * m_replications + replication];
+        }
+        fitness[candidate] /= static_cast<double>(m_replications);
+    }
+    return fitness;
+}
+
+PulsePlanOptimizer::PulsePlanOptimizer(const PulsePlanEvaluator& evaluator, std::vector<PulseSignalPlan> initial_plans,
+                                       const PulsePlanSearchConfig& config)
+    : m_evaluator(evaluator), m_config(config)
+{
+    if (config.population_size == 0 || config.elite_count > config.population_size || config.tournament_size == 0
+        || !(config.mutation_rate >= 0.0 && config.mutation_rate <= 1.0) || !(config.mutation_step >= 0.0)
+        || !(config.min_green > 0.0 && config.min_green <= config.max_green)
+        || !(config.min_red > 0.0 && config.min_red <= config.max_red)) {
+        throw std::invalid_argument("Plan search parameters out of range.");
+    }
+    if (initial_plans.empty()) {
+        throw std::invalid_argument("Plan search needs at least one traffic light.");
+    }
+
+    std::unordered_set<std::string> seen;
+    for (auto& plan : initial_plans) {
+        if (plan.traffic_light_id.empty() || plan.traffic_light_id.find('\n') != std::string::npos
+            || !seen.insert(plan.traffic_light_id).second) {
+            throw std::invalid_argument("Invalid or duplicate traffic light in plan search: " + plan.traffic_light_id);
+        }
+        plan.durations.green = std::clamp(plan.durations.green, config.min_green, config.max_green);
+        plan.durations.red = std::clamp(plan.durations.red, config.min_red, config.max_red);
+        m_lights.push_back(plan.traffic_light_id);
+    }
+
+    m_population.push_back(Individual{initial_plans});
+    while (m_population.size() < config.population_size) {
+        auto plans = initial_plans;
+        mutate(plans);
+        m_population.push_back(Individual{std::move(plans)});
+    }
+}
+
+void PulsePlanOptimizer::step()
+{
+    std::vector<std::vector<PulseSignalPlan>> batch;
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < m_population.size(); ++i) {
+        if (!m_population[i].scored) {
+            batch.push_back(m_population[i].plans);
+            pending.push_back(i);
+        }
+    }
+    const auto scores = m_evaluator.evaluate(batch);
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        m_population[pending[i]].fitness = scores[i];
+        m_population[pending[i]].scored = true;
+    }
+
+    std::stable_sort(m_population.begin(), m_population.end(),
+                     [](const Individual& a, const Individual& b) { return a.fitness < b.fitness; });
+    if (m_generation == 0 || m_population.front().fitness < m_best.fitness) {
+        m_best = PulsePlanCandidate{m_population.front().plans, m_population.front().fitness};
+    }
+    m_history.push_back(m_best.fitness);
+    ++m_generation;
+
+    std::vector<Individual> next(m_population.begin(), m_population.begin() + static_cast<std::ptrdiff_t>(m_config.elite_count));
+    while (next.size() < m_config.population_size) {
+        const auto& first = selectParent();
+        const auto& second = selectParent();
+
+        Individual child{first.plans};
+        for (std::size_t light = 0; light < child.plans.size(); ++light) {
+            if (nextUniform() < 0.5) {
+                child.plans[light] = second.plans[light];
+            }
+        }
+        mutate(child.plans);
+        next.push_back(std::move(child));
+    }
+    m_population = std::move(next);
+}
+
+const PulsePlanCandidate& PulsePlanOptimizer::run(std::size_t generations)
+{
+    for (std::size_t i = 0; i < generations; ++i) {
+        step();
+    }
+    return getBest();
+}
+
+const PulsePlanCandidate& PulsePlanOptimizer::getBest() const
+{
+    if (m_generation == 0) {
+        throw std::logic_error("No plan search generation scored yet.");
+    }
+    return m_best;
+}
+
+std::size_t PulsePlanOptimizer::getGeneration() const
+{
+    return m_generation;
+}
+
+const std::vector<double>& PulsePlanOptimizer::getHistory() const
+{
+    return m_history;
+}
+
+void PulsePlanOptimizer::saveCheckpoint(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write plan search checkpoint: " + path);
+    }
+    out.precision(std::numeric_limits<double>::max_digits10);
+
+    out << kCheckpointMagic << ' ' << kCheckpointVersion << '\n';
+    out << "lights " << m_lights.size() << '\n';
+    for (const auto& light : m_lights) {
+        out << light << '\n';
+    }
+    out << "generation " << m_generation << " draws " << m_draws << '\n';
+    out << "history " << m_history.size();
+    for (const double fitness : m_history) {
+        out << ' ' << fitness;
+    }
+    out << "\nbest " << m_best.fitness;
+    writePlans(out, m_generation ? m_best.plans : m_population.front().plans);
+    out << "population " << m_population.size() << '\n';
+    for (const auto& individual : m_population) {
+        out << individual.scored << ' ' << individual.fitness;
+        writePlans(out, individual.plans);
+    }
+
+    if (!out.flush()) {
+        throw std::runtime_error("Cannot write plan search checkpoint: " + path);
+    }
+}
+
+void PulsePlanOptimizer::loadCheckpoint(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot read plan search checkpoint: " + path);
+    }
+
+    int version = 0;
+    expect(in, kCheckpointMagic, path);
+    in >> version;
+    if (version != kCheckpointVersion) {
+        throw std::runtime_error("Unsupported plan search checkpoint version in " + path);
+    }
+
+    std::size_t light_count = 0;
+    expect(in, "lights", path);
+    in >> light_count >> std::ws;
+    std::vector<std::string> lights(light_count);
+    for (auto& light : lights) {
+        std::getline(in, light);
+    }
+    if (!in) {
+        throw std::runtime_error("Malformed plan search checkpoint " + path);
+    }
+    if (lights != m_lights) {
+        throw std::invalid_argument("Checkpoint " + path + " searches other traffic lights.");
+    }
+
+    std::size_t generation = 0;
+    std::uint64_t draws = 0;
+    std::size_t history_size = 0;
+    expect(in, "generation", path);
+    in >> generation;
+    expect(in, "draws", path);
+    in >> draws;
+    expect(in, "history", path);
+    in >> history_size;
+    std::vector<double> history(in ? history_size : 0);
+    for (auto& fitness : history) {
+        in >> fitness;
+    }
+
+    // Plan sets are read into copies of the initial ones, which carry the light IDs
+    PulsePlanCandidate best{m_population.front().plans};
+    expect(in, "best", path);
+    in >> best.fitness;
+    readPlans(in, best.plans);
+
+    std::size_t population_size = 0;
+    expect(in, "population", path);
+    in >> population_size;
+    if (in && population_size != m_config.population_size) {
+        throw std::invalid_argument("Checkpoint " + path + " has another population size.");
+    }
+    std::vector<Individual> population(in ? population_size : 0, Individual{best.plans});
+    for (auto& individual : population) {
+        in >> individual.scored >> individual.fitness;
+        readPlans(in, individual.plans);
+    }
+    if (!in || history.size() != generation) {
+        throw std::runtime_error("Malformed plan search checkpoint " + path);
+    }
+
+    m_generation = generation;
+    m_draws = draws;
+    m_history = std::move(history);
+    m_best = std::move(best);
+    m_population = std::move(population);
+}
+
+double PulsePlanOptimizer::nextUniform()
+{
+    // Element m_draws of a SplitMix64 stream; a checkpoint only needs the counter
+    return static_cast<double>(PulseReplicationRunner::deriveSeed(m_config.seed, m_draws++) >> 11) * 0x1.0p-53;
+}
+
+void PulsePlanOptimizer::mutate(std::vector<PulseSignalPlan>& plans)
+{
+    auto perturb = [&](double& value) {
+        if (nextUniform() < m_config.mutation_rate) {
+            value += (2.0 * nextUniform() - 1.0) * m_config.mutation_step;
+        }
+    };
+
+    for (auto& plan : plans) {
+        auto& durations = plan.durations;
+        perturb(durations.green);
+        perturb(durations.red);
+        perturb(plan.offset);
+        durations.green = std::clamp(durations.green, m_config.min_green, m_config.max_green);
+        durations.red = std::clamp(durations.red, m_config.min_red, m_config.max_red);
+
+        const double cycle = durations.green + durations.yellow + durations.red;
+        plan.offset = std::fmod(plan.offset, cycle);
+        if (plan.offset < 0.0) {
+            plan.offset += cycle;
+        }
+    }
+}
+
+const PulsePlanOptimizer::Individual& PulsePlanOptimizer::selectParent()
+{
+    // The population is sorted by fitness, so the lowest drawn index wins the tournament
+    std::size_t winner = m_population.size();
+    for (std::size_t i = 0; i < m_config.tournament_size; ++i) {
+        const auto drawn = static_cast<std::size_t>(nextUniform() * static_cast<double>(m_population.size()));
+        winner = std::min(winner, std::min(drawn, m_population.size() - 1));
+    }
+    return m_population[winner];
+}
@@ -0,0 +1,221 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseProfiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "core/PulseObjectPool.h"
+
+#include "entities/PulseIntersection.h"
+#include "entities/PulseTrafficLight.h"
+#include "entities/PulseVehicle.h"
+
+namespace
+{
+    constexpr double kSecondsPerNanosecond = 1e-9;
+
+    struct PoolStats
+    {
+        const char* name;
+        std::uint64_t allocations;
+        std::size_t slabs;
+        std::size_t live;
+    };
+
+    template <typename T>
+    PoolStats poolStatsOf(const char* name)
+    {
+        const auto& pool = PulseObjectPool<T>::getInstance();
+        return {name, pool.getAllocationCount(), pool.getSlabCount(), pool.getLiveCount()};
+    }
+
+    std::array<PoolStats, 3> collectPoolStats()
+    {
+        return {{
+            poolStatsOf<PulseVehicle>("vehicle"),
+            poolStatsOf<PulseTrafficLight>("traffic_light"),
+            poolStatsOf<PulseIntersection>("intersection"),
+        }};
+    }
+}
+
+PulseProfiler& PulseProfiler::getInstance()
+{
+    static PulseProfiler instance;
+    return instance;
+}
+
+bool PulseProfiler::isEnabled()
+{
+#ifdef PULSE_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PulseProfiler::record(PulseProfileStage stage, std::chrono::nanoseconds duration)
+{
+    auto& histogram = m_stages[static_cast<std::size_t>(stage)];
+    const auto ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+    const std::size_t bucket = std::min<std::size_t>(ns ? std::bit_width(ns) - 1 : 0, kBucketCount - 1);
+
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    std::uint64_t max = histogram.max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !histogram.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void PulseProfiler::setEntityCounts(std::size_t vehicles, std::size_t traffic_lights, std::size_t intersections)
+{
+    m_vehicles.store(vehicles, std::memory_order_relaxed);
+    m_traffic_lights.store(traffic_lights, std::memory_order_relaxed);
+    m_intersections.store(intersections, std::memory_order_relaxed);
+}
+
+std::uint64_t PulseProfiler::getCount(PulseProfileStage stage) const
+{
+    return m_stages[static_cast<std::size_t>(stage)].count.load(std::memory_order_relaxed);
+}
+
+double PulseProfiler::getTotalSeconds(PulseProfileStage stage) const
+{
+    const auto ns = m_stages[static_cast<std::size_t>(stage)].total_ns.load(std::memory_order_relaxed);
+    return static_cast<double>(ns) * kSecondsPerNanosecond;
+}
+
+void PulseProfiler::writeJson(std::ostream& out) const
+{
+    out << "{\"stages\":{";
+    for (std::size_t i = 0; i < PULSE_PROFILE_STAGE_COUNT; ++i) {
+        const auto& histogram = m_stages[i];
+        const auto count = histogram.count.load(std::memory_order_relaxed);
+        const double total = static_cast<double>(histogram.total_ns.load(std::memory_order_relaxed)) * kSecondsPerNanosecond;
+        const double max = static_cast<double>(histogram.max_ns.load(std::memory_order_relaxed)) * kSecondsPerNanosecond;
+
+        out << (i ? "," : "") << '"' << toString(static_cast<PulseProfileStage>(i)) << "\":{"
+            << "\"count\":" << count
+            << ",\"total_seconds\":" << total
+            << ",\"mean_seconds\":" << (count ? total / static_cast<double>(count) : 0.0)
+            << ",\"max_seconds\":" << max
+            << ",\"buckets\":[";
+        bool first = true;
+        for (std::size_t b = 0; b < kBucketCount; ++b) {
+            const auto bucket_count = histogram.buckets[b].load(std::memory_order_relaxed);
+            if (bucket_count == 0) {
+                continue;
+            }
+            const double upper = static_cast<double>(std::uint64_t{2} << b) * kSecondsPerNanosecond;
+            out << (first ? "" : ",") << "{\"le\":" << upper << ",\"count\":" << bucket_count << '}';
+            first = false;
+        }
+        out << "]}";
+    }
+
+    out << "},\"entities\":{"
+        << "\"vehicles\":" << m_vehicles.load(std::memory_order_relaxed)
+        << ",\"traffic_lights\":" << m_traffic_lights.load(std::memory_order_relaxed)
+        << ",\"intersections\":" << m_intersections.load(std::memory_order_relaxed)
+        << "},\"pools\":{";
+
+    const auto pools = collectPoolStats();
+    for (std::size_t i = 0; i < pools.size(); ++i) {
+        out << (i ? "," : "") << '"' << pools[i].name << "\":{\"allocations\":" << pools[i].allocations
+            << ",\"slabs\":" << pools[i].slabs << ",\"live\":" << pools[i].live << '}';
+    }
+    out << "}}";
+}
+
+void PulseProfiler::writePrometheus(std::ostream& out) const
+{
+    out << "# HELP pulse_stage_duration_seconds Duration of simulation step stages.\n"
+        << "# TYPE pulse_stage_duration_seconds histogram\n";
+    for (std::size_t i = 0; i < PULSE_PROFILE_STAGE_COUNT; ++i) {
+        const auto& histogram = m_stages[i];
+        const char* stage = toString(static_cast<PulseProfileStage>(i));
+
+        // Prometheus buckets are cumulative; emit only up to the highest non-empty bucket
+        std::size_t last = 0;
+        for (std::size_t b = 0; b < kBucketCount; ++b) {
+            if (histogram.buckets[b].load(std::memory_order_relaxed)) {
+                last = b;
+            }
+        }
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b <= last; ++b) {
+            cumulative += histogram.buckets[b].load(std::memory_order_relaxed);
+            const double upper = static_cast<double>(std::uint64_t{2} << b) * kSecondsPerNanosecond;
+            out << "pulse_stage_duration_seconds_bucket{stage=\"" << stage << "\",le=\"" << upper << "\"} " << cumulative << '\n';
+        }
+        const auto count = histogram.count.load(std::memory_order_relaxed);
+        out << "pulse_stage_duration_seconds_bucket{stage=\"" << stage << "\",le=\"+Inf\"} " << count << '\n'
+            << "pulse_stage_duration_seconds_sum{stage=\"" << stage << "\"} "
+            << static_cast<double>(histogram.total_ns.load(std::memory_order_relaxed)) * kSecondsPerNanosecond << '\n'
+            << "pulse_stage_duration_seconds_count{stage=\"" << stage << "\"} " << count << '\n';
+    }
+
+    out << "# HELP pulse_entities Number of entities held by the data manager.\n"
+        << "# TYPE pulse_entities gauge\n"
+        << "pulse_entities{kind=\"vehicle\"} " << m_vehicles.load(std::memory_order_relaxed) << '\n'
+        << "pulse_entities{kind=\"traffic_light\"} " << m_traffic_lights.load(std::memory_order_relaxed) << '\n'
+        << "pulse_entities{kind=\"intersection\"} " << m_intersections.load(std::memory_order_relaxed) << '\n';
+
+    const auto pools = collectPoolStats();
+    out << "# HELP pulse_pool_allocations_total Entities allocated from pools since start.\n"
+        << "# TYPE pulse_pool_allocations_total counter\n";
+    for (const auto& pool : pools) {
+        out << "pulse_pool_allocations_total{type=\"" << pool.name << "\"} " << pool.allocations << '\n';
+    }
+    out << "# HELP pulse_pool_slabs Slabs allocated from the heap by entity pools.\n"
+        << "# TYPE pulse_pool_slabs gauge\n";
+    for (const auto& pool : pools) {
+        out << "pulse_pool_slabs{type=\"" << pool.name << "\"} " << pool.slabs << '\n';
+    }
+    out << "# HELP pulse_pool_live_objects Entities currently allocated from pools.\n"
+        << "# TYPE pulse_pool_live_objects gauge\n";
+    for (const auto& pool : pools) {
+        out << "pulse_pool_live_objects{type=\"" << pool.name << "\"} " << pool.live << '\n';
+    }
+}
+
+void PulseProfiler::writeToFile(const std::string& path, bool prometheus) const
+{
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Cannot open metrics file: " + temporary);
+        }
+        if (prometheus) {
+            writePrometheus(file);
+        }
+        else {
+            writeJson(file);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace metrics file: " + path);
+    }
+}
+
+void PulseProfiler::reset()
+{
+    for (auto& histogram : m_stages) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.total_ns.store(0, std::memory_order_relaxed);
+        histogram.max_ns.store(0, std::memory_order_relaxed);
+    }
+    setEntityCounts(0, 0, 0);
+}
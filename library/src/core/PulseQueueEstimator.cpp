@@ -0,0 +1,178 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseQueueEstimator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+PulseQueueEstimator::PulseQueueEstimator(const std::vector<PulseIntersection*>& intersections,
+                                         const std::vector<PulseRoadBinding>& bindings,
+                                         double halting_speed, double vehicle_spacing, double gap_tolerance)
+    : m_halting_speed(halting_speed), m_vehicle_spacing(vehicle_spacing), m_gap_tolerance(gap_tolerance)
+{
+    if (!(halting_speed >= 0.0) || !(vehicle_spacing >= 0.0) || !(gap_tolerance >= 0.0)) {
+        throw std::invalid_argument("Halting speed, vehicle spacing and gap tolerance must not be negative.");
+    }
+
+    std::unordered_map<std::string, const PulseIntersection*> nodes;
+    for (const auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot watch a null intersection.");
+        }
+        nodes.emplace(intersection->getId(), intersection);
+    }
+
+    m_approaches.reserve(bindings.size());
+    for (const auto& binding : bindings) {
+        auto node = nodes.find(binding.intersection_id);
+        if (node == nodes.end()) {
+            throw std::invalid_argument("Unknown intersection: " + binding.intersection_id);
+        }
+        const auto& roads = node->second->getConnectedRoads();
+        auto road = roads.find(binding.road_id);
+        if (road == roads.end()) {
+            throw std::invalid_argument("Unknown road " + std::to_string(binding.road_id) + " at intersection " + binding.intersection_id);
+        }
+
+        const auto approach = static_cast<std::uint32_t>(m_approaches.size());
+        if (!m_source_roads.try_emplace(binding.source_road_id, approach).second) {
+            throw std::invalid_argument("Source road bound twice: " + binding.source_road_id);
+        }
+        m_approaches.push_back(PulseApproach{
+            road->second.getConnectedIntersection().getId(),
+            binding.intersection_id,
+            binding.road_id,
+            road->second.getTrafficLight().getId(),
+            binding.source_road_id,
+            road->second.getDistance()
+        });
+    }
+
+    m_queues.resize(m_approaches.size());
+    m_touched_update.resize(m_approaches.size());
+    m_touched.reserve(m_approaches.size());
+    m_active.reserve(m_approaches.size());
+}
+
+void PulseQueueEstimator::update(const PulseDataManager& data_manager)
+{
+    ++m_update;
+    m_touched.clear();
+    m_halted.clear();
+
+    data_manager.forEachVehicle([this](const PulseVehicle& vehicle) {
+        const auto& kinematics = vehicle.getKinematics();
+        if (kinematics.road_id.empty() || kinematics.speed > m_halting_speed) {
+            return;
+        }
+        auto it = m_source_roads.find(kinematics.road_id);
+        if (it != m_source_roads.end()) {
+            m_halted.push_back(HaltedVehicle{it->second, kinematics.lane_index, kinematics.lane_position, kinematics.lane_length});
+        }
+    });
+
+    // Per approach and lane, front of the queue first
+    std::sort(m_halted.begin(), m_halted.end(), [](const HaltedVehicle& a, const HaltedVehicle& b) {
+        if (a.approach != b.approach) {
+            return a.approach < b.approach;
+        }
+        if (a.lane_index != b.lane_index) {
+            return a.lane_index < b.lane_index;
+        }
+        return a.lane_position > b.lane_position;
+    });
+
+    // A lane's queue is the run of halted vehicles that starts at the stop line and ends at the first
+    // gap wider than a jammed vehicle; vehicles halted further upstream (parked, stopped at a bus
+    // stop, waiting to change lanes) are not part of it. Lane positions are measured on the source's
+    // lane, whose length may differ from the road connection's, so the stop line is the lane end
+    const double max_gap = m_vehicle_spacing + m_gap_tolerance;
+    for (std::size_t i = 0; i < m_halted.size();) {
+        const std::uint32_t approach = m_halted[i].approach;
+        std::size_t queued = 0;
+        double queue_length = 0.0;
+        bool spillback = false;
+
+        while (i < m_halted.size() && m_halted[i].approach == approach) {
+            const int lane_index = m_halted[i].lane_index;
+            const double lane_length = m_halted[i].lane_length > 0.0 ? m_halted[i].lane_length : m_approaches[approach].length;
+            double front = lane_length;
+            std::size_t lane_queued = 0;
+            bool contiguous = true;
+            for (; i < m_halted.size() && m_halted[i].approach == approach && m_halted[i].lane_index == lane_index; ++i) {
+                contiguous = contiguous && front - m_halted[i].lane_position <= max_gap;
+                if (contiguous) {
+                    front = m_halted[i].lane_position;
+                    ++lane_queued;
+                }
+            }
+            if (lane_queued > 0) {
+                queued += lane_queued;
+                const double lane_queue = lane_length - front + m_vehicle_spacing;
+                queue_length = std::max(queue_length, lane_queue);
+                spillback = spillback || lane_queue > lane_length;
+            }
+        }
+
+        m_touched_update[approach] = m_update;
+        m_touched.push_back(approach);
+        setQueue(approach, queued, queue_length, spillback);
+    }
+
+    // Queues that were present last time but have no halted vehicles now have dissolved
+    for (const auto approach : m_active) {
+        if (m_touched_update[approach] != m_update) {
+            setQueue(approach, 0, 0.0, false);
+        }
+    }
+    m_active.swap(m_touched);
+}
+
+void PulseQueueEstimator::addSpillbackListener(SpillbackListener listener)
+{
+    m_listeners.push_back(std::move(listener));
+}
+
+std::size_t PulseQueueEstimator::getApproachCount() const
+{
+    return m_approaches.size();
+}
+
+const PulseApproach& PulseQueueEstimator::getApproach(std::size_t approach) const
+{
+    return m_approaches.at(approach);
+}
+
+std::vector<std::size_t> PulseQueueEstimator::getApproaches(const std::string& intersection_id) const
+{
+    std::vector<std::size_t> result;
+    for (std::size_t approach = 0; approach < m_approaches.size(); ++approach) {
+        if (m_approaches[approach].intersection_id == intersection_id) {
+            result.push_back(approach);
+        }
+    }
+    return result;
+}
+
+PulseQueueState PulseQueueEstimator::getQueue(std::size_t approach) const
+{
+    return m_queues.at(approach);
+}
+
+void PulseQueueEstimator::setQueue(std::size_t approach, std::size_t queued, double queue_length, bool spillback)
+{
+    auto& queue = m_queues[approach];
+    queue.queued_vehicles = queued;
+    queue.queue_length = queue_length;
+    queue.max_queue_length = std::max(queue.max_queue_length, queue_length);
+
+    if (spillback != queue.spillback) {
+        queue.spillback = spillback;
+        const PulseSpillbackEvent event{approach, &m_approaches[approach], spillback, queue_length};
+        for (const auto& listener : m_listeners) {
+            listener(event);
+        }
+    }
+}
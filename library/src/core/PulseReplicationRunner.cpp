@@ -0,0 +1,112 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseReplicationRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+PulseReplicationRunner::PulseReplicationRunner(SourceFactory factory, std::size_t steps_per_replication, std::size_t thread_count)
+    : m_factory(std::move(factory)),
+      m_steps_per_replication(steps_per_replication),
+      m_thread_count(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency()))
+{
+    if (!m_factory) {
+        throw std::invalid_argument("Cannot create a replication runner without a source factory.");
+    }
+}
+
+void PulseReplicationRunner::setStepCallback(StepCallback callback)
+{
+    m_step_callback = std::move(callback);
+}
+
+std::vector<PulseReplicationResult> PulseReplicationRunner::run(std::size_t replications, std::uint64_t base_seed)
+{
+    std::vector<PulseReplicationResult> results(replications);
+    std::vector<std::exception_ptr> errors(replications);
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&] {
+        for (std::size_t index = next++; index < replications; index = next++) {
+            try {
+                results[index] = runReplication(index, deriveSeed(base_seed, index));
+            }
+            catch (...) {
+                errors[index] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t thread_count = std::min(m_thread_count, std::max<std::size_t>(replications, 1));
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
+
+std::uint64_t PulseReplicationRunner::deriveSeed(std::uint64_t base_seed, std::size_t replication)
+{
+    std::uint64_t z = base_seed + 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(replication) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+std::map<std::string, IntersectionStatistics> PulseReplicationRunner::aggregate(const std::vector<PulseReplicationResult>& results)
+{
+    std::map<std::string, IntersectionStatistics> combined;
+    for (const auto& result : results) {
+        for (const auto& [id, stats] : result.intersections) {
+            combined.try_emplace(id, id).first->second.merge(stats);
+        }
+    }
+    return combined;
+}
+
+PulseReplicationResult PulseReplicationRunner::runReplication(std::size_t replication, std::uint64_t seed) const
+{
+    auto source = m_factory(seed);
+    if (!source) {
+        throw std::runtime_error("Source factory returned no simulation for replication " + std::to_string(replication));
+    }
+    source->setSeed(seed);
+
+    TrafficSystem system(std::move(source));
+    system.initialize();
+
+    PulseReplicationResult result;
+    result.replication = replication;
+    result.seed = seed;
+
+    for (; result.steps < m_steps_per_replication && system.getSimulationSource().isRunning(); ++result.steps) {
+        system.stepSimulation();
+        if (m_step_callback) {
+            m_step_callback(system, result.steps);
+        }
+    }
+
+    for (auto& intersection : system.getDataManager().viewIntersections()) {
+        result.intersections.emplace(intersection.getId(), intersection.getStatistics());
+    }
+
+    if (system.getSimulationSource().isRunning()) {
+        system.stopSimulation();
+    }
+    return result;
+}
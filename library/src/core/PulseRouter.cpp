@@ -0,0 +1,596 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseRouter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+    // Witness searches give up after this many settled nodes and keep the shortcut,
+    // which costs a few extra edges but never correctness.
+    constexpr std::size_t kWitnessSettleLimit = 500;
+
+    using QueueEntry = std::pair<double, std::uint32_t>;
+
+    void pushQueue(std::vector<QueueEntry>& queue, double key, std::uint32_t node)
+    {
+        queue.emplace_back(key, node);
+        std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+    }
+
+    QueueEntry popQueue(std::vector<QueueEntry>& queue)
+    {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+        const QueueEntry top = queue.back();
+        queue.pop_back();
+        return top;
+    }
+
+    double straightLineDistance(const PulsePosition& from, const PulsePosition& to)
+    {
+        return std::hypot(to.x - from.x, to.y - from.y);
+    }
+}
+
+void PulseRouter::SearchLabels::resize(std::size_t nodes)
+{
+    distance.assign(nodes, kInfinity);
+    parent.assign(nodes, kNone);
+    stamp.assign(nodes, 0);
+    current = 0;
+}
+
+void PulseRouter::SearchLabels::clear()
+{
+    if (++current == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        current = 1;
+    }
+}
+
+double PulseRouter::SearchLabels::get(std::uint32_t node) const
+{
+    return stamp[node] == current ? distance[node] : kInfinity;
+}
+
+void PulseRouter::SearchLabels::set(std::uint32_t node, double value, std::uint32_t edge)
+{
+    stamp[node] = current;
+    distance[node] = value;
+    parent[node] = edge;
+}
+
+PulseRouter::PulseRouter(const std::vector<PulseIntersection*>& intersections, double free_flow_speed)
+    : m_free_flow_speed(free_flow_speed)
+{
+    if (!(free_flow_speed > 0.0)) {
+        throw std::invalid_argument("Free-flow speed must be positive.");
+    }
+
+    std::unordered_map<const PulseIntersection*, std::uint32_t> nodes;
+    for (const auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot route over a null intersection.");
+        }
+        const auto node = static_cast<std::uint32_t>(m_ids.size());
+        if (!m_index.try_emplace(intersection->getId(), node).second) {
+            throw std::invalid_argument("Duplicate intersection ID: " + intersection->getId());
+        }
+        nodes.emplace(intersection, node);
+        m_ids.push_back(intersection->getId());
+        m_positions.push_back(intersection->getPosition());
+    }
+
+    m_edge_begin.reserve(m_ids.size() + 1);
+    for (std::uint32_t node = 0; node < m_ids.size(); ++node) {
+        m_edge_begin.push_back(static_cast<std::uint32_t>(m_edges.size()));
+
+        // Sort by road ID so the graph does not depend on hash map iteration order
+        std::vector<std::pair<int, const PulseRoadConnection*>> roads;
+        for (const auto& [road_id, road] : intersections[node]->getConnectedRoads()) {
+            roads.emplace_back(road_id, &road);
+        }
+        std::sort(roads.begin(), roads.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        for (const auto& [road_id, road] : roads) {
+            auto target = nodes.find(&road->getConnectedIntersection());
+            if (target == nodes.end()) {
+                continue;
+            }
+            if (!(road->getDistance() >= 0.0)) {
+                throw std::invalid_argument("Road distance must not be negative: " + m_ids[node]);
+            }
+            m_edges.push_back(Edge{
+                node,
+                target->second,
+                road_id,
+                road->getDistance(),
+                road->getDistance() / m_free_flow_speed,
+                road->getTrafficLight().getId()
+            });
+        }
+    }
+    m_edge_begin.push_back(static_cast<std::uint32_t>(m_edges.size()));
+
+    m_forward.resize(m_ids.size());
+    m_backward.resize(m_ids.size());
+    updateHeuristicScale();
+}
+
+PulseRouter::PulseRouter(const PulseDataManager& data_manager, double free_flow_speed)
+    : PulseRouter(data_manager.getAllIntersections(), free_flow_speed) {}
+
+std::optional<PulseRoute> PulseRouter::findRoute(const std::string& from_id, const std::string& to_id, PulseRoutingAlgorithm algorithm)
+{
+    const auto from = indexOf(from_id);
+    const auto to = indexOf(to_id);
+    if (!search(from, to, algorithm, true)) {
+        return std::nullopt;
+    }
+    return buildRoute(from);
+}
+
+std::optional<double> PulseRouter::findTravelTime(const std::string& from_id, const std::string& to_id, PulseRoutingAlgorithm algorithm)
+{
+    return search(indexOf(from_id), indexOf(to_id), algorithm, false);
+}
+
+void PulseRouter::setTravelTime(const std::string& intersection_id, int road_id, double seconds)
+{
+    if (!(seconds >= 0.0)) {
+        throw std::invalid_argument("Travel time must not be negative.");
+    }
+
+    auto& edge = m_edges[findEdge(intersection_id, road_id)];
+    edge.weight = seconds;
+
+    // Keep the heuristic admissible; a looser bound only slows A* down
+    const double straight = straightLineDistance(m_positions[edge.source], m_positions[edge.target]);
+    if (straight > 0.0) {
+        m_heuristic_scale = std::min(m_heuristic_scale, seconds / straight);
+    }
+    m_hierarchy_valid = false;
+}
+
+double PulseRouter::getTravelTime(const std::string& intersection_id, int road_id) const
+{
+    return m_edges[findEdge(intersection_id, road_id)].weight;
+}
+
+void PulseRouter::resetTravelTimes()
+{
+    for (auto& edge : m_edges) {
+        edge.weight = edge.distance / m_free_flow_speed;
+    }
+    updateHeuristicScale();
+    m_hierarchy_valid = false;
+}
+
+void PulseRouter::preprocess()
+{
+    struct Arc
+    {
+        std::uint32_t node;
+        std::uint32_t edge;
+    };
+
+    struct Shortcut
+    {
+        std::uint32_t source;
+        std::uint32_t target;
+        double weight;
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    const std::size_t node_count = m_ids.size();
+    m_hierarchy_edges.clear();
+    m_shortcut_count = 0;
+
+    // Remaining graph among nodes not contracted yet
+    std::vector<std::vector<Arc>> out(node_count);
+    std::vector<std::vector<Arc>> in(node_count);
+
+    // Keeps only the cheapest edge per node pair. Edges between uncontracted nodes are not
+    // referenced by any shortcut yet, so they can be overwritten in place.
+    auto link = [&](std::uint32_t source, std::uint32_t target, double weight,
+                    std::uint32_t first, std::uint32_t second, std::uint32_t original) {
+        for (const auto& arc : out[source]) {
+            if (arc.node == target) {
+                auto& existing = m_hierarchy_edges[arc.edge];
+                if (weight < existing.weight) {
+                    existing = HierarchyEdge{source, target, weight, first, second, original};
+                    return true;
+                }
+                return false;
+            }
+        }
+        const auto edge = static_cast<std::uint32_t>(m_hierarchy_edges.size());
+        m_hierarchy_edges.push_back(HierarchyEdge{source, target, weight, first, second, original});
+        out[source].push_back(Arc{target, edge});
+        in[target].push_back(Arc{source, edge});
+        return true;
+    };
+
+    for (std::uint32_t e = 0; e < m_edges.size(); ++e) {
+        const auto& edge = m_edges[e];
+        if (edge.source != edge.target && std::isfinite(edge.weight)) {
+            link(edge.source, edge.target, edge.weight, kNone, kNone, e);
+        }
+    }
+
+    // Bounded Dijkstra from `source` that avoids the node being contracted
+    std::vector<double> witness_distance(node_count, kInfinity);
+    std::vector<std::uint32_t> touched;
+    std::vector<QueueEntry> witness_queue;
+    auto witnessSearch = [&](std::uint32_t source, std::uint32_t excluded, double limit) {
+        for (auto node : touched) {
+            witness_distance[node] = kInfinity;
+        }
+        touched.clear();
+        witness_queue.clear();
+
+        witness_distance[source] = 0.0;
+        touched.push_back(source);
+        pushQueue(witness_queue, 0.0, source);
+
+        std::size_t settled = 0;
+        while (!witness_queue.empty()) {
+            const auto [distance, node] = popQueue(witness_queue);
+            if (distance > witness_distance[node]) {
+                continue;
+            }
+            if (distance > limit || ++settled > kWitnessSettleLimit) {
+                break;
+            }
+            for (const auto& arc : out[node]) {
+                if (arc.node == excluded) {
+                    continue;
+                }
+                const double candidate = distance + m_hierarchy_edges[arc.edge].weight;
+                if (candidate < witness_distance[arc.node]) {
+                    if (witness_distance[arc.node] == kInfinity) {
+                        touched.push_back(arc.node);
+                    }
+                    witness_distance[arc.node] = candidate;
+                    pushQueue(witness_queue, candidate, arc.node);
+                }
+            }
+        }
+    };
+
+    auto collectShortcuts = [&](std::uint32_t node, std::vector<Shortcut>& shortcuts) {
+        shortcuts.clear();
+        for (const auto& incoming : in[node]) {
+            const double to_node = m_hierarchy_edges[incoming.edge].weight;
+            double limit = -1.0;
+            for (const auto& outgoing : out[node]) {
+                if (outgoing.node != incoming.node) {
+                    limit = std::max(limit, to_node + m_hierarchy_edges[outgoing.edge].weight);
+                }
+            }
+            if (limit < 0.0) {
+                continue;
+            }
+
+            witnessSearch(incoming.node, node, limit);
+            for (const auto& outgoing : out[node]) {
+                if (outgoing.node == incoming.node) {
+                    continue;
+                }
+                const double via = to_node + m_hierarchy_edges[outgoing.edge].weight;
+                if (witness_distance[outgoing.node] > via) {
+                    shortcuts.push_back(Shortcut{incoming.node, outgoing.node, via, incoming.edge, outgoing.edge});
+                }
+            }
+        }
+    };
+
+    // Contraction order: edge difference, contracted neighbours and hierarchy depth, updated lazily.
+    // The last two spread contraction evenly over the network, which keeps query search spaces small.
+    std::vector<std::size_t> contracted_neighbours(node_count, 0);
+    std::vector<std::size_t> depth(node_count, 0);
+    std::vector<Shortcut> shortcuts;
+    auto priority = [&](std::uint32_t node) {
+        collectShortcuts(node, shortcuts);
+        const double edge_difference = static_cast<double>(shortcuts.size()) - static_cast<double>(in[node].size() + out[node].size());
+        return 2.0 * edge_difference + static_cast<double>(contracted_neighbours[node]) + static_cast<double>(depth[node]);
+    };
+
+    std::vector<QueueEntry> order;
+    for (std::uint32_t node = 0; node < node_count; ++node) {
+        pushQueue(order, priority(node), node);
+    }
+
+    std::vector<std::vector<std::uint32_t>> up(node_count);
+    std::vector<std::vector<std::uint32_t>> down(node_count);
+    while (!order.empty()) {
+        const auto [stored, node] = popQueue(order);
+        const double current = priority(node);
+        if (!order.empty() && current > order.front().first) {
+            pushQueue(order, current, node);
+            continue;
+        }
+
+        // Remaining neighbours all rank higher than this node
+        for (const auto& arc : out[node]) {
+            up[node].push_back(arc.edge);
+            std::erase_if(in[arc.node], [node](const Arc& other) { return other.node == node; });
+            ++contracted_neighbours[arc.node];
+            depth[arc.node] = std::max(depth[arc.node], depth[node] + 1);
+        }
+        for (const auto& arc : in[node]) {
+            down[node].push_back(arc.edge);
+            std::erase_if(out[arc.node], [node](const Arc& other) { return other.node == node; });
+            ++contracted_neighbours[arc.node];
+            depth[arc.node] = std::max(depth[arc.node], depth[node] + 1);
+        }
+        out[node].clear();
+        in[node].clear();
+
+        // `shortcuts` still holds the result of priority(node)
+        for (const auto& shortcut : shortcuts) {
+            if (link(shortcut.source, shortcut.target, shortcut.weight, shortcut.first, shortcut.second, kNone)) {
+                ++m_shortcut_count;
+            }
+        }
+    }
+
+    auto flatten = [](const std::vector<std::vector<std::uint32_t>>& lists,
+                      std::vector<std::uint32_t>& begin, std::vector<std::uint32_t>& edges) {
+        begin.clear();
+        edges.clear();
+        for (const auto& list : lists) {
+            begin.push_back(static_cast<std::uint32_t>(edges.size()));
+            edges.insert(edges.end(), list.begin(), list.end());
+        }
+        begin.push_back(static_cast<std::uint32_t>(edges.size()));
+    };
+    flatten(up, m_up_begin, m_up_edges);
+    flatten(down, m_down_begin, m_down_edges);
+
+    m_hierarchy_valid = true;
+}
+
+bool PulseRouter::isPreprocessed() const
+{
+    return m_hierarchy_valid;
+}
+
+std::size_t PulseRouter::getNodeCount() const
+{
+    return m_ids.size();
+}
+
+std::size_t PulseRouter::getEdgeCount() const
+{
+    return m_edges.size();
+}
+
+std::size_t PulseRouter::getShortcutCount() const
+{
+    return m_shortcut_count;
+}
+
+std::uint32_t PulseRouter::indexOf(const std::string& intersection_id) const
+{
+    auto it = m_index.find(intersection_id);
+    if (it == m_index.end()) {
+        throw std::invalid_argument("Unknown intersection: " + intersection_id);
+    }
+    return it->second;
+}
+
+std::uint32_t PulseRouter::findEdge(const std::string& intersection_id, int road_id) const
+{
+    const auto node = indexOf(intersection_id);
+    for (auto e = m_edge_begin[node]; e < m_edge_begin[node + 1]; ++e) {
+        if (m_edges[e].road_id == road_id) {
+            return e;
+        }
+    }
+    throw std::invalid_argument("Unknown road " + std::to_string(road_id) + " at intersection " + intersection_id);
+}
+
+double PulseRouter::straightLineTime(std::uint32_t from, std::uint32_t to) const
+{
+    return m_heuristic_scale * straightLineDistance(m_positions[from], m_positions[to]);
+}
+
+void PulseRouter::updateHeuristicScale()
+{
+    double scale = kInfinity;
+    for (const auto& edge : m_edges) {
+        const double straight = straightLineDistance(m_positions[edge.source], m_positions[edge.target]);
+        if (straight > 0.0) {
+            scale = std::min(scale, edge.weight / straight);
+        }
+    }
+    m_heuristic_scale = std::isfinite(scale) ? scale : 0.0;
+}
+
+std::optional<double> PulseRouter::search(std::uint32_t from, std::uint32_t to, PulseRoutingAlgorithm algorithm, bool want_path)
+{
+    m_path.clear();
+    if (from == to) {
+        return 0.0;
+    }
+
+    switch (algorithm) {
+        case PulseRoutingAlgorithm::DIJKSTRA:
+            return searchGraph(from, to, false, want_path);
+        case PulseRoutingAlgorithm::A_STAR:
+            return searchGraph(from, to, true, want_path);
+        case PulseRoutingAlgorithm::CONTRACTION_HIERARCHY:
+            if (!m_hierarchy_valid) {
+                throw std::logic_error("Contraction hierarchy is missing or stale; call preprocess() first.");
+            }
+            return searchHierarchy(from, to, want_path);
+        case PulseRoutingAlgorithm::AUTO:
+        default:
+            return m_hierarchy_valid ? searchHierarchy(from, to, want_path) : searchGraph(from, to, true, want_path);
+    }
+}
+
+std::optional<double> PulseRouter::searchGraph(std::uint32_t from, std::uint32_t to, bool use_heuristic, bool want_path)
+{
+    auto heuristic = [&](std::uint32_t node) { return use_heuristic ? straightLineTime(node, to) : 0.0; };
+
+    auto& queue = m_forward_queue;
+    queue.clear();
+    m_forward.clear();
+    m_forward.set(from, 0.0, kNone);
+    pushQueue(queue, heuristic(from), from);
+
+    while (!queue.empty()) {
+        const auto [key, node] = popQueue(queue);
+        const double distance = m_forward.get(node);
+        if (key > distance + heuristic(node)) {
+            continue;
+        }
+
+        if (node == to) {
+            if (want_path) {
+                for (auto current = to; m_forward.parent[current] != kNone; current = m_edges[m_forward.parent[current]].source) {
+                    m_path.push_back(m_forward.parent[current]);
+                }
+                std::reverse(m_path.begin(), m_path.end());
+            }
+            return distance;
+        }
+
+        for (auto e = m_edge_begin[node]; e < m_edge_begin[node + 1]; ++e) {
+            const auto& edge = m_edges[e];
+            const double candidate = distance + edge.weight;
+            if (candidate < m_forward.get(edge.target)) {
+                m_forward.set(edge.target, candidate, e);
+                pushQueue(queue, candidate + heuristic(edge.target), edge.target);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<double> PulseRouter::searchHierarchy(std::uint32_t from, std::uint32_t to, bool want_path)
+{
+    auto& forward_queue = m_forward_queue;
+    auto& backward_queue = m_backward_queue;
+    forward_queue.clear();
+    backward_queue.clear();
+    m_forward.clear();
+    m_backward.clear();
+    m_forward.set(from, 0.0, kNone);
+    m_backward.set(to, 0.0, kNone);
+    pushQueue(forward_queue, 0.0, from);
+    pushQueue(backward_queue, 0.0, to);
+
+    double best = kInfinity;
+    std::uint32_t meeting = kNone;
+
+    // Both searches only climb the hierarchy; stop once neither can improve on the best meeting
+    while (!forward_queue.empty() || !backward_queue.empty()) {
+        const bool forward = !forward_queue.empty()
+            && (backward_queue.empty() || forward_queue.front().first <= backward_queue.front().first);
+        auto& queue = forward ? forward_queue : backward_queue;
+        auto& labels = forward ? m_forward : m_backward;
+        const auto& other = forward ? m_backward : m_forward;
+
+        const auto [distance, node] = popQueue(queue);
+        if (distance >= best) {
+            break;
+        }
+        if (distance > labels.get(node)) {
+            continue;
+        }
+
+        const double total = distance + other.get(node);
+        if (total < best) {
+            best = total;
+            meeting = node;
+        }
+
+        // Stall on demand: a node reachable more cheaply from above cannot be on a shortest up-path
+        const auto& stall_begin = forward ? m_down_begin : m_up_begin;
+        const auto& stall_edges = forward ? m_down_edges : m_up_edges;
+        bool stalled = false;
+        for (auto i = stall_begin[node]; i < stall_begin[node + 1] && !stalled; ++i) {
+            const auto& edge = m_hierarchy_edges[stall_edges[i]];
+            const auto higher = forward ? edge.source : edge.target;
+            stalled = labels.get(higher) + edge.weight < distance;
+        }
+        if (stalled) {
+            continue;
+        }
+
+        const auto& begin = forward ? m_up_begin : m_down_begin;
+        const auto& edges = forward ? m_up_edges : m_down_edges;
+        for (auto i = begin[node]; i < begin[node + 1]; ++i) {
+            const auto& edge = m_hierarchy_edges[edges[i]];
+            const auto next = forward ? edge.target : edge.source;
+            const double candidate = distance + edge.weight;
+            if (candidate < labels.get(next)) {
+                labels.set(next, candidate, edges[i]);
+                pushQueue(queue, candidate, next);
+            }
+        }
+    }
+
+    if (meeting == kNone) {
+        return std::nullopt;
+    }
+
+    if (want_path) {
+        std::vector<std::uint32_t> upward;
+        for (auto node = meeting; m_forward.parent[node] != kNone; node = m_hierarchy_edges[m_forward.parent[node]].source) {
+            upward.push_back(m_forward.parent[node]);
+        }
+        std::for_each(upward.rbegin(), upward.rend(), [this](std::uint32_t edge) { unpack(edge); });
+        for (auto node = meeting; m_backward.parent[node] != kNone; node = m_hierarchy_edges[m_backward.parent[node]].target) {
+            unpack(m_backward.parent[node]);
+        }
+    }
+    return best;
+}
+
+void PulseRouter::unpack(std::uint32_t hierarchy_edge)
+{
+    std::vector<std::uint32_t> stack{hierarchy_edge};
+    while (!stack.empty()) {
+        const auto& edge = m_hierarchy_edges[stack.back()];
+        stack.pop_back();
+        if (edge.first == kNone) {
+            m_path.push_back(edge.original);
+        }
+        else {
+            stack.push_back(edge.second);
+            stack.push_back(edge.first);
+        }
+    }
+}
+
+PulseRoute PulseRouter::buildRoute(std::uint32_t from) const
+{
+    PulseRoute route;
+    route.intersections.reserve(m_path.size() + 1);
+    route.roads.reserve(m_path.size());
+    route.signals.reserve(m_path.size());
+    route.intersections.push_back(m_ids[from]);
+
+    for (const auto e : m_path) {
+        const auto& edge = m_edges[e];
+        route.travel_time += edge.weight;
+        route.distance += edge.distance;
+        route.roads.push_back(edge.road_id);
+        route.intersections.push_back(m_ids[edge.target]);
+        route.signals.push_back(PulseRouteSignal{edge.traffic_light_id, m_ids[edge.target], route.travel_time});
+    }
+    return route;
+}
@@ -0,0 +1,493 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseScenarioCatalog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr char kCacheMagic[8] = "PULSESC";
+    constexpr std::uint32_t kCacheVersion = 2;
+    constexpr const char* kPreferredConfig = "osm.sumocfg";
+
+    // --- .sumocfg parsing ---
+
+    std::string stripComments(std::string xml)
+    {
+        std::size_t begin;
+        while ((begin = xml.find("<!--")) != std::string::npos) {
+            const std::size_t end = xml.find("-->", begin + 4);
+            xml.erase(begin, end == std::string::npos ? std::string::npos : end + 3 - begin);
+        }
+        return xml;
+    }
+
+    std::string unescape(std::string_view value)
+    {
+        static constexpr std::pair<std::string_view, char> kEntities[] = {
+            {"&amp;", '&'}, {"&quot;", '"'}, {"&apos;", '\''}, {"&lt;", '<'}, {"&gt;", '>'}};
+
+        std::string out;
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            bool replaced = false;
+            if (value[i] == '&') {
+                for (const auto& [entity, character] : kEntities) {
+                    if (value.substr(i, entity.size()) == entity) {
+                        out.push_back(character);
+                        i += entity.size() - 1;
+                        replaced = true;
+                        break;
+                    }
+                }
+            }
+            if (!replaced) {
+                out.push_back(value[i]);
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Value of the "value" attribute of the first <tag .../> element, as SUMO writes options.
+     */
+    std::optional<std::string> findOption(std::string_view xml, std::string_view tag)
+    {
+        for (std::size_t position = xml.find('<'); position != std::string_view::npos; position = xml.find('<', position + 1)) {
+            if (xml.substr(position + 1, tag.size()) != tag) {
+                continue;
+            }
+            const std::size_t after = position + 1 + tag.size();
+            if (after >= xml.size() || !(xml[after] == ' ' || xml[after] == '\t' || xml[after] == '\n' || xml[after] == '\r'
+                                         || xml[after] == '/' || xml[after] == '>')) {
+                continue;
+            }
+
+            const std::size_t close = xml.find('>', after);
+            const std::string_view element = xml.substr(after, close == std::string_view::npos ? std::string_view::npos : close - after);
+            for (std::size_t attribute = element.find("value"); attribute != std::string_view::npos; attribute = element.find("value", attribute + 5)) {
+                // Must be the whole attribute name, followed by ="..." or ='...'
+                if (attribute > 0 && element[attribute - 1] != ' ' && element[attribute - 1] != '\t' && element[attribute - 1] != '\n') {
+                    continue;
+                }
+                std::size_t quote = attribute + 5;
+                while (quote < element.size() && (element[quote] == ' ' || element[quote] == '=')) {
+                    ++quote;
+                }
+                if (quote >= element.size() || (element[quote] != '"' && element[quote] != '\'')) {
+                    continue;
+                }
+                const std::size_t end = element.find(element[quote], quote + 1);
+                if (end == std::string_view::npos) {
+                    return std::nullopt;
+                }
+                return unescape(element.substr(quote + 1, end - quote - 1));
+            }
+            return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<std::string> splitList(const std::string& value)
+    {
+        std::vector<std::string> items;
+        std::size_t begin = 0;
+        while (begin < value.size()) {
+            const std::size_t end = value.find_first_of(", ", begin);
+            const std::size_t stop = end == std::string::npos ? value.size() : end;
+            if (stop > begin) {
+                items.push_back(value.substr(begin, stop - begin));
+            }
+            begin = stop + 1;
+        }
+        return items;
+    }
+
+    // --- Binary cache ---
+
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(std::ostream& out, const std::string& value)
+    {
+        writeValue(out, static_cast<std::uint32_t>(value.size()));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void writeList(std::ostream& out, const std::vector<std::string>& values)
+    {
+        writeValue(out, static_cast<std::uint32_t>(values.size()));
+        for (const auto& value : values) {
+            writeString(out, value);
+        }
+    }
+
+    template <typename T>
+    void readValue(std::istream& in, T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            throw std::runtime_error("truncated");
+        }
+    }
+
+    void readString(std::istream& in, std::string& value)
+    {
+        std::uint32_t size = 0;
+        readValue(in, size);
+        value.resize(size);
+        if (!in.read(value.data(), size)) {
+            throw std::runtime_error("truncated");
+        }
+    }
+
+    void readList(std::istream& in, std::vector<std::string>& values)
+    {
+        std::uint32_t count = 0;
+        readValue(in, count);
+        values.resize(count);
+        for (auto& value : values) {
+            readString(in, value);
+        }
+    }
+
+    /**
+     * @brief Config of a snapshot directory, or an empty path if it has none.
+     */
+    fs::path selectConfig(const fs::path& directory)
+    {
+        std::vector<fs::path> configs;
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(directory, error)) {
+            if (entry.is_regular_file(error) && entry.path().extension() == ".sumocfg") {
+                if (entry.path().filename() == kPreferredConfig) {
+                    return entry.path();
+                }
+                configs.push_back(entry.path());
+            }
+        }
+        return configs.empty() ? fs::path{} : *std::min_element(configs.begin(), configs.end());
+    }
+
+    /**
+     * @brief First referenced input file that does not exist, or nullptr if all do.
+     */
+    const std::string* findMissingInput(const PulseScenarioDescriptor& scenario)
+    {
+        std::error_code error;
+        if (!fs::is_regular_file(scenario.net_file, error)) {
+            return &scenario.net_file;
+        }
+        for (const auto* files : {&scenario.route_files, &scenario.additional_files}) {
+            for (const auto& path : *files) {
+                if (!fs::is_regular_file(path, error)) {
+                    return &path;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<fs::path> sortedSubdirectories(const fs::path& directory)
+    {
+        std::vector<fs::path> directories;
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(directory, error)) {
+            if (entry.is_directory(error)) {
+                directories.push_back(entry.path());
+            }
+        }
+        std::sort(directories.begin(), directories.end());
+        return directories;
+    }
+}
+
+PulseScenarioCatalog::PulseScenarioCatalog(std::string root_directory, std::string cache_path)
+    : m_root(std::move(root_directory)), m_cache_path(std::move(cache_path))
+{
+}
+
+std::size_t PulseScenarioCatalog::scan()
+{
+    std::error_code error;
+    if (!fs::is_directory(m_root, error)) {
+        throw std::runtime_error("Scenario root directory not found: " + m_root);
+    }
+    if (!m_cache_path.empty() && m_cache.empty()) {
+        loadCache();
+    }
+
+    m_scenarios.clear();
+    m_index.clear();
+    m_parsed = 0;
+    m_cached = 0;
+
+    for (const auto& city : sortedSubdirectories(m_root)) {
+        for (const auto& snapshot : sortedSubdirectories(city)) {
+            const fs::path config = selectConfig(snapshot);
+            if (config.empty()) {
+                continue;
+            }
+
+            const std::string config_path = fs::absolute(config).lexically_normal().string();
+            const auto size = fs::file_size(config, error);
+            const auto modified = fs::last_write_time(config, error).time_since_epoch().count();
+
+            // The config is unchanged, but a hit must still see its inputs; invalid entries are re-parsed
+            const auto cached = m_cache.find(config_path);
+            if (cached != m_cache.end() && cached->second.config_size == size
+                && cached->second.config_modified == static_cast<std::int64_t>(modified)
+                && cached->second.valid && findMissingInput(cached->second) == nullptr) {
+                m_scenarios.push_back(cached->second);
+                ++m_cached;
+            }
+            else {
+                m_scenarios.push_back(parseConfig(config_path));
+                ++m_parsed;
+            }
+
+            auto& scenario = m_scenarios.back();
+            scenario.city = city.filename().string();
+            scenario.timestamp = snapshot.filename().string();
+            scenario.name = scenario.city + "/" + scenario.timestamp;
+            m_index.emplace(scenario.name, m_scenarios.size() - 1);
+        }
+    }
+
+    // Entries of configs that disappeared are dropped, so the cache mirrors the tree
+    const bool changed = m_parsed > 0 || m_cached != m_cache.size();
+    m_cache.clear();
+    for (const auto& scenario : m_scenarios) {
+        m_cache.emplace(scenario.config_path, scenario);
+    }
+    if (changed && !m_cache_path.empty()) {
+        saveCache();
+    }
+
+    return m_scenarios.size();
+}
+
+const std::vector<PulseScenarioDescriptor>& PulseScenarioCatalog::getScenarios() const
+{
+    return m_scenarios;
+}
+
+const PulseScenarioDescriptor* PulseScenarioCatalog::find(std::string_view name) const
+{
+    const auto it = m_index.find(std::string(name));
+    return it != m_index.end() ? &m_scenarios[it->second] : nullptr;
+}
+
+const PulseScenarioDescriptor* PulseScenarioCatalog::findLatest(std::string_view city) const
+{
+    // Scenarios are sorted by city, then timestamp
+    for (auto it = m_scenarios.rbegin(); it != m_scenarios.rend(); ++it) {
+        if (it->city == city && it->valid && it->variant_of.empty()) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> PulseScenarioCatalog::getCities() const
+{
+    std::vector<std::string> cities;
+    for (const auto& scenario : m_scenarios) {
+        if (cities.empty() || cities.back() != scenario.city) {
+            cities.push_back(scenario.city);
+        }
+    }
+    return cities;
+}
+
+std::size_t PulseScenarioCatalog::getParsedCount() const
+{
+    return m_parsed;
+}
+
+std::size_t PulseScenarioCatalog::getCachedCount() const
+{
+    return m_cached;
+}
+
+PulseScenarioDescriptor PulseScenarioCatalog::parseConfig(const std::string& config_path)
+{
+    PulseScenarioDescriptor scenario;
+    scenario.config_path = config_path;
+
+    std::error_code error;
+    scenario.config_size = fs::file_size(config_path, error);
+    scenario.config_modified = static_cast<std::int64_t>(fs::last_write_time(config_path, error).time_since_epoch().count());
+
+    std::ifstream file(config_path, std::ios::binary);
+    if (!file) {
+        scenario.error = "Cannot read " + config_path;
+        return scenario;
+    }
+    const std::string xml = stripComments(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+    if (xml.find("<sumoConfiguration") == std::string::npos && xml.find("<configuration") == std::string::npos) {
+        scenario.error = "Not a SUMO configuration: " + config_path;
+        return scenario;
+    }
+
+    const fs::path directory = fs::path(config_path).parent_path();
+    if (std::ifstream marker(directory / PulseScenarioCatalog::kVariantMarker); marker) {
+        std::getline(marker, scenario.variant_of);
+    }
+    const auto resolve = [&](const std::string& file_name) {
+        return (directory / file_name).lexically_normal().string();
+    };
+
+    const auto net_file = findOption(xml, "net-file");
+    if (!net_file || net_file->empty()) {
+        scenario.error = "No net-file in " + config_path;
+        return scenario;
+    }
+    scenario.net_file = resolve(*net_file);
+    if (const auto routes = findOption(xml, "route-files")) {
+        for (const auto& route : splitList(*routes)) {
+            scenario.route_files.push_back(resolve(route));
+        }
+    }
+    if (const auto additionals = findOption(xml, "additional-files")) {
+        for (const auto& additional : splitList(*additionals)) {
+            scenario.additional_files.push_back(resolve(additional));
+        }
+    }
+
+    try {
+        if (const auto begin = findOption(xml, "begin")) {
+            scenario.begin = std::stod(*begin);
+        }
+        if (const auto end = findOption(xml, "end")) {
+            scenario.end = std::stod(*end);
+        }
+        if (const auto step_length = findOption(xml, "step-length")) {
+            scenario.step_length = std::stod(*step_length);
+        }
+    }
+    catch (const std::exception&) {
+        scenario.error = "Invalid time option in " + config_path;
+        return scenario;
+    }
+    if (!(scenario.step_length > 0.0)) {
+        scenario.error = "Non-positive step-length in " + config_path;
+        return scenario;
+    }
+
+    // Every input must exist, so a scenario that parses cleanly also starts
+    if (const std::string* missing = findMissingInput(scenario)) {
+        scenario.error = "Missing input file: " + *missing;
+        return scenario;
+    }
+
+    scenario.valid = true;
+    return scenario;
+}
+
+void PulseScenarioCatalog::loadCache()
+{
+    std::ifstream in(m_cache_path, std::ios::binary);
+    if (!in) {
+        return;
+    }
+
+    // A cache that cannot be read is only a missed optimization; the scan parses everything instead
+    try {
+        char magic[sizeof(kCacheMagic)];
+        std::uint32_t version = 0;
+        std::uint32_t count = 0;
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kCacheMagic, sizeof(magic)) != 0) {
+            return;
+        }
+        readValue(in, version);
+        if (version != kCacheVersion) {
+            return;
+        }
+        readValue(in, count);
+
+        for (std::uint32_t i = 0; i < count; ++i) {
+            PulseScenarioDescriptor scenario;
+            std::uint8_t valid = 0;
+            readString(in, scenario.name);
+            readString(in, scenario.city);
+            readString(in, scenario.timestamp);
+            readString(in, scenario.config_path);
+            readString(in, scenario.net_file);
+            readList(in, scenario.route_files);
+            readList(in, scenario.additional_files);
+            readValue(in, scenario.begin);
+            readValue(in, scenario.end);
+            readValue(in, scenario.step_length);
+            readString(in, scenario.variant_of);
+            readValue(in, scenario.config_modified);
+            readValue(in, scenario.config_size);
+            readValue(in, valid);
+            readString(in, scenario.error);
+            scenario.valid = valid != 0;
+            const std::string key = scenario.config_path;
+            m_cache.insert_or_assign(key, std::move(scenario));
+        }
+    }
+    catch (const std::exception&) {
+        m_cache.clear();
+    }
+}
+
+void PulseScenarioCatalog::saveCache() const
+{
+    // Written next to the cache and renamed, so a crash never leaves a half-written cache behind
+    const std::string temporary = m_cache_path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to write scenario cache: " + temporary);
+        }
+
+        out.write(kCacheMagic, sizeof(kCacheMagic));
+        writeValue(out, kCacheVersion);
+        writeValue(out, static_cast<std::uint32_t>(m_scenarios.size()));
+        for (const auto& scenario : m_scenarios) {
+            writeString(out, scenario.name);
+            writeString(out, scenario.city);
+            writeString(out, scenario.timestamp);
+            writeString(out, scenario.config_path);
+            writeString(out, scenario.net_file);
+            writeList(out, scenario.route_files);
+            writeList(out, scenario.additional_files);
+            writeValue(out, scenario.begin);
+            writeValue(out, scenario.end);
+            writeValue(out, scenario.step_length);
+            writeString(out, scenario.variant_of);
+            writeValue(out, scenario.config_modified);
+            writeValue(out, scenario.config_size);
+            writeValue(out, static_cast<std::uint8_t>(scenario.valid ? 1 : 0));
+            writeString(out, scenario.error);
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write scenario cache: " + temporary);
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, m_cache_path, error);
+    if (error) {
+        throw std::runtime_error("Failed to write scenario cache: " + m_cache_path + ": " + error.message());
+    }
+}
@@ -0,0 +1,547 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseScenarioTransformer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "core/PulseDemandFile.h"
+#include "core/PulseScenarioCatalog.h"
+#include "core/PulseStateHasher.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct FileCounts {
+        std::size_t read = 0;
+        std::size_t written = 0;
+    };
+
+    // Uniform in [0, 1), a pure function of seed, trip id and salt
+    double unitHash(std::string_view id, std::uint64_t seed, std::uint64_t salt)
+    {
+        PulseStateHasher hasher(seed);
+        hasher.updateString(id);
+        hasher.updateValue(salt);
+        return static_cast<double>(hasher.digest() >> 11) * 0x1.0p-53;
+    }
+
+    std::string formatTime(double seconds)
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.2f", seconds);
+        return text;
+    }
+
+    double parseTime(std::string_view value)
+    {
+        try {
+            std::size_t used = 0;
+            const double seconds = std::stod(std::string(value), &used);
+            return used == value.size() ? seconds : -1.0;
+        }
+        catch (const std::exception&) {
+            return -1.0;
+        }
+    }
+
+    /**
+     * @brief Position and length of an attribute value in an element's start tag, or npos.
+     */
+    std::pair<std::size_t, std::size_t> findAttribute(std::string_view element, std::string_view name)
+    {
+        const std::size_t tag_end = element.find('>');
+        for (std::size_t position = element.find(name); position < tag_end; position = element.find(name, position + 1)) {
+            const char before = element[position - 1];
+            if (before != ' ' && before != '\t' && before != '\n' && before != '\r') {
+                continue;
+            }
+            std::size_t quote = position + name.size();
+            while (quote < tag_end && (element[quote] == ' ' || element[quote] == '\t')) {
+                ++quote;
+            }
+            if (quote >= tag_end || element[quote] != '=') {
+                continue;
+            }
+            ++quote;
+            while (quote < tag_end && (element[quote] == ' ' || element[quote] == '\t')) {
+                ++quote;
+            }
+            if (quote >= tag_end || (element[quote] != '"' && element[quote] != '\'')) {
+                continue;
+            }
+            const std::size_t end = element.find(element[quote], quote + 1);
+            return {quote + 1, end - quote - 1};
+        }
+        return {std::string_view::npos, 0};
+    }
+
+    void replaceAttribute(std::string& element, std::string_view name, const std::string& value)
+    {
+        const auto [position, length] = findAttribute(element, name);
+        if (position != std::string_view::npos) {
+            element.replace(position, length, value);
+        }
+    }
+
+    std::string copyOf(const PulseTripRecord& trip, std::size_t copy, double depart, double shift)
+    {
+        std::string element(trip.element);
+        if (copy > 0) {
+            replaceAttribute(element, "id", std::string(trip.id) + "_s" + std::to_string(copy));
+        }
+        if (shift != 0.0) {
+            if (trip.kind == PulseTripKind::FLOW) {
+                const auto [position, length] = findAttribute(element, "end");
+                if (position != std::string_view::npos) {
+                    const double end = parseTime(std::string_view(element).substr(position, length));
+                    if (end >= 0.0) {
+                        replaceAttribute(element, "end", formatTime(std::max(depart, end + shift)));
+                    }
+                }
+                replaceAttribute(element, "begin", formatTime(depart));
+            }
+            else {
+                replaceAttribute(element, "depart", formatTime(depart));
+            }
+        }
+        return element;
+    }
+
+    struct Output {
+        double depart;
+        std::string_view element;
+    };
+
+    /**
+     * @brief Expands trips [begin, end) of a file into their copies, sorted by departure.
+     * @param copies Storage for rewritten elements; unchanged ones point into the file.
+     */
+    void expandTrips(const std::vector<PulseTripRecord>& trips, std::size_t begin, std::size_t end,
+                     const PulseDemandTransform& transform, std::vector<Output>& output, std::deque<std::string>& copies)
+    {
+        const double earliest = std::max(0.0, transform.begin);
+        for (std::size_t index = begin; index < end; ++index) {
+            const auto& trip = trips[index];
+            const bool timed = trip.depart >= 0.0;
+            if (timed && (trip.depart < transform.begin || (transform.end >= 0.0 && trip.depart >= transform.end))) {
+                continue;
+            }
+
+            const auto class_scale = transform.class_scales.find(std::string(trip.vclass));
+            const double scale = class_scale != transform.class_scales.end() ? class_scale->second : transform.scale;
+            const double whole = std::floor(scale);
+            const std::size_t count = static_cast<std::size_t>(whole) + (unitHash(trip.id, transform.seed, 0) < scale - whole ? 1 : 0);
+
+            for (std::size_t copy = 0; copy < count; ++copy) {
+                double shift = 0.0;
+                double depart = trip.depart;
+                if (timed && transform.jitter > 0.0) {
+                    depart = std::max(earliest, trip.depart + (2.0 * unitHash(trip.id, transform.seed, copy + 1) - 1.0) * transform.jitter);
+                    shift = depart - trip.depart;
+                }
+                if (copy == 0 && shift == 0.0) {
+                    output.push_back(Output{depart, trip.element});
+                }
+                else {
+                    output.push_back(Output{depart, copies.emplace_back(copyOf(trip, copy, depart, shift))});
+                }
+            }
+        }
+
+        // SUMO reads route files incrementally and expects departures in order
+        std::stable_sort(output.begin(), output.end(), [](const Output& a, const Output& b) { return a.depart < b.depart; });
+    }
+
+    /**
+     * @brief Runs task(0) to task(count - 1) on up to thread_count threads, then rethrows the
+     *        failure of the lowest index, if any.
+     */
+    template <typename Task>
+    void runParallel(std::size_t count, std::size_t thread_count, Task&& task)
+    {
+        std::vector<std::exception_ptr> errors(count);
+        std::atomic<std::size_t> next{0};
+
+        auto worker = [&] {
+            for (std::size_t index = next++; index < count; index = next++) {
+                try {
+                    task(index);
+                }
+                catch (...) {
+                    errors[index] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(std::min(thread_count, count));
+        for (std::size_t i = 0; i < std::min(thread_count, count); ++i) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& failure : errors) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+    }
+
+    /**
+     * @brief Temporary files holding sorted runs of one route file, removed when it goes out of scope.
+     *        A record is the departure, the element size and the element text.
+     */
+    class SortedRuns
+    {
+    public:
+        SortedRuns(const std::string& target, std::size_t count)
+        {
+            for (std::size_t run = 0; run < count; ++run) {
+                m_paths.push_back(target + ".run" + std::to_string(run));
+            }
+        }
+
+        ~SortedRuns()
+        {
+            std::error_code error;
+            for (const auto& path : m_paths) {
+                fs::remove(path, error);
+            }
+        }
+
+        SortedRuns(const SortedRuns&) = delete;
+        SortedRuns& operator=(const SortedRuns&) = delete;
+
+        const std::string& getPath(std::size_t run) const
+        {
+            return m_paths[run];
+        }
+
+        void write(std::size_t run, const std::vector<Output>& output) const
+        {
+            std::ofstream out(m_paths[run], std::ios::binary | std::ios::trunc);
+            for (const auto& entry : output) {
+                const std::uint64_t size = entry.element.size();
+                out.write(reinterpret_cast<const char*>(&entry.depart), sizeof(entry.depart));
+                out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                out.write(entry.element.data(), static_cast<std::streamsize>(size));
+            }
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Failed to write sorted run: " + m_paths[run]);
+            }
+        }
+
+    private:
+        std::vector<std::string> m_paths;
+    };
+
+    /**
+     * @brief Reads a sorted run back one record at a time.
+     */
+    class RunReader
+    {
+    public:
+        explicit RunReader(const std::string& path)
+            : m_path(path), m_in(path, std::ios::binary)
+        {
+            if (!m_in) {
+                throw std::runtime_error("Failed to read sorted run: " + path);
+            }
+        }
+
+        /**
+         * @brief Loads the next record into depart and element.
+         * @return false at the end of the run.
+         */
+        bool next()
+        {
+            if (!m_in.read(reinterpret_cast<char*>(&depart), sizeof(depart))) {
+                return false;
+            }
+            std::uint64_t size = 0;
+            m_in.read(reinterpret_cast<char*>(&size), sizeof(size));
+            element.resize(size);
+            if (!m_in.read(element.data(), static_cast<std::streamsize>(size))) {
+                throw std::runtime_error("Truncated sorted run: " + m_path);
+            }
+            return true;
+        }
+
+        double depart = 0.0;
+        std::string element;
+
+    private:
+        std::string m_path;
+        std::ifstream m_in;
+    };
+
+    /**
+     * @brief Rewrites one route file. Trips are expanded in runs of run_trips source trips on the
+     *        worker threads; a file of one run is written straight from memory, otherwise each
+     *        sorted run goes to a temporary file and the runs are merged into the output.
+     */
+    FileCounts transformFile(const std::string& source, const std::string& target, const PulseDemandTransform& transform,
+                             std::size_t run_trips, std::size_t thread_count)
+    {
+        const PulseDemandFile file = PulseDemandFile::load(source);
+        const auto& trips = file.getTrips();
+        const std::size_t run_count = std::max<std::size_t>(1, (trips.size() + run_trips - 1) / run_trips);
+
+        if (run_count == 1) {
+            std::vector<Output> output;
+            std::deque<std::string> copies;
+            expandTrips(trips, 0, trips.size(), transform, output, copies);
+            std::vector<std::string_view> elements;
+            elements.reserve(output.size());
+            for (const auto& entry : output) {
+                elements.push_back(entry.element);
+            }
+            file.write(target, elements);
+            return FileCounts{trips.size(), elements.size()};
+        }
+
+        const SortedRuns runs(target, run_count);
+        std::vector<std::size_t> written(run_count);
+        runParallel(run_count, thread_count, [&](std::size_t run) {
+            std::vector<Output> output;
+            std::deque<std::string> copies;
+            const std::size_t begin = run * run_trips;
+            expandTrips(trips, begin, std::min(trips.size(), begin + run_trips), transform, output, copies);
+            runs.write(run, output);
+            written[run] = output.size();
+        });
+
+        std::vector<RunReader> readers;
+        readers.reserve(run_count);
+        std::vector<std::size_t> heap;
+        for (std::size_t run = 0; run < run_count; ++run) {
+            readers.emplace_back(runs.getPath(run));
+            if (readers.back().next()) {
+                heap.push_back(run);
+            }
+        }
+
+        // Min-heap on the next departure of each run; ties go to the earlier run, which keeps
+        // equal departures in file order like the in-memory stable sort
+        const auto later = [&](std::size_t a, std::size_t b) {
+            return readers[a].depart != readers[b].depart ? readers[a].depart > readers[b].depart : a > b;
+        };
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        // The handed-out element lives in its reader, so that run advances only on the following call
+        std::optional<std::size_t> current;
+        file.write(target, [&](std::string_view& element) {
+            if (current && readers[*current].next()) {
+                heap.push_back(*current);
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+            current.reset();
+            if (heap.empty()) {
+                return false;
+            }
+            std::pop_heap(heap.begin(), heap.end(), later);
+            current = heap.back();
+            heap.pop_back();
+            element = readers[*current].element;
+            return true;
+        });
+
+        std::size_t total = 0;
+        for (const auto count : written) {
+            total += count;
+        }
+        return FileCounts{trips.size(), total};
+    }
+
+    bool insideComment(const std::string& xml, std::size_t position)
+    {
+        const std::size_t open = xml.rfind("<!--", position);
+        if (open == std::string::npos) {
+            return false;
+        }
+        const std::size_t close = xml.find("-->", open);
+        return close == std::string::npos || close > position;
+    }
+
+    /**
+     * @brief Sets the value of a config option, adding the option (and its section) if missing.
+     */
+    void setOption(std::string& xml, std::string_view section, std::string_view option, const std::string& value)
+    {
+        const std::string tag = "<" + std::string(option);
+        for (std::size_t position = xml.find(tag); position != std::string::npos; position = xml.find(tag, position + 1)) {
+            const char after = position + tag.size() < xml.size() ? xml[position + tag.size()] : '\0';
+            if ((after != ' ' && after != '\t' && after != '/' && after != '>') || insideComment(xml, position)) {
+                continue;
+            }
+            const std::string_view element = std::string_view(xml).substr(position);
+            const auto [value_position, length] = findAttribute(element, "value");
+            if (value_position == std::string_view::npos) {
+                xml.insert(position + tag.size(), " value=\"" + value + "\"");
+            }
+            else {
+                xml.replace(position + value_position, length, value);
+            }
+            return;
+        }
+
+        const std::string line = "\n        " + tag + " value=\"" + value + "\"/>";
+        const std::string section_tag = "<" + std::string(section) + ">";
+        const std::size_t section_position = xml.find(section_tag);
+        if (section_position != std::string::npos) {
+            xml.insert(section_position + section_tag.size(), line);
+            return;
+        }
+
+        std::size_t root_end = xml.rfind("</sumoConfiguration>");
+        if (root_end == std::string::npos) {
+            root_end = xml.rfind("</configuration>");
+        }
+        if (root_end == std::string::npos) {
+            throw std::runtime_error("No configuration root element to add " + std::string(option) + " to.");
+        }
+        xml.insert(root_end, "    " + section_tag + line + "\n    </" + std::string(section) + ">\n\n");
+    }
+
+    std::string join(const std::vector<std::string>& values)
+    {
+        std::string joined;
+        for (const auto& value : values) {
+            if (!joined.empty()) {
+                joined.push_back(',');
+            }
+            joined += value;
+        }
+        return joined;
+    }
+
+    void validate(const PulseScenarioDescriptor& scenario, const PulseDemandTransform& transform)
+    {
+        if (!scenario.valid) {
+            throw std::invalid_argument("Cannot transform invalid scenario '" + scenario.name + "': " + scenario.error);
+        }
+        if (transform.name.empty() || transform.name.find_first_of("/\\") != std::string::npos) {
+            throw std::invalid_argument("Transform name must be a non-empty directory name.");
+        }
+        if (!(transform.scale >= 0.0) || !std::isfinite(transform.scale)) {
+            throw std::invalid_argument("Demand scale must be non-negative.");
+        }
+        for (const auto& [vclass, scale] : transform.class_scales) {
+            if (!(scale >= 0.0) || !std::isfinite(scale)) {
+                throw std::invalid_argument("Demand scale of class " + vclass + " must be non-negative.");
+            }
+        }
+        if (!(transform.jitter >= 0.0)) {
+            throw std::invalid_argument("Departure jitter must be non-negative.");
+        }
+        if (transform.end >= 0.0 && transform.end <= transform.begin) {
+            throw std::invalid_argument("Time slice end must be after its begin.");
+        }
+    }
+}
+
+PulseScenarioTransformer::PulseScenarioTransformer(std::string output_root, std::size_t thread_count, std::size_t run_trips)
+    : m_output_root(std::move(output_root)),
+      m_thread_count(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency())),
+      m_run_trips(run_trips)
+{
+    if (run_trips == 0) {
+        throw std::invalid_argument("Sorted runs must hold at least one trip.");
+    }
+}
+
+PulseTransformResult PulseScenarioTransformer::transform(const PulseScenarioDescriptor& scenario, const PulseDemandTransform& transform) const
+{
+    validate(scenario, transform);
+
+    // Descriptors parsed outside a catalog have no name; fall back to the <city>/<timestamp> directories
+    const fs::path config_path(scenario.config_path);
+    const std::string city = scenario.city.empty() ? config_path.parent_path().parent_path().filename().string() : scenario.city;
+    const std::string source_timestamp = scenario.timestamp.empty() ? config_path.parent_path().filename().string() : scenario.timestamp;
+    const std::string timestamp = source_timestamp + "-" + transform.name;
+
+    const fs::path directory = fs::path(m_output_root) / city / timestamp;
+    std::error_code error;
+    fs::remove_all(directory, error);
+    fs::create_directories(directory, error);
+    if (error) {
+        throw std::runtime_error("Failed to create scenario directory " + directory.string() + ": " + error.message());
+    }
+
+    std::vector<std::string> targets;
+    for (const auto& route_file : scenario.route_files) {
+        targets.push_back(fs::path(route_file).filename().string());
+    }
+
+    // Files are done one after another, each spreading its runs over all workers, so only one
+    // source file is resident and a single dominant file still uses every thread
+    std::vector<FileCounts> counts;
+    for (std::size_t index = 0; index < scenario.route_files.size(); ++index) {
+        counts.push_back(transformFile(scenario.route_files[index], (directory / targets[index]).string(), transform,
+                                       m_run_trips, m_thread_count));
+    }
+
+    std::ifstream source(scenario.config_path, std::ios::binary);
+    if (!source) {
+        throw std::runtime_error("Failed to read scenario config: " + scenario.config_path);
+    }
+    std::string config((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+
+    setOption(config, "input", "net-file", scenario.net_file);
+    setOption(config, "input", "route-files", join(targets));
+    if (!scenario.additional_files.empty()) {
+        setOption(config, "input", "additional-files", join(scenario.additional_files));
+    }
+    if (transform.begin > 0.0) {
+        setOption(config, "time", "begin", formatTime(transform.begin));
+    }
+    if (transform.end >= 0.0) {
+        setOption(config, "time", "end", formatTime(transform.end));
+    }
+
+    const std::string target_config = (directory / config_path.filename()).string();
+    std::ofstream out(target_config, std::ios::binary | std::ios::trunc);
+    out << config;
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write scenario config: " + target_config);
+    }
+
+    // Marks the directory as generated, so a catalog over the same root never picks it as a source
+    const fs::path marker = directory / PulseScenarioCatalog::kVariantMarker;
+    std::ofstream(marker, std::ios::trunc) << city << "/" << source_timestamp << "\n";
+    if (!fs::is_regular_file(marker, error)) {
+        throw std::runtime_error("Failed to write variant marker: " + marker.string());
+    }
+
+    PulseTransformResult result;
+    result.scenario = PulseScenarioCatalog::parseConfig(fs::absolute(target_config).lexically_normal().string());
+    result.scenario.city = city;
+    result.scenario.timestamp = timestamp;
+    result.scenario.name = city + "/" + timestamp;
+    for (const auto& count : counts) {
+        result.trips_read += count.read;
+        result.trips_written += count.written;
+    }
+    return result;
+}
@@ -0,0 +1,223 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseSignalProgramTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+std::size_t PulseSignalProgramTable::addTrafficLight(const std::string& traffic_light_id, const PulseSignalProgram& program)
+{
+    if (m_index.count(traffic_light_id)) {
+        throw std::runtime_error("Traffic light program already added: " + traffic_light_id);
+    }
+    if (program.phases.empty() || program.current_phase >= program.phases.size()) {
+        throw std::invalid_argument("Signal program of " + traffic_light_id + " has no phases or an invalid current phase.");
+    }
+
+    const std::size_t signals = program.phases.front().state.size();
+    std::vector<PulseSignalColor> colors;
+    colors.reserve(program.phases.size() * signals);
+    double cycle = 0.0;
+    for (const auto& phase : program.phases) {
+        if (phase.state.size() != signals || !(phase.duration > 0.0)) {
+            throw std::invalid_argument("Signal program of " + traffic_light_id + " mixes state lengths or has a non-positive duration.");
+        }
+        for (const char state : phase.state) {
+            colors.push_back(parseStateChar(state));
+        }
+        cycle += phase.duration;
+    }
+    for (const auto& link : program.links) {
+        if (link.signal >= signals) {
+            throw std::invalid_argument("Controlled link of " + traffic_light_id + " refers to missing signal " + std::to_string(link.signal));
+        }
+    }
+
+    // Validated; from here on nothing throws except allocation
+    const std::size_t handle = m_ids.size();
+    m_ids.push_back(traffic_light_id);
+    m_index.emplace(traffic_light_id, handle);
+
+    m_phase_begin.push_back(static_cast<std::uint32_t>(m_phase_durations.size()));
+    m_phase_count.push_back(static_cast<std::uint32_t>(program.phases.size()));
+    m_signal_count.push_back(static_cast<std::uint32_t>(signals));
+    m_color_begin.push_back(m_colors.size());
+    m_link_begin.push_back(static_cast<std::uint32_t>(m_links.size()));
+    m_link_count.push_back(static_cast<std::uint32_t>(program.links.size()));
+    m_cycle_time.push_back(cycle);
+    m_current_phase.push_back(static_cast<std::uint32_t>(program.current_phase));
+    m_time_to_switch.push_back(program.time_to_switch > 0.0 ? program.time_to_switch
+                                                            : program.phases[program.current_phase].duration);
+
+    for (const auto& phase : program.phases) {
+        m_phase_durations.push_back(phase.duration);
+    }
+    m_colors.insert(m_colors.end(), colors.begin(), colors.end());
+    m_links.insert(m_links.end(), program.links.begin(), program.links.end());
+    return handle;
+}
+
+std::size_t PulseSignalProgramTable::loadFrom(const SimulationSource& source)
+{
+    std::size_t added = 0;
+    PulseSignalProgram program;
+    for (const auto& traffic_light_id : source.getAllTrafficLights()) {
+        if (!m_index.count(traffic_light_id) && source.fillSignalProgram(traffic_light_id, program)) {
+            addTrafficLight(traffic_light_id, program);
+            ++added;
+        }
+    }
+    return added;
+}
+
+std::optional<std::size_t> PulseSignalProgramTable::findTrafficLight(const std::string& traffic_light_id) const
+{
+    auto it = m_index.find(traffic_light_id);
+    if (it == m_index.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void PulseSignalProgramTable::advance(double seconds)
+{
+    if (!(seconds > 0.0)) {
+        return;
+    }
+
+    const std::size_t count = m_ids.size();
+    for (std::size_t light = 0; light < count; ++light) {
+        double remaining = m_time_to_switch[light] - seconds;
+        if (remaining > 0.0) {
+            m_time_to_switch[light] = remaining;
+            continue;
+        }
+
+        // Whole cycles change nothing; skip them so a long step costs at most one pass over the phases
+        if (-remaining >= m_cycle_time[light]) {
+            remaining = -std::fmod(-remaining, m_cycle_time[light]);
+        }
+        const double* durations = m_phase_durations.data() + m_phase_begin[light];
+        const std::uint32_t phases = m_phase_count[light];
+        std::uint32_t phase = m_current_phase[light];
+        while (remaining <= 0.0) {
+            phase = phase + 1 == phases ? 0 : phase + 1;
+            remaining += durations[phase];
+        }
+        m_current_phase[light] = phase;
+        m_time_to_switch[light] = remaining;
+    }
+}
+
+void PulseSignalProgramTable::setPhase(std::size_t handle, std::size_t phase, double time_to_switch)
+{
+    requireHandle(handle);
+    if (phase >= m_phase_count[handle]) {
+        throw std::out_of_range("Phase " + std::to_string(phase) + " out of range for traffic light " + m_ids[handle]);
+    }
+    m_current_phase[handle] = static_cast<std::uint32_t>(phase);
+    m_time_to_switch[handle] = time_to_switch > 0.0 ? time_to_switch : m_phase_durations[m_phase_begin[handle] + phase];
+}
+
+std::size_t PulseSignalProgramTable::size() const
+{
+    return m_ids.size();
+}
+
+const std::string& PulseSignalProgramTable::getId(std::size_t handle) const
+{
+    requireHandle(handle);
+    return m_ids[handle];
+}
+
+std::size_t PulseSignalProgramTable::getPhaseCount(std::size_t handle) const
+{
+    requireHandle(handle);
+    return m_phase_count[handle];
+}
+
+std::size_t PulseSignalProgramTable::getPhaseIndex(std::size_t handle) const
+{
+    requireHandle(handle);
+    return m_current_phase[handle];
+}
+
+double PulseSignalProgramTable::getTimeToSwitch(std::size_t handle) const
+{
+    requireHandle(handle);
+    return m_time_to_switch[handle];
+}
+
+std::span<const PulseSignalColor> PulseSignalProgramTable::getSignalColors(std::size_t handle) const
+{
+    requireHandle(handle);
+    const std::size_t signals = m_signal_count[handle];
+    return {m_colors.data() + m_color_begin[handle] + m_current_phase[handle] * signals, signals};
+}
+
+std::span<const PulseControlledLink> PulseSignalProgramTable::getControlledLinks(std::size_t handle) const
+{
+    requireHandle(handle);
+    return {m_links.data() + m_link_begin[handle], m_link_count[handle]};
+}
+
+PulseSignalColor PulseSignalProgramTable::getLinkColor(std::size_t handle, std::size_t link) const
+{
+    const auto links = getControlledLinks(handle);
+    if (link >= links.size()) {
+        throw std::out_of_range("Controlled link " + std::to_string(link) + " out of range for traffic light " + m_ids[handle]);
+    }
+    return getSignalColors(handle)[links[link].signal];
+}
+
+TrafficLightState PulseSignalProgramTable::getSummaryState(std::size_t handle) const
+{
+    TrafficLightState summary = TrafficLightState::RED;
+    for (const auto color : getSignalColors(handle)) {
+        switch (color) {
+            case PulseSignalColor::GREEN_MINOR:
+            case PulseSignalColor::GREEN_MAJOR:
+            case PulseSignalColor::GREEN_RIGHT:
+                return TrafficLightState::GREEN;
+            case PulseSignalColor::YELLOW:
+            case PulseSignalColor::RED_YELLOW:
+                summary = TrafficLightState::YELLOW;
+                break;
+            default:
+                break;
+        }
+    }
+    return summary;
+}
+
+void PulseSignalProgramTable::fillStateString(std::size_t handle, std::string& out) const
+{
+    const auto colors = getSignalColors(handle);
+    out.resize(colors.size());
+    std::transform(colors.begin(), colors.end(), out.begin(), toStateChar);
+}
+
+PulseSignalColor PulseSignalProgramTable::parseStateChar(char state)
+{
+    switch (state) {
+        case 'r': return PulseSignalColor::RED;
+        case 'u': return PulseSignalColor::RED_YELLOW;
+        case 'y': return PulseSignalColor::YELLOW;
+        case 'g': return PulseSignalColor::GREEN_MINOR;
+        case 'G': return PulseSignalColor::GREEN_MAJOR;
+        case 's': return PulseSignalColor::GREEN_RIGHT;
+        case 'o': return PulseSignalColor::OFF_BLINKING;
+        case 'O': return PulseSignalColor::OFF;
+        default: throw std::invalid_argument(std::string("Unknown signal state character: ") + state);
+    }
+}
+
+void PulseSignalProgramTable::requireHandle(std::size_t handle) const
+{
+    if (handle >= m_ids.size()) {
+        throw std::out_of_range("Traffic light handle out of range: " + std::to_string(handle));
+    }
+}
@@ -0,0 +1,140 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseSnapshotPublisher.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+PulseSnapshotPublisher::Guard::Guard(const PulseSnapshotPublisher* publisher, std::size_t slot, const PulseStateSnapshot* snapshot)
+    : m_publisher(publisher), m_slot(slot), m_snapshot(snapshot) {}
+
+PulseSnapshotPublisher::Guard::Guard(Guard&& other) noexcept
+    : m_publisher(other.m_publisher), m_slot(other.m_slot), m_snapshot(other.m_snapshot)
+{
+    other.m_publisher = nullptr;
+    other.m_snapshot = nullptr;
+}
+
+PulseSnapshotPublisher::Guard& PulseSnapshotPublisher::Guard::operator=(Guard&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_publisher = other.m_publisher;
+        m_slot = other.m_slot;
+        m_snapshot = other.m_snapshot;
+        other.m_publisher = nullptr;
+        other.m_snapshot = nullptr;
+    }
+    return *this;
+}
+
+PulseSnapshotPublisher::Guard::~Guard()
+{
+    release();
+}
+
+void PulseSnapshotPublisher::Guard::release()
+{
+    if (m_publisher) {
+        m_publisher->unpin(m_slot);
+        m_publisher = nullptr;
+    }
+    m_snapshot = nullptr;
+}
+
+PulseSnapshotPublisher::PulseSnapshotPublisher()
+{
+    for (auto& slot : m_pinned) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+PulseStateSnapshot& PulseSnapshotPublisher::beginWrite()
+{
+    if (!m_pending) {
+        if (!m_free.empty()) {
+            m_pending = m_free.back();
+            m_free.pop_back();
+        }
+        else {
+            m_storage.push_back(std::make_unique<PulseStateSnapshot>());
+            m_pending = m_storage.back().get();
+        }
+    }
+    return *m_pending;
+}
+
+void PulseSnapshotPublisher::publish()
+{
+    if (!m_pending) {
+        throw std::logic_error("Cannot publish snapshot: beginWrite() was not called.");
+    }
+
+    const std::uint64_t epoch = m_epoch.load(std::memory_order_relaxed) + 1;
+    m_pending->epoch = epoch;
+
+    // Readers that loaded the previous snapshot pinned an epoch older than the new one
+    PulseStateSnapshot* previous = m_current.exchange(m_pending, std::memory_order_seq_cst);
+    m_epoch.store(epoch, std::memory_order_seq_cst);
+    m_pending = nullptr;
+
+    if (previous) {
+        m_retired.push_back({previous, epoch});
+    }
+    reclaim();
+}
+
+PulseSnapshotPublisher::Guard PulseSnapshotPublisher::pin() const
+{
+    for (std::size_t slot = 0; slot < kMaxReaders; ++slot) {
+        std::uint64_t expected = 0;
+        const std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+        if (m_pinned[slot].compare_exchange_strong(expected, epoch + 1, std::memory_order_seq_cst)) {
+            return Guard(this, slot, m_current.load(std::memory_order_seq_cst));
+        }
+    }
+    throw std::runtime_error("Cannot pin snapshot: all reader slots are in use.");
+}
+
+std::uint64_t PulseSnapshotPublisher::getEpoch() const
+{
+    return m_epoch.load(std::memory_order_acquire);
+}
+
+std::size_t PulseSnapshotPublisher::getRetiredCount() const
+{
+    return m_retired.size();
+}
+
+void PulseSnapshotPublisher::unpin(std::size_t slot) const
+{
+    m_pinned[slot].store(0, std::memory_order_release);
+}
+
+void PulseSnapshotPublisher::reclaim()
+{
+    if (m_retired.empty()) {
+        return;
+    }
+
+    // Oldest generation any reader may still hold (pins store epoch + 1)
+    std::uint64_t oldest_pin = std::numeric_limits<std::uint64_t>::max();
+    for (const auto& slot : m_pinned) {
+        const std::uint64_t pinned = slot.load(std::memory_order_seq_cst);
+        if (pinned != 0) {
+            oldest_pin = std::min(oldest_pin, pinned);
+        }
+    }
+
+    // A snapshot retired at epoch E is only visible to readers pinned before E
+    std::erase_if(m_retired, [&](const Retired& retired) {
+        if (oldest_pin > retired.retired_at) {
+            m_free.push_back(retired.snapshot);
+            return true;
+        }
+        return false;
+    });
+}
@@ -0,0 +1,295 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseStateEncoder.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <limits>
+
+namespace
+{
+    // --- Binary ---
+
+    template <typename T>
+    void putInteger(std::string& out, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<char>(static_cast<std::uint64_t>(value) >> (8 * i) & 0xFF));
+        }
+    }
+
+    void putFloat(std::string& out, float value)
+    {
+        putInteger(out, std::bit_cast<std::uint32_t>(value));
+    }
+
+    void putDouble(std::string& out, double value)
+    {
+        putInteger(out, std::bit_cast<std::uint64_t>(value));
+    }
+
+    void putId(std::string& out, const std::string& id)
+    {
+        const std::size_t length = std::min<std::size_t>(id.size(), std::numeric_limits<std::uint16_t>::max());
+        putInteger(out, static_cast<std::uint16_t>(length));
+        out.append(id, 0, length);
+    }
+
+    void putHeader(std::string& out, std::uint8_t kind, std::uint64_t epoch, std::uint64_t base_epoch, std::uint64_t step)
+    {
+        out.push_back(static_cast<char>(kind));
+        putInteger(out, epoch);
+        putInteger(out, base_epoch);
+        putInteger(out, step);
+    }
+
+    void putVehicle(std::string& out, const PulseStateSnapshot::VehicleRecord& vehicle)
+    {
+        putId(out, vehicle.id);
+        out.push_back(static_cast<char>(vehicle.type));
+        out.push_back(static_cast<char>(vehicle.role));
+        putFloat(out, static_cast<float>(vehicle.position.x));
+        putFloat(out, static_cast<float>(vehicle.position.y));
+    }
+
+    void putTrafficLight(std::string& out, const PulseStateSnapshot::TrafficLightRecord& traffic_light)
+    {
+        putId(out, traffic_light.id);
+        out.push_back(static_cast<char>(traffic_light.state));
+    }
+
+    // --- JSON ---
+
+    void appendString(std::string& out, const std::string& value)
+    {
+        static constexpr char kHex[] = "0123456789abcdef";
+        out.push_back('"');
+        for (const char c : value) {
+            const auto byte = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            }
+            else if (byte < 0x20) {
+                out.append("\\u00");
+                out.push_back(kHex[byte >> 4]);
+                out.push_back(kHex[byte & 0xF]);
+            }
+            else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    template <typename T>
+    void appendNumber(std::string& out, T value)
+    {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void appendHeader(std::string& out, const char* type, std::uint64_t epoch, std::uint64_t step)
+    {
+        out.append("{\"type\":\"").append(type).append("\",\"epoch\":");
+        appendNumber(out, epoch);
+        out.append(",\"step\":");
+        appendNumber(out, step);
+    }
+
+    void appendVehicle(std::string& out, const PulseStateSnapshot::VehicleRecord& vehicle)
+    {
+        out.append("{\"id\":");
+        appendString(out, vehicle.id);
+        out.append(",\"type\":\"").append(toString(vehicle.type));
+        out.append("\",\"role\":\"").append(toString(vehicle.role));
+        out.append("\",\"x\":");
+        appendNumber(out, vehicle.position.x);
+        out.append(",\"y\":");
+        appendNumber(out, vehicle.position.y);
+        out.push_back('}');
+    }
+
+    void appendTrafficLight(std::string& out, const PulseStateSnapshot::TrafficLightRecord& traffic_light)
+    {
+        out.append("{\"id\":");
+        appendString(out, traffic_light.id);
+        out.append(",\"state\":\"").append(toString(traffic_light.state)).append("\"}");
+    }
+
+    template <typename Range, typename Append>
+    void appendArray(std::string& out, const char* name, const Range& items, std::size_t count, Append&& append)
+    {
+        out.append(",\"").append(name).append("\":[");
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i > 0) {
+                out.push_back(',');
+            }
+            append(out, items[i]);
+        }
+        out.push_back(']');
+    }
+}
+
+void PulseStateEncoder::encodeState(const PulseStateSnapshot& snapshot, PulseWireFormat format, std::string& out)
+{
+    out.clear();
+
+    if (format == PulseWireFormat::BINARY) {
+        putHeader(out, kStateMessage, snapshot.epoch, 0, snapshot.step);
+        putInteger(out, static_cast<std::uint32_t>(snapshot.vehicles.size()));
+        for (const auto& vehicle : snapshot.vehicles) {
+            putVehicle(out, vehicle);
+        }
+        putInteger(out, static_cast<std::uint32_t>(snapshot.traffic_lights.size()));
+        for (const auto& traffic_light : snapshot.traffic_lights) {
+            putTrafficLight(out, traffic_light);
+        }
+        putInteger(out, static_cast<std::uint32_t>(snapshot.intersections.size()));
+        for (const auto& intersection : snapshot.intersections) {
+            putId(out, intersection.id);
+            putInteger(out, static_cast<std::uint64_t>(intersection.vehicles_passed));
+            putDouble(out, intersection.vehicle_waiting_time);
+            putInteger(out, static_cast<std::uint64_t>(intersection.pedestrians_passed));
+            putDouble(out, intersection.pedestrian_waiting_time);
+        }
+        return;
+    }
+
+    appendHeader(out, "state", snapshot.epoch, snapshot.step);
+    appendArray(out, "vehicles", snapshot.vehicles, snapshot.vehicles.size(), appendVehicle);
+    appendArray(out, "traffic_lights", snapshot.traffic_lights, snapshot.traffic_lights.size(), appendTrafficLight);
+    appendArray(out, "intersections", snapshot.intersections, snapshot.intersections.size(),
+                [](std::string& json, const PulseStateSnapshot::IntersectionRecord& intersection) {
+                    json.append("{\"id\":");
+                    appendString(json, intersection.id);
+                    json.append(",\"vehicles_passed\":");
+                    appendNumber(json, static_cast<std::uint64_t>(intersection.vehicles_passed));
+                    json.append(",\"vehicle_waiting_time\":");
+                    appendNumber(json, intersection.vehicle_waiting_time);
+                    json.append(",\"pedestrians_passed\":");
+                    appendNumber(json, static_cast<std::uint64_t>(intersection.pedestrians_passed));
+                    json.append(",\"pedestrian_waiting_time\":");
+                    appendNumber(json, intersection.pedestrian_waiting_time);
+                    json.push_back('}');
+                });
+    out.push_back('}');
+}
+
+void PulseStateEncoder::diff(const PulseStateSnapshot& snapshot)
+{
+    ++m_generation;
+    m_base_epoch = m_epoch;
+    m_epoch = snapshot.epoch;
+    m_step = snapshot.step;
+    m_changed_vehicle_count = 0;
+    m_removed_vehicle_count = 0;
+    m_changed_light_count = 0;
+
+    for (const auto& vehicle : snapshot.vehicles) {
+        auto [it, inserted] = m_vehicles.try_emplace(vehicle.id);
+        auto& base = it->second;
+        base.seen = m_generation;
+        if (!inserted && base.record.position == vehicle.position && base.record.type == vehicle.type
+            && base.record.role == vehicle.role) {
+            continue;
+        }
+
+        base.record = vehicle;
+        if (m_changed_vehicle_count == m_changed_vehicles.size()) {
+            m_changed_vehicles.emplace_back();
+        }
+        m_changed_vehicles[m_changed_vehicle_count++] = vehicle;
+    }
+
+    for (auto it = m_vehicles.begin(); it != m_vehicles.end();) {
+        if (it->second.seen == m_generation) {
+            ++it;
+            continue;
+        }
+        if (m_removed_vehicle_count == m_removed_vehicles.size()) {
+            m_removed_vehicles.emplace_back();
+        }
+        m_removed_vehicles[m_removed_vehicle_count++].assign(it->first);
+        it = m_vehicles.erase(it);
+    }
+
+    for (const auto& traffic_light : snapshot.traffic_lights) {
+        auto [it, inserted] = m_lights.try_emplace(traffic_light.id, traffic_light.state);
+        if (!inserted && it->second == traffic_light.state) {
+            continue;
+        }
+
+        it->second = traffic_light.state;
+        if (m_changed_light_count == m_changed_lights.size()) {
+            m_changed_lights.emplace_back();
+        }
+        m_changed_lights[m_changed_light_count++] = traffic_light;
+    }
+}
+
+void PulseStateEncoder::encodeDelta(PulseWireFormat format, std::string& out) const
+{
+    out.clear();
+
+    if (format == PulseWireFormat::BINARY) {
+        putHeader(out, kDeltaMessage, m_epoch, m_base_epoch, m_step);
+        putInteger(out, static_cast<std::uint32_t>(m_changed_vehicle_count));
+        for (std::size_t i = 0; i < m_changed_vehicle_count; ++i) {
+            putVehicle(out, m_changed_vehicles[i]);
+        }
+        putInteger(out, static_cast<std::uint32_t>(m_removed_vehicle_count));
+        for (std::size_t i = 0; i < m_removed_vehicle_count; ++i) {
+            putId(out, m_removed_vehicles[i]);
+        }
+        putInteger(out, static_cast<std::uint32_t>(m_changed_light_count));
+        for (std::size_t i = 0; i < m_changed_light_count; ++i) {
+            putTrafficLight(out, m_changed_lights[i]);
+        }
+        return;
+    }
+
+    appendHeader(out, "delta", m_epoch, m_step);
+    out.append(",\"base_epoch\":");
+    appendNumber(out, m_base_epoch);
+    appendArray(out, "vehicles", m_changed_vehicles, m_changed_vehicle_count, appendVehicle);
+    appendArray(out, "removed", m_removed_vehicles, m_removed_vehicle_count, appendString);
+    appendArray(out, "traffic_lights", m_changed_lights, m_changed_light_count, appendTrafficLight);
+    out.push_back('}');
+}
+
+std::uint64_t PulseStateEncoder::getEpoch() const
+{
+    return m_epoch;
+}
+
+std::size_t PulseStateEncoder::getChangedVehicleCount() const
+{
+    return m_changed_vehicle_count;
+}
+
+std::size_t PulseStateEncoder::getRemovedVehicleCount() const
+{
+    return m_removed_vehicle_count;
+}
+
+std::size_t PulseStateEncoder::getChangedTrafficLightCount() const
+{
+    return m_changed_light_count;
+}
+
+void PulseStateEncoder::reset()
+{
+    m_vehicles.clear();
+    m_lights.clear();
+    m_epoch = 0;
+    m_base_epoch = 0;
+    m_step = 0;
+    m_changed_vehicle_count = 0;
+    m_removed_vehicle_count = 0;
+    m_changed_light_count = 0;
+}
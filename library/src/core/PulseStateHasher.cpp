@@ -0,0 +1,223 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseStateHasher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if !defined(PULSE_DISABLE_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define PULSE_HASH_AVX2
+#elif !defined(PULSE_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define PULSE_HASH_SSE2
+#endif
+
+namespace
+{
+    constexpr std::uint64_t kPrime32 = 0x9E3779B1u;
+    constexpr std::uint64_t kPrime64_1 = 0x9E3779B185EBCA87ull;
+    constexpr std::uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr std::uint64_t kPrime64_3 = 0x165667B19E3779F9ull;
+
+    constexpr std::size_t kLanes = 4;
+
+    // Stripe n of a block is keyed with kSecret[n..n+3]; the scramble uses the last four entries
+    constexpr std::size_t kSecretSize = PulseStateHasher::kStripesPerBlock + 2 * kLanes;
+
+    constexpr std::array<std::uint64_t, kSecretSize> makeSecret()
+    {
+        std::array<std::uint64_t, kSecretSize> secret{};
+        std::uint64_t state = 0x50756C7365547266ull;   // splitmix64
+        for (auto& key : secret) {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            key = z ^ (z >> 31);
+        }
+        return secret;
+    }
+
+    alignas(32) constexpr std::array<std::uint64_t, kSecretSize> kSecret = makeSecret();
+    constexpr const std::uint64_t* kScrambleKey = kSecret.data() + PulseStateHasher::kStripesPerBlock + kLanes;
+
+    [[maybe_unused]] std::uint64_t load64(const unsigned char* bytes)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big) {
+            std::uint64_t swapped = 0;
+            for (int i = 0; i < 8; ++i) {
+                swapped = swapped << 8 | (value >> (8 * i) & 0xFF);
+            }
+            value = swapped;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Folds stripes into the accumulators: acc[i] += lo32(d[i] ^ k[i]) * hi32(d[i] ^ k[i]) + d[i ^ 1].
+     *        Adding the neighbouring lane's input keeps data that multiplies to zero from vanishing.
+     */
+    void accumulate(std::uint64_t* acc, const unsigned char* input, std::size_t stripes, std::size_t first_stripe)
+    {
+#if defined(PULSE_HASH_AVX2)
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+        for (std::size_t s = 0; s < stripes; ++s) {
+            const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + s * PulseStateHasher::kStripeSize));
+            const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kSecret.data() + first_stripe + s));
+            const __m256i data_key = _mm256_xor_si256(data, key);
+            const __m256i product = _mm256_mul_epu32(data_key, _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+            const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            a = _mm256_add_epi64(a, _mm256_add_epi64(product, swapped));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), a);
+#elif defined(PULSE_HASH_SSE2)
+        __m128i a[2] = {_mm_loadu_si128(reinterpret_cast<const __m128i*>(acc)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2))};
+        for (std::size_t s = 0; s < stripes; ++s) {
+            for (std::size_t half = 0; half < 2; ++half) {
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + s * PulseStateHasher::kStripeSize + 16 * half));
+                const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kSecret.data() + first_stripe + s + 2 * half));
+                const __m128i data_key = _mm_xor_si128(data, key);
+                const __m128i product = _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                a[half] = _mm_add_epi64(a[half], _mm_add_epi64(product, swapped));
+            }
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), a[0]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2), a[1]);
+#else
+        for (std::size_t s = 0; s < stripes; ++s) {
+            const unsigned char* stripe = input + s * PulseStateHasher::kStripeSize;
+            for (std::size_t i = 0; i < kLanes; ++i) {
+                const std::uint64_t data = load64(stripe + 8 * i);
+                const std::uint64_t data_key = data ^ kSecret[first_stripe + s + i];
+                acc[i ^ 1] += data;
+                acc[i] += (data_key & 0xFFFFFFFFu) * (data_key >> 32);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Spreads the high bits of each accumulator over the low ones: acc = (acc ^ acc >> 47 ^ key) * kPrime32.
+     */
+    void scramble(std::uint64_t* acc)
+    {
+        for (std::size_t i = 0; i < kLanes; ++i) {
+            acc[i] = (acc[i] ^ (acc[i] >> 47) ^ kScrambleKey[i]) * kPrime32;
+        }
+    }
+
+    std::uint64_t avalanche(std::uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= kPrime64_2;
+        hash ^= hash >> 29;
+        hash *= kPrime64_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
+
+PulseStateHasher::PulseStateHasher(std::uint64_t seed)
+{
+    reset(seed);
+}
+
+void PulseStateHasher::reset(std::uint64_t seed)
+{
+    m_accumulators = {kPrime64_1 + seed, kPrime64_2 - seed, kPrime64_3 ^ seed, kPrime32 + seed};
+    m_buffered = 0;
+    m_length = 0;
+}
+
+void PulseStateHasher::update(const void* data, std::size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    const auto* input = static_cast<const unsigned char*>(data);
+    m_length += size;
+
+    // Complete a partially filled block first
+    if (m_buffered > 0) {
+        const std::size_t take = std::min(size, kBlockSize - m_buffered);
+        std::memcpy(m_buffer.data() + m_buffered, input, take);
+        m_buffered += take;
+        input += take;
+        size -= take;
+        if (m_buffered < kBlockSize) {
+            return;
+        }
+        accumulate(m_accumulators.data(), m_buffer.data(), kStripesPerBlock, 0);
+        scramble(m_accumulators.data());
+        m_buffered = 0;
+    }
+
+    // Whole blocks straight from the input; the last one stays buffered so digest() sees it
+    while (size > kBlockSize) {
+        accumulate(m_accumulators.data(), input, kStripesPerBlock, 0);
+        scramble(m_accumulators.data());
+        input += kBlockSize;
+        size -= kBlockSize;
+    }
+
+    if (size > 0) {
+        std::memcpy(m_buffer.data(), input, size);
+        m_buffered = size;
+    }
+}
+
+void PulseStateHasher::updateString(std::string_view value)
+{
+    updateValue(static_cast<std::uint64_t>(value.size()));
+    update(value.data(), value.size());
+}
+
+std::uint64_t PulseStateHasher::digest() const
+{
+    auto acc = m_accumulators;
+
+    const std::size_t stripes = m_buffered / kStripeSize;
+    accumulate(acc.data(), m_buffer.data(), stripes, 0);
+    if (m_buffered == kBlockSize) {
+        // Same state update() reaches once more input arrives, so chunking never changes the digest
+        scramble(acc.data());
+    }
+
+    const std::size_t tail = m_buffered % kStripeSize;
+    if (tail > 0) {
+        // Zero-padded last stripe; the length below tells padding from zero bytes
+        alignas(32) unsigned char last[kStripeSize] = {};
+        std::memcpy(last, m_buffer.data() + stripes * kStripeSize, tail);
+        accumulate(acc.data(), last, 1, stripes % kStripesPerBlock);
+    }
+
+    std::uint64_t hash = m_length * kPrime64_1;
+    for (std::size_t i = 0; i < kLanes; ++i) {
+        hash ^= avalanche(acc[i] + kSecret[i]);
+        hash = std::rotl(hash, 27) * kPrime64_1 + kPrime64_3;
+    }
+    return avalanche(hash);
+}
+
+std::uint64_t PulseStateHasher::hash(const void* data, std::size_t size, std::uint64_t seed)
+{
+    PulseStateHasher hasher(seed);
+    hasher.update(data, size);
+    return hasher.digest();
+}
+
+bool PulseStateHasher::isVectorized()
+{
+#if defined(PULSE_HASH_AVX2) || defined(PULSE_HASH_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
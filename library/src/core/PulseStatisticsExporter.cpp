@@ -0,0 +1,282 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseStatisticsExporter.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "types/PulseVehicleType.h"
+#include "types/TrafficLightState.h"
+
+namespace
+{
+    constexpr std::size_t kVehicleTypeCount = static_cast<std::size_t>(PulseVehicleType::PEDESTRIAN) + 1;
+
+    const char* const kFileNames[] = {"intersections.parquet", "traffic_lights.parquet", "vehicle_types.parquet"};
+
+    std::vector<PulseColumnSpec> schemaOf(std::size_t table)
+    {
+        switch (table) {
+            case 0: return {
+                {"time", PulseColumnType::DOUBLE},
+                {"intersection_id", PulseColumnType::STRING},
+                {"vehicles_passed", PulseColumnType::INT64},
+                {"vehicle_waiting_time", PulseColumnType::DOUBLE},
+                {"pedestrians_passed", PulseColumnType::INT64},
+                {"pedestrian_waiting_time", PulseColumnType::DOUBLE}
+            };
+            case 1: return {
+                {"time", PulseColumnType::DOUBLE},
+                {"traffic_light_id", PulseColumnType::STRING},
+                {"state", PulseColumnType::STRING}
+            };
+            default: return {
+                {"time", PulseColumnType::DOUBLE},
+                {"vehicle_type", PulseColumnType::STRING},
+                {"vehicles", PulseColumnType::INT64},
+                {"mean_speed", PulseColumnType::DOUBLE}
+            };
+        }
+    }
+}
+
+std::uint32_t PulseStatisticsExporter::Dictionary::intern(const std::string& value, PulseColumn& column)
+{
+    auto [it, inserted] = codes.try_emplace(value, static_cast<std::uint32_t>(codes.size()));
+    if (inserted) {
+        column.dictionary_additions.push_back(value);
+    }
+    return it->second;
+}
+
+PulseStatisticsExporter::PulseStatisticsExporter(const PulseExportConfig& config)
+    : m_config(config)
+{
+    if (config.directory.empty()) {
+        throw std::invalid_argument("Export directory must not be empty.");
+    }
+    if (!(config.sample_interval >= 0.0) || config.row_group_size == 0 || config.max_pending_batches == 0) {
+        throw std::invalid_argument("Sample interval must not be negative, row groups and the writer queue must not be empty.");
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(config.directory, error);
+    if (error) {
+        throw std::runtime_error("Failed to create export directory: " + config.directory);
+    }
+    for (std::size_t table = 0; table < TABLE_COUNT; ++table) {
+        const auto path = std::filesystem::path(config.directory) / kFileNames[table];
+        m_writers[table] = std::make_unique<PulseParquetWriter>(path.string(), schemaOf(table), config.compression_level);
+    }
+
+    m_writer = std::thread(&PulseStatisticsExporter::runWriter, this);
+}
+
+PulseStatisticsExporter::~PulseStatisticsExporter()
+{
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+bool PulseStatisticsExporter::sample(const PulseDataManager& data_manager, double simulation_time)
+{
+    if (m_closed) {
+        throw std::logic_error("Cannot sample into a closed exporter.");
+    }
+    rethrowWriterError();
+    if (m_samples > 0 && simulation_time < m_next_sample) {
+        return false;
+    }
+    m_next_sample = simulation_time + m_config.sample_interval;
+    ++m_samples;
+
+    {
+        auto& rows = batch(INTERSECTIONS);
+        for (auto& intersection : data_manager.viewIntersections()) {
+            const auto& statistics = intersection.getStatistics();
+            rows.columns[0].double_values.push_back(simulation_time);
+            rows.columns[1].codes.push_back(m_dictionaries[INTERSECTIONS].intern(intersection.getId(), rows.columns[1]));
+            rows.columns[2].int64_values.push_back(static_cast<std::int64_t>(statistics.getTotalVehiclesPassed()));
+            rows.columns[3].double_values.push_back(statistics.getTotalVehicleWaitingTime());
+            rows.columns[4].int64_values.push_back(static_cast<std::int64_t>(statistics.getTotalPedestriansPassed()));
+            rows.columns[5].double_values.push_back(statistics.getTotalPedestrianWaitingTime());
+            ++rows.rows;
+        }
+        if (rows.rows >= m_config.row_group_size) {
+            submit(INTERSECTIONS);
+        }
+    }
+
+    {
+        auto& rows = batch(TRAFFIC_LIGHTS);
+        for (const auto& traffic_light : data_manager.viewTrafficLights()) {
+            rows.columns[0].double_values.push_back(simulation_time);
+            rows.columns[1].codes.push_back(m_dictionaries[TRAFFIC_LIGHTS].intern(traffic_light.getId(), rows.columns[1]));
+            rows.columns[2].codes.push_back(m_states.intern(toString(traffic_light.getState()), rows.columns[2]));
+            ++rows.rows;
+        }
+        if (rows.rows >= m_config.row_group_size) {
+            submit(TRAFFIC_LIGHTS);
+        }
+    }
+
+    {
+        std::array<std::size_t, kVehicleTypeCount> vehicles{};
+        std::array<double, kVehicleTypeCount> speeds{};
+        data_manager.forEachVehicle([&](const PulseVehicle& vehicle) {
+            const auto type = static_cast<std::size_t>(vehicle.getType());
+            ++vehicles[type];
+            speeds[type] += vehicle.getKinematics().speed;
+        });
+
+        auto& rows = batch(VEHICLE_TYPES);
+        for (std::size_t type = 0; type < kVehicleTypeCount; ++type) {
+            const char* name = toString(static_cast<PulseVehicleType>(type));
+            rows.columns[0].double_values.push_back(simulation_time);
+            rows.columns[1].codes.push_back(m_dictionaries[VEHICLE_TYPES].intern(name, rows.columns[1]));
+            rows.columns[2].int64_values.push_back(static_cast<std::int64_t>(vehicles[type]));
+            rows.columns[3].double_values.push_back(vehicles[type] ? speeds[type] / static_cast<double>(vehicles[type]) : 0.0);
+            ++rows.rows;
+        }
+        if (rows.rows >= m_config.row_group_size) {
+            submit(VEHICLE_TYPES);
+        }
+    }
+    return true;
+}
+
+void PulseStatisticsExporter::flush()
+{
+    for (std::size_t table = 0; table < TABLE_COUNT; ++table) {
+        if (m_batches[table] && m_batches[table]->rows > 0) {
+            submit(static_cast<Table>(table));
+        }
+    }
+    {
+        std::unique_lock lock(m_mutex);
+        m_work_done.wait(lock, [this] { return m_in_flight == 0; });
+    }
+    rethrowWriterError();
+}
+
+void PulseStatisticsExporter::close()
+{
+    if (m_closed) {
+        return;
+    }
+    m_closed = true;
+
+    for (std::size_t table = 0; table < TABLE_COUNT; ++table) {
+        if (m_batches[table] && m_batches[table]->rows > 0) {
+            submit(static_cast<Table>(table));
+        }
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work_ready.notify_one();
+    m_writer.join();
+
+    rethrowWriterError();
+    for (auto& writer : m_writers) {
+        writer->close();
+    }
+}
+
+std::uint64_t PulseStatisticsExporter::getSampleCount() const
+{
+    return m_samples;
+}
+
+PulseColumnBatch& PulseStatisticsExporter::batch(Table table)
+{
+    auto& current = m_batches[table];
+    if (current) {
+        return *current;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto& free = m_free[table];
+        if (!free.empty()) {
+            current = std::move(free.back());
+            free.pop_back();
+            return *current;
+        }
+    }
+
+    // Buffers are sized once; recycled batches keep their capacity
+    const auto& schema = m_writers[table]->getSchema();
+    current = std::make_unique<PulseColumnBatch>();
+    current->columns.resize(schema.size());
+    for (std::size_t column = 0; column < schema.size(); ++column) {
+        switch (schema[column].type) {
+            case PulseColumnType::INT64: current->columns[column].int64_values.reserve(m_config.row_group_size); break;
+            case PulseColumnType::DOUBLE: current->columns[column].double_values.reserve(m_config.row_group_size); break;
+            case PulseColumnType::STRING: current->columns[column].codes.reserve(m_config.row_group_size); break;
+        }
+    }
+    return *current;
+}
+
+void PulseStatisticsExporter::submit(Table table)
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_work_done.wait(lock, [this] { return m_in_flight < m_config.max_pending_batches; });
+        m_jobs.push_back(Job{table, std::move(m_batches[table])});
+        ++m_in_flight;
+    }
+    m_work_ready.notify_one();
+}
+
+void PulseStatisticsExporter::rethrowWriterError()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void PulseStatisticsExporter::runWriter()
+{
+    bool failed = false;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_work_ready.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // After a failure the remaining batches are dropped; the error surfaces on the simulation thread
+        if (!failed) {
+            try {
+                m_writers[job.table]->writeRowGroup(*job.batch);
+            }
+            catch (...) {
+                failed = true;
+                std::lock_guard lock(m_mutex);
+                m_error = std::current_exception();
+            }
+        }
+        job.batch->clear();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_free[job.table].push_back(std::move(job.batch));
+            --m_in_flight;
+        }
+        m_work_done.notify_all();
+    }
+}
@@ -0,0 +1,164 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseStepScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    double toMilliseconds(std::chrono::nanoseconds duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+PulseStepScheduler::PulseStepScheduler(TrafficSystem& system, double step_length, double real_time_factor)
+    : m_system(system), m_period(0)
+{
+    if (step_length <= 0.0) {
+        throw std::invalid_argument("Step length must be positive.");
+    }
+    if (real_time_factor < 0.0) {
+        throw std::invalid_argument("Real-time factor must not be negative.");
+    }
+    if (real_time_factor != AS_FAST_AS_POSSIBLE) {
+        m_period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(step_length / real_time_factor));
+    }
+}
+
+void PulseStepScheduler::setRecoveryPolicy(double budget_fraction, std::size_t steps)
+{
+    m_recovery_fraction = budget_fraction;
+    m_recovery_steps = steps;
+}
+
+std::size_t PulseStepScheduler::run(std::size_t max_steps)
+{
+    using Clock = std::chrono::steady_clock;
+
+    m_stop_requested = false;
+    const bool paced = m_period.count() > 0;
+    auto next_start = Clock::now();
+
+    std::size_t executed = 0;
+    while (executed < max_steps && !m_stop_requested.load() && m_system.getSimulationSource().isRunning()) {
+        if (paced) {
+            std::this_thread::sleep_until(next_start);
+        }
+
+        const auto start = Clock::now();
+        const auto lateness = paced ? std::max(start - next_start, Clock::duration::zero()) : Clock::duration::zero();
+        if (!m_system.areNonCriticalConsumersEnabled()) {
+            ++m_report.degraded_steps;
+        }
+
+        m_system.stepSimulation();
+
+        const auto step_duration = Clock::now() - start;
+        recordStep(step_duration, lateness);
+        ++executed;
+
+        if (!paced) {
+            continue;
+        }
+
+        // Degrade on overrun, recover after enough comfortable steps
+        if (step_duration > m_period) {
+            ++m_report.overruns;
+            m_comfortable_steps = 0;
+            m_system.setNonCriticalConsumersEnabled(false);
+        }
+        else if (!m_system.areNonCriticalConsumersEnabled()) {
+            if (step_duration <= m_period * m_recovery_fraction) {
+                if (++m_comfortable_steps >= m_recovery_steps) {
+                    m_system.setNonCriticalConsumersEnabled(true);
+                    m_comfortable_steps = 0;
+                }
+            }
+            else {
+                m_comfortable_steps = 0;
+            }
+        }
+
+        next_start += m_period;
+        const auto now = Clock::now();
+        if (now > next_start + m_period) {
+            next_start = now;
+            ++m_report.resynchronizations;
+        }
+    }
+    return executed;
+}
+
+void PulseStepScheduler::requestStop()
+{
+    m_stop_requested = true;
+}
+
+std::chrono::nanoseconds PulseStepScheduler::getStepPeriod() const
+{
+    return m_period;
+}
+
+PulseSchedulerReport PulseStepScheduler::getReport() const
+{
+    PulseSchedulerReport report = m_report;
+    if (report.steps > 0) {
+        const auto steps = static_cast<double>(report.steps);
+        report.mean_step_ms = m_total_step_ms / steps;
+        report.mean_jitter_ms = m_total_jitter_ms / steps;
+        const double variance = m_total_jitter_sq / steps - report.mean_jitter_ms * report.mean_jitter_ms;
+        report.jitter_stddev_ms = std::sqrt(std::max(variance, 0.0));
+    }
+
+    const auto& names = m_system.getStageNames();
+    for (std::size_t i = 0; i < m_stages.size() && i < names.size(); ++i) {
+        const auto& stage = m_stages[i];
+        report.stages.push_back(PulseStageReport{
+            names[i],
+            stage.runs,
+            stage.skipped,
+            stage.runs ? stage.total_ms / static_cast<double>(stage.runs) : 0.0,
+            stage.max_ms
+        });
+    }
+    return report;
+}
+
+void PulseStepScheduler::recordStep(std::chrono::nanoseconds step_duration, std::chrono::nanoseconds lateness)
+{
+    const double step_ms = toMilliseconds(step_duration);
+    const double jitter_ms = toMilliseconds(lateness);
+
+    ++m_report.steps;
+    m_total_step_ms += step_ms;
+    m_report.max_step_ms = std::max(m_report.max_step_ms, step_ms);
+    m_total_jitter_ms += jitter_ms;
+    m_total_jitter_sq += jitter_ms * jitter_ms;
+    m_report.max_jitter_ms = std::max(m_report.max_jitter_ms, jitter_ms);
+
+    const auto& timings = m_system.getStageTimings();
+    if (m_stages.size() < timings.size()) {
+        m_stages.resize(timings.size());
+    }
+    for (std::size_t i = 0; i < timings.size(); ++i) {
+        auto& stage = m_stages[i];
+        if (timings[i].idle) {
+            continue;
+        }
+        if (timings[i].skipped) {
+            ++stage.skipped;
+            continue;
+        }
+        const double ms = toMilliseconds(timings[i].duration);
+        ++stage.runs;
+        stage.total_ms += ms;
+        stage.max_ms = std::max(stage.max_ms, ms);
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseTransitPriority.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+PulseTransitPriority::PulseTransitPriority(const PulseTransitPriorityConfig& config)
+    : m_config(config)
+{
+    if (!(config.min_lateness >= 0.0) || !(config.max_extension > 0.0) || !(config.clearance >= 0.0)
+        || !(config.min_approach_speed > 0.0) || !(config.recovery_time >= 0.0)) {
+        throw std::invalid_argument("Transit priority parameters out of range.");
+    }
+}
+
+std::size_t PulseTransitPriority::apply(const PulseTransitTable& transit, SimulationSource& source, double now)
+{
+    std::size_t granted = 0;
+    transit.forEach([&](std::size_t slot) {
+        const auto& state = transit.getState(slot);
+        if (transit.getLateness(slot) < m_config.min_lateness || state.next_traffic_light_id.empty()
+            || (state.next_signal_state != 'G' && state.next_signal_state != 'g')) {
+            return;
+        }
+
+        const double arrival = state.next_traffic_light_distance / std::max(state.speed, m_config.min_approach_speed);
+        const double hold = arrival + m_config.clearance;
+        if (hold > m_config.max_extension) {
+            return;
+        }
+
+        auto it = m_recovered_at.find(state.next_traffic_light_id);
+        if (it != m_recovered_at.end() && now < it->second) {
+            return;
+        }
+        if (source.extendGreen(state.next_traffic_light_id, hold)) {
+            m_recovered_at.insert_or_assign(state.next_traffic_light_id, now + hold + m_config.recovery_time);
+            ++granted;
+        }
+    });
+
+    m_extension_count += granted;
+    return granted;
+}
+
+std::size_t PulseTransitPriority::getExtensionCount() const
+{
+    return m_extension_count;
+}
+
+const PulseTransitPriorityConfig& PulseTransitPriority::getConfig() const
+{
+    return m_config;
+}
@@ -0,0 +1,121 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseTransitTable.h"
+
+#include <algorithm>
+#include <utility>
+
+void PulseTransitTable::add(const std::string& vehicle_id)
+{
+    if (m_slot_by_id.find(vehicle_id) != m_slot_by_id.end()) {
+        return;
+    }
+
+    std::uint32_t slot;
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else {
+        slot = static_cast<std::uint32_t>(m_ids.size());
+        m_ids.emplace_back();
+        m_states.emplace_back();
+        m_lateness.push_back(0.0);
+        m_active.push_back(0);
+    }
+
+    // Keep the buffers of a reused slot but forget its previous vehicle's schedule
+    auto& state = m_states[slot];
+    state.line.clear();
+    state.next_stop_id.clear();
+    state.next_stop_until = -1.0;
+    state.at_stop = false;
+    state.next_traffic_light_id.clear();
+    state.next_traffic_light_distance = 0.0;
+    state.speed = 0.0;
+
+    m_ids[slot].assign(vehicle_id);
+    m_lateness[slot] = 0.0;
+    m_active[slot] = 1;
+    m_slot_by_id.try_emplace(std::pmr::string(vehicle_id, &m_node_resource), slot);
+}
+
+void PulseTransitTable::remove(std::string_view vehicle_id)
+{
+    auto it = m_slot_by_id.find(vehicle_id);
+    if (it == m_slot_by_id.end()) {
+        return;
+    }
+    m_active[it->second] = 0;
+    m_free_slots.push_back(it->second);
+    m_slot_by_id.erase(it);
+}
+
+void PulseTransitTable::update(const SimulationSource& source, double now)
+{
+    m_stop_event_count = 0;
+
+    for (std::size_t slot = 0; slot < m_active.size(); ++slot) {
+        if (!m_active[slot] || !source.fillTransitState(m_ids[slot], m_state_buffer)) {
+            continue;
+        }
+
+        // The next stop changing means the vehicle has just left the previous one
+        const auto& previous = m_states[slot];
+        if (!previous.next_stop_id.empty() && previous.next_stop_id != m_state_buffer.next_stop_id
+            && previous.next_stop_until >= 0.0) {
+            m_lateness[slot] = now - previous.next_stop_until;
+            recordStopEvent(slot, m_lateness[slot]);
+        }
+        if (m_state_buffer.next_stop_until >= 0.0) {
+            m_lateness[slot] = std::max(m_lateness[slot], now - m_state_buffer.next_stop_until);
+        }
+
+        std::swap(m_states[slot], m_state_buffer);
+    }
+}
+
+void PulseTransitTable::clear()
+{
+    m_slot_by_id.clear();
+    m_free_slots.clear();
+    for (std::uint32_t slot = 0; slot < m_active.size(); ++slot) {
+        m_active[slot] = 0;
+        m_free_slots.push_back(slot);
+    }
+    m_stop_event_count = 0;
+}
+
+std::size_t PulseTransitTable::size() const
+{
+    return m_slot_by_id.size();
+}
+
+std::span<const PulseTransitStopEvent> PulseTransitTable::getStopEvents() const
+{
+    return {m_stop_events.data(), m_stop_event_count};
+}
+
+std::optional<std::size_t> PulseTransitTable::find(std::string_view vehicle_id) const
+{
+    auto it = m_slot_by_id.find(vehicle_id);
+    if (it == m_slot_by_id.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void PulseTransitTable::recordStopEvent(std::size_t slot, double lateness)
+{
+    if (m_stop_event_count == m_stop_events.size()) {
+        m_stop_events.emplace_back();
+    }
+    auto& event = m_stop_events[m_stop_event_count++];
+    const auto& previous = m_states[slot];
+    event.vehicle_id.assign(m_ids[slot]);
+    event.line.assign(previous.line);
+    event.stop_id.assign(previous.next_stop_id);
+    event.lateness = lateness;
+}
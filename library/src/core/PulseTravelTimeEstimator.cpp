@@ -0,0 +1,154 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/PulseTravelTimeEstimator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+PulseTravelTimeEstimator::PulseTravelTimeEstimator(const std::vector<PulseIntersection*>& intersections,
+                                                   const std::vector<PulseRoadBinding>& bindings,
+                                                   double smoothing, double free_flow_speed)
+    : m_smoothing(smoothing)
+{
+    if (!(smoothing > 0.0 && smoothing <= 1.0)) {
+        throw std::invalid_argument("Smoothing must be in (0, 1].");
+    }
+    if (!(free_flow_speed > 0.0)) {
+        throw std::invalid_argument("Free-flow speed must be positive.");
+    }
+
+    std::unordered_map<const PulseIntersection*, std::uint32_t> nodes;
+    for (const auto* intersection : intersections) {
+        if (!intersection) {
+            throw std::invalid_argument("Cannot track a null intersection.");
+        }
+        const auto node = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace(intersection, node);
+        m_node_index.emplace(intersection->getId(), node);
+    }
+
+    // Same edge order as PulseRouter: by intersection, then by road ID
+    for (const auto* intersection : intersections) {
+        m_edge_begin.push_back(static_cast<std::uint32_t>(m_edges.size()));
+
+        std::vector<std::pair<int, const PulseRoadConnection*>> roads;
+        for (const auto& [road_id, road] : intersection->getConnectedRoads()) {
+            if (nodes.contains(&road.getConnectedIntersection())) {
+                roads.emplace_back(road_id, &road);
+            }
+        }
+        std::sort(roads.begin(), roads.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        for (const auto& [road_id, road] : roads) {
+            m_edges.push_back(EdgeInfo{intersection->getId(), road_id, road->getDistance()});
+        }
+    }
+    m_edge_begin.push_back(static_cast<std::uint32_t>(m_edges.size()));
+
+    m_state = std::make_unique<EdgeState[]>(m_edges.size());
+    for (std::size_t edge = 0; edge < m_edges.size(); ++edge) {
+        m_state[edge].travel_time.store(m_edges[edge].length / free_flow_speed, std::memory_order_relaxed);
+        m_state[edge].speed.store(free_flow_speed, std::memory_order_relaxed);
+    }
+
+    for (const auto& binding : bindings) {
+        const auto edge = findEdge(binding.intersection_id, binding.road_id);
+        if (!edge) {
+            throw std::invalid_argument("Unknown road " + std::to_string(binding.road_id) + " at intersection " + binding.intersection_id);
+        }
+        if (!m_source_roads.try_emplace(binding.source_road_id, static_cast<std::uint32_t>(*edge)).second) {
+            throw std::invalid_argument("Source road bound twice: " + binding.source_road_id);
+        }
+    }
+}
+
+void PulseTravelTimeEstimator::update(const PulseDataManager& data_manager)
+{
+    for (const auto& transition : data_manager.getRoadTransitions()) {
+        auto it = m_source_roads.find(transition.road_id);
+        if (it != m_source_roads.end()) {
+            recordTraversal(it->second, transition.exited_at - transition.entered_at);
+        }
+    }
+}
+
+void PulseTravelTimeEstimator::recordTraversal(std::size_t edge, double travel_time)
+{
+    if (edge >= m_edges.size()) {
+        throw std::out_of_range("Edge index out of range.");
+    }
+    if (!(travel_time > 0.0)) {
+        return;
+    }
+
+    // Single writer: plain load/store pairs are enough, atomics only protect readers
+    auto& state = m_state[edge];
+    const double length = m_edges[edge].length;
+    const double speed = length > 0.0 ? length / travel_time : state.speed.load(std::memory_order_relaxed);
+    const auto samples = state.samples.load(std::memory_order_relaxed);
+
+    if (samples == 0) {
+        state.travel_time.store(travel_time, std::memory_order_relaxed);
+        state.speed.store(speed, std::memory_order_relaxed);
+    }
+    else {
+        const double previous_time = state.travel_time.load(std::memory_order_relaxed);
+        const double previous_speed = state.speed.load(std::memory_order_relaxed);
+        state.travel_time.store(previous_time + m_smoothing * (travel_time - previous_time), std::memory_order_relaxed);
+        state.speed.store(previous_speed + m_smoothing * (speed - previous_speed), std::memory_order_relaxed);
+    }
+    state.samples.store(samples + 1, std::memory_order_relaxed);
+}
+
+std::size_t PulseTravelTimeEstimator::getEdgeCount() const
+{
+    return m_edges.size();
+}
+
+std::optional<std::size_t> PulseTravelTimeEstimator::findEdge(const std::string& intersection_id, int road_id) const
+{
+    auto it = m_node_index.find(intersection_id);
+    if (it == m_node_index.end()) {
+        return std::nullopt;
+    }
+    for (auto edge = m_edge_begin[it->second]; edge < m_edge_begin[it->second + 1]; ++edge) {
+        if (m_edges[edge].road_id == road_id) {
+            return edge;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t> PulseTravelTimeEstimator::findSourceRoad(const std::string& source_road_id) const
+{
+    auto it = m_source_roads.find(source_road_id);
+    if (it == m_source_roads.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+PulseEdgeEstimate PulseTravelTimeEstimator::getEstimate(std::size_t edge) const
+{
+    if (edge >= m_edges.size()) {
+        throw std::out_of_range("Edge index out of range.");
+    }
+    const auto& state = m_state[edge];
+    return PulseEdgeEstimate{
+        state.travel_time.load(std::memory_order_relaxed),
+        state.speed.load(std::memory_order_relaxed),
+        state.samples.load(std::memory_order_relaxed)
+    };
+}
+
+void PulseTravelTimeEstimator::applyTo(PulseRouter& router) const
+{
+    for (std::size_t edge = 0; edge < m_edges.size(); ++edge) {
+        const auto estimate = getEstimate(edge);
+        if (estimate.samples > 0) {
+            router.setTravelTime(m_edges[edge].intersection_id, m_edges[edge].road_id, estimate.travel_time);
+        }
+    }
+}
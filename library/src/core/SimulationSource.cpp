@@ -0,0 +1,82 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include "core/SimulationSource.h"
+
+namespace
+{
+    void assignIds(const std::vector<std::string>& ids, std::vector<std::string>& out)
+    {
+        out.resize(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            out[i].assign(ids[i]);
+        }
+    }
+}
+
+void SimulationSource::fillVehicleIds(std::vector<std::string>& out) const
+{
+    assignIds(getAllVehicles(), out);
+}
+
+void SimulationSource::fillTrafficLightIds(std::vector<std::string>& out) const
+{
+    assignIds(getAllTrafficLights(), out);
+}
+
+void SimulationSource::fillTrafficLightState(const std::string& tl_id, std::string& out) const
+{
+    out.assign(getTrafficLightState(tl_id));
+}
+
+double SimulationSource::getSimulationTime() const
+{
+    return 0.0;
+}
+
+bool SimulationSource::fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const
+{
+    (void)vehicle_id;
+    (void)out;
+    return false;
+}
+
+bool SimulationSource::fillSignalProgram(const std::string& tl_id, PulseSignalProgram& out) const
+{
+    (void)tl_id;
+    (void)out;
+    return false;
+}
+
+PulseVehicleType SimulationSource::getVehicleType(const std::string& vehicle_id) const
+{
+    (void)vehicle_id;
+    return PulseVehicleType::CAR;
+}
+
+std::size_t SimulationSource::fillPersonStates(std::vector<PulsePersonState>& out) const
+{
+    (void)out;
+    return 0;
+}
+
+bool SimulationSource::fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const
+{
+    (void)vehicle_id;
+    (void)out;
+    return false;
+}
+
+bool SimulationSource::extendGreen(const std::string& tl_id, double seconds)
+{
+    (void)tl_id;
+    (void)seconds;
+    return false;
+}
+
+bool SimulationSource::applySignalPlan(const PulseSignalPlan& plan)
+{
+    (void)plan;
+    return false;
+}
@@ -39,6 +39,17 @@ SumoIntegration::SumoIntegration(std::string sumo_config)
     std::cout << "[INFO] Using SUMO config file: " << m_sumo_config << std::endl;
 }
 
+SumoIntegration::SumoIntegration(const PulseScenarioDescriptor& scenario)
+    : m_running(false)
+{
+    if (!scenario.valid) {
+        throw std::invalid_argument("Invalid SUMO scenario '" + scenario.name + "': " + scenario.error);
+    }
+
+    m_sumo_config = scenario.config_path;
+    std::cout << "[INFO] Using SUMO scenario " << scenario.name << ": " << m_sumo_config << std::endl;
+}
+
 void SumoIntegration::startSimulation()
 {
     if (m_running) {
@@ -47,18 +58,36 @@ void SumoIntegration::startSimulation()
 
     std::cout << "[SumoIntegration] Starting libsumo with config: " << m_sumo_config << std::endl;
 
-    libsumo::Simulation::start({"sumo", "-c", m_sumo_config});
+    std::vector<std::string> args = {"sumo", "-c", m_sumo_config};
+    if (m_seed) {
+        args.insert(args.end(), {"--seed", std::to_string(*m_seed)});
+    }
+    libsumo::Simulation::start(args);
     m_running = true;
 
+    m_traffic_light_ids = libsumo::TrafficLight::getIDList();
+    m_signals.clear();
+    m_lane_lengths.clear();
+    loadVehicleIds();
+
     std::cout << "[SumoIntegration] SUMO simulation started via libsumo." << std::endl;
 }
 
-void SumoIntegration::stepSimulation() const {
+void SumoIntegration::stepSimulation()
+{
     if (!m_running) {
         throw std::runtime_error("Cannot step simulation: SUMO not running.");
     }
 
     libsumo::Simulation::step();
+
+    // Only the vehicles that entered or left the network in this step cross the libsumo boundary
+    for (const auto& vehicle_id : libsumo::Simulation::getDepartedIDList()) {
+        addVehicleId(vehicle_id);
+    }
+    for (const auto& vehicle_id : libsumo::Simulation::getArrivedIDList()) {
+        removeVehicleId(vehicle_id);
+    }
 }
 
 void SumoIntegration::stopSimulation()
@@ -75,6 +104,11 @@ void SumoIntegration::stopSimulation()
     std::cout << "[SumoIntegration] SUMO simulation stopped." << std::endl;
 }
 
+void SumoIntegration::setSeed(std::uint64_t seed)
+{
+    m_seed = seed;
+}
+
 bool SumoIntegration::isRunning() const
 {
     return m_running;
@@ -117,10 +151,259 @@ std::string SumoIntegration::getTrafficLightState(const std::string& tl_id) cons
     return libsumo::TrafficLight::getRedYellowGreenState(tl_id);
 }
 
-void SumoIntegration::setTrafficLightState(const std::string& tl_id, const std::string& state) const {
+void SumoIntegration::setTrafficLightState(const std::string& tl_id, const std::string& state)
+{
     if (!m_running) {
         throw std::runtime_error("Cannot set traffic light state: SUMO not running.");
     }
 
     libsumo::TrafficLight::setRedYellowGreenState(tl_id, state);
+    m_signals.erase(tl_id);
+}
+
+void SumoIntegration::fillVehicleIds(std::vector<std::string>& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve vehicles: SUMO not running.");
+    }
+
+    // Vehicles can also leave without arriving (e.g. removed by another client); resynchronize then
+    if (static_cast<std::size_t>(libsumo::Vehicle::getIDCount()) != m_vehicle_ids.size()) {
+        loadVehicleIds();
+    }
+    out.resize(m_vehicle_ids.size());
+    for (std::size_t i = 0; i < m_vehicle_ids.size(); ++i) {
+        out[i].assign(m_vehicle_ids[i]);
+    }
+}
+
+void SumoIntegration::fillTrafficLightIds(std::vector<std::string>& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve traffic lights: SUMO not running.");
+    }
+
+    out.resize(m_traffic_light_ids.size());
+    for (std::size_t i = 0; i < m_traffic_light_ids.size(); ++i) {
+        out[i].assign(m_traffic_light_ids[i]);
+    }
+}
+
+void SumoIntegration::fillTrafficLightState(const std::string& tl_id, std::string& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve traffic light state: SUMO not running.");
+    }
+
+    // The state only changes at a phase switch, or when this class changes the light
+    const double now = libsumo::Simulation::getTime();
+    auto it = m_signals.find(tl_id);
+    if (it == m_signals.end()) {
+        it = m_signals.try_emplace(tl_id).first;
+        it->second.next_switch = now;
+    }
+    auto& signal = it->second;
+    if (now >= signal.next_switch) {
+        signal.state = libsumo::TrafficLight::getRedYellowGreenState(tl_id);
+        signal.next_switch = libsumo::TrafficLight::getNextSwitch(tl_id);
+    }
+    out.assign(signal.state);
+}
+
+double SumoIntegration::getSimulationTime() const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve simulation time: SUMO not running.");
+    }
+
+    return libsumo::Simulation::getTime();
+}
+
+bool SumoIntegration::fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve vehicle kinematics: SUMO not running.");
+    }
+
+    out.road_id.assign(libsumo::Vehicle::getRoadID(vehicle_id));
+    out.lane_index = libsumo::Vehicle::getLaneIndex(vehicle_id);
+    out.lane_position = libsumo::Vehicle::getLanePosition(vehicle_id);
+    out.speed = libsumo::Vehicle::getSpeed(vehicle_id);
+
+    const std::string lane_id = libsumo::Vehicle::getLaneID(vehicle_id);
+    auto it = m_lane_lengths.find(lane_id);
+    if (it == m_lane_lengths.end()) {
+        it = m_lane_lengths.emplace(lane_id, libsumo::Lane::getLength(lane_id)).first;
+    }
+    out.lane_length = it->second;
+    return true;
+}
+
+bool SumoIntegration::fillSignalProgram(const std::string& tl_id, PulseSignalProgram& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve signal program: SUMO not running.");
+    }
+
+    const std::string program_id = libsumo::TrafficLight::getProgram(tl_id);
+    for (const auto& logic : libsumo::TrafficLight::getAllProgramLogics(tl_id)) {
+        if (logic.programID != program_id) {
+            continue;
+        }
+
+        out.phases.clear();
+        for (const auto& phase : logic.phases) {
+            out.phases.push_back(PulseSignalPhase{phase->state, phase->duration});
+        }
+
+        // One entry per signal index, each listing the lane pairs that signal controls
+        out.links.clear();
+        const auto signals = libsumo::TrafficLight::getControlledLinks(tl_id);
+        for (std::size_t signal = 0; signal < signals.size(); ++signal) {
+            for (const auto& link : signals[signal]) {
+                out.links.push_back(PulseControlledLink{signal, link.fromLane, link.toLane});
+            }
+        }
+
+        out.current_phase = static_cast<std::size_t>(libsumo::TrafficLight::getPhase(tl_id));
+        out.time_to_switch = libsumo::TrafficLight::getNextSwitch(tl_id) - libsumo::Simulation::getTime();
+        return true;
+    }
+    return false;
+}
+
+PulseVehicleType SumoIntegration::getVehicleType(const std::string& vehicle_id) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve vehicle type: SUMO not running.");
+    }
+
+    const std::string vehicle_class = libsumo::Vehicle::getVehicleClass(vehicle_id);
+    if (vehicle_class == "bus" || vehicle_class == "coach") {
+        return PulseVehicleType::BUS;
+    }
+    if (vehicle_class == "truck" || vehicle_class == "trailer" || vehicle_class == "delivery") {
+        return PulseVehicleType::TRUCK;
+    }
+    if (vehicle_class == "motorcycle" || vehicle_class == "moped") {
+        return PulseVehicleType::MOTORCYCLE;
+    }
+    if (vehicle_class == "tram") {
+        return PulseVehicleType::TRAM;
+    }
+    if (vehicle_class == "bicycle") {
+        return PulseVehicleType::BICYCLE;
+    }
+    if (vehicle_class == "scooter") {
+        return PulseVehicleType::E_SCOOTER;
+    }
+    if (vehicle_class == "pedestrian") {
+        return PulseVehicleType::PEDESTRIAN;
+    }
+    return PulseVehicleType::CAR;
+}
+
+std::size_t SumoIntegration::fillPersonStates(std::vector<PulsePersonState>& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve persons: SUMO not running.");
+    }
+
+    const auto ids = libsumo::Person::getIDList();
+    if (out.size() < ids.size()) {
+        out.resize(ids.size());
+    }
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto& person = out[i];
+        const auto position = libsumo::Person::getPosition(ids[i]);
+        person.id.assign(ids[i]);
+        person.position = PulsePosition{position.x, position.y};
+        person.road_id.assign(libsumo::Person::getRoadID(ids[i]));
+        person.speed = libsumo::Person::getSpeed(ids[i]);
+        person.waiting_time = libsumo::Person::getWaitingTime(ids[i]);
+    }
+    return ids.size();
+}
+
+bool SumoIntegration::fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot retrieve transit state: SUMO not running.");
+    }
+
+    out.line.assign(libsumo::Vehicle::getLine(vehicle_id));
+    out.speed = libsumo::Vehicle::getSpeed(vehicle_id);
+
+    const auto stops = libsumo::Vehicle::getStops(vehicle_id, 1);
+    if (stops.empty()) {
+        out.next_stop_id.clear();
+        out.next_stop_until = -1.0;
+        out.at_stop = false;
+    }
+    else {
+        // Stops without a stopping place (bus stop, tram stop) are identified by their lane
+        const auto& stop = stops.front();
+        out.next_stop_id.assign(stop.stoppingPlaceID.empty() ? stop.lane : stop.stoppingPlaceID);
+        out.next_stop_until = stop.until >= 0.0 ? stop.until : -1.0;
+        out.at_stop = libsumo::Vehicle::isStopped(vehicle_id);
+    }
+
+    const auto lights = libsumo::Vehicle::getNextTLS(vehicle_id);
+    if (lights.empty()) {
+        out.next_traffic_light_id.clear();
+        out.next_traffic_light_distance = 0.0;
+    }
+    else {
+        out.next_traffic_light_id.assign(lights.front().id);
+        out.next_signal_state = lights.front().state;
+        out.next_traffic_light_distance = lights.front().dist;
+    }
+    return true;
+}
+
+bool SumoIntegration::extendGreen(const std::string& tl_id, double seconds)
+{
+    if (!m_running) {
+        throw std::runtime_error("Cannot extend traffic light phase: SUMO not running.");
+    }
+
+    const double remaining = libsumo::TrafficLight::getNextSwitch(tl_id) - libsumo::Simulation::getTime();
+    if (remaining < seconds) {
+        libsumo::TrafficLight::setPhaseDuration(tl_id, seconds);
+        m_signals.erase(tl_id);
+    }
+    return true;
+}
+
+void SumoIntegration::loadVehicleIds() const
+{
+    m_vehicle_ids.clear();
+    m_vehicle_index.clear();
+    for (const auto& vehicle_id : libsumo::Vehicle::getIDList()) {
+        addVehicleId(vehicle_id);
+    }
+}
+
+void SumoIntegration::addVehicleId(const std::string& vehicle_id) const
+{
+    if (m_vehicle_index.try_emplace(vehicle_id, m_vehicle_ids.size()).second) {
+        m_vehicle_ids.push_back(vehicle_id);
+    }
+}
+
+void SumoIntegration::removeVehicleId(const std::string& vehicle_id) const
+{
+    const auto it = m_vehicle_index.find(vehicle_id);
+    if (it == m_vehicle_index.end()) {
+        return;
+    }
+
+    // Swap with the last ID so removal stays O(1)
+    const std::size_t index = it->second;
+    m_vehicle_index.erase(it);
+    if (index + 1 != m_vehicle_ids.size()) {
+        m_vehicle_ids[index].swap(m_vehicle_ids.back());
+        m_vehicle_index[m_vehicle_ids[index]] = index;
+    }
+    m_vehicle_ids.pop_back();
 }
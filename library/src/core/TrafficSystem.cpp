@@ -2,18 +2,327 @@
 // Created by andrii on 3/1/25.
 //
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
 #include "core/TrafficSystem.h"
+#include "core/PulseProfiler.h"
+#include "core/SumoIntegration.h"
+
+#include "constants/SumoConfigPath.h"
+
+namespace
+{
+    // Built-in stages, in execution order
+    enum BuiltInStage : std::size_t {
+        COMMAND_STAGE,
+        SIMULATION_STAGE,
+        VEHICLE_SYNC_STAGE,
+        TRAFFIC_LIGHT_SYNC_STAGE,
+        PEDESTRIAN_SYNC_STAGE,
+        TRANSIT_SYNC_STAGE,
+        SNAPSHOT_STAGE,
+        CHECKSUM_STAGE,
+        BUILT_IN_STAGE_COUNT
+    };
+    constexpr const char* kBuiltInStageNames[BUILT_IN_STAGE_COUNT] = {
+        "commands", "simulation", "vehicle_sync", "traffic_light_sync", "pedestrian_sync", "transit_sync", "snapshot", "checksum"
+    };
+
+#ifdef PULSE_ENABLE_PROFILING
+    constexpr PulseProfileStage kBuiltInProfileStages[BUILT_IN_STAGE_COUNT] = {
+        PulseProfileStage::COMMANDS, PulseProfileStage::SUMO_STEP, PulseProfileStage::VEHICLE_SYNC,
+        PulseProfileStage::TRAFFIC_LIGHT_SYNC, PulseProfileStage::PEDESTRIAN_SYNC, PulseProfileStage::TRANSIT_SYNC,
+        PulseProfileStage::SNAPSHOT, PulseProfileStage::CHECKSUM
+    };
+
+    // Feeds the stage timings of a step to the profiler, so every stage is timed only once
+    void recordProfile(const std::vector<PulseStageTiming>& timings, bool checksums)
+    {
+        auto& profiler = PulseProfiler::getInstance();
+        for (std::size_t i = 0; i < BUILT_IN_STAGE_COUNT; ++i) {
+            if (!timings[i].idle && (i != CHECKSUM_STAGE || checksums)) {
+                profiler.record(kBuiltInProfileStages[i], timings[i].duration);
+            }
+        }
+
+        std::chrono::nanoseconds consumers{0};
+        bool consumed = false;
+        for (std::size_t i = BUILT_IN_STAGE_COUNT; i < timings.size(); ++i) {
+            if (!timings[i].idle && !timings[i].skipped) {
+                consumers += timings[i].duration;
+                consumed = true;
+            }
+        }
+        if (consumed) {
+            profiler.record(PulseProfileStage::CONSUMERS, consumers);
+        }
+    }
+#endif
+}
+
+TrafficSystem& TrafficSystem::getInstance()
+{
+    static TrafficSystem instance(std::make_unique<SumoIntegration>(SUMO_CONFIG_PATH), PulseDataManager::getInstance());
+    return instance;
+}
+
+TrafficSystem::TrafficSystem(std::unique_ptr<SimulationSource> source)
+    : m_simulationSource(std::move(source)),
+      m_ownedDataManager(std::make_unique<PulseDataManager>()),
+      m_dataManager(m_ownedDataManager.get()),
+      m_stageNames(std::begin(kBuiltInStageNames), std::end(kBuiltInStageNames)),
+      m_stageTimings(BUILT_IN_STAGE_COUNT),
+      m_stageRates(BUILT_IN_STAGE_COUNT)
+{
+    if (!m_simulationSource) {
+        throw std::invalid_argument("Cannot create a traffic system without a simulation source.");
+    }
+}
+
+TrafficSystem::TrafficSystem(std::unique_ptr<SimulationSource> source, PulseDataManager& data_manager)
+    : m_simulationSource(std::move(source)),
+      m_dataManager(&data_manager),
+      m_stageNames(std::begin(kBuiltInStageNames), std::end(kBuiltInStageNames)),
+      m_stageTimings(BUILT_IN_STAGE_COUNT),
+      m_stageRates(BUILT_IN_STAGE_COUNT)
+{
+    if (!m_simulationSource) {
+        throw std::invalid_argument("Cannot create a traffic system without a simulation source.");
+    }
+}
+
+template <typename Stage>
+void TrafficSystem::runStage(std::size_t index, Stage&& stage)
+{
+    const auto start = std::chrono::steady_clock::now();
+    stage();
+    m_stageTimings[index] = PulseStageTiming{std::chrono::steady_clock::now() - start, false, false};
+}
+
+bool TrafficSystem::isDue(std::size_t index, std::uint64_t step) const
+{
+    const auto& rate = m_stageRates[index];
+    return step % rate.period == rate.phase;
+}
 
 void TrafficSystem::initialize()
 {
-    m_sumoIntegration->startSimulation();
-    auto& manager = PulseDataManager::getInstance();
-    manager.syncFromSumo(*m_sumoIntegration);
+    m_simulationSource->startSimulation();
+    m_dataManager->syncFromSumo(*m_simulationSource);
+    m_dataManager->publishSnapshot();
 }
 
 void TrafficSystem::stepSimulation()
 {
-    m_sumoIntegration->stepSimulation();
-    auto& manager = PulseDataManager::getInstance();
-    manager.updateFromSumo(*m_sumoIntegration);
-}
\ No newline at end of file
+    PULSE_PROFILE_SCOPE(PulseProfileStage::STEP);
+    const std::uint64_t step = m_steps;
+
+    // Stages that are not due this step keep their results from the last run
+    const auto run = [&](std::size_t index, auto&& stage) {
+        if (!isDue(index, step)) {
+            m_stageTimings[index] = PulseStageTiming{std::chrono::nanoseconds{0}, false, true};
+            return;
+        }
+        runStage(index, stage);
+    };
+
+    run(COMMAND_STAGE, [this] { applyCommands(); });
+    run(SIMULATION_STAGE, [this] { m_simulationSource->stepSimulation(); });
+    m_dataManager->beginUpdate();
+    run(VEHICLE_SYNC_STAGE, [this] { m_dataManager->syncVehicles(*m_simulationSource); });
+    run(TRAFFIC_LIGHT_SYNC_STAGE, [this] { m_dataManager->syncTrafficLights(*m_simulationSource); });
+    run(PEDESTRIAN_SYNC_STAGE, [this] { m_dataManager->syncPedestrians(*m_simulationSource); });
+    run(TRANSIT_SYNC_STAGE, [this] { m_dataManager->syncTransit(*m_simulationSource); });
+    run(SNAPSHOT_STAGE, [this] { m_dataManager->publishSnapshot(); });
+    ++m_steps;
+    run(CHECKSUM_STAGE, [this] {
+        if (!m_checksumsEnabled) {
+            return;
+        }
+        const auto& checksum = m_checksums.compute(*m_dataManager, m_steps);
+        if (m_checksumStream) {
+            PulseChecksumRecorder::write(*m_checksumStream, checksum);
+        }
+    });
+
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+        auto& consumer = m_consumers[i];
+        if (isDue(BUILT_IN_STAGE_COUNT + i, step) && !consumer.critical && !m_nonCriticalEnabled) {
+            m_stageTimings[BUILT_IN_STAGE_COUNT + i] = PulseStageTiming{std::chrono::nanoseconds{0}, true, false};
+            continue;
+        }
+        run(BUILT_IN_STAGE_COUNT + i, [&] { consumer.callback(*this); });
+    }
+
+#ifdef PULSE_ENABLE_PROFILING
+    recordProfile(m_stageTimings, m_checksumsEnabled);
+#endif
+}
+
+void TrafficSystem::applyCommands()
+{
+    if (m_commands.empty()) {
+        return;
+    }
+
+    for (const auto& command : m_commands.drain()) {
+        try {
+            if (command.type == PulseControlCommandType::LIGHT_OVERRIDE) {
+                m_simulationSource->setTrafficLightState(command.traffic_light_id, command.state);
+            }
+            else {
+                if (!m_simulationSource->applySignalPlan(command.plan)) {
+                    ++m_rejectedCommands;
+                    continue;
+                }
+                if (auto* traffic_light = m_dataManager->getTrafficLight(command.traffic_light_id)) {
+                    traffic_light->setDurations(command.plan.durations);
+                }
+            }
+            ++m_appliedCommands;
+        }
+        catch (const std::exception&) {
+            // One bad command must not hold back the rest of the batch
+            ++m_rejectedCommands;
+        }
+    }
+}
+
+void TrafficSystem::stopSimulation()
+{
+    m_simulationSource->stopSimulation();
+}
+
+void TrafficSystem::addStepConsumer(const std::string& name, StepConsumer consumer, bool critical)
+{
+    if (!consumer) {
+        throw std::invalid_argument("Cannot add an empty step consumer: " + name);
+    }
+    m_consumers.push_back(Consumer{std::move(consumer), critical});
+    m_stageNames.push_back(name);
+    m_stageTimings.emplace_back();
+    m_stageRates.emplace_back();
+}
+
+void TrafficSystem::setStageRate(const std::string& name, std::uint32_t period, std::optional<std::uint32_t> phase)
+{
+    const auto it = std::find(m_stageNames.begin(), m_stageNames.end(), name);
+    if (it == m_stageNames.end()) {
+        throw std::invalid_argument("Unknown stage: " + name);
+    }
+    const auto index = static_cast<std::size_t>(it - m_stageNames.begin());
+    if (period == 0) {
+        throw std::invalid_argument("Stage period must be at least one step: " + name);
+    }
+    if (index == SIMULATION_STAGE && period != 1) {
+        throw std::invalid_argument("The simulation stage must run every step.");
+    }
+    if (phase && *phase >= period) {
+        throw std::invalid_argument("Stage phase must be below its period: " + name);
+    }
+
+    if (!phase) {
+        // Runs of two stages coincide iff their phases agree modulo gcd(periods); pick the phase
+        // that coincides with the fewest other periodic stages
+        std::size_t fewest = std::numeric_limits<std::size_t>::max();
+        for (std::uint32_t candidate = 0; candidate < period && fewest > 0; ++candidate) {
+            std::size_t collisions = 0;
+            for (std::size_t other = 0; other < m_stageRates.size(); ++other) {
+                const auto& rate = m_stageRates[other];
+                if (other == index || rate.period == 1) {
+                    continue;
+                }
+                const std::uint32_t divisor = std::gcd(period, rate.period);
+                if (candidate % divisor == rate.phase % divisor) {
+                    ++collisions;
+                }
+            }
+            if (collisions < fewest) {
+                fewest = collisions;
+                phase = candidate;
+            }
+        }
+    }
+
+    m_stageRates[index] = PulseStageRate{period, *phase};
+}
+
+const std::vector<PulseStageRate>& TrafficSystem::getStageRates() const
+{
+    return m_stageRates;
+}
+
+void TrafficSystem::setNonCriticalConsumersEnabled(bool enabled)
+{
+    m_nonCriticalEnabled = enabled;
+}
+
+bool TrafficSystem::areNonCriticalConsumersEnabled() const
+{
+    return m_nonCriticalEnabled;
+}
+
+const std::vector<std::string>& TrafficSystem::getStageNames() const
+{
+    return m_stageNames;
+}
+
+const std::vector<PulseStageTiming>& TrafficSystem::getStageTimings() const
+{
+    return m_stageTimings;
+}
+
+void TrafficSystem::enableChecksums(std::ostream* stream)
+{
+    m_checksumsEnabled = true;
+    m_checksumStream = stream;
+}
+
+void TrafficSystem::disableChecksums()
+{
+    m_checksumsEnabled = false;
+    m_checksumStream = nullptr;
+}
+
+bool TrafficSystem::areChecksumsEnabled() const
+{
+    return m_checksumsEnabled;
+}
+
+const PulseStateChecksum& TrafficSystem::getLastChecksum() const
+{
+    return m_checksums.getLast();
+}
+
+std::uint64_t TrafficSystem::getStepCount() const
+{
+    return m_steps;
+}
+
+PulseCommandQueue& TrafficSystem::getCommandQueue()
+{
+    return m_commands;
+}
+
+std::uint64_t TrafficSystem::getAppliedCommandCount() const
+{
+    return m_appliedCommands;
+}
+
+std::uint64_t TrafficSystem::getRejectedCommandCount() const
+{
+    return m_rejectedCommands;
+}
+
+PulseDataManager& TrafficSystem::getDataManager()
+{
+    return *m_dataManager;
+}
+
+SimulationSource& TrafficSystem::getSimulationSource()
+{
+    return *m_simulationSource;
+}
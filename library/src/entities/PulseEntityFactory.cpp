@@ -20,11 +20,11 @@ std::unique_ptr<PulseEntity> PulseEntityFactory::createEntity(
     switch (type)
     {
         case PulseEntityType::INTERSECTION:
-            return std::make_unique<PulseIntersection>(id, position);
+            return create<PulseEntityType::INTERSECTION>(id, position);
         case PulseEntityType::TRAFFIC_LIGHT:
-            return std::make_unique<PulseTrafficLight>(id, TrafficLightDurations());
+            return create<PulseEntityType::TRAFFIC_LIGHT>(id, TrafficLightDurations());
         case PulseEntityType::VEHICLE:
-            return std::make_unique<PulseVehicle>(id, vehicle_type, vehicle_role, position);
+            return create<PulseEntityType::VEHICLE>(id, vehicle_type, vehicle_role, position);
         default:
             return nullptr;
     }
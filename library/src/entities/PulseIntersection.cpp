@@ -9,16 +9,6 @@
 PulseIntersection::PulseIntersection(const std::string &intersection_id, const PulsePosition &position)
     : m_intersection_id(intersection_id), m_position(position), m_statistics(intersection_id) {}
 
-std::string PulseIntersection::getId() const
-{
-    return m_intersection_id;
-}
-
-PulsePosition PulseIntersection::getPosition() const
-{
-    return m_position;
-}
-
 void PulseIntersection::addRoadConnection(int road_id, PulseIntersection* intersection, PulseTrafficLight* traffic_light, double distance)
 {
     if (!intersection || !traffic_light)
@@ -7,21 +7,6 @@
 PulseTrafficLight::PulseTrafficLight(const std::string& traffic_light_id, const TrafficLightDurations& durations)
     : m_traffic_light_id(traffic_light_id), m_current_state(TrafficLightState::RED), m_durations(durations) {}
 
-std::string PulseTrafficLight::getId() const
-{
-    return m_traffic_light_id;
-}
-
-void PulseTrafficLight::setState(TrafficLightState state)
-{
-    m_current_state = state;
-}
-
-TrafficLightState PulseTrafficLight::getState() const
-{
-    return m_current_state;
-}
-
 void PulseTrafficLight::setDurations(const TrafficLightDurations& durations)
 {
     m_durations = durations;
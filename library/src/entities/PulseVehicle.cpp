@@ -4,30 +4,32 @@
 
 #include "entities/PulseVehicle.h"
 
-PulseVehicle::PulseVehicle(const std::string& vehicle_id, PulseVehicleType type, PulseVehicleRole role, const PulsePosition& position)
-    : m_vehicle_id(vehicle_id), m_type(type), m_role(role), m_position(position) {}
-
-std::string PulseVehicle::getId() const
-{
-    return m_vehicle_id;
-}
-
-PulseVehicleType PulseVehicle::getType() const
-{
-    return m_type;
-}
+#include <limits>
 
-PulseVehicleRole PulseVehicle::getRole() const
-{
-    return m_role;
-}
+PulseVehicle::PulseVehicle(const std::string& vehicle_id, PulseVehicleType type, PulseVehicleRole role, const PulsePosition& position)
+    : m_vehicle_id(vehicle_id), m_type(type), m_role(role), m_position(position),
+      m_road_entry_time(std::numeric_limits<double>::quiet_NaN()) {}
 
-PulsePosition PulseVehicle::getPosition() const
+void PulseVehicle::updateKinematics(const PulseVehicleKinematics& kinematics)
 {
-    return m_position;
+    m_kinematics.road_id.assign(kinematics.road_id);
+    m_kinematics.lane_index = kinematics.lane_index;
+    m_kinematics.lane_position = kinematics.lane_position;
+    m_kinematics.speed = kinematics.speed;
+    m_kinematics.lane_length = kinematics.lane_length;
 }
 
-void PulseVehicle::updatePosition(const PulsePosition& new_position)
+void PulseVehicle::reset(const std::string& vehicle_id, PulseVehicleType type, PulseVehicleRole role, const PulsePosition& position)
 {
-    m_position = new_position;
+    m_vehicle_id.assign(vehicle_id);
+    m_type = type;
+    m_role = role;
+    m_position = position;
+    m_kinematics.road_id.clear();
+    m_kinematics.lane_index = 0;
+    m_kinematics.lane_position = 0.0;
+    m_kinematics.speed = 0.0;
+    m_kinematics.lane_length = 0.0;
+    m_road_entry_time = std::numeric_limits<double>::quiet_NaN();
+    ++m_generation;
 }
@@ -0,0 +1,74 @@
+#include "TrafficPulseLibrary.h"
+#include "constants/SumoSimulationsPath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Generates demand variants of a city's latest snapshot and runs each end to end in SUMO.
+// Variants are written next to the snapshot; findLatest() skips them, so reruns keep scaling the original.
+// Usage: stress_scenarios [scenario_root] [city] [steps]
+int main(int argc, char** argv) {
+    const std::string root = argc > 1 ? argv[1] : SUMO_SIMULATIONS_PATH;
+    const std::string city = argc > 2 ? argv[2] : "zhytomyr";
+    const int steps = argc > 3 ? std::atoi(argv[3]) : 3600;
+
+    PulseScenarioCatalog catalog(root);
+    catalog.scan();
+    const PulseScenarioDescriptor* source = catalog.findLatest(city);
+    if (source == nullptr) {
+        std::cerr << "No valid scenario for " << city << " under " << root << std::endl;
+        return 1;
+    }
+
+    std::vector<PulseDemandTransform> variants(4);
+    variants[0].name = "x2";
+    variants[0].scale = 2.0;
+    variants[1].name = "x5";
+    variants[1].scale = 5.0;
+    variants[2].name = "x10";
+    variants[2].scale = 10.0;
+    variants[3].name = "rush";
+    variants[3].begin = 0.0;
+    variants[3].end = 1800.0;
+    for (auto& variant : variants) {
+        variant.jitter = 60.0;
+        variant.seed = 42;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    PulseScenarioTransformer transformer(root);
+    for (const auto& variant : variants) {
+        const auto transform_start = Clock::now();
+        const PulseTransformResult result = transformer.transform(*source, variant);
+        const std::chrono::duration<double> transform_time = Clock::now() - transform_start;
+
+        const auto run_start = Clock::now();
+        TrafficSystem system(std::make_unique<SumoIntegration>(result.scenario));
+        system.initialize();
+        std::size_t peak_vehicles = 0;
+        for (int step = 0; step < steps; ++step) {
+            system.stepSimulation();
+            std::size_t vehicles = 0;
+            for ([[maybe_unused]] const auto& vehicle : system.getDataManager().viewVehicles()) {
+                ++vehicles;
+            }
+            peak_vehicles = std::max(peak_vehicles, vehicles);
+        }
+        system.stopSimulation();
+        const std::chrono::duration<double> run_time = Clock::now() - run_start;
+
+        std::cout << result.scenario.name
+                  << ": trips " << result.trips_read << " -> " << result.trips_written
+                  << ", transform " << transform_time.count() << " s"
+                  << ", " << steps << " steps in " << run_time.count() << " s"
+                  << " (" << run_time.count() * 1000.0 / steps << " ms/step)"
+                  << ", peak vehicles " << peak_vehicles << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef CHURNMOCKSUMO_H
+#define CHURNMOCKSUMO_H
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MockSimulationSource.h"
+
+/**
+ * @brief Source with a fixed-size fleet whose vehicles depart and arrive on every advance(),
+ *        shared by the pooling and allocation tests.
+ */
+class ChurnMockSumo : public MockSimulationSource
+{
+public:
+    std::vector<std::string> getAllVehicles() const override { return m_ids; }
+
+    std::vector<std::string> getAllTrafficLights() const override { return {"mock_tl1", "mock_tl2"}; }
+
+    std::pair<double, double> getVehiclePosition(const std::string&) const override
+    {
+        return {static_cast<double>(m_step), 1.0};
+    }
+
+    std::string getTrafficLightState(const std::string&) const override { return "rrrrGGGGrrrrGGGGyyyy"; }
+
+    void fillVehicleIds(std::vector<std::string>& out) const override
+    {
+        out.resize(m_ids.size());
+        for (std::size_t i = 0; i < m_ids.size(); ++i) {
+            out[i].assign(m_ids[i]);
+        }
+    }
+
+    void fillTrafficLightIds(std::vector<std::string>& out) const override
+    {
+        out.resize(2);
+        out[0].assign("mock_tl1");
+        out[1].assign("mock_tl2");
+    }
+
+    void fillTrafficLightState(const std::string&, std::string& out) const override
+    {
+        out.assign("rrrrGGGGrrrrGGGGyyyy");
+    }
+
+    /**
+     * @brief Replaces a quarter of the fleet with newly departed vehicles, keeping the size constant.
+     */
+    void advance()
+    {
+        ++m_step;
+        for (std::size_t i = m_step % 4; i < m_ids.size(); i += 4) {
+            m_ids[i].assign(makeId());
+        }
+    }
+
+    void populate(std::size_t count)
+    {
+        m_ids.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            m_ids.push_back(makeId());
+        }
+    }
+
+private:
+    // Fixed-width IDs longer than the small-string buffer, so every vehicle ID lives on the heap
+    std::string makeId()
+    {
+        std::string id = std::to_string(m_next_id++);
+        return "passenger_vehicle_" + std::string(12 - id.size(), '0') + id;
+    }
+
+    std::vector<std::string> m_ids;
+    std::size_t m_step = 0;
+    std::size_t m_next_id = 0;
+};
+
+#endif //CHURNMOCKSUMO_H
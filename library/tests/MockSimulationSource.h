@@ -0,0 +1,39 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef MOCKSIMULATIONSOURCE_H
+#define MOCKSIMULATIONSOURCE_H
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/SimulationSource.h"
+
+/**
+ * @brief Base of the test sources: an empty network that runs between startSimulation() and
+ *        stopSimulation(), shows every light red and ignores light changes. Tests override only
+ *        what they script.
+ */
+class MockSimulationSource : public SimulationSource
+{
+public:
+    void startSimulation() override { m_running = true; }
+    void stepSimulation() override {}
+    void stopSimulation() override { m_running = false; }
+    bool isRunning() const override { return m_running; }
+
+    std::vector<std::string> getAllVehicles() const override { return {}; }
+    std::pair<double, double> getVehiclePosition(const std::string&) const override { return {0.0, 0.0}; }
+    std::vector<std::string> getAllTrafficLights() const override { return {}; }
+    std::string getTrafficLightState(const std::string&) const override { return "r"; }
+    void setTrafficLightState(const std::string&, const std::string&) override {}
+
+private:
+    bool m_running = false;
+};
+
+#endif //MOCKSIMULATIONSOURCE_H
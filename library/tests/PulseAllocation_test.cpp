@@ -0,0 +1,127 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+// Built as its own executable: replacing the global operator new affects the whole binary,
+// so the counting hook is kept out of library_tests.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "ChurnMockSumo.h"
+
+#include "core/PulseDataManager.h"
+
+#include "entities/PulseVehicle.h"
+
+// Global allocator hook: counts heap allocations while g_count_allocations is set. Every
+// replaceable form is replaced so each allocation and its release go through malloc and free; the
+// operators are kept out of line so the compiler never pairs a new-expression with free() directly.
+namespace
+{
+    std::atomic<bool> g_count_allocations{false};
+    std::atomic<std::size_t> g_allocation_count{0};
+
+    void* allocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        if (g_count_allocations.load(std::memory_order_relaxed)) {
+            g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        size = size ? size : 1;
+        if (alignment <= alignof(std::max_align_t)) {
+            return std::malloc(size);
+        }
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void* allocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        if (void* ptr = allocate(size, alignment)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+[[gnu::noinline]] void* operator new(std::size_t size) { return allocateOrThrow(size, 0); }
+[[gnu::noinline]] void* operator new[](std::size_t size) { return allocateOrThrow(size, 0); }
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+[[gnu::noinline]] void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+[[gnu::noinline]] void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+[[gnu::noinline]] void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+[[gnu::noinline]] void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+TEST(PulseAllocationTest, SteadyStateUpdateMakesNoHeapAllocations)
+{
+    auto& manager = PulseDataManager::getInstance();
+    manager.clearAll();
+
+    ChurnMockSumo mockSumo;
+    mockSumo.populate(512);
+    manager.syncFromSumo(mockSumo);
+
+    // Warm up until buffers, pools and the hash table have reached their working size
+    for (int i = 0; i < 16; ++i) {
+        mockSumo.advance();
+        manager.updateFromSumo(mockSumo);
+    }
+
+    g_allocation_count = 0;
+    for (int i = 0; i < 64; ++i) {
+        mockSumo.advance();
+        g_count_allocations = true;
+        manager.updateFromSumo(mockSumo);
+        g_count_allocations = false;
+    }
+
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+    EXPECT_EQ(manager.getAllVehicles().size(), 512u);
+    manager.clearAll();
+}
+
+TEST(PulseAllocationTest, IteratingViewsMakesNoHeapAllocations)
+{
+    auto& manager = PulseDataManager::getInstance();
+    manager.clearAll();
+
+    ChurnMockSumo mockSumo;
+    mockSumo.populate(512);
+    manager.syncFromSumo(mockSumo);
+
+    const PulseBoundingBox box{{0.0, 0.0}, {1e9, 1e9}};
+    std::size_t cars = 0;
+    std::size_t lights = 0;
+
+    g_allocation_count = 0;
+    g_count_allocations = true;
+    for (const auto& vehicle : manager.viewVehicles() | PulseViews::ofType(PulseVehicleType::CAR) | PulseViews::within(box)) {
+        cars += vehicle.getRole() == PulseVehicleRole::NORMAL;
+    }
+    for (const auto& traffic_light : manager.viewTrafficLights()) {
+        lights += !traffic_light.getId().empty();
+    }
+    g_count_allocations = false;
+
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+    EXPECT_EQ(cars, 512u);
+    EXPECT_EQ(lights, 2u);
+    manager.clearAll();
+}
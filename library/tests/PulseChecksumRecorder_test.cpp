@@ -0,0 +1,171 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseChecksumRecorder.h"
+#include "core/PulseStateHasher.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    std::vector<unsigned char> makeInput(std::size_t size)
+    {
+        std::vector<unsigned char> input(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            input[i] = static_cast<unsigned char>(i * 131 + 7);
+        }
+        return input;
+    }
+
+    void populate(PulseDataManager& manager, bool reversed)
+    {
+        std::vector<std::string> ids = {"a", "b", "c", "d"};
+        if (reversed) {
+            std::reverse(ids.begin(), ids.end());
+        }
+        for (const auto& id : ids) {
+            const double x = static_cast<double>(id[0]);
+            manager.addVehicle(std::make_unique<PulseVehicle>(id, PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{x, 0.0}));
+            manager.addTrafficLight(std::make_unique<PulseTrafficLight>("tl_" + id));
+            manager.addIntersection(std::make_unique<PulseIntersection>("j_" + id, PulsePosition{x, x}));
+        }
+    }
+
+    // Vehicle "v" moves 1 m per step; from diverge_at on it moves 1 mm further
+    class DriftingSource : public MockSimulationSource
+    {
+    public:
+        explicit DriftingSource(std::uint64_t diverge_at = 0) : m_diverge_at(diverge_at) {}
+
+        void stepSimulation() override { ++m_step; }
+        std::vector<std::string> getAllVehicles() const override { return {"v", "w"}; }
+
+        std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const override
+        {
+            if (vehicle_id == "w") {
+                return {0.0, 0.0};
+            }
+            const double drift = (m_diverge_at > 0 && m_step >= m_diverge_at) ? 0.001 : 0.0;
+            return {static_cast<double>(m_step) + drift, 0.0};
+        }
+
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl"}; }
+        std::string getTrafficLightState(const std::string&) const override { return m_step % 2 ? "g" : "r"; }
+
+    private:
+        std::uint64_t m_diverge_at;
+        std::uint64_t m_step = 0;
+    };
+
+    std::string runWithChecksums(std::uint64_t diverge_at, int steps)
+    {
+        std::ostringstream stream;
+        TrafficSystem system(std::make_unique<DriftingSource>(diverge_at));
+        system.initialize();
+        system.enableChecksums(&stream);
+        for (int i = 0; i < steps; ++i) {
+            system.stepSimulation();
+        }
+        return stream.str();
+    }
+}
+
+TEST(PulseStateHasherTest, DigestIsStableAcrossBuildsAndChunking)
+{
+    // Reference values shared by the scalar, SSE2 and AVX2 paths; a change here breaks stream comparisons
+    const std::pair<std::size_t, std::uint64_t> expected[] = {
+        {0, 0x92e66c43a44711b0ull}, {33, 0xe3fdcf3f4e78ba0dull}, {512, 0x27b2967d20cbf352ull}, {1500, 0x521f46dd290895f1ull},
+    };
+
+    const auto input = makeInput(1500);
+    for (const auto& [size, digest] : expected) {
+        EXPECT_EQ(PulseStateHasher::hash(input.data(), size), digest) << size;
+
+        PulseStateHasher hasher;
+        for (std::size_t offset = 0, chunk = 1; offset < size; chunk = chunk * 3 + 1) {
+            const std::size_t take = std::min(chunk, size - offset);
+            hasher.update(input.data() + offset, take);
+            offset += take;
+        }
+        EXPECT_EQ(hasher.digest(), digest) << size;
+    }
+
+    EXPECT_NE(PulseStateHasher::hash(input.data(), 64, 1), PulseStateHasher::hash(input.data(), 64, 2));
+}
+
+TEST(PulseChecksumRecorderTest, ChecksumIgnoresInsertionOrder)
+{
+    PulseDataManager forward;
+    PulseDataManager backward;
+    populate(forward, false);
+    populate(backward, true);
+
+    PulseChecksumRecorder recorder;
+    const PulseStateChecksum first = recorder.compute(forward, 1);
+    const PulseStateChecksum second = recorder.compute(backward, 1);
+    EXPECT_EQ(first, second);
+
+    backward.getVehicle("c")->updatePosition(PulsePosition{1000.0, 0.0});
+    backward.getIntersection("j_a")->getStatistics().addVehiclePass(3.0);
+    const PulseStateChecksum changed = recorder.compute(backward, 1);
+    EXPECT_NE(changed.state, first.state);
+    EXPECT_NE(changed.vehicles, first.vehicles);
+    EXPECT_EQ(changed.traffic_lights, first.traffic_lights);
+    EXPECT_NE(changed.statistics, first.statistics);
+}
+
+TEST(PulseChecksumRecorderTest, StreamsRoundTripAndLocateDivergence)
+{
+    PulseStateChecksum checksum{42, 0x1, 0xabcdef, 0xffffffffffffffffull, 0};
+    std::stringstream stream;
+    PulseChecksumRecorder::write(stream, checksum);
+    EXPECT_EQ(stream.str(), "42 0000000000000001 0000000000abcdef ffffffffffffffff 0000000000000000\n");
+
+    PulseStateChecksum parsed;
+    ASSERT_TRUE(PulseChecksumRecorder::read(stream, parsed));
+    EXPECT_EQ(parsed, checksum);
+    EXPECT_FALSE(PulseChecksumRecorder::read(stream, parsed));
+
+    std::istringstream malformed("7 xyz\n");
+    EXPECT_THROW((void)PulseChecksumRecorder::read(malformed, parsed), std::runtime_error);
+
+    // Identical runs produce identical streams
+    const std::string reference = runWithChecksums(0, 10);
+    std::istringstream a(reference);
+    std::istringstream b(runWithChecksums(0, 10));
+    EXPECT_FALSE(PulseChecksumRecorder::findFirstDivergence(a, b).has_value());
+
+    std::istringstream expected(reference);
+    std::istringstream drifted(runWithChecksums(6, 10));
+    EXPECT_EQ(PulseChecksumRecorder::findFirstDivergence(expected, drifted), 6u);
+
+    std::istringstream full(reference);
+    std::istringstream truncated(runWithChecksums(0, 4));
+    EXPECT_EQ(PulseChecksumRecorder::findFirstDivergence(full, truncated), 5u);
+}
+
+TEST(PulseChecksumRecorderTest, TrafficSystemChecksumsOnlyWhenEnabled)
+{
+    TrafficSystem system(std::make_unique<DriftingSource>());
+    system.initialize();
+    system.stepSimulation();
+    EXPECT_FALSE(system.areChecksumsEnabled());
+    EXPECT_EQ(system.getLastChecksum().state, 0u);
+
+    system.enableChecksums();
+    system.stepSimulation();
+    EXPECT_EQ(system.getLastChecksum().step, 2u);
+    EXPECT_NE(system.getLastChecksum().state, 0u);
+
+    system.disableChecksums();
+    system.stepSimulation();
+    EXPECT_EQ(system.getLastChecksum().step, 2u);
+    EXPECT_EQ(system.getStepCount(), 3u);
+}
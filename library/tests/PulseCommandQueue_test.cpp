@@ -0,0 +1,184 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseCommandQueue.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    class RecordingSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl1", "tl2"}; }
+        std::string getTrafficLightState(const std::string& tl_id) const override { return tl_id == "tl1" ? m_state : "r"; }
+
+        void setTrafficLightState(const std::string& tl_id, const std::string& state) override
+        {
+            if (tl_id != "tl1" && tl_id != "tl2") {
+                throw std::invalid_argument("Unknown traffic light: " + tl_id);
+            }
+            ++overrides;
+            m_state = state;
+        }
+
+        bool applySignalPlan(const PulseSignalPlan& plan) override
+        {
+            last_plan = plan;
+            return true;
+        }
+
+        int overrides = 0;
+        PulseSignalPlan last_plan;
+
+    private:
+        std::string m_state = "r";
+    };
+}
+
+TEST(PulseCommandQueueTest, DrainCoalescesPerLightAndType)
+{
+    PulseCommandQueue queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.drain().empty());
+
+    EXPECT_EQ(queue.overrideLight("tl1", "r"), 1u);
+    queue.overrideLight("tl2", "G");
+    queue.overrideLight("tl1", "y");
+    PulseSignalPlan plan;
+    plan.traffic_light_id = "tl1";
+    plan.offset = 5.0;
+    queue.changePlan(plan);
+    EXPECT_EQ(queue.overrideLight("tl1", "G"), 5u);
+    EXPECT_FALSE(queue.empty());
+
+    const auto& batch = queue.drain();
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch[0].traffic_light_id, "tl2");
+    EXPECT_EQ(batch[1].type, PulseControlCommandType::PLAN_CHANGE);
+    EXPECT_EQ(batch[1].plan.offset, 5.0);
+    EXPECT_EQ(batch[2].state, "G");
+    EXPECT_EQ(batch[2].sequence, 5u);
+    EXPECT_LE(batch[1].issued_at, batch[2].issued_at);
+
+    EXPECT_EQ(queue.getIssuedCount(), 5u);
+    EXPECT_EQ(queue.getCoalescedCount(), 2u);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.drain().empty());
+
+    EXPECT_THROW((void)queue.overrideLight("", "G"), std::invalid_argument);
+    EXPECT_THROW((void)queue.overrideLight("tl1", ""), std::invalid_argument);
+}
+
+TEST(PulseCommandQueueTest, ConcurrentProducersLoseNothing)
+{
+    constexpr int kProducers = 4;
+    constexpr int kCommandsPerProducer = 5000;
+
+    PulseCommandQueue queue;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            const std::string id = "tl" + std::to_string(p);
+            for (int i = 0; i < kCommandsPerProducer; ++i) {
+                queue.overrideLight(id, std::to_string(i));
+            }
+            ++finished;
+        });
+    }
+
+    // Per producer, the last state drained must be its last command
+    std::vector<int> last(kProducers, -1);
+    std::size_t drained = 0;
+    while (finished < kProducers || !queue.empty()) {
+        std::uint64_t sequence = 0;
+        for (const auto& command : queue.drain()) {
+            EXPECT_GT(command.sequence, sequence);
+            sequence = command.sequence;
+            auto& previous = last[command.traffic_light_id.back() - '0'];
+            const int value = std::stoi(command.state);
+            EXPECT_GT(value, previous);
+            previous = value;
+            ++drained;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    for (const int value : last) {
+        EXPECT_EQ(value, kCommandsPerProducer - 1);
+    }
+    EXPECT_EQ(drained + queue.getCoalescedCount(), static_cast<std::size_t>(kProducers * kCommandsPerProducer));
+}
+
+TEST(PulseCommandQueueTest, OlderTicketNeverFollowsNewerAcrossDrains)
+{
+    constexpr int kProducers = 4;
+    constexpr int kCommandsPerProducer = 5000;
+
+    // Every producer targets the same light, so late-linked nodes race with drains
+    PulseCommandQueue queue;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < kCommandsPerProducer; ++i) {
+                queue.overrideLight("tl1", "G");
+            }
+            ++finished;
+        });
+    }
+
+    std::uint64_t applied = 0;
+    while (finished < kProducers || !queue.empty()) {
+        for (const auto& command : queue.drain()) {
+            EXPECT_GT(command.sequence, applied);
+            applied = command.sequence;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(applied, static_cast<std::uint64_t>(kProducers * kCommandsPerProducer));
+}
+
+TEST(PulseCommandQueueTest, TrafficSystemAppliesBatchAtStepStart)
+{
+    auto source = std::make_unique<RecordingSource>();
+    auto* recorder = source.get();
+    TrafficSystem system(std::move(source));
+    system.initialize();
+    EXPECT_EQ(system.getStageNames().front(), "commands");
+
+    auto& queue = system.getCommandQueue();
+    queue.overrideLight("tl1", "r");
+    queue.overrideLight("tl1", "g");
+    queue.overrideLight("unknown", "g");
+    PulseSignalPlan plan;
+    plan.traffic_light_id = "tl2";
+    plan.durations.green = 42.0;
+    queue.changePlan(plan);
+
+    // Nothing is applied until the next step
+    EXPECT_EQ(recorder->overrides, 0);
+
+    system.stepSimulation();
+    EXPECT_EQ(recorder->overrides, 1);
+    EXPECT_EQ(recorder->last_plan.traffic_light_id, "tl2");
+    EXPECT_EQ(system.getAppliedCommandCount(), 2u);
+    EXPECT_EQ(system.getRejectedCommandCount(), 1u);
+    EXPECT_EQ(queue.getCoalescedCount(), 1u);
+
+    // The override is visible in the state read during the same step
+    EXPECT_EQ(system.getDataManager().getTrafficLight("tl1")->getState(), TrafficLightState::GREEN);
+    EXPECT_EQ(system.getDataManager().getTrafficLight("tl2")->getDurations().green, 42.0);
+}
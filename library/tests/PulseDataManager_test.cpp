@@ -4,26 +4,18 @@
 
 #include <gtest/gtest.h>
 
+#include "MockSimulationSource.h"
+
 #include "core/PulseDataManager.h"
-#include "core/SumoIntegration.h"
 
 #include "entities/PulseIntersection.h"
 #include "entities/PulseTrafficLight.h"
 #include "entities/PulseVehicle.h"
 
-#include "constants/SumoConfigPath.h"
-
 
-class MockSumoIntegration : public SumoIntegration
+class MockSumoIntegration : public MockSimulationSource
 {
 public:
-    MockSumoIntegration()
-        : SumoIntegration(SUMO_CONFIG_PATH)
-    {
-    }
-
-    bool isRunning() const override { return true; }
-
     std::vector<std::string> getAllTrafficLights() const override
     {
         return {"mock_tl1", "mock_tl2"};
@@ -41,7 +33,7 @@ public:
         return {0.0, 0.0};
     }
 
-    std::string getTrafficLightState(const std::string& tl_id) const override
+    std::string getTrafficLightState(const std::string&) const override
     {
         return "rGrG";
     }
@@ -169,4 +161,39 @@ TEST(PulseDataManagerTest, UpdateFromMockSumo)
     // Traffic light1 still present
     auto tl1 = manager.getTrafficLight("mock_tl1");
     ASSERT_NE(tl1, nullptr);
-}
\ No newline at end of file
+}
+
+TEST(PulseDataManagerTest, ViewsComposeWithFilters)
+{
+    PulseDataManager manager;
+    manager.addIntersection(std::make_unique<PulseIntersection>("center", PulsePosition{5.0, 5.0}));
+    manager.addIntersection(std::make_unique<PulseIntersection>("outskirts", PulsePosition{50.0, 5.0}));
+    manager.addTrafficLight(std::make_unique<PulseTrafficLight>("tl"));
+    manager.addVehicle(std::make_unique<PulseVehicle>("bus_in", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{1.0, 1.0}));
+    manager.addVehicle(std::make_unique<PulseVehicle>("bus_out", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{20.0, 1.0}));
+    manager.addVehicle(std::make_unique<PulseVehicle>("car_in", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{10.0, 10.0}));
+
+    EXPECT_EQ(std::ranges::distance(manager.viewVehicles()), 3);
+    EXPECT_EQ(std::ranges::distance(manager.viewTrafficLights()), 1);
+    EXPECT_EQ(std::ranges::distance(manager.view<PulseEntityType::INTERSECTION>()), 2);
+
+    const PulseBoundingBox center{{0.0, 0.0}, {10.0, 10.0}};
+    std::vector<std::string> ids;
+    for (const PulseVehicle& bus : manager.viewVehicles() | PulseViews::ofType(PulseVehicleType::BUS) | PulseViews::within(center)) {
+        ids.push_back(bus.getId());
+    }
+    EXPECT_EQ(ids, std::vector<std::string>{"bus_in"});
+
+    EXPECT_EQ(std::ranges::distance(manager.viewVehicles() | PulseViews::within(center)), 2);
+    EXPECT_EQ(std::ranges::distance(manager.viewVehicles() | PulseViews::withRole(PulseVehicleRole::EMERGENCY)), 0);
+
+    auto inner = manager.viewIntersections() | PulseViews::within(center);
+    ASSERT_NE(inner.begin(), inner.end());
+    EXPECT_EQ((*inner.begin()).getId(), "center");
+
+    // Elements are the stored entities, not copies
+    for (auto& intersection : manager.viewIntersections()) {
+        intersection.getStatistics().addVehiclePass(1.0);
+    }
+    EXPECT_EQ(manager.getIntersection("outskirts")->getStatistics().getTotalVehiclesPassed(), 1u);
+}
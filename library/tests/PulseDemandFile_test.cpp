@@ -0,0 +1,156 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+#include "TempDirectory.h"
+
+#include "core/PulseDemandFile.h"
+
+namespace
+{
+    const char* kRoutes = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- generated by randomTrips.py -->
+<routes xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance">
+    <vType id="veh_bus" vClass="bus"/>
+    <route id="r0" edges="e1 e2 e3"/>
+    <trip id="t0" type="veh_bus" depart="0.00" from="a" to="b"/>
+    <trip
+        id="t1" depart='5.50' from="c" to="d"/>
+    <vehicle id="v0" depart="10.00">
+        <route edges="  x y z "/>
+        <stop busStop="s1" duration="20"/>
+    </vehicle>
+    <vehicle id="v1" depart="triggered" route="r0"/>
+    <flow id="f0" type="veh_bus" begin="60" end="120" number="3" from="a" to="b"/>
+    <person id="p0" depart="30.00">
+        <walk from="w1" to="w2"/>
+        <ride from="w2" to="w3" lines="ANY"/>
+    </person>
+</routes>
+)";
+}
+
+TEST(PulseDemandFileTest, ParsesTripsRoutesAndPersons)
+{
+    const PulseDemandFile file = PulseDemandFile::parse(kRoutes);
+    const auto& trips = file.getTrips();
+    ASSERT_EQ(trips.size(), 6u);
+    ASSERT_EQ(file.getDefinitions().size(), 2u);
+    EXPECT_EQ(file.getDefinitions()[1], R"(<route id="r0" edges="e1 e2 e3"/>)");
+
+    EXPECT_EQ(trips[0].kind, PulseTripKind::TRIP);
+    EXPECT_EQ(trips[0].vclass, "bus");
+    EXPECT_EQ(trips[0].from, "a");
+    EXPECT_DOUBLE_EQ(trips[1].depart, 5.5);
+    EXPECT_EQ(trips[1].vclass, "passenger");
+    EXPECT_EQ(trips[1].to, "d");
+
+    EXPECT_EQ(trips[2].kind, PulseTripKind::VEHICLE);
+    EXPECT_EQ(trips[2].from, "x");
+    EXPECT_EQ(trips[2].to, "z");
+    EXPECT_EQ(trips[2].element.substr(0, 32), R"(<vehicle id="v0" depart="10.00">)");
+    EXPECT_EQ(trips[2].element.substr(trips[2].element.size() - 10), "</vehicle>");
+
+    EXPECT_DOUBLE_EQ(trips[3].depart, -1.0);
+    EXPECT_EQ(trips[3].from, "e1");
+    EXPECT_EQ(trips[3].to, "e3");
+
+    EXPECT_EQ(trips[4].kind, PulseTripKind::FLOW);
+    EXPECT_DOUBLE_EQ(trips[4].depart, 60.0);
+
+    EXPECT_EQ(trips[5].kind, PulseTripKind::PERSON);
+    EXPECT_EQ(trips[5].vclass, "pedestrian");
+    EXPECT_EQ(trips[5].from, "w1");
+    EXPECT_EQ(trips[5].to, "w3");
+
+    EXPECT_THROW((void)PulseDemandFile::parse("<routes><trip id=\"t0\"/>"), std::runtime_error);
+    EXPECT_THROW((void)PulseDemandFile::parse("<routes><trip id=t0/></routes>"), std::runtime_error);
+    EXPECT_THROW((void)PulseDemandFile::parse("no xml"), std::runtime_error);
+}
+
+TEST(PulseDemandFileTest, WritesFilteredDemandThatParsesAgain)
+{
+    const PulseDemandFile file = PulseDemandFile::parse(kRoutes);
+    const auto buses = file.select([](const PulseTripRecord& trip) { return trip.vclass == "bus"; });
+    ASSERT_EQ(buses.size(), 2u);
+
+    std::ostringstream out;
+    file.write(out, buses);
+    const PulseDemandFile filtered = PulseDemandFile::parse(out.str());
+    ASSERT_EQ(filtered.getTrips().size(), 2u);
+    EXPECT_EQ(filtered.getTrips()[1].id, "f0");
+    EXPECT_EQ(filtered.getTrips()[1].vclass, "bus");
+    EXPECT_EQ(filtered.getDefinitions().size(), 2u);
+
+    // Round trip through a gzipped file keeps nested elements intact
+    const auto directory = makeTempDirectory("pulse_demand_test");
+    const auto path = (directory / "demand.rou.xml.gz").string();
+    const auto window = file.select([](const PulseTripRecord& trip) { return trip.depart >= 10.0 && trip.depart < 60.0; });
+    file.write(path, window);
+    const PulseDemandFile loaded = PulseDemandFile::load(path);
+    ASSERT_EQ(loaded.getTrips().size(), 2u);
+    EXPECT_EQ(loaded.getTrips()[0].element, file.getTrips()[2].element);
+    EXPECT_EQ(loaded.getTrips()[1].to, "w3");
+
+    EXPECT_THROW((void)PulseDemandFile::load(path + ".missing"), std::runtime_error);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseDemandFileTest, ReopensSelfClosingRootAndStreamsLargeGzip)
+{
+    const PulseDemandFile empty = PulseDemandFile::parse("<?xml version=\"1.0\"?>\n<routes xmlns:xsi=\"x\"/>\n");
+    EXPECT_TRUE(empty.getTrips().empty());
+    std::ostringstream out;
+    empty.write(out, std::vector<std::string_view>{"<trip id=\"t\" depart=\"0\" from=\"a\" to=\"b\"/>"});
+    EXPECT_NE(out.str().find("<routes xmlns:xsi=\"x\">\n"), std::string::npos) << out.str();
+    ASSERT_EQ(PulseDemandFile::parse(out.str()).getTrips().size(), 1u);
+
+    // Larger than one 1 MiB write chunk, so the output is compressed in several pieces
+    std::string xml = "<routes>\n";
+    for (int i = 0; i < 40000; ++i) {
+        xml += "    <trip id=\"t" + std::to_string(i) + "\" depart=\"" + std::to_string(i) + ".00\" from=\"a\" to=\"b\"/>\n";
+    }
+    xml += "</routes>\n";
+    const PulseDemandFile file = PulseDemandFile::parse(xml);
+    const auto directory = makeTempDirectory("pulse_demand_large_test");
+    const auto path = (directory / "demand.trips.xml.gz").string();
+    file.write(path, file.sample(1.0));
+    const PulseDemandFile loaded = PulseDemandFile::load(path);
+    ASSERT_EQ(loaded.getTrips().size(), 40000u);
+    EXPECT_EQ(loaded.getTrips().back().id, "t39999");
+    EXPECT_EQ(loaded.getSize(), file.getSize());
+
+    // A truncated gzip file is reported, not parsed as a shorter demand file
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_THROW((void)PulseDemandFile::load(path), std::runtime_error);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseDemandFileTest, SampleIsDeterministicAndNested)
+{
+    std::string xml = "<routes>\n";
+    for (int i = 0; i < 2000; ++i) {
+        xml += "    <trip id=\"t" + std::to_string(i) + "\" depart=\"" + std::to_string(i) + "\" from=\"a\" to=\"b\"/>\n";
+    }
+    xml += "</routes>\n";
+    const PulseDemandFile file = PulseDemandFile::parse(xml);
+
+    const auto tenth = file.sample(0.1, 7);
+    const auto half = file.sample(0.5, 7);
+    EXPECT_NEAR(static_cast<double>(tenth.size()), 200.0, 60.0);
+    EXPECT_NEAR(static_cast<double>(half.size()), 1000.0, 100.0);
+    EXPECT_EQ(file.sample(0.1, 7), tenth);
+    EXPECT_EQ(file.sample(1.0).size(), 2000u);
+    EXPECT_TRUE(file.sample(0.0).empty());
+
+    for (const auto* trip : tenth) {
+        EXPECT_NE(std::find(half.begin(), half.end(), trip), half.end());
+    }
+    EXPECT_THROW((void)file.sample(1.5), std::invalid_argument);
+}
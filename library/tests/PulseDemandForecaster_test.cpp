@@ -0,0 +1,93 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "core/PulseDemandForecaster.h"
+
+namespace
+{
+    void passVehicles(PulseIntersection& intersection, std::size_t count, double waiting_time)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            intersection.getStatistics().addVehiclePass(waiting_time);
+        }
+    }
+}
+
+TEST(PulseDemandForecasterTest, FirstIntervalOnlySetsBaseline)
+{
+    PulseIntersection intersection("A", PulsePosition{});
+    passVehicles(intersection, 50, 10.0);
+
+    PulseDemandForecaster forecaster(PulseForecastConfig{1, 2});
+    forecaster.recordInterval({&intersection});
+    EXPECT_EQ(forecaster.getIntersectionCount(), 1u);
+    EXPECT_THROW((void)forecaster.getForecast("A", 1), std::invalid_argument);
+
+    // Only the growth since the baseline counts as the interval's demand
+    passVehicles(intersection, 4, 3.0);
+    forecaster.recordInterval({&intersection});
+
+    const auto forecast = forecaster.getForecast("A", 1);
+    EXPECT_DOUBLE_EQ(forecast.vehicles, 4.0);
+    EXPECT_DOUBLE_EQ(forecast.average_waiting_time, 3.0);
+    EXPECT_EQ(forecaster.getIntervalCount(), 2u);
+}
+
+TEST(PulseDemandForecasterTest, FollowsLevelAndTrend)
+{
+    PulseIntersection intersection("A", PulsePosition{});
+    PulseDemandForecaster forecaster(PulseForecastConfig{1, 3, 0.5, 0.5, 0.0});
+    forecaster.recordInterval({&intersection});
+
+    for (std::size_t interval = 1; interval <= 60; ++interval) {
+        passVehicles(intersection, 2 * interval, 1.0);
+        forecaster.recordInterval({&intersection});
+    }
+
+    // Demand grows by 2 vehicles per interval; the last interval had 120
+    EXPECT_NEAR(forecaster.getForecast("A", 1).vehicles, 122.0, 0.5);
+    EXPECT_NEAR(forecaster.getForecast("A", 3).vehicles, 126.0, 0.5);
+    EXPECT_NEAR(forecaster.getForecast("A", 2).average_waiting_time, 1.0, 1e-9);
+}
+
+TEST(PulseDemandForecasterTest, LearnsSeasonalProfile)
+{
+    PulseIntersection intersection("A", PulsePosition{});
+    PulseIntersection idle("B", PulsePosition{});
+    PulseDemandForecaster forecaster(PulseForecastConfig{4, 4, 0.2, 0.0, 0.5});
+    forecaster.recordInterval({&intersection, &idle});
+
+    const std::size_t profile[] = {10, 30, 20, 0};
+    for (std::size_t interval = 0; interval < 400; ++interval) {
+        passVehicles(intersection, profile[interval % 4], 5.0);
+        forecaster.recordInterval({&intersection, &idle});
+    }
+
+    // The next interval is slot 0 of the profile again
+    for (std::size_t ahead = 1; ahead <= 4; ++ahead) {
+        EXPECT_NEAR(forecaster.getForecast("A", ahead).vehicles, profile[(ahead - 1) % 4], 0.5);
+    }
+    EXPECT_DOUBLE_EQ(forecaster.getForecast("B", 1).vehicles, 0.0);
+    EXPECT_DOUBLE_EQ(forecaster.getForecast("B", 1).average_waiting_time, 0.0);
+}
+
+TEST(PulseDemandForecasterTest, RejectsInvalidUse)
+{
+    EXPECT_THROW(PulseDemandForecaster(PulseForecastConfig{0}), std::invalid_argument);
+    EXPECT_THROW(PulseDemandForecaster(PulseForecastConfig{4, 0}), std::invalid_argument);
+    EXPECT_THROW(PulseDemandForecaster(PulseForecastConfig{4, 1, 0.0}), std::invalid_argument);
+    EXPECT_THROW(PulseDemandForecaster(PulseForecastConfig{4, 1, 0.5, 1.5}), std::invalid_argument);
+
+    PulseIntersection intersection("A", PulsePosition{});
+    PulseDemandForecaster forecaster(PulseForecastConfig{1, 2});
+    EXPECT_THROW(forecaster.recordInterval(std::vector<PulseIntersection*>{nullptr}), std::invalid_argument);
+
+    forecaster.recordInterval({&intersection});
+    forecaster.recordInterval({&intersection});
+    EXPECT_THROW((void)forecaster.getForecast("missing", 1), std::invalid_argument);
+    EXPECT_THROW((void)forecaster.getForecast("A", 0), std::out_of_range);
+    EXPECT_THROW((void)forecaster.getForecast("A", 3), std::out_of_range);
+}
@@ -1,53 +1,99 @@
 //
 // Created by andrii on 2/25/25.
 //
-//
-//#include <gtest/gtest.h>
-//#include "core/PulseEntityFactory.h"
-//#include "entities/PulseIntersection.h"
-//#include "entities/PulseTrafficLight.h"
-//#include "entities/PulseVehicle.h"
-//
-//TEST(PulseEntityFactoryTest, CreateIntersection)
-//{
-//    auto intersection = PulseEntityFactory::createEntity(PulseEntityType::INTERSECTION, "1", PulsePosition(10.5, 20.5));
-//
-//    ASSERT_NE(intersection, nullptr);  // Ensure it's not null
-//    auto* casted_intersection = dynamic_cast<PulseIntersection*>(intersection.get());
-//    ASSERT_NE(casted_intersection, nullptr);  // Ensure correct type
-//
-//    EXPECT_EQ(casted_intersection->getId(), 1);
-//    EXPECT_EQ(casted_intersection->getPosition().x, 10.5);
-//    EXPECT_EQ(casted_intersection->getPosition().y, 20.5);
-//}
-//
-//TEST(PulseEntityFactoryTest, CreateTrafficLight)
-//{
-//    auto traffic_light = PulseEntityFactory::createEntity(PulseEntityType::TRAFFIC_LIGHT, "101");
-//
-//    ASSERT_NE(traffic_light, nullptr);
-//    auto* casted_light = dynamic_cast<PulseTrafficLight*>(traffic_light.get());
-//    ASSERT_NE(casted_light, nullptr);
-//
-//    EXPECT_EQ(casted_light->getId(), 101);
-//}
-//
-//TEST(PulseEntityFactoryTest, CreateVehicle)
-//{
-//    auto vehicle = PulseEntityFactory::createEntity(PulseEntityType::VEHICLE, "V123", {}, PulseVehicleType::CAR, PulseVehicleRole::NORMAL);
-//
-//    ASSERT_NE(vehicle, nullptr);
-//    auto* casted_vehicle = dynamic_cast<PulseVehicle*>(vehicle.get());
-//    ASSERT_NE(casted_vehicle, nullptr);
-//
-//    EXPECT_EQ(casted_vehicle->getId(), "V123");
-//    EXPECT_EQ(casted_vehicle->getType(), PulseVehicleType::CAR);
-//    EXPECT_EQ(casted_vehicle->getRole(), PulseVehicleRole::NORMAL);
-//}
-//
-//TEST(PulseEntityFactoryTest, InvalidEntityType)
-//{
-//    auto invalid_entity = PulseEntityFactory::createEntity(static_cast<PulseEntityType>(999), "X");
-//
-//    EXPECT_EQ(invalid_entity, nullptr);
-//}
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseEntityFactory.h"
+#include "entities/PulseIntersection.h"
+#include "entities/PulseTrafficLight.h"
+#include "entities/PulseVehicle.h"
+
+namespace
+{
+    template <PulseEntityType Type, typename... Args>
+    concept Creatable = requires(Args&&... args) { PulseEntityFactory::create<Type>(std::forward<Args>(args)...); };
+}
+
+TEST(PulseEntityFactoryTest, CreateIntersection)
+{
+    auto intersection = PulseEntityFactory::createEntity(PulseEntityType::INTERSECTION, "1", PulsePosition(10.5, 20.5));
+
+    ASSERT_NE(intersection, nullptr);  // Ensure it's not null
+    auto* casted_intersection = dynamic_cast<PulseIntersection*>(intersection.get());
+    ASSERT_NE(casted_intersection, nullptr);  // Ensure correct type
+
+    EXPECT_EQ(casted_intersection->getId(), "1");
+    EXPECT_EQ(casted_intersection->getPosition().x, 10.5);
+    EXPECT_EQ(casted_intersection->getPosition().y, 20.5);
+}
+
+TEST(PulseEntityFactoryTest, CreateTrafficLight)
+{
+    auto traffic_light = PulseEntityFactory::createEntity(PulseEntityType::TRAFFIC_LIGHT, "101");
+
+    ASSERT_NE(traffic_light, nullptr);
+    auto* casted_light = dynamic_cast<PulseTrafficLight*>(traffic_light.get());
+    ASSERT_NE(casted_light, nullptr);
+
+    EXPECT_EQ(casted_light->getId(), "101");
+}
+
+TEST(PulseEntityFactoryTest, CreateVehicle)
+{
+    auto vehicle = PulseEntityFactory::createEntity(PulseEntityType::VEHICLE, "V123", {}, PulseVehicleType::CAR, PulseVehicleRole::NORMAL);
+
+    ASSERT_NE(vehicle, nullptr);
+    auto* casted_vehicle = dynamic_cast<PulseVehicle*>(vehicle.get());
+    ASSERT_NE(casted_vehicle, nullptr);
+
+    EXPECT_EQ(casted_vehicle->getId(), "V123");
+    EXPECT_EQ(casted_vehicle->getType(), PulseVehicleType::CAR);
+    EXPECT_EQ(casted_vehicle->getRole(), PulseVehicleRole::NORMAL);
+}
+
+TEST(PulseEntityFactoryTest, InvalidEntityType)
+{
+    auto invalid_entity = PulseEntityFactory::createEntity(static_cast<PulseEntityType>(999), "X");
+
+    EXPECT_EQ(invalid_entity, nullptr);
+}
+
+TEST(PulseEntityFactoryTest, CreateWithCompileTimeType)
+{
+    auto vehicle = PulseEntityFactory::create<PulseEntityType::VEHICLE>("V7", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition(1.0, 2.0));
+    auto traffic_light = PulseEntityFactory::create<PulseEntityType::TRAFFIC_LIGHT>("tl");
+
+    static_assert(std::is_same_v<decltype(vehicle), std::unique_ptr<PulseVehicle>>);
+    static_assert(std::is_same_v<decltype(traffic_light), std::unique_ptr<PulseTrafficLight>>);
+    static_assert(!Creatable<PulseEntityType::INTERSECTION, int>);
+
+    EXPECT_EQ(vehicle->getId(), "V7");
+    EXPECT_EQ(vehicle->getType(), PulseVehicleType::BUS);
+    EXPECT_EQ(traffic_light->getState(), TrafficLightState::RED);
+}
+
+TEST(PulseEntityFactoryTest, TypedStorageAccess)
+{
+    PulseDataManager manager;
+    manager.add<PulseEntityType::INTERSECTION>(PulseEntityFactory::create<PulseEntityType::INTERSECTION>("I1", PulsePosition(0.0, 0.0)));
+    manager.add<PulseEntityType::VEHICLE>(PulseEntityFactory::create<PulseEntityType::VEHICLE>("V1", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition(3.0, 4.0)));
+    manager.add<PulseEntityType::VEHICLE>(PulseEntityFactory::create<PulseEntityType::VEHICLE>("V2", PulseVehicleType::TRUCK, PulseVehicleRole::NORMAL, PulsePosition(5.0, 6.0)));
+
+    PulseVehicle* vehicle = manager.get<PulseEntityType::VEHICLE>("V1");
+    ASSERT_NE(vehicle, nullptr);
+    EXPECT_EQ(vehicle->getPosition().y, 4.0);
+    EXPECT_NE(manager.get<PulseEntityType::INTERSECTION>("I1"), nullptr);
+    EXPECT_EQ(manager.get<PulseEntityType::TRAFFIC_LIGHT>("I1"), nullptr);
+
+    double x_sum = 0.0;
+    manager.forEach<PulseEntityType::VEHICLE>([&](const PulseVehicle& v) { x_sum += v.getPosition().x; });
+    EXPECT_EQ(x_sum, 8.0);
+
+    std::size_t intersections = 0;
+    manager.forEach<PulseEntityType::INTERSECTION>([&](const PulseIntersection&) { ++intersections; });
+    EXPECT_EQ(intersections, 1u);
+}
@@ -0,0 +1,347 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseLiveServer.h"
+
+#include "entities/PulseVehicle.h"
+
+namespace
+{
+    PulseLiveServerConfig fastConfig()
+    {
+        PulseLiveServerConfig config;
+        config.poll_interval = std::chrono::milliseconds(5);
+        return config;
+    }
+
+    class TestClient
+    {
+    public:
+        static constexpr std::size_t kMaxUnmatched = 1 << 20;
+
+        explicit TestClient(std::uint16_t port, int receive_buffer = 0)
+        {
+            m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (receive_buffer > 0) {
+                ::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+            }
+            timeval timeout{2, 0};
+            ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+            m_connected = ::connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        }
+
+        ~TestClient() { ::close(m_fd); }
+
+        bool connected() const { return m_connected; }
+
+        void send(const std::string& data) const { (void)::send(m_fd, data.data(), data.size(), MSG_NOSIGNAL); }
+
+        // Reads until the server closes the connection or the timeout expires
+        std::string readAll()
+        {
+            char buffer[4096];
+            ssize_t received;
+            while ((received = ::recv(m_fd, buffer, sizeof(buffer), 0)) > 0) {
+                m_data.append(buffer, static_cast<std::size_t>(received));
+            }
+            return std::move(m_data);
+        }
+
+        std::string readUntil(const std::string& marker)
+        {
+            char buffer[4096];
+            while (m_data.find(marker) == std::string::npos) {
+                const ssize_t received = ::recv(m_fd, buffer, sizeof(buffer), 0);
+                // A marker that never comes (e.g. frames without a handshake) must not be waited for forever
+                if (received <= 0 || m_data.size() > kMaxUnmatched) {
+                    return {};
+                }
+                m_data.append(buffer, static_cast<std::size_t>(received));
+            }
+            const std::size_t end = m_data.find(marker) + marker.size();
+            std::string head = m_data.substr(0, end);
+            m_data.erase(0, end);
+            return head;
+        }
+
+        // Reads one unmasked server frame; returns its opcode, or -1 on timeout
+        int readFrame(std::string& payload)
+        {
+            if (!fill(2)) {
+                return -1;
+            }
+            const int opcode = static_cast<std::uint8_t>(m_data[0]) & 0x0F;
+            std::size_t length = static_cast<std::uint8_t>(m_data[1]) & 0x7F;
+            std::size_t position = 2;
+            if (length == 126 || length == 127) {
+                const std::size_t bytes = length == 126 ? 2 : 8;
+                if (!fill(2 + bytes)) {
+                    return -1;
+                }
+                length = 0;
+                for (std::size_t i = 0; i < bytes; ++i) {
+                    length = length << 8 | static_cast<std::uint8_t>(m_data[2 + i]);
+                }
+                position += bytes;
+            }
+            if (!fill(position + length)) {
+                return -1;
+            }
+            payload = m_data.substr(position, length);
+            m_data.erase(0, position + length);
+            return opcode;
+        }
+
+        void upgrade(const std::string& target)
+        {
+            send("GET " + target + " HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+        }
+
+    private:
+        bool fill(std::size_t size)
+        {
+            char buffer[4096];
+            while (m_data.size() < size) {
+                const ssize_t received = ::recv(m_fd, buffer, sizeof(buffer), 0);
+                if (received <= 0) {
+                    return false;
+                }
+                m_data.append(buffer, static_cast<std::size_t>(received));
+            }
+            return true;
+        }
+
+    private:
+        int m_fd = -1;
+        bool m_connected = false;
+        std::string m_data;
+    };
+
+    template <typename Predicate>
+    bool waitFor(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return true;
+    }
+
+    bool contains(const std::string& text, const std::string& part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+}
+
+class PulseLiveServerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        manager.clearAll();
+        manager.addVehicle(std::make_unique<PulseVehicle>("V1", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{1.0, 2.0}));
+        manager.publishSnapshot();
+    }
+
+    void TearDown() override
+    {
+        manager.clearAll();
+    }
+
+    PulseDataManager& manager = PulseDataManager::getInstance();
+};
+
+TEST_F(PulseLiveServerTest, RejectsInvalidConfig)
+{
+    PulseLiveServerConfig config;
+    config.bind_address = "localhost";
+    EXPECT_THROW(PulseLiveServer(manager, config), std::invalid_argument);
+
+    config = PulseLiveServerConfig{};
+    config.max_queued_bytes = 0;
+    EXPECT_THROW(PulseLiveServer(manager, config), std::invalid_argument);
+
+    PulseLiveServer server(manager, fastConfig());
+    server.start();
+    EXPECT_TRUE(server.isRunning());
+    EXPECT_THROW(server.start(), std::logic_error);
+    server.stop();
+    EXPECT_FALSE(server.isRunning());
+}
+
+TEST_F(PulseLiveServerTest, ServesStateOverHttp)
+{
+    PulseLiveServer server(manager, fastConfig());
+    server.start();
+    ASSERT_NE(server.getPort(), 0);
+
+    TestClient json(server.getPort());
+    ASSERT_TRUE(json.connected());
+    json.send("GET /state HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    const std::string response = json.readAll();
+    EXPECT_TRUE(response.starts_with("HTTP/1.1 200 OK\r\n"));
+    EXPECT_TRUE(contains(response, "Content-Type: application/json"));
+    EXPECT_TRUE(contains(response, "\"type\":\"state\""));
+    EXPECT_TRUE(contains(response, "\"id\":\"V1\""));
+
+    TestClient binary(server.getPort());
+    binary.send("GET /state?format=binary HTTP/1.1\r\n\r\n");
+    const std::string binary_response = binary.readAll();
+    const std::size_t body = binary_response.find("\r\n\r\n") + 4;
+    ASSERT_LT(body, binary_response.size());
+    EXPECT_EQ(static_cast<std::uint8_t>(binary_response[body]), PulseStateEncoder::kStateMessage);
+
+    TestClient metrics(server.getPort());
+    metrics.send("GET /metrics HTTP/1.1\r\n\r\n");
+    const std::string metrics_response = metrics.readAll();
+    EXPECT_TRUE(metrics_response.starts_with("HTTP/1.1 200 OK\r\n"));
+    EXPECT_TRUE(contains(metrics_response, "# TYPE pulse_stage_duration_seconds histogram"));
+
+    TestClient missing(server.getPort());
+    missing.send("GET /nothing HTTP/1.1\r\n\r\n");
+    EXPECT_TRUE(missing.readAll().starts_with("HTTP/1.1 404"));
+
+    TestClient post(server.getPort());
+    post.send("POST /state HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    EXPECT_TRUE(post.readAll().starts_with("HTTP/1.1 405"));
+}
+
+TEST_F(PulseLiveServerTest, StreamsStateThenDeltas)
+{
+    PulseLiveServer server(manager, fastConfig());
+    server.start();
+    ASSERT_TRUE(waitFor([&] { return server.getStreamedEpoch() == manager.acquireSnapshot()->epoch; }));
+
+    TestClient first(server.getPort());
+    first.upgrade("/stream");
+    const std::string handshake = first.readUntil("\r\n\r\n");
+    EXPECT_TRUE(handshake.starts_with("HTTP/1.1 101"));
+    // Example key and accept value from RFC 6455, section 1.3
+    EXPECT_TRUE(contains(handshake, "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"));
+
+    TestClient second(server.getPort());
+    second.upgrade("/stream?format=binary");
+    EXPECT_FALSE(second.readUntil("\r\n\r\n").empty());
+    ASSERT_TRUE(waitFor([&] { return server.getStreamClientCount() == 2; }));
+
+    std::string payload;
+    ASSERT_EQ(first.readFrame(payload), 0x1);
+    EXPECT_TRUE(contains(payload, "\"type\":\"state\""));
+    EXPECT_TRUE(contains(payload, "\"id\":\"V1\""));
+    ASSERT_EQ(second.readFrame(payload), 0x2);
+    EXPECT_EQ(static_cast<std::uint8_t>(payload[0]), PulseStateEncoder::kStateMessage);
+
+    manager.getVehicle("V1")->updatePosition(PulsePosition{9.0, 2.0});
+    manager.addVehicle(std::make_unique<PulseVehicle>("V2", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{0.0, 0.0}));
+    manager.publishSnapshot();
+
+    ASSERT_EQ(first.readFrame(payload), 0x1);
+    EXPECT_TRUE(contains(payload, "\"type\":\"delta\""));
+    EXPECT_TRUE(contains(payload, "\"id\":\"V1\",\"type\":\"car\",\"role\":\"normal\",\"x\":9"));
+    EXPECT_TRUE(contains(payload, "\"id\":\"V2\""));
+    ASSERT_EQ(second.readFrame(payload), 0x2);
+    EXPECT_EQ(static_cast<std::uint8_t>(payload[0]), PulseStateEncoder::kDeltaMessage);
+
+    // Close handshake: masked close frame with an empty payload
+    first.send(std::string("\x88\x80\x01\x02\x03\x04", 6));
+    EXPECT_EQ(first.readFrame(payload), 0x8);
+    EXPECT_TRUE(waitFor([&] { return server.getStreamClientCount() == 1; }));
+}
+
+TEST_F(PulseLiveServerTest, BacklogNeverDropsHandshakeOrInitialState)
+{
+    for (int i = 0; i < 2000; ++i) {
+        const std::string id = "bulk_vehicle_" + std::to_string(i);
+        manager.addVehicle(std::make_unique<PulseVehicle>(id, PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{0.0, 0.0}));
+    }
+    manager.publishSnapshot();
+
+    // The initial state alone is larger than the queue limit
+    auto config = fastConfig();
+    config.max_queued_bytes = 1024;
+    config.socket_buffer_size = 4096;
+    PulseLiveServer server(manager, config);
+    server.start();
+
+    // New epochs keep arriving while the upgrade is handled, so deltas queue up behind the state
+    std::atomic<bool> publishing{true};
+    std::thread publisher([&] {
+        double x = 1.0;
+        while (publishing) {
+            manager.getVehicle("V1")->updatePosition(PulsePosition{x, x});
+            x += 1.0;
+            manager.publishSnapshot();
+            std::this_thread::yield();
+        }
+    });
+
+    TestClient client(server.getPort(), 4096);
+    client.upgrade("/stream");
+    const std::string handshake = client.readUntil("\r\n\r\n");
+    std::string payload;
+    const int opcode = client.readFrame(payload);
+    publishing = false;
+    publisher.join();
+
+    EXPECT_TRUE(handshake.starts_with("HTTP/1.1 101"));
+    ASSERT_EQ(opcode, 0x1);
+    EXPECT_TRUE(contains(payload, "\"type\":\"state\""));
+    EXPECT_TRUE(contains(payload, "\"id\":\"bulk_vehicle_1999\""));
+}
+
+TEST_F(PulseLiveServerTest, SlowClientIsResynchronized)
+{
+    for (int i = 0; i < 2000; ++i) {
+        const std::string id = "bulk_vehicle_" + std::to_string(i);
+        manager.addVehicle(std::make_unique<PulseVehicle>(id, PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{0.0, 0.0}));
+    }
+    manager.publishSnapshot();
+
+    auto config = fastConfig();
+    config.max_queued_bytes = 64 * 1024;
+    config.socket_buffer_size = 4096;
+    PulseLiveServer server(manager, config);
+    server.start();
+
+    // Never reads after the handshake
+    TestClient slow(server.getPort(), 4096);
+    slow.upgrade("/stream");
+    ASSERT_FALSE(slow.readUntil("\r\n\r\n").empty());
+    ASSERT_TRUE(waitFor([&] { return server.getStreamClientCount() == 1; }));
+
+    double x = 1.0;
+    const bool resynchronized = waitFor([&] {
+        for (PulseVehicle& vehicle : manager.viewVehicles()) {
+            vehicle.updatePosition(PulsePosition{x, x});
+        }
+        x += 1.0;
+        manager.publishSnapshot();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return server.getResyncCount() > 0;
+    });
+    EXPECT_TRUE(resynchronized);
+    EXPECT_EQ(server.getStreamClientCount(), 1u);
+}
@@ -0,0 +1,180 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "core/PulseDataManager.h"
+#include "core/PulseMesoSimulation.h"
+
+namespace
+{
+    /**
+     * @brief Corridor A -> B -> C of 150 m roads; the light of the downstream intersection controls each road.
+     */
+    struct Corridor
+    {
+        std::vector<std::unique_ptr<PulseIntersection>> intersections;
+        std::vector<std::unique_ptr<PulseTrafficLight>> traffic_lights;
+
+        Corridor()
+        {
+            for (const char* id : {"A", "B", "C"}) {
+                const double x = 150.0 * static_cast<double>(intersections.size());
+                intersections.push_back(std::make_unique<PulseIntersection>(id, PulsePosition{x, 0.0}));
+                traffic_lights.push_back(std::make_unique<PulseTrafficLight>(std::string("tl_") + id));
+            }
+            for (std::size_t i = 0; i + 1 < intersections.size(); ++i) {
+                intersections[i]->addRoadConnection(0, intersections[i + 1].get(), traffic_lights[i + 1].get(), 150.0);
+            }
+        }
+
+        std::vector<PulseIntersection*> nodes() const
+        {
+            std::vector<PulseIntersection*> result;
+            for (const auto& intersection : intersections) {
+                result.push_back(intersection.get());
+            }
+            return result;
+        }
+    };
+
+    PulseMesoConfig throughTraffic()
+    {
+        PulseMesoConfig config;
+        config.exit_probability = 0.0;
+        return config;
+    }
+}
+
+TEST(PulseMesoSimulationTest, SameSeedReproducesRun)
+{
+    Corridor corridor;
+
+    auto run = [&](std::uint64_t seed) {
+        PulseMesoSimulation simulation(corridor.nodes(), throughTraffic());
+        simulation.setDemand("A", 900.0);
+        simulation.setSeed(seed);
+        simulation.startSimulation();
+        simulation.advance(900.0);
+        return std::make_pair(simulation.getTotalDelay(), simulation.getStatistics("C").getTotalVehiclesPassed());
+    };
+
+    const auto first = run(7);
+    EXPECT_GT(first.second, 0u);
+    EXPECT_EQ(run(7), first);
+    EXPECT_NE(run(8), first);
+}
+
+TEST(PulseMesoSimulationTest, RestartResetsState)
+{
+    Corridor corridor;
+    PulseMesoSimulation simulation(corridor.nodes(), throughTraffic());
+    simulation.setDemand("A", 600.0);
+    simulation.setSeed(3);
+
+    simulation.startSimulation();
+    EXPECT_THROW(simulation.startSimulation(), std::runtime_error);
+    simulation.advance(300.0);
+    const double delay = simulation.getTotalDelay();
+    const auto vehicles = simulation.getAllVehicles();
+    simulation.stopSimulation();
+    EXPECT_THROW(simulation.stepSimulation(), std::runtime_error);
+
+    simulation.startSimulation();
+    EXPECT_DOUBLE_EQ(simulation.getSimulationTime(), 0.0);
+    EXPECT_EQ(simulation.getStatistics("B").getTotalVehiclesPassed(), 0u);
+    simulation.advance(300.0);
+    EXPECT_DOUBLE_EQ(simulation.getTotalDelay(), delay);
+    EXPECT_EQ(simulation.getAllVehicles(), vehicles);
+}
+
+TEST(PulseMesoSimulationTest, GreenRoadsDischargeWithoutDelay)
+{
+    Corridor corridor;
+    PulseMesoSimulation simulation(corridor.nodes(), throughTraffic());
+    simulation.setTrafficLightPlan("tl_B", TrafficLightDurations(0.0, 0.0, 60.0));
+    simulation.setTrafficLightPlan("tl_C", TrafficLightDurations(0.0, 0.0, 60.0));
+    simulation.setDemand("A", 360.0);
+    simulation.startSimulation();
+    simulation.advance(1800.0);
+
+    // About 180 arrivals; every one crossing B has to pass C as well
+    const auto& passed_b = simulation.getStatistics("B");
+    const auto& passed_c = simulation.getStatistics("C");
+    EXPECT_GT(passed_b.getTotalVehiclesPassed(), 120u);
+    EXPECT_LT(passed_b.getTotalVehiclesPassed(), 240u);
+    EXPECT_LE(passed_b.getTotalVehiclesPassed() - passed_c.getTotalVehiclesPassed(), simulation.getVehicleCount());
+    EXPECT_LT(passed_b.getAverageVehicleWaitingTime(), 2.0);
+    EXPECT_EQ(simulation.getBlockedEntries(), 0u);
+}
+
+TEST(PulseMesoSimulationTest, RedLightQueuesAndSpillsBack)
+{
+    Corridor corridor;
+    PulseMesoSimulation simulation(corridor.nodes(), throughTraffic());
+    simulation.setDemand("A", 1800.0);
+    simulation.startSimulation();
+    simulation.setTrafficLightState("tl_B", "rrr");
+    simulation.advance(600.0);
+
+    // 150 m at 7.5 m per vehicle hold 20 vehicles; the rest wait to enter
+    EXPECT_EQ(simulation.getStatistics("B").getTotalVehiclesPassed(), 0u);
+    EXPECT_EQ(simulation.getVehicleCount(), 20u);
+    EXPECT_GT(simulation.getBlockedEntries(), 0u);
+    EXPECT_EQ(simulation.getTrafficLightState("tl_B"), "r");
+
+    PulseVehicleKinematics kinematics;
+    const auto vehicles = simulation.getAllVehicles();
+    ASSERT_TRUE(simulation.fillVehicleKinematics(vehicles.front(), kinematics));
+    EXPECT_EQ(kinematics.road_id, PulseMesoSimulation::getLinkId("A", 0));
+    EXPECT_DOUBLE_EQ(kinematics.lane_position, 150.0);
+    EXPECT_DOUBLE_EQ(kinematics.speed, 0.0);
+    EXPECT_DOUBLE_EQ(simulation.getVehiclePosition(vehicles.front()).first, 150.0);
+
+    // Back on a plan, the queue discharges and its waiting shows up as delay
+    simulation.setTrafficLightPlan("tl_B", TrafficLightDurations(0.0, 0.0, 60.0));
+    simulation.advance(60.0);
+    EXPECT_GE(simulation.getStatistics("B").getTotalVehiclesPassed(), 20u);
+    EXPECT_GT(simulation.getStatistics("B").getAverageVehicleWaitingTime(), 60.0);
+}
+
+TEST(PulseMesoSimulationTest, FeedsDataManager)
+{
+    Corridor corridor;
+    PulseMesoSimulation simulation(corridor.nodes(), throughTraffic());
+    simulation.setDemand("A", 900.0);
+    simulation.startSimulation();
+    simulation.advance(120.0);
+
+    auto& manager = PulseDataManager::getInstance();
+    manager.syncFromSumo(simulation);
+    simulation.setTrafficLightState("tl_C", "G");
+    simulation.advance(60.0);
+    manager.updateFromSumo(simulation);
+
+    EXPECT_EQ(manager.getAllVehicles().size(), simulation.getVehicleCount());
+    // Only lights that control a road exist in the simulation
+    EXPECT_EQ(manager.getAllTrafficLights().size(), 2u);
+    ASSERT_NE(manager.getTrafficLight("tl_C"), nullptr);
+    EXPECT_EQ(manager.getTrafficLight("tl_C")->getState(), TrafficLightState::GREEN);
+    manager.clearAll();
+}
+
+TEST(PulseMesoSimulationTest, RejectsInvalidInput)
+{
+    Corridor corridor;
+    PulseMesoConfig config;
+    config.saturation_flow = 0.0;
+    EXPECT_THROW(PulseMesoSimulation(corridor.nodes(), config), std::invalid_argument);
+    EXPECT_THROW(PulseMesoSimulation({corridor.intersections[0].get()}), std::invalid_argument);
+
+    PulseMesoSimulation simulation(corridor.nodes());
+    EXPECT_THROW(simulation.setDemand("C", 100.0), std::invalid_argument);
+    EXPECT_THROW(simulation.setDemand("X", 100.0), std::invalid_argument);
+    EXPECT_THROW(simulation.setTrafficLightPlan("tl_B", TrafficLightDurations(0.0, 0.0, 0.0)), std::invalid_argument);
+    EXPECT_THROW((void)simulation.getVehiclePosition("meso.0"), std::invalid_argument);
+    EXPECT_THROW(simulation.advance(1.0), std::runtime_error);
+}
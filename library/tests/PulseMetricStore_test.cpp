@@ -0,0 +1,166 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "TempDirectory.h"
+
+#include "core/PulseMetricStore.h"
+
+namespace
+{
+    // Three intersections, one record each per 300 s interval; A carries 1 vehicle per interval, B 2, C 3
+    void fill(PulseMetricStore& store, std::int64_t first, std::int64_t last)
+    {
+        const std::uint32_t handles[] = {store.getHandle("A"), store.getHandle("B"), store.getHandle("C")};
+        for (std::int64_t interval = first; interval < last; ++interval) {
+            for (std::uint32_t i = 0; i < 3; ++i) {
+                PulseMetricRecord record;
+                record.interval = interval * 300;
+                record.intersection = handles[i];
+                record.vehicles = i + 1;
+                record.vehicle_waiting_time = 10.0 * (i + 1);
+                store.append(record);
+            }
+        }
+    }
+}
+
+TEST(PulseMetricStoreTest, AggregatesRangesAcrossSegments)
+{
+    const auto directory = makeTempDirectory("pulse_metric_store_test");
+    PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 0});
+    fill(store, 0, 1000);
+    EXPECT_EQ(store.getRecordCount(), 3000u);
+    EXPECT_EQ(store.getSegmentCount(), 47u);
+
+    // One hour buckets over ten hours, starting mid-way through the history
+    const auto buckets = store.query("B", 36000, 72000, 3600);
+    ASSERT_EQ(buckets.size(), 10u);
+    for (const auto& bucket : buckets) {
+        EXPECT_EQ(bucket.records, 12u);
+        EXPECT_EQ(bucket.vehicles, 24u);
+        EXPECT_DOUBLE_EQ(bucket.vehicle_waiting_time, 240.0);
+    }
+    EXPECT_EQ(buckets[3].start, 36000 + 3 * 3600);
+
+    // The range runs past the last interval: the tail bucket is partial, later ones empty
+    const auto tail = store.query("C", 290000, 310000, 5000);
+    ASSERT_EQ(tail.size(), 4u);
+    EXPECT_EQ(tail[0].records, 17u);
+    EXPECT_EQ(tail[1].records, 16u);
+    EXPECT_EQ(tail[2].records, 0u);
+
+    PulseMetricRecord record;
+    record.interval = 0;
+    EXPECT_THROW(store.append(record), std::invalid_argument);
+    record.interval = 300000;
+    record.intersection = 7;
+    EXPECT_THROW(store.append(record), std::invalid_argument);
+    EXPECT_THROW((void)store.query("missing", 0, 10, 1), std::invalid_argument);
+    EXPECT_THROW((void)store.query("A", 10, 0, 1), std::invalid_argument);
+    EXPECT_THROW((void)store.query("A", 0, 10, 0), std::invalid_argument);
+    EXPECT_THROW(store.getHandle("bad\nid"), std::invalid_argument);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseMetricStoreTest, CompactsWithoutChangingResults)
+{
+    const auto directory = makeTempDirectory("pulse_metric_store_compaction_test");
+    {
+        PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 0});
+        fill(store, 0, 300);
+        EXPECT_EQ(store.getSegmentCount(), 15u);
+
+        const auto before = store.query("A", 0, 90000, 900);
+        store.compact();
+        // 14 sealed segments merged into one, next to the open append segment
+        EXPECT_EQ(store.getSegmentCount(), 2u);
+        EXPECT_EQ(store.getRecordCount(), 900u);
+
+        const auto after = store.query("A", 0, 90000, 900);
+        ASSERT_EQ(after.size(), before.size());
+        for (std::size_t i = 0; i < after.size(); ++i) {
+            EXPECT_EQ(after[i].records, before[i].records);
+            EXPECT_EQ(after[i].vehicles, before[i].vehicles);
+        }
+        EXPECT_EQ(after[0].vehicles, 3u);
+    }
+
+    // History, handles and the partially filled append segment survive a reopen
+    PulseMetricStore reopened(PulseMetricStoreConfig{directory.string(), 64, 0});
+    EXPECT_EQ(reopened.getRecordCount(), 900u);
+    EXPECT_EQ(*reopened.findHandle("C"), 2u);
+    fill(reopened, 300, 301);
+    EXPECT_EQ(reopened.getRecordCount(), 903u);
+    EXPECT_EQ(reopened.getSegmentCount(), 2u);
+    EXPECT_EQ(reopened.query("C", 89700, 90300, 600)[0].records, 2u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseMetricStoreTest, CompactsInBackground)
+{
+    const auto directory = makeTempDirectory("pulse_metric_store_background_test");
+    PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 4});
+    fill(store, 0, 300);
+    store.waitForCompaction();
+
+    EXPECT_LT(store.getSegmentCount(), 15u);
+    EXPECT_EQ(store.getRecordCount(), 900u);
+    const auto total = store.query("B", 0, 90000, 90000);
+    EXPECT_EQ(total[0].records, 300u);
+    EXPECT_EQ(total[0].vehicles, 600u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseMetricStoreTest, RecoversFromInterruptedCompaction)
+{
+    namespace fs = std::filesystem;
+    const auto directory = makeTempDirectory("pulse_metric_store_recovery_test");
+    const auto first = directory / "segment-0000000000.pms";
+    const auto backup = directory / "backup";
+    {
+        PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 0});
+        fill(store, 0, 100);
+        store.flush();
+        fs::copy_file(first, backup);
+        store.compact();
+    }
+
+    // As if the process died after renaming the compacted segment, and during a later compaction
+    fs::rename(backup, first);
+    fs::copy_file(first, directory / "segment-0000000042.pms.tmp");
+
+    PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 0});
+    EXPECT_EQ(store.getRecordCount(), 300u);
+    EXPECT_FALSE(fs::exists(first));
+    EXPECT_FALSE(fs::exists(directory / "segment-0000000042.pms.tmp"));
+    fs::remove_all(directory);
+}
+
+TEST(PulseMetricStoreTest, RecordsStatisticsGrowth)
+{
+    const auto directory = makeTempDirectory("pulse_metric_store_interval_test");
+    PulseMetricStore store(PulseMetricStoreConfig{directory.string(), 64, 0});
+    PulseIntersection intersection("X", PulsePosition{});
+    intersection.getStatistics().addVehiclePass(100.0);
+
+    store.recordInterval({&intersection}, 0);
+    EXPECT_EQ(store.getRecordCount(), 0u);
+
+    intersection.getStatistics().addVehiclePass(4.0);
+    intersection.getStatistics().addVehiclePass(6.0);
+    intersection.getStatistics().addPedestrianPass(3.0);
+    store.recordInterval({&intersection}, 300);
+
+    const auto buckets = store.query("X", 0, 600, 300);
+    EXPECT_EQ(buckets[0].records, 0u);
+    EXPECT_EQ(buckets[1].vehicles, 2u);
+    EXPECT_DOUBLE_EQ(buckets[1].vehicle_waiting_time, 10.0);
+    EXPECT_EQ(buckets[1].pedestrians, 1u);
+    EXPECT_DOUBLE_EQ(buckets[1].pedestrian_waiting_time, 3.0);
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,79 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChurnMockSumo.h"
+
+#include "core/PulseDataManager.h"
+#include "core/PulseEntityFactory.h"
+#include "core/PulseObjectPool.h"
+
+#include "entities/PulseVehicle.h"
+
+TEST(PulseObjectPoolTest, RecyclesReleasedSlotInPlace)
+{
+    auto first = std::make_unique<PulseVehicle>("V1", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{});
+    void* address = first.get();
+    first.reset();
+
+    auto second = std::make_unique<PulseVehicle>("V2", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{});
+    EXPECT_EQ(static_cast<void*>(second.get()), address);
+}
+
+TEST(PulseObjectPoolTest, FactoryDrawsFromTypedPool)
+{
+    auto& pool = PulseObjectPool<PulseVehicle>::getInstance();
+    const auto live_before = pool.getLiveCount();
+
+    auto entity = PulseEntityFactory::createEntity(PulseEntityType::VEHICLE, "V42");
+    EXPECT_EQ(pool.getLiveCount(), live_before + 1);
+
+    entity.reset();
+    EXPECT_EQ(pool.getLiveCount(), live_before);
+}
+
+TEST(PulseObjectPoolTest, AddressesStayStableWhilePoolGrows)
+{
+    std::vector<std::unique_ptr<PulseVehicle>> vehicles;
+    vehicles.push_back(std::make_unique<PulseVehicle>("anchor", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{1.0, 2.0}));
+    const PulseVehicle* anchor = vehicles.front().get();
+
+    for (int i = 0; i < 1000; ++i) {
+        vehicles.push_back(std::make_unique<PulseVehicle>("V" + std::to_string(i), PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{}));
+    }
+
+    EXPECT_EQ(vehicles.front().get(), anchor);
+    EXPECT_EQ(anchor->getId(), "anchor");
+    EXPECT_EQ(anchor->getPosition(), PulsePosition(1.0, 2.0));
+}
+
+TEST(PulseObjectPoolTest, RecycledVehicleStartsNewGeneration)
+{
+    PulseDataManager manager;
+    ChurnMockSumo mockSumo;
+    mockSumo.populate(4);
+    manager.syncFromSumo(mockSumo);
+
+    PulseVehicle* held = manager.getAllVehicles().front();
+    const std::string held_id = held->getId();
+    const std::uint32_t held_generation = held->getGeneration();
+
+    // Replace the whole fleet; each departed vehicle is recycled for an arrival of the next update
+    for (int i = 0; i < 5; ++i) {
+        mockSumo.advance();
+        manager.updateFromSumo(mockSumo);
+    }
+
+    EXPECT_EQ(manager.getVehicle(held_id), nullptr);
+    bool recycled = false;
+    for (const auto* vehicle : manager.getAllVehicles()) {
+        if (vehicle == held) {
+            recycled = true;
+            EXPECT_NE(held->getGeneration(), held_generation);
+            EXPECT_NE(held->getId(), held_id);
+        }
+    }
+    EXPECT_TRUE(recycled);
+}
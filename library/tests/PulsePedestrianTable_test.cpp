@@ -0,0 +1,129 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseDataManager.h"
+#include "core/PulsePedestrianTable.h"
+
+namespace
+{
+    /**
+     * @brief Source with one signalized junction "J1", one bicycle and a scripted set of persons.
+     */
+    class PersonSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllVehicles() const override { return {"bike"}; }
+        std::vector<std::string> getAllTrafficLights() const override { return {"J1"}; }
+
+        PulseVehicleType getVehicleType(const std::string&) const override { return PulseVehicleType::BICYCLE; }
+
+        std::size_t fillPersonStates(std::vector<PulsePersonState>& out) const override
+        {
+            if (out.size() < persons.size()) {
+                out.resize(persons.size());
+            }
+            std::copy(persons.begin(), persons.end(), out.begin());
+            return persons.size();
+        }
+
+        std::vector<PulsePersonState> persons;
+    };
+}
+
+TEST(PulsePedestrianTableTest, TracksArrivalsAndDepartures)
+{
+    PulsePedestrianTable table;
+    std::vector<PulsePersonState> persons = {{"p1", {1.0, 2.0}, "e1", 1.2, 0.0}, {"p2", {5.0, 5.0}, "e2", 0.0, 4.0}};
+    table.update(persons, 1);
+    ASSERT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.getWaitingCount(), 1u);
+
+    const auto slot = table.find("p2").value();
+    EXPECT_EQ(table.getId(slot), "p2");
+    EXPECT_EQ(table.getRoadId(slot), "e2");
+    EXPECT_DOUBLE_EQ(table.getWaitingTime(slot), 4.0);
+
+    // p1 leaves; p3 arrives on the next update and takes over its slot
+    const auto freed = table.find("p1").value();
+    persons = {{"p2", {6.0, 5.0}, "e2", 1.0, 0.0}};
+    table.update(persons, 2);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_FALSE(table.find("p1").has_value());
+    EXPECT_DOUBLE_EQ(table.getPosition(slot).x, 6.0);
+    EXPECT_EQ(table.getWaitingCount(), 0u);
+
+    persons.push_back({"p3", {0.0, 0.0}, "e3", 1.0, 0.0});
+    table.update(persons, 3);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.find("p3"), freed);
+
+    std::size_t visited = 0;
+    table.forEach([&](std::size_t) { ++visited; });
+    EXPECT_EQ(visited, 2u);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+    table.update(persons, 4);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(PulsePedestrianTableTest, ParsesCrossingEdges)
+{
+    EXPECT_EQ(PulsePedestrianTable::crossingJunction(":J1_c0"), "J1");
+    EXPECT_EQ(PulsePedestrianTable::crossingJunction(":a_b_c12"), "a_b");
+    EXPECT_TRUE(PulsePedestrianTable::crossingJunction(":J_w0").empty());
+    EXPECT_TRUE(PulsePedestrianTable::crossingJunction(":J_c").empty());
+    EXPECT_TRUE(PulsePedestrianTable::crossingJunction(":J_cx").empty());
+    EXPECT_TRUE(PulsePedestrianTable::crossingJunction("J1_c0").empty());
+    EXPECT_TRUE(PulsePedestrianTable::crossingJunction("").empty());
+}
+
+TEST(PulsePedestrianTableTest, ReportsCrossingWaits)
+{
+    PulsePedestrianTable table;
+    table.update(std::vector<PulsePersonState>{{"p", {}, ":J1_w0", 0.0, 12.0}}, 1);
+    EXPECT_TRUE(table.getCrossingEvents().empty());
+
+    // SUMO resets the waiting time once the person moves; the wait seen before still counts
+    table.update(std::vector<PulsePersonState>{{"p", {}, ":J1_c0", 1.3, 0.0}}, 2);
+    const auto events = table.getCrossingEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].junction_id, "J1");
+    EXPECT_DOUBLE_EQ(events[0].waiting_time, 12.0);
+
+    // Staying on the crossing, or moving to the next one directly, is not a new crossing
+    table.update(std::vector<PulsePersonState>{{"p", {}, ":J1_c0", 1.3, 0.0}}, 3);
+    EXPECT_TRUE(table.getCrossingEvents().empty());
+    table.update(std::vector<PulsePersonState>{{"p", {}, ":J1_c1", 1.3, 0.0}}, 4);
+    EXPECT_TRUE(table.getCrossingEvents().empty());
+}
+
+TEST(PulsePedestrianTableTest, DataManagerCreditsIntersections)
+{
+    auto& manager = PulseDataManager::getInstance();
+    manager.clearAll();
+
+    PersonSource source;
+    manager.syncFromSumo(source);
+    EXPECT_EQ(manager.getVehicle("bike")->getType(), PulseVehicleType::BICYCLE);
+
+    source.persons = {{"p1", {}, ":J1_w0", 0.0, 8.0}, {"p2", {}, "e1", 1.0, 0.0}};
+    manager.updateFromSumo(source);
+    EXPECT_EQ(manager.getPedestrians().size(), 2u);
+
+    source.persons = {{"p1", {}, ":J1_c2", 1.2, 0.0}};
+    manager.updateFromSumo(source);
+    EXPECT_EQ(manager.getPedestrians().size(), 1u);
+
+    const auto& statistics = manager.getIntersection("J1")->getStatistics();
+    EXPECT_EQ(statistics.getTotalPedestriansPassed(), 1u);
+    EXPECT_DOUBLE_EQ(statistics.getTotalPedestrianWaitingTime(), 8.0);
+
+    manager.clearAll();
+    EXPECT_EQ(manager.getPedestrians().size(), 0u);
+}
@@ -0,0 +1,157 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+
+#include "TempDirectory.h"
+
+#include "core/PulsePlanOptimizer.h"
+
+namespace
+{
+    /**
+     * @brief Corridor A -> B -> C of 150 m roads with demand entering at A.
+     */
+    struct Corridor
+    {
+        std::vector<std::unique_ptr<PulseIntersection>> intersections;
+        std::vector<std::unique_ptr<PulseTrafficLight>> traffic_lights;
+
+        Corridor()
+        {
+            for (const char* id : {"A", "B", "C"}) {
+                const double x = 150.0 * static_cast<double>(intersections.size());
+                intersections.push_back(std::make_unique<PulseIntersection>(id, PulsePosition{x, 0.0}));
+                traffic_lights.push_back(std::make_unique<PulseTrafficLight>(std::string("tl_") + id));
+            }
+            for (std::size_t i = 0; i + 1 < intersections.size(); ++i) {
+                intersections[i]->addRoadConnection(0, intersections[i + 1].get(), traffic_lights[i + 1].get(), 150.0);
+            }
+        }
+
+        PulsePlanEvaluator::SimulationFactory factory() const
+        {
+            return [this] {
+                std::vector<PulseIntersection*> nodes;
+                for (const auto& intersection : intersections) {
+                    nodes.push_back(intersection.get());
+                }
+                PulseMesoConfig config;
+                config.exit_probability = 0.0;
+                auto simulation = std::make_unique<PulseMesoSimulation>(nodes, config);
+                simulation->setDemand("A", 900.0);
+                return simulation;
+            };
+        }
+    };
+
+    std::vector<PulseSignalPlan> makePlans(double green, double red)
+    {
+        return {{"tl_B", TrafficLightDurations(red, 3.0, green), 0.0},
+                {"tl_C", TrafficLightDurations(red, 3.0, green), 0.0}};
+    }
+
+    PulsePlanSearchConfig smallSearch()
+    {
+        PulsePlanSearchConfig config;
+        config.population_size = 8;
+        config.seed = 5;
+        return config;
+    }
+}
+
+TEST(PulsePlanOptimizerTest, EvaluatorRanksPlansIndependentlyOfThreads)
+{
+    Corridor corridor;
+    const std::vector<std::vector<PulseSignalPlan>> candidates{makePlans(60.0, 10.0), makePlans(10.0, 60.0), makePlans(30.0, 30.0)};
+
+    const PulsePlanEvaluator serial(corridor.factory(), 900.0, 2, 11, 1);
+    const PulsePlanEvaluator parallel(corridor.factory(), 900.0, 2, 11, 4);
+    const auto scores = serial.evaluate(candidates);
+
+    ASSERT_EQ(scores.size(), 3u);
+    EXPECT_EQ(parallel.evaluate(candidates), scores);
+    EXPECT_LT(scores[0], scores[2]);
+    EXPECT_LT(scores[2], scores[1]);
+    EXPECT_TRUE(serial.evaluate({}).empty());
+}
+
+TEST(PulsePlanOptimizerTest, SearchIsReproducibleAndMonotonic)
+{
+    Corridor corridor;
+    const PulsePlanEvaluator serial(corridor.factory(), 900.0, 1, 3, 1);
+    const PulsePlanEvaluator parallel(corridor.factory(), 900.0, 1, 3, 4);
+    const auto initial = makePlans(20.0, 40.0);
+    const double initial_delay = serial.evaluate({initial}).front();
+
+    PulsePlanOptimizer first(serial, initial, smallSearch());
+    PulsePlanOptimizer second(parallel, initial, smallSearch());
+    const auto& best = first.run(5);
+    second.run(5);
+
+    EXPECT_EQ(first.getGeneration(), 5u);
+    EXPECT_EQ(first.getHistory(), second.getHistory());
+    EXPECT_EQ(best.plans.size(), 2u);
+    EXPECT_DOUBLE_EQ(second.getBest().plans[0].durations.green, best.plans[0].durations.green);
+    EXPECT_DOUBLE_EQ(second.getBest().plans[1].offset, best.plans[1].offset);
+
+    // The first generation includes the initial plans and the elite is kept
+    EXPECT_LE(best.fitness, initial_delay);
+    for (std::size_t i = 1; i < first.getHistory().size(); ++i) {
+        EXPECT_LE(first.getHistory()[i], first.getHistory()[i - 1]);
+    }
+    EXPECT_LT(best.fitness, initial_delay);
+    EXPECT_DOUBLE_EQ(serial.evaluate({best.plans}).front(), best.fitness);
+}
+
+TEST(PulsePlanOptimizerTest, CheckpointResumesSearch)
+{
+    Corridor corridor;
+    const PulsePlanEvaluator evaluator(corridor.factory(), 600.0, 1, 3, 2);
+    const auto directory = makeTempDirectory("pulse_plan_checkpoint_test");
+    const auto path = (directory / "checkpoint.txt").string();
+
+    PulsePlanOptimizer uninterrupted(evaluator, makePlans(20.0, 40.0), smallSearch());
+    uninterrupted.run(2);
+    uninterrupted.saveCheckpoint(path);
+    uninterrupted.run(2);
+
+    PulsePlanOptimizer resumed(evaluator, makePlans(20.0, 40.0), smallSearch());
+    resumed.loadCheckpoint(path);
+    EXPECT_EQ(resumed.getGeneration(), 2u);
+    resumed.run(2);
+
+    EXPECT_EQ(resumed.getHistory(), uninterrupted.getHistory());
+    EXPECT_DOUBLE_EQ(resumed.getBest().plans[0].durations.red, uninterrupted.getBest().plans[0].durations.red);
+
+    PulsePlanOptimizer other_lights(evaluator, {makePlans(20.0, 40.0).front()}, smallSearch());
+    EXPECT_THROW(other_lights.loadCheckpoint(path), std::invalid_argument);
+    std::filesystem::remove(path);
+    EXPECT_THROW(resumed.loadCheckpoint(path), std::runtime_error);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulsePlanOptimizerTest, RejectsInvalidSettings)
+{
+    Corridor corridor;
+    EXPECT_THROW(PulsePlanEvaluator(corridor.factory(), 0.0), std::invalid_argument);
+    EXPECT_THROW(PulsePlanEvaluator(nullptr, 60.0), std::invalid_argument);
+
+    const PulsePlanEvaluator evaluator(corridor.factory(), 60.0);
+    auto config = smallSearch();
+    config.elite_count = 9;
+    EXPECT_THROW(PulsePlanOptimizer(evaluator, makePlans(20.0, 20.0), config), std::invalid_argument);
+
+    auto duplicate = makePlans(20.0, 20.0);
+    duplicate[1].traffic_light_id = "tl_B";
+    EXPECT_THROW(PulsePlanOptimizer(evaluator, duplicate), std::invalid_argument);
+    EXPECT_THROW(PulsePlanOptimizer(evaluator, {}), std::invalid_argument);
+
+    PulsePlanOptimizer optimizer(evaluator, makePlans(20.0, 20.0), smallSearch());
+    EXPECT_THROW((void)optimizer.getBest(), std::logic_error);
+    EXPECT_THROW((void)evaluator.evaluate({{{"tl_X", {}, 0.0}}}), std::invalid_argument);
+}
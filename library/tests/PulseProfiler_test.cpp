@@ -0,0 +1,112 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseProfiler.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    class TwoVehicleMockSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllVehicles() const override { return {"veh0", "veh1"}; }
+        std::pair<double, double> getVehiclePosition(const std::string&) const override { return {1.0, 1.0}; }
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl1"}; }
+        std::string getTrafficLightState(const std::string&) const override { return "Gr"; }
+    };
+}
+
+TEST(PulseProfilerTest, RecordsIntoHistograms)
+{
+    auto& profiler = PulseProfiler::getInstance();
+    profiler.reset();
+
+    profiler.record(PulseProfileStage::SUMO_STEP, std::chrono::nanoseconds(1000));
+    profiler.record(PulseProfileStage::SUMO_STEP, std::chrono::nanoseconds(3000));
+
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::SUMO_STEP), 2u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::SNAPSHOT), 0u);
+    EXPECT_DOUBLE_EQ(profiler.getTotalSeconds(PulseProfileStage::SUMO_STEP), 4e-6);
+}
+
+TEST(PulseProfilerTest, ExportsJsonAndPrometheus)
+{
+    auto& profiler = PulseProfiler::getInstance();
+    profiler.reset();
+    profiler.record(PulseProfileStage::VEHICLE_SYNC, std::chrono::nanoseconds(500));
+    profiler.setEntityCounts(12, 3, 3);
+
+    std::ostringstream json;
+    profiler.writeJson(json);
+    EXPECT_NE(json.str().find("\"vehicle_sync\":{\"count\":1"), std::string::npos);
+    EXPECT_NE(json.str().find("\"vehicles\":12"), std::string::npos);
+    EXPECT_NE(json.str().find("\"pools\":{\"vehicle\":{\"allocations\":"), std::string::npos);
+
+    std::ostringstream text;
+    profiler.writePrometheus(text);
+    EXPECT_NE(text.str().find("# TYPE pulse_stage_duration_seconds histogram"), std::string::npos);
+    EXPECT_NE(text.str().find("pulse_stage_duration_seconds_count{stage=\"vehicle_sync\"} 1"), std::string::npos);
+    EXPECT_NE(text.str().find("pulse_stage_duration_seconds_bucket{stage=\"vehicle_sync\",le=\"+Inf\"} 1"), std::string::npos);
+    EXPECT_NE(text.str().find("pulse_entities{kind=\"vehicle\"} 12"), std::string::npos);
+    EXPECT_NE(text.str().find("# TYPE pulse_pool_allocations_total counter"), std::string::npos);
+}
+
+TEST(PulseProfilerTest, StepStagesReuseStageTimings)
+{
+    if (!PulseProfiler::isEnabled()) {
+        GTEST_SKIP() << "Built without PULSE_ENABLE_PROFILING";
+    }
+    auto& profiler = PulseProfiler::getInstance();
+    profiler.reset();
+
+    TrafficSystem system(std::make_unique<TwoVehicleMockSource>());
+    system.addStepConsumer("sleep", [](TrafficSystem&) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    system.initialize();
+    std::chrono::nanoseconds simulation{0};
+    std::chrono::nanoseconds consumers{0};
+    for (int i = 0; i < 5; ++i) {
+        system.stepSimulation();
+        simulation += system.getStageTimings()[1].duration;
+        consumers += system.getStageTimings().back().duration;
+    }
+
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::STEP), 5u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::SUMO_STEP), 5u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::VEHICLE_SYNC), 5u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::TRAFFIC_LIGHT_SYNC), 5u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::SNAPSHOT), 5u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::CHECKSUM), 0u);
+    EXPECT_EQ(profiler.getCount(PulseProfileStage::CONSUMERS), 5u);
+
+    // The profiler records the very durations the step reports, not a second measurement
+    EXPECT_DOUBLE_EQ(profiler.getTotalSeconds(PulseProfileStage::SUMO_STEP), std::chrono::duration<double>(simulation).count());
+    EXPECT_DOUBLE_EQ(profiler.getTotalSeconds(PulseProfileStage::CONSUMERS), std::chrono::duration<double>(consumers).count());
+
+    std::ostringstream json;
+    profiler.writeJson(json);
+    EXPECT_NE(json.str().find("\"vehicles\":2"), std::string::npos);
+}
+
+TEST(PulseProfilerTest, ScopedTimerIsCheap)
+{
+    PulseProfiler::getInstance().reset();
+
+    constexpr int iterations = 100000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        PulseScopedTimer timer(PulseProfileStage::CONSUMERS);
+    }
+    const auto per_timer = (std::chrono::steady_clock::now() - start) / iterations;
+
+    // A step takes milliseconds and has about ten timers, so this keeps the overhead well below 1%
+    EXPECT_LT(per_timer, std::chrono::nanoseconds(1000));
+    EXPECT_EQ(PulseProfiler::getInstance().getCount(PulseProfileStage::CONSUMERS), static_cast<std::uint64_t>(iterations));
+}
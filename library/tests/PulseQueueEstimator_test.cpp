@@ -0,0 +1,232 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseQueueEstimator.h"
+
+namespace
+{
+    /**
+     * @brief Source whose vehicles and their kinematics are set directly by the test.
+     */
+    class KinematicsMockSource : public MockSimulationSource
+    {
+    public:
+        std::map<std::string, PulseVehicleKinematics> vehicles;
+
+        std::vector<std::string> getAllVehicles() const override
+        {
+            std::vector<std::string> ids;
+            for (const auto& [id, kinematics] : vehicles) {
+                ids.push_back(id);
+            }
+            return ids;
+        }
+
+        bool fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const override
+        {
+            out = vehicles.at(vehicle_id);
+            return true;
+        }
+    };
+
+    // West -(1, 100 m)-> Center <-(1, 60 m)- North
+    struct Network
+    {
+        std::vector<std::unique_ptr<PulseIntersection>> intersections;
+        std::unique_ptr<PulseTrafficLight> traffic_light = std::make_unique<PulseTrafficLight>("tl_center");
+
+        Network()
+        {
+            for (const auto* id : {"West", "Center", "North"}) {
+                intersections.push_back(std::make_unique<PulseIntersection>(id, PulsePosition{}));
+            }
+            intersections[0]->addRoadConnection(1, intersections[1].get(), traffic_light.get(), 100.0);
+            intersections[2]->addRoadConnection(1, intersections[1].get(), traffic_light.get(), 60.0);
+        }
+
+        std::vector<PulseIntersection*> nodes() const
+        {
+            return {intersections[0].get(), intersections[1].get(), intersections[2].get()};
+        }
+    };
+
+    PulseVehicleKinematics at(const std::string& road, double lane_position, double speed, double lane_length = 0.0)
+    {
+        return PulseVehicleKinematics{road, 0, lane_position, speed, lane_length};
+    }
+}
+
+TEST(PulseQueueEstimatorTest, MeasuresQueuesPerApproach)
+{
+    Network network;
+    PulseQueueEstimator estimator(network.nodes(), {{"west_in", "West", 1}, {"north_in", "North", 1}});
+    ASSERT_EQ(estimator.getApproachCount(), 2u);
+    EXPECT_EQ(estimator.getApproaches("Center"), (std::vector<std::size_t>{0, 1}));
+    EXPECT_TRUE(estimator.getApproaches("West").empty());
+    EXPECT_EQ(estimator.getApproach(0).upstream_intersection_id, "West");
+    EXPECT_EQ(estimator.getApproach(0).traffic_light_id, "tl_center");
+
+    KinematicsMockSource source;
+    source.startSimulation();
+    source.vehicles = {
+        {"veh0", at("west_in", 98.0, 0.0)},
+        {"veh1", at("west_in", 90.0, 0.05)},
+        {"veh2", at("west_in", 40.0, 12.0)},    // still moving
+        {"veh3", at("elsewhere", 10.0, 0.0)},   // not an approach
+    };
+
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    auto queue = estimator.getQueue(0);
+    EXPECT_EQ(queue.queued_vehicles, 2u);
+    EXPECT_DOUBLE_EQ(queue.queue_length, 100.0 - 90.0 + PulseQueueEstimator::kDefaultVehicleSpacing);
+    EXPECT_FALSE(queue.spillback);
+    EXPECT_EQ(estimator.getQueue(1).queued_vehicles, 0u);
+
+    // The light turns green and the queue discharges
+    source.vehicles = {{"veh2", at("west_in", 60.0, 12.0)}};
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    queue = estimator.getQueue(0);
+    EXPECT_EQ(queue.queued_vehicles, 0u);
+    EXPECT_DOUBLE_EQ(queue.queue_length, 0.0);
+    EXPECT_DOUBLE_EQ(queue.max_queue_length, 100.0 - 90.0 + PulseQueueEstimator::kDefaultVehicleSpacing);
+}
+
+TEST(PulseQueueEstimatorTest, RaisesSpillbackEvents)
+{
+    Network network;
+    PulseQueueEstimator estimator(network.nodes(), {{"west_in", "West", 1}, {"north_in", "North", 1}});
+
+    std::vector<PulseSpillbackEvent> events;
+    estimator.addSpillbackListener([&](const PulseSpillbackEvent& event) { events.push_back(event); });
+
+    KinematicsMockSource source;
+    source.startSimulation();
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+
+    // Eight halted vehicles fill the 60 m north approach; the last one sticks out into North
+    for (int i = 0; i < 8; ++i) {
+        source.vehicles["veh" + std::to_string(i)] = at("north_in", 59.0 - 7.5 * i, 0.0);
+    }
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].approach, 1u);
+    EXPECT_EQ(events[0].info->upstream_intersection_id, "North");
+    EXPECT_TRUE(events[0].started);
+    EXPECT_GT(events[0].queue_length, 60.0);
+    EXPECT_TRUE(estimator.getQueue(1).spillback);
+
+    // Still spilling back: no new event
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+    EXPECT_EQ(events.size(), 1u);
+
+    // The tail moves off the upstream junction
+    source.vehicles.erase("veh7");
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_FALSE(events[1].started);
+    EXPECT_FALSE(estimator.getQueue(1).spillback);
+    EXPECT_EQ(estimator.getQueue(1).queued_vehicles, 7u);
+}
+
+TEST(PulseQueueEstimatorTest, QueueEndsAtFirstGapFromStopLine)
+{
+    Network network;
+    PulseQueueEstimator estimator(network.nodes(), {{"north_in", "North", 1}});
+
+    std::vector<PulseSpillbackEvent> events;
+    estimator.addSpillbackListener([&](const PulseSpillbackEvent& event) { events.push_back(event); });
+
+    KinematicsMockSource source;
+    source.startSimulation();
+    source.vehicles = {
+        {"queued0", at("north_in", 58.0, 0.0)},
+        {"queued1", at("north_in", 51.0, 0.0)},
+        {"parked", at("north_in", 3.0, 0.0)},                               // Halted far upstream of the queue
+        {"left0", PulseVehicleKinematics{"north_in", 1, 57.0, 0.0}},
+        {"left_stop", PulseVehicleKinematics{"north_in", 1, 20.0, 0.0}},    // Beyond the gap on its own lane
+    };
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    auto queue = estimator.getQueue(0);
+    EXPECT_EQ(queue.queued_vehicles, 3u);
+    EXPECT_DOUBLE_EQ(queue.queue_length, 60.0 - 51.0 + PulseQueueEstimator::kDefaultVehicleSpacing);
+    EXPECT_FALSE(queue.spillback);
+    EXPECT_TRUE(events.empty());
+
+    // Halted vehicles that do not reach the stop line form no queue at all
+    source.vehicles = {{"parked", at("north_in", 3.0, 0.0)}};
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+    EXPECT_EQ(estimator.getQueue(0).queued_vehicles, 0u);
+    EXPECT_DOUBLE_EQ(estimator.getQueue(0).queue_length, 0.0);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST(PulseQueueEstimatorTest, AnchorsQueuesOnSourceLaneEnd)
+{
+    Network network;
+    PulseQueueEstimator estimator(network.nodes(), {{"west_in", "West", 1}, {"north_in", "North", 1}});
+
+    std::vector<PulseSpillbackEvent> events;
+    estimator.addSpillbackListener([&](const PulseSpillbackEvent& event) { events.push_back(event); });
+
+    // The west edge is 140 m against a 100 m connection, the north edge 30 m against 60 m
+    KinematicsMockSource source;
+    source.startSimulation();
+    source.vehicles = {
+        {"west0", at("west_in", 138.0, 0.0, 140.0)},
+        {"west1", at("west_in", 131.0, 0.0, 140.0)},
+    };
+    for (int i = 0; i < 5; ++i) {
+        source.vehicles["north" + std::to_string(i)] = at("north_in", 28.0 - 7.0 * i, 0.0, 30.0);
+    }
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+    manager.updateFromSumo(source);
+    estimator.update(manager);
+
+    auto west = estimator.getQueue(0);
+    EXPECT_EQ(west.queued_vehicles, 2u);
+    EXPECT_DOUBLE_EQ(west.queue_length, 140.0 - 131.0 + PulseQueueEstimator::kDefaultVehicleSpacing);
+    EXPECT_FALSE(west.spillback);
+
+    // The short edge is full although the queue is shorter than the connection
+    auto north = estimator.getQueue(1);
+    EXPECT_EQ(north.queued_vehicles, 5u);
+    EXPECT_DOUBLE_EQ(north.queue_length, 30.0 + PulseQueueEstimator::kDefaultVehicleSpacing);
+    EXPECT_TRUE(north.spillback);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].approach, 1u);
+    EXPECT_TRUE(events[0].started);
+}
+
+TEST(PulseQueueEstimatorTest, RejectsInvalidBindings)
+{
+    Network network;
+    EXPECT_THROW(PulseQueueEstimator(network.nodes(), {{"x", "Center", 1}}), std::invalid_argument);
+    EXPECT_THROW(PulseQueueEstimator(network.nodes(), {{"x", "Nowhere", 1}}), std::invalid_argument);
+    EXPECT_THROW(PulseQueueEstimator(network.nodes(), {{"x", "West", 1}, {"x", "North", 1}}), std::invalid_argument);
+    EXPECT_THROW(PulseQueueEstimator(network.nodes(), {}, -1.0), std::invalid_argument);
+}
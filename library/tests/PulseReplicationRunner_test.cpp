@@ -0,0 +1,129 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseReplicationRunner.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    /**
+     * @brief Minimal seeded source: one traffic light and a fleet whose size depends on the seed.
+     */
+    class SeededMockSource : public MockSimulationSource
+    {
+    public:
+        void stepSimulation() override { ++m_step; }
+        void setSeed(std::uint64_t seed) override { m_seed = seed; }
+
+        std::vector<std::string> getAllVehicles() const override
+        {
+            std::vector<std::string> ids;
+            for (std::uint64_t i = 0; i < 1 + m_seed % 7; ++i) {
+                ids.push_back("veh" + std::to_string(i));
+            }
+            return ids;
+        }
+
+        std::pair<double, double> getVehiclePosition(const std::string&) const override
+        {
+            return {static_cast<double>(m_step), 0.0};
+        }
+
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl1"}; }
+        std::string getTrafficLightState(const std::string&) const override { return "GGrr"; }
+
+    private:
+        std::uint64_t m_seed = 0;
+        std::size_t m_step = 0;
+    };
+
+    PulseReplicationRunner makeRunner(std::size_t threads)
+    {
+        PulseReplicationRunner runner([](std::uint64_t) { return std::make_unique<SeededMockSource>(); }, 20, threads);
+
+        // Record one pass per vehicle per step, waiting a seed-dependent random time
+        runner.setStepCallback([](TrafficSystem& system, std::size_t) {
+            auto& manager = system.getDataManager();
+            std::mt19937_64 rng(manager.getAllVehicles().size());
+            for (auto* intersection : manager.getAllIntersections()) {
+                for (std::size_t i = 0; i < manager.getAllVehicles().size(); ++i) {
+                    intersection->getStatistics().addVehiclePass(static_cast<double>(rng() % 10));
+                }
+            }
+        });
+        return runner;
+    }
+}
+
+TEST(PulseReplicationRunnerTest, IndependentSystemsDoNotShareState)
+{
+    TrafficSystem first(std::make_unique<SeededMockSource>());
+    TrafficSystem second(std::make_unique<SeededMockSource>());
+    first.getSimulationSource().setSeed(2);
+    second.getSimulationSource().setSeed(5);
+
+    first.initialize();
+    second.initialize();
+
+    EXPECT_NE(&first.getDataManager(), &second.getDataManager());
+    EXPECT_NE(&first.getDataManager(), &PulseDataManager::getInstance());
+    EXPECT_EQ(first.getDataManager().getAllVehicles().size(), 3u);
+    EXPECT_EQ(second.getDataManager().getAllVehicles().size(), 6u);
+}
+
+TEST(PulseReplicationRunnerTest, ResultsAreIndependentOfThreadCount)
+{
+    auto serial = makeRunner(1).run(8, 1234);
+    auto parallel = makeRunner(4).run(8, 1234);
+
+    ASSERT_EQ(serial.size(), 8u);
+    ASSERT_EQ(parallel.size(), 8u);
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].replication, i);
+        EXPECT_EQ(serial[i].seed, PulseReplicationRunner::deriveSeed(1234, i));
+        EXPECT_EQ(serial[i].seed, parallel[i].seed);
+        EXPECT_EQ(serial[i].steps, 20u);
+
+        const auto& a = serial[i].intersections.at("tl1");
+        const auto& b = parallel[i].intersections.at("tl1");
+        EXPECT_EQ(a.getTotalVehiclesPassed(), b.getTotalVehiclesPassed());
+        EXPECT_DOUBLE_EQ(a.getTotalVehicleWaitingTime(), b.getTotalVehicleWaitingTime());
+    }
+}
+
+TEST(PulseReplicationRunnerTest, AggregateMergesAllReplications)
+{
+    auto results = makeRunner(3).run(5, 42);
+
+    std::size_t expected_passed = 0;
+    double expected_waiting = 0.0;
+    for (const auto& result : results) {
+        expected_passed += result.intersections.at("tl1").getTotalVehiclesPassed();
+        expected_waiting += result.intersections.at("tl1").getTotalVehicleWaitingTime();
+    }
+
+    auto combined = PulseReplicationRunner::aggregate(results);
+    ASSERT_EQ(combined.size(), 1u);
+    EXPECT_EQ(combined.at("tl1").getIntersectionId(), "tl1");
+    EXPECT_EQ(combined.at("tl1").getTotalVehiclesPassed(), expected_passed);
+    EXPECT_DOUBLE_EQ(combined.at("tl1").getTotalVehicleWaitingTime(), expected_waiting);
+}
+
+TEST(PulseReplicationRunnerTest, FailingReplicationIsRethrown)
+{
+    PulseReplicationRunner runner([](std::uint64_t seed) -> std::unique_ptr<SimulationSource> {
+        if (seed == PulseReplicationRunner::deriveSeed(7, 2)) {
+            throw std::runtime_error("bad scenario");
+        }
+        return std::make_unique<SeededMockSource>();
+    }, 5, 2);
+
+    EXPECT_THROW(runner.run(4, 7), std::runtime_error);
+}
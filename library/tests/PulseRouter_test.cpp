@@ -0,0 +1,203 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "core/PulseRouter.h"
+
+namespace
+{
+    /**
+     * @brief Owns intersections and traffic lights for a small test network.
+     */
+    struct TestNetwork
+    {
+        std::vector<std::unique_ptr<PulseIntersection>> intersections;
+        std::vector<std::unique_ptr<PulseTrafficLight>> traffic_lights;
+
+        PulseIntersection* add(const std::string& id, double x, double y)
+        {
+            intersections.push_back(std::make_unique<PulseIntersection>(id, PulsePosition{x, y}));
+            traffic_lights.push_back(std::make_unique<PulseTrafficLight>("tl_" + id));
+            return intersections.back().get();
+        }
+
+        void connect(PulseIntersection* from, int road_id, PulseIntersection* to, double distance)
+        {
+            // The signal at the far end controls traffic arriving from this road
+            for (std::size_t i = 0; i < intersections.size(); ++i) {
+                if (intersections[i].get() == to) {
+                    from->addRoadConnection(road_id, to, traffic_lights[i].get(), distance);
+                    return;
+                }
+            }
+        }
+
+        std::vector<PulseIntersection*> nodes() const
+        {
+            std::vector<PulseIntersection*> result;
+            for (const auto& intersection : intersections) {
+                result.push_back(intersection.get());
+            }
+            return result;
+        }
+    };
+
+    std::string gridId(int x, int y)
+    {
+        return "n" + std::to_string(x) + "_" + std::to_string(y);
+    }
+
+    TestNetwork makeGrid(int size)
+    {
+        TestNetwork network;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                network.add(gridId(x, y), x * 100.0, y * 100.0);
+            }
+        }
+        auto at = [&](int x, int y) { return network.intersections[y * size + x].get(); };
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (x + 1 < size) network.connect(at(x, y), 0, at(x + 1, y), 100.0);
+                if (x > 0) network.connect(at(x, y), 1, at(x - 1, y), 100.0);
+                if (y + 1 < size) network.connect(at(x, y), 2, at(x, y + 1), 100.0);
+                if (y > 0) network.connect(at(x, y), 3, at(x, y - 1), 100.0);
+            }
+        }
+        return network;
+    }
+
+    // A -> B -> D is shorter than A -> C -> D
+    TestNetwork makeDiamond()
+    {
+        TestNetwork network;
+        auto* a = network.add("A", 0.0, 0.0);
+        auto* b = network.add("B", 100.0, 50.0);
+        auto* c = network.add("C", 100.0, -50.0);
+        auto* d = network.add("D", 200.0, 0.0);
+        network.add("isolated", 500.0, 500.0);
+        network.connect(a, 1, b, 120.0);
+        network.connect(a, 2, c, 150.0);
+        network.connect(b, 1, d, 120.0);
+        network.connect(c, 1, d, 150.0);
+        return network;
+    }
+}
+
+TEST(PulseRouterTest, AlgorithmsAgreeOnGrid)
+{
+    constexpr int size = 12;
+    auto network = makeGrid(size);
+    PulseRouter router(network.nodes());
+    EXPECT_EQ(router.getNodeCount(), static_cast<std::size_t>(size * size));
+    EXPECT_EQ(router.getEdgeCount(), static_cast<std::size_t>(4 * size * (size - 1)));
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> seconds(4.0, 40.0);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            for (int road = 0; road < 4; ++road) {
+                try {
+                    router.setTravelTime(gridId(x, y), road, seconds(random));
+                }
+                catch (const std::invalid_argument&) {
+                    // Border intersections have fewer roads
+                }
+            }
+        }
+    }
+    router.preprocess();
+    EXPECT_TRUE(router.isPreprocessed());
+
+    std::uniform_int_distribution<int> coordinate(0, size - 1);
+    for (int i = 0; i < 200; ++i) {
+        const auto from = gridId(coordinate(random), coordinate(random));
+        const auto to = gridId(coordinate(random), coordinate(random));
+
+        const auto dijkstra = router.findTravelTime(from, to, PulseRoutingAlgorithm::DIJKSTRA);
+        const auto a_star = router.findTravelTime(from, to, PulseRoutingAlgorithm::A_STAR);
+        const auto hierarchy = router.findRoute(from, to, PulseRoutingAlgorithm::CONTRACTION_HIERARCHY);
+        ASSERT_TRUE(dijkstra && a_star && hierarchy);
+        EXPECT_NEAR(*a_star, *dijkstra, 1e-9);
+        EXPECT_NEAR(hierarchy->travel_time, *dijkstra, 1e-9);
+
+        // The unpacked hierarchy route is a connected chain of real roads
+        ASSERT_EQ(hierarchy->intersections.size(), hierarchy->roads.size() + 1);
+        EXPECT_EQ(hierarchy->intersections.front(), from);
+        EXPECT_EQ(hierarchy->intersections.back(), to);
+        EXPECT_DOUBLE_EQ(hierarchy->distance, 100.0 * static_cast<double>(hierarchy->roads.size()));
+    }
+}
+
+TEST(PulseRouterTest, LiveTravelTimesChangeTheRoute)
+{
+    auto network = makeDiamond();
+    PulseRouter router(network.nodes());
+    router.preprocess();
+
+    auto route = router.findRoute("A", "D");
+    ASSERT_TRUE(route);
+    EXPECT_EQ(route->intersections, (std::vector<std::string>{"A", "B", "D"}));
+    EXPECT_NEAR(route->travel_time, 240.0 / PulseRouter::kDefaultFreeFlowSpeed, 1e-9);
+
+    // Congestion on B -> D makes the longer road faster
+    router.setTravelTime("B", 1, 120.0);
+    EXPECT_FALSE(router.isPreprocessed());
+    EXPECT_THROW(router.findRoute("A", "D", PulseRoutingAlgorithm::CONTRACTION_HIERARCHY), std::logic_error);
+
+    route = router.findRoute("A", "D");
+    ASSERT_TRUE(route);
+    EXPECT_EQ(route->intersections, (std::vector<std::string>{"A", "C", "D"}));
+    EXPECT_EQ(route->roads, (std::vector<int>{2, 1}));
+
+    router.preprocess();
+    EXPECT_EQ(router.findRoute("A", "D", PulseRoutingAlgorithm::CONTRACTION_HIERARCHY)->intersections, route->intersections);
+
+    router.resetTravelTimes();
+    EXPECT_DOUBLE_EQ(router.getTravelTime("B", 1), 120.0 / PulseRouter::kDefaultFreeFlowSpeed);
+    EXPECT_EQ(router.findRoute("A", "D")->intersections, (std::vector<std::string>{"A", "B", "D"}));
+}
+
+TEST(PulseRouterTest, ReportsSignalsAlongTheRoute)
+{
+    auto network = makeDiamond();
+    PulseRouter router(network.nodes());
+    router.setTravelTime("A", 1, 4.0);
+    router.setTravelTime("B", 1, 6.0);
+
+    auto route = router.findRoute("A", "D");
+    ASSERT_TRUE(route);
+    ASSERT_EQ(route->signals.size(), 2u);
+    EXPECT_EQ(route->signals[0].traffic_light_id, "tl_B");
+    EXPECT_EQ(route->signals[0].intersection_id, "B");
+    EXPECT_DOUBLE_EQ(route->signals[0].arrival_time, 4.0);
+    EXPECT_EQ(route->signals[1].traffic_light_id, "tl_D");
+    EXPECT_DOUBLE_EQ(route->signals[1].arrival_time, 10.0);
+    EXPECT_DOUBLE_EQ(route->travel_time, 10.0);
+}
+
+TEST(PulseRouterTest, HandlesUnreachableAndUnknownNodes)
+{
+    auto network = makeDiamond();
+    PulseRouter router(network.nodes());
+    router.preprocess();
+
+    EXPECT_FALSE(router.findRoute("A", "isolated"));
+    EXPECT_FALSE(router.findTravelTime("D", "A", PulseRoutingAlgorithm::DIJKSTRA));
+    EXPECT_FALSE(router.findTravelTime("D", "A", PulseRoutingAlgorithm::CONTRACTION_HIERARCHY));
+    EXPECT_EQ(router.findRoute("A", "A")->intersections, (std::vector<std::string>{"A"}));
+
+    EXPECT_THROW(router.findRoute("A", "missing"), std::invalid_argument);
+    EXPECT_THROW(router.setTravelTime("A", 99, 1.0), std::invalid_argument);
+    EXPECT_THROW(router.setTravelTime("A", 1, -1.0), std::invalid_argument);
+
+    // Closing both roads out of A disconnects it
+    router.setTravelTime("A", 1, std::numeric_limits<double>::infinity());
+    router.setTravelTime("A", 2, std::numeric_limits<double>::infinity());
+    router.preprocess();
+    EXPECT_FALSE(router.findTravelTime("A", "D"));
+}
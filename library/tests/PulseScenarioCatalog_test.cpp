@@ -0,0 +1,154 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "TempDirectory.h"
+
+#include "core/PulseScenarioCatalog.h"
+#include "core/SumoIntegration.h"
+
+namespace
+{
+    void writeFile(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << content;
+    }
+
+    // A snapshot shaped like the OSM wizard output; with_net = false leaves the network out
+    void writeScenario(const std::filesystem::path& root, const std::string& city, const std::string& timestamp, bool with_net = true)
+    {
+        const auto directory = root / city / timestamp;
+        writeFile(directory / "osm.sumocfg",
+                  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<!-- <net-file value=\"commented.net.xml\"/> -->\n"
+                  "<sumoConfiguration xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n"
+                  "    <input>\n"
+                  "        <net-file value=\"osm.net.xml.gz\"/>\n"
+                  "        <route-files value=\"osm.bus.trips.xml,osm.passenger.trips.xml\"/>\n"
+                  "        <additional-files value=\"osm_stops.add.xml\"/>\n"
+                  "    </input>\n"
+                  "    <time>\n"
+                  "        <begin value=\"0\"/>\n"
+                  "        <end value=\"3600\"/>\n"
+                  "        <step-length value=\"0.5\"/>\n"
+                  "    </time>\n"
+                  "</sumoConfiguration>\n");
+        if (with_net) {
+            writeFile(directory / "osm.net.xml.gz", "net");
+        }
+        writeFile(directory / "osm.bus.trips.xml", "<routes/>");
+        writeFile(directory / "osm.passenger.trips.xml", "<routes/>");
+        writeFile(directory / "osm_stops.add.xml", "<additional/>");
+    }
+}
+
+TEST(PulseScenarioCatalogTest, ParsesConfigWithAbsoluteInputs)
+{
+    const auto root = makeTempDirectory("pulse_scenario_parse");
+    writeScenario(root, "zhytomyr", "2025-01-28-19-55-28");
+
+    const auto directory = root / "zhytomyr" / "2025-01-28-19-55-28";
+    const auto scenario = PulseScenarioCatalog::parseConfig((directory / "osm.sumocfg").string());
+    ASSERT_TRUE(scenario.valid) << scenario.error;
+    EXPECT_EQ(scenario.net_file, (directory / "osm.net.xml.gz").string());
+    ASSERT_EQ(scenario.route_files.size(), 2u);
+    EXPECT_EQ(scenario.route_files[1], (directory / "osm.passenger.trips.xml").string());
+    ASSERT_EQ(scenario.additional_files.size(), 1u);
+    EXPECT_DOUBLE_EQ(scenario.end, 3600.0);
+    EXPECT_DOUBLE_EQ(scenario.step_length, 0.5);
+
+    std::filesystem::remove(directory / "osm_stops.add.xml");
+    const auto missing = PulseScenarioCatalog::parseConfig((directory / "osm.sumocfg").string());
+    EXPECT_FALSE(missing.valid);
+    EXPECT_NE(missing.error.find("osm_stops.add.xml"), std::string::npos);
+
+    writeFile(directory / "other.sumocfg", "<routes/>");
+    EXPECT_FALSE(PulseScenarioCatalog::parseConfig((directory / "other.sumocfg").string()).valid);
+    std::filesystem::remove_all(root);
+}
+
+TEST(PulseScenarioCatalogTest, IndexesCitiesAndSnapshots)
+{
+    const auto root = makeTempDirectory("pulse_scenario_index");
+    writeScenario(root, "zhytomyr", "2025-01-28-19-55-28");
+    writeScenario(root, "zhytomyr", "2025-03-02-08-00-00");
+    writeScenario(root, "zhytomyr", "2025-04-10-08-00-00", false);
+    writeScenario(root, "kyiv", "2025-02-01-12-00-00");
+    std::filesystem::create_directories(root / "kyiv" / "empty");
+
+    PulseScenarioCatalog catalog(root.string());
+    EXPECT_EQ(catalog.scan(), 4u);
+    EXPECT_EQ(catalog.getParsedCount(), 4u);
+    EXPECT_EQ(catalog.getCities(), (std::vector<std::string>{"kyiv", "zhytomyr"}));
+    EXPECT_EQ(catalog.getScenarios().front().name, "kyiv/2025-02-01-12-00-00");
+
+    const auto* scenario = catalog.find("zhytomyr/2025-01-28-19-55-28");
+    ASSERT_NE(scenario, nullptr);
+    EXPECT_TRUE(scenario->valid);
+    EXPECT_EQ(catalog.find("zhytomyr/missing"), nullptr);
+
+    // The newest snapshot has no network, so the latest usable one is the previous
+    const auto* latest = catalog.findLatest("zhytomyr");
+    ASSERT_NE(latest, nullptr);
+    EXPECT_EQ(latest->timestamp, "2025-03-02-08-00-00");
+    EXPECT_EQ(catalog.findLatest("lviv"), nullptr);
+
+    const auto* broken = catalog.find("zhytomyr/2025-04-10-08-00-00");
+    ASSERT_NE(broken, nullptr);
+    EXPECT_FALSE(broken->valid);
+    EXPECT_THROW(SumoIntegration{*broken}, std::invalid_argument);
+
+    EXPECT_THROW(PulseScenarioCatalog((root / "missing").string()).scan(), std::runtime_error);
+    std::filesystem::remove_all(root);
+}
+
+TEST(PulseScenarioCatalogTest, CacheSkipsUnchangedConfigs)
+{
+    const auto root = makeTempDirectory("pulse_scenario_cache");
+    const auto cache_directory = makeTempDirectory("pulse_scenario_cache_file");
+    const auto cache = (cache_directory / "catalog.bin").string();
+    writeScenario(root, "zhytomyr", "2025-01-28-19-55-28");
+    writeScenario(root, "zhytomyr", "2025-03-02-08-00-00");
+    writeScenario(root, "kyiv", "2025-02-01-12-00-00");
+
+    PulseScenarioCatalog first(root.string(), cache);
+    EXPECT_EQ(first.scan(), 3u);
+    EXPECT_EQ(first.getParsedCount(), 3u);
+    ASSERT_TRUE(std::filesystem::exists(cache));
+
+    PulseScenarioCatalog second(root.string(), cache);
+    EXPECT_EQ(second.scan(), 3u);
+    EXPECT_EQ(second.getParsedCount(), 0u);
+    EXPECT_EQ(second.getCachedCount(), 3u);
+    const auto* restored = second.find("zhytomyr/2025-01-28-19-55-28");
+    ASSERT_NE(restored, nullptr);
+    EXPECT_TRUE(restored->valid);
+    EXPECT_EQ(restored->route_files, first.find("zhytomyr/2025-01-28-19-55-28")->route_files);
+
+    // A changed config is parsed again; the rest still come from the cache
+    std::ofstream(root / "kyiv" / "2025-02-01-12-00-00" / "osm.sumocfg", std::ios::app) << "\n";
+    EXPECT_EQ(second.scan(), 3u);
+    EXPECT_EQ(second.getParsedCount(), 1u);
+    EXPECT_EQ(second.getCachedCount(), 2u);
+
+    // An unchanged config whose input disappeared is not served from the cache
+    std::filesystem::remove(root / "zhytomyr" / "2025-03-02-08-00-00" / "osm.passenger.trips.xml");
+    EXPECT_EQ(second.scan(), 3u);
+    EXPECT_EQ(second.getParsedCount(), 1u);
+    EXPECT_FALSE(second.find("zhytomyr/2025-03-02-08-00-00")->valid);
+    EXPECT_EQ(second.findLatest("zhytomyr")->timestamp, "2025-01-28-19-55-28");
+
+    // A corrupt cache is ignored rather than trusted
+    std::ofstream(cache, std::ios::trunc) << "garbage";
+    PulseScenarioCatalog third(root.string(), cache);
+    EXPECT_EQ(third.scan(), 3u);
+    EXPECT_EQ(third.getParsedCount(), 3u);
+    std::filesystem::remove_all(root);
+    std::filesystem::remove_all(cache_directory);
+}
@@ -0,0 +1,184 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "TempDirectory.h"
+
+#include "core/PulseDemandFile.h"
+#include "core/PulseScenarioCatalog.h"
+#include "core/PulseScenarioTransformer.h"
+
+namespace
+{
+    void writeFile(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << content;
+    }
+
+    // 100 passenger trips and 10 buses, one departure every 10 s
+    std::filesystem::path makeScenario(const std::filesystem::path& root)
+    {
+        const auto directory = root / "sources" / "zhytomyr" / "2025-01-28-19-55-28";
+
+        std::string passenger = "<routes>\n";
+        for (int i = 0; i < 100; ++i) {
+            passenger += "    <trip id=\"veh" + std::to_string(i) + "\" depart=\"" + std::to_string(i * 10) + ".00\" from=\"a\" to=\"b\"/>\n";
+        }
+        passenger += "</routes>\n";
+        std::string bus = "<routes>\n    <vType id=\"bus_bus\" vClass=\"bus\"/>\n";
+        for (int i = 0; i < 10; ++i) {
+            bus += "    <trip id=\"bus" + std::to_string(i) + "\" type=\"bus_bus\" depart=\"" + std::to_string(i * 100) + ".00\" from=\"c\" to=\"d\"/>\n";
+        }
+        bus += "</routes>\n";
+
+        writeFile(directory / "osm.passenger.trips.xml", passenger);
+        writeFile(directory / "osm.bus.trips.xml", bus);
+        writeFile(directory / "osm.net.xml.gz", "net");
+        writeFile(directory / "osm_stops.add.xml", "<additional/>");
+        writeFile(directory / "osm.sumocfg",
+                  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<!-- <net-file value=\"commented.net.xml\"/> -->\n"
+                  "<sumoConfiguration>\n"
+                  "    <input>\n"
+                  "        <net-file value=\"osm.net.xml.gz\"/>\n"
+                  "        <route-files value=\"osm.passenger.trips.xml,osm.bus.trips.xml\"/>\n"
+                  "        <additional-files value=\"osm_stops.add.xml\"/>\n"
+                  "    </input>\n"
+                  "    <processing>\n"
+                  "        <ignore-route-errors value=\"true\"/>\n"
+                  "    </processing>\n"
+                  "</sumoConfiguration>\n");
+        return directory / "osm.sumocfg";
+    }
+}
+
+TEST(PulseScenarioTransformerTest, ScalesDemandPerClassWithSortedJitteredDepartures)
+{
+    const auto root = makeTempDirectory("pulse_transform_scale");
+    const auto source = PulseScenarioCatalog::parseConfig(makeScenario(root).string());
+    ASSERT_TRUE(source.valid) << source.error;
+
+    PulseDemandTransform transform;
+    transform.name = "x2.5";
+    transform.scale = 2.5;
+    transform.class_scales = {{"bus", 0.0}};
+    transform.jitter = 30.0;
+    transform.seed = 11;
+
+    PulseScenarioTransformer transformer((root / "simulations").string(), 2);
+    const PulseTransformResult result = transformer.transform(source, transform);
+    EXPECT_EQ(result.trips_read, 110u);
+    EXPECT_NEAR(static_cast<double>(result.trips_written), 250.0, 20.0);
+    ASSERT_TRUE(result.scenario.valid) << result.scenario.error;
+    EXPECT_EQ(result.scenario.name, "zhytomyr/2025-01-28-19-55-28-x2.5");
+    EXPECT_EQ(result.scenario.net_file, source.net_file);
+
+    const PulseDemandFile passenger = PulseDemandFile::load(result.scenario.route_files[0]);
+    EXPECT_EQ(passenger.getTrips().size(), result.trips_written);
+    std::set<std::string_view> ids;
+    double previous = 0.0;
+    bool shifted = false;
+    for (const auto& trip : passenger.getTrips()) {
+        EXPECT_TRUE(ids.insert(trip.id).second) << trip.id;
+        EXPECT_GE(trip.depart, previous);
+        previous = trip.depart;
+        shifted = shifted || trip.depart != std::floor(trip.depart / 10.0) * 10.0;
+    }
+    EXPECT_TRUE(shifted);
+    EXPECT_TRUE(PulseDemandFile::load(result.scenario.route_files[1]).getTrips().empty());
+
+    // The same seed gives the same variant
+    const PulseTransformResult again = transformer.transform(source, transform);
+    EXPECT_EQ(again.trips_written, result.trips_written);
+
+    // Options outside the input section carry over
+    std::ifstream config(result.scenario.config_path);
+    const std::string text((std::istreambuf_iterator<char>(config)), std::istreambuf_iterator<char>());
+    EXPECT_NE(text.find("<ignore-route-errors value=\"true\"/>"), std::string::npos);
+    std::filesystem::remove_all(root);
+}
+
+TEST(PulseScenarioTransformerTest, MergedRunsMatchInMemorySort)
+{
+    const auto root = makeTempDirectory("pulse_transform_runs");
+    const auto source = PulseScenarioCatalog::parseConfig(makeScenario(root).string());
+
+    PulseDemandTransform transform;
+    transform.name = "whole";
+    transform.scale = 3.5;
+    transform.jitter = 45.0;
+    transform.seed = 5;
+
+    // In runs of 7 source trips, the 100 passenger trips spill 15 runs and the 10 buses 2
+    const PulseTransformResult whole = PulseScenarioTransformer((root / "simulations").string(), 2).transform(source, transform);
+    transform.name = "runs";
+    const PulseTransformResult runs = PulseScenarioTransformer((root / "simulations").string(), 3, 7).transform(source, transform);
+    EXPECT_EQ(runs.trips_written, whole.trips_written);
+
+    const auto read = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+    ASSERT_EQ(runs.scenario.route_files.size(), whole.scenario.route_files.size());
+    for (std::size_t i = 0; i < runs.scenario.route_files.size(); ++i) {
+        EXPECT_EQ(read(runs.scenario.route_files[i]), read(whole.scenario.route_files[i]));
+    }
+
+    // The temporary runs are gone
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(runs.scenario.config_path).parent_path())) {
+        EXPECT_EQ(entry.path().string().find(".run"), std::string::npos) << entry.path();
+    }
+    EXPECT_THROW(PulseScenarioTransformer((root / "simulations").string(), 1, 0), std::invalid_argument);
+    std::filesystem::remove_all(root);
+}
+
+TEST(PulseScenarioTransformerTest, SlicesTimeWindowIntoCatalogLayout)
+{
+    const auto root = makeTempDirectory("pulse_transform_slice");
+    const auto source = PulseScenarioCatalog::parseConfig(makeScenario(root).string());
+
+    PulseDemandTransform transform;
+    transform.name = "rush";
+    transform.begin = 200.0;
+    transform.end = 500.0;
+
+    PulseScenarioTransformer transformer((root / "simulations").string());
+    const PulseTransformResult result = transformer.transform(source, transform);
+    EXPECT_EQ(result.trips_written, 30u + 3u);
+    EXPECT_DOUBLE_EQ(result.scenario.begin, 200.0);
+    EXPECT_DOUBLE_EQ(result.scenario.end, 500.0);
+
+    PulseScenarioCatalog catalog((root / "simulations").string());
+    EXPECT_EQ(catalog.scan(), 1u);
+    const auto* rush = catalog.find("zhytomyr/2025-01-28-19-55-28-rush");
+    ASSERT_NE(rush, nullptr);
+    EXPECT_TRUE(rush->valid);
+    EXPECT_EQ(rush->variant_of, "zhytomyr/2025-01-28-19-55-28");
+    EXPECT_EQ(catalog.findLatest("zhytomyr"), nullptr);
+
+    // Written into the source's own root, the variant sorts after the snapshot but is never its latest
+    PulseScenarioTransformer in_place((root / "sources").string());
+    in_place.transform(source, transform);
+    PulseScenarioCatalog sources((root / "sources").string());
+    EXPECT_EQ(sources.scan(), 2u);
+    ASSERT_NE(sources.findLatest("zhytomyr"), nullptr);
+    EXPECT_EQ(sources.findLatest("zhytomyr")->timestamp, "2025-01-28-19-55-28");
+
+    transform.end = 100.0;
+    EXPECT_THROW(transformer.transform(source, transform), std::invalid_argument);
+    transform.end = -1.0;
+    transform.scale = -1.0;
+    EXPECT_THROW(transformer.transform(source, transform), std::invalid_argument);
+    transform.scale = 1.0;
+    transform.name.clear();
+    EXPECT_THROW(transformer.transform(source, transform), std::invalid_argument);
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,138 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseSignalProgramTable.h"
+
+namespace
+{
+    /**
+     * @brief Two-phase program of a crossing: north-south (signals 0, 1) against east-west (signal 2).
+     */
+    PulseSignalProgram makeCrossing()
+    {
+        PulseSignalProgram program;
+        program.phases = {{"GGr", 30.0}, {"yyr", 3.0}, {"rrG", 20.0}, {"rry", 3.0}};
+        program.links = {{0, "n_0", "s_0"}, {1, "n_1", "e_0"}, {2, "w_0", "e_0"}, {2, "w_0", "s_0"}};
+        return program;
+    }
+
+    /**
+     * @brief Source that reports a program for every light but "plain".
+     */
+    class ProgramSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl1", "plain", "tl2"}; }
+
+        bool fillSignalProgram(const std::string& tl_id, PulseSignalProgram& out) const override
+        {
+            if (tl_id == "plain") {
+                return false;
+            }
+            out = makeCrossing();
+            out.current_phase = 2;
+            out.time_to_switch = 5.0;
+            return true;
+        }
+    };
+}
+
+TEST(PulseSignalProgramTableTest, AdvancesThroughPhases)
+{
+    PulseSignalProgramTable table;
+    const auto handle = table.addTrafficLight("tl", makeCrossing());
+    EXPECT_EQ(table.getPhaseIndex(handle), 0u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 30.0);
+
+    table.advance(29.0);
+    EXPECT_EQ(table.getPhaseIndex(handle), 0u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 1.0);
+
+    table.advance(2.0);
+    EXPECT_EQ(table.getPhaseIndex(handle), 1u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 2.0);
+
+    // At t = 31 in a 56 s cycle; ten cycles later plus 5 s is t = 596, 3 s into the east-west green
+    table.advance(565.0);
+    EXPECT_EQ(table.getPhaseIndex(handle), 2u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 17.0);
+
+    table.setPhase(handle, 3);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 3.0);
+    table.advance(3.0);
+    EXPECT_EQ(table.getPhaseIndex(handle), 0u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 30.0);
+}
+
+TEST(PulseSignalProgramTableTest, ReportsPerLinkColors)
+{
+    PulseSignalProgramTable table;
+    table.addTrafficLight("other", PulseSignalProgram{{{"G", 10.0}}, {}});
+    const auto handle = table.addTrafficLight("tl", makeCrossing());
+    EXPECT_EQ(table.findTrafficLight("tl"), handle);
+    EXPECT_FALSE(table.findTrafficLight("missing").has_value());
+
+    std::string state;
+    table.fillStateString(handle, state);
+    EXPECT_EQ(state, "GGr");
+    EXPECT_EQ(table.getLinkColor(handle, 1), PulseSignalColor::GREEN_MAJOR);
+    EXPECT_EQ(table.getLinkColor(handle, 3), PulseSignalColor::RED);
+    EXPECT_EQ(table.getSummaryState(handle), TrafficLightState::GREEN);
+    EXPECT_EQ(table.getControlledLinks(handle)[2].from_lane, "w_0");
+
+    table.setPhase(handle, 1);
+    EXPECT_EQ(table.getSummaryState(handle), TrafficLightState::YELLOW);
+    table.setPhase(handle, 3);
+    table.fillStateString(handle, state);
+    EXPECT_EQ(state, "rry");
+    EXPECT_EQ(table.getLinkColor(handle, 2), PulseSignalColor::YELLOW);
+    EXPECT_EQ(table.getSignalColors(0).size(), 1u);
+}
+
+TEST(PulseSignalProgramTableTest, LoadsFromSource)
+{
+    PulseSignalProgramTable table;
+    ProgramSource source;
+    EXPECT_EQ(table.loadFrom(source), 2u);
+    EXPECT_EQ(table.loadFrom(source), 0u);
+    ASSERT_EQ(table.size(), 2u);
+
+    const auto handle = table.findTrafficLight("tl2").value();
+    EXPECT_EQ(table.getPhaseIndex(handle), 2u);
+    EXPECT_DOUBLE_EQ(table.getTimeToSwitch(handle), 5.0);
+    EXPECT_EQ(table.getPhaseCount(handle), 4u);
+}
+
+TEST(PulseSignalProgramTableTest, RejectsInvalidPrograms)
+{
+    PulseSignalProgramTable table;
+    auto program = makeCrossing();
+    program.phases[1].state = "yy";
+    EXPECT_THROW(table.addTrafficLight("a", program), std::invalid_argument);
+
+    program = makeCrossing();
+    program.phases[0].state = "GGx";
+    EXPECT_THROW(table.addTrafficLight("a", program), std::invalid_argument);
+
+    program = makeCrossing();
+    program.phases[2].duration = 0.0;
+    EXPECT_THROW(table.addTrafficLight("a", program), std::invalid_argument);
+
+    program = makeCrossing();
+    program.links.push_back({3, "x", "y"});
+    EXPECT_THROW(table.addTrafficLight("a", program), std::invalid_argument);
+
+    EXPECT_THROW(table.addTrafficLight("a", PulseSignalProgram{}), std::invalid_argument);
+    EXPECT_EQ(table.size(), 0u);
+
+    table.addTrafficLight("a", makeCrossing());
+    EXPECT_THROW(table.addTrafficLight("a", makeCrossing()), std::runtime_error);
+    EXPECT_THROW(table.setPhase(0, 4), std::out_of_range);
+    EXPECT_THROW((void)table.getLinkColor(0, 4), std::out_of_range);
+    EXPECT_THROW((void)table.getPhaseIndex(1), std::out_of_range);
+}
@@ -0,0 +1,215 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <thread>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseDataManager.h"
+#include "core/PulseSnapshotPublisher.h"
+
+#include "entities/PulseIntersection.h"
+#include "entities/PulseTrafficLight.h"
+#include "entities/PulseVehicle.h"
+
+namespace
+{
+    const PulseStateSnapshot* publishVehicles(PulseSnapshotPublisher& publisher, std::size_t count, double x)
+    {
+        auto& snapshot = publisher.beginWrite();
+        snapshot.vehicles.resize(count);
+        for (auto& record : snapshot.vehicles) {
+            record.id.assign("veh");
+            record.position = PulsePosition{x, x};
+        }
+        publisher.publish();
+        return &snapshot;
+    }
+
+    class FleetMockSumo : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllVehicles() const override { return vehicles; }
+        std::vector<std::string> getAllTrafficLights() const override { return traffic_lights; }
+
+        std::pair<double, double> getVehiclePosition(const std::string& vehicle_id) const override
+        {
+            return {static_cast<double>(step), static_cast<double>(vehicle_id.size())};
+        }
+
+        std::string getTrafficLightState(const std::string&) const override { return step % 2 == 0 ? "GGrr" : "rrGG"; }
+
+        std::vector<std::string> vehicles;
+        std::vector<std::string> traffic_lights;
+        int step = 0;
+    };
+}
+
+TEST(PulseSnapshotPublisherTest, PinBeforePublishIsEmpty)
+{
+    PulseSnapshotPublisher publisher;
+    auto guard = publisher.pin();
+    EXPECT_FALSE(guard);
+    EXPECT_EQ(publisher.getEpoch(), 0u);
+}
+
+TEST(PulseSnapshotPublisherTest, ReaderSeesLatestSnapshot)
+{
+    PulseSnapshotPublisher publisher;
+    publishVehicles(publisher, 3, 1.0);
+    publishVehicles(publisher, 5, 2.0);
+
+    auto guard = publisher.pin();
+    ASSERT_TRUE(guard);
+    EXPECT_EQ(guard->epoch, 2u);
+    EXPECT_EQ(guard->vehicles.size(), 5u);
+    EXPECT_EQ(guard->vehicles.front().position.x, 2.0);
+}
+
+TEST(PulseSnapshotPublisherTest, PinnedSnapshotSurvivesUntilReleased)
+{
+    PulseSnapshotPublisher publisher;
+    publishVehicles(publisher, 1, 1.0);
+
+    auto guard = publisher.pin();
+    const PulseStateSnapshot* pinned = guard.get();
+
+    const auto* second = publishVehicles(publisher, 2, 2.0);
+    const auto* third = publishVehicles(publisher, 3, 3.0);
+
+    // The pinned snapshot was retired but must not be reused while held
+    EXPECT_EQ(guard->epoch, 1u);
+    EXPECT_EQ(guard->vehicles.size(), 1u);
+    EXPECT_GE(publisher.getRetiredCount(), 1u);
+
+    guard.release();
+    publishVehicles(publisher, 4, 4.0);
+    EXPECT_EQ(publisher.getRetiredCount(), 0u);
+
+    // Reclaimed snapshots are recycled by the writer
+    const auto* next = &publisher.beginWrite();
+    EXPECT_TRUE(next == pinned || next == second || next == third);
+}
+
+TEST(PulseSnapshotPublisherTest, ConcurrentReadersSeeConsistentSnapshots)
+{
+    PulseSnapshotPublisher publisher;
+    publishVehicles(publisher, 1, 1.0);
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> inconsistencies{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            std::uint64_t last_epoch = 0;
+            while (!done.load()) {
+                auto guard = publisher.pin();
+                // Every record of one snapshot carries the same position, and epochs only move forward
+                const double x = guard->vehicles.front().position.x;
+                for (const auto& record : guard->vehicles) {
+                    if (record.position.x != x || record.position.y != x) {
+                        ++inconsistencies;
+                    }
+                }
+                if (guard->epoch < last_epoch) {
+                    ++inconsistencies;
+                }
+                last_epoch = guard->epoch;
+            }
+        });
+    }
+
+    for (int step = 2; step < 2000; ++step) {
+        publishVehicles(publisher, 1 + step % 32, static_cast<double>(step));
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(inconsistencies.load(), 0u);
+}
+
+TEST(PulseSnapshotPublisherTest, DataManagerPublishesCurrentState)
+{
+    auto& manager = PulseDataManager::getInstance();
+    manager.clearAll();
+    manager.addVehicle(std::make_unique<PulseVehicle>("V1", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{4.0, 2.0}));
+
+    manager.publishSnapshot();
+    auto guard = manager.acquireSnapshot();
+    ASSERT_TRUE(guard);
+    ASSERT_EQ(guard->vehicles.size(), 1u);
+    EXPECT_EQ(guard->vehicles.front().id, "V1");
+    EXPECT_EQ(guard->vehicles.front().type, PulseVehicleType::BUS);
+    EXPECT_EQ(guard->vehicles.front().position, PulsePosition(4.0, 2.0));
+
+    manager.clearAll();
+}
+
+TEST(PulseSnapshotPublisherTest, RecycledSnapshotsFollowChurn)
+{
+    PulseDataManager manager;
+    FleetMockSumo source;
+    source.vehicles = {"a", "bb", "ccc", "dddd"};
+    source.traffic_lights = {"tl1", "tl2"};
+    manager.syncFromSumo(source);
+
+    for (int step = 1; step <= 20; ++step) {
+        // One vehicle departs and one arrives each step; lights and intersections change now and then
+        source.step = step;
+        source.vehicles.erase(source.vehicles.begin() + step % source.vehicles.size());
+        source.vehicles.push_back("veh" + std::to_string(step));
+        if (step % 7 == 0) {
+            source.traffic_lights.push_back("tl" + std::to_string(step));
+        }
+        if (step % 9 == 0) {
+            source.traffic_lights.erase(source.traffic_lights.begin());
+        }
+        if (step % 5 == 0) {
+            manager.addIntersection(std::make_unique<PulseIntersection>("int" + std::to_string(step), PulsePosition{}));
+        }
+        manager.updateFromSumo(source);
+        manager.publishSnapshot();
+
+        auto guard = manager.acquireSnapshot();
+        ASSERT_TRUE(guard);
+
+        std::map<std::string, PulsePosition> expected_vehicles;
+        for (const auto* vehicle : manager.getAllVehicles()) {
+            expected_vehicles.emplace(vehicle->getId(), vehicle->getPosition());
+        }
+        std::map<std::string, PulsePosition> published_vehicles;
+        for (const auto& record : guard->vehicles) {
+            published_vehicles.emplace(record.id, record.position);
+        }
+        EXPECT_EQ(published_vehicles, expected_vehicles) << "step " << step;
+
+        std::map<std::string, TrafficLightState> expected_lights;
+        for (const auto* light : manager.getAllTrafficLights()) {
+            expected_lights.emplace(light->getId(), light->getState());
+        }
+        std::map<std::string, TrafficLightState> published_lights;
+        for (const auto& record : guard->traffic_lights) {
+            published_lights.emplace(record.id, record.state);
+        }
+        EXPECT_EQ(published_lights, expected_lights) << "step " << step;
+
+        std::set<std::string> expected_intersections;
+        for (const auto* intersection : manager.getAllIntersections()) {
+            expected_intersections.insert(intersection->getId());
+        }
+        std::set<std::string> published_intersections;
+        for (const auto& record : guard->intersections) {
+            published_intersections.insert(record.id);
+        }
+        EXPECT_EQ(published_intersections, expected_intersections) << "step " << step;
+    }
+}
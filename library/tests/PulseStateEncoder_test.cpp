@@ -0,0 +1,107 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "core/PulseStateEncoder.h"
+
+namespace
+{
+    PulseStateSnapshot makeSnapshot(std::uint64_t epoch)
+    {
+        PulseStateSnapshot snapshot;
+        snapshot.epoch = epoch;
+        snapshot.step = epoch * 10;
+        snapshot.vehicles.push_back({"V1", PulseVehicleType::CAR, PulseVehicleRole::NORMAL, PulsePosition{1.0, 2.0}});
+        snapshot.vehicles.push_back({"V2", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{3.0, 4.0}});
+        snapshot.traffic_lights.push_back({"TL1", TrafficLightState::RED});
+        return snapshot;
+    }
+
+    bool contains(const std::string& text, const std::string& part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+}
+
+TEST(PulseStateEncoderTest, DeltaReportsOnlyChanges)
+{
+    PulseStateEncoder encoder;
+    auto snapshot = makeSnapshot(1);
+    encoder.diff(snapshot);
+    EXPECT_EQ(encoder.getChangedVehicleCount(), 2u);
+    EXPECT_EQ(encoder.getChangedTrafficLightCount(), 1u);
+
+    snapshot = makeSnapshot(2);
+    encoder.diff(snapshot);
+    EXPECT_EQ(encoder.getChangedVehicleCount(), 0u);
+    EXPECT_EQ(encoder.getRemovedVehicleCount(), 0u);
+    EXPECT_EQ(encoder.getChangedTrafficLightCount(), 0u);
+
+    snapshot = makeSnapshot(3);
+    snapshot.vehicles[0].position = PulsePosition{5.0, 2.0};
+    snapshot.vehicles.pop_back();
+    snapshot.vehicles.push_back({"V3", PulseVehicleType::TRUCK, PulseVehicleRole::EMERGENCY, PulsePosition{0.0, 0.0}});
+    snapshot.traffic_lights[0].state = TrafficLightState::GREEN;
+    encoder.diff(snapshot);
+    EXPECT_EQ(encoder.getEpoch(), 3u);
+    EXPECT_EQ(encoder.getChangedVehicleCount(), 2u);
+    EXPECT_EQ(encoder.getRemovedVehicleCount(), 1u);
+    EXPECT_EQ(encoder.getChangedTrafficLightCount(), 1u);
+
+    std::string json;
+    encoder.encodeDelta(PulseWireFormat::JSON, json);
+    EXPECT_TRUE(contains(json, "\"type\":\"delta\""));
+    EXPECT_TRUE(contains(json, "\"base_epoch\":2"));
+    EXPECT_TRUE(contains(json, "\"id\":\"V1\""));
+    EXPECT_TRUE(contains(json, "\"id\":\"V3\""));
+    EXPECT_TRUE(contains(json, "\"removed\":[\"V2\"]"));
+    EXPECT_FALSE(contains(json, "\"id\":\"V2\""));
+
+    encoder.reset();
+    encoder.diff(snapshot);
+    EXPECT_EQ(encoder.getChangedVehicleCount(), 2u);
+    EXPECT_EQ(encoder.getRemovedVehicleCount(), 0u);
+}
+
+TEST(PulseStateEncoderTest, BinaryMessagesStartWithHeader)
+{
+    const auto snapshot = makeSnapshot(7);
+    std::string binary;
+    PulseStateEncoder::encodeState(snapshot, PulseWireFormat::BINARY, binary);
+
+    ASSERT_GE(binary.size(), 29u);
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[0]), PulseStateEncoder::kStateMessage);
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[1]), 7u);     // epoch, little-endian
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[17]), 70u);   // step
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[25]), 2u);    // vehicle count
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[29]), 2u);    // first ID length
+    EXPECT_EQ(binary.substr(31, 2), "V1");
+
+    float x = 0.0f;
+    std::memcpy(&x, binary.data() + 35, sizeof(x));
+    EXPECT_FLOAT_EQ(x, 1.0f);
+
+    PulseStateEncoder encoder;
+    encoder.diff(snapshot);
+    encoder.encodeDelta(PulseWireFormat::BINARY, binary);
+    EXPECT_EQ(static_cast<std::uint8_t>(binary[0]), PulseStateEncoder::kDeltaMessage);
+}
+
+TEST(PulseStateEncoderTest, JsonEscapesIds)
+{
+    PulseStateSnapshot snapshot;
+    snapshot.epoch = 1;
+    snapshot.vehicles.push_back({"a\"b\\c\n", PulseVehicleType::CAR, PulseVehicleRole::EMERGENCY, PulsePosition{0.5, -1.0}});
+
+    std::string json;
+    PulseStateEncoder::encodeState(snapshot, PulseWireFormat::JSON, json);
+    EXPECT_TRUE(contains(json, "\"id\":\"a\\\"b\\\\c\\u000a\""));
+    EXPECT_TRUE(contains(json, "\"role\":\"emergency\""));
+    EXPECT_TRUE(contains(json, "\"x\":0.5,\"y\":-1"));
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+}
@@ -0,0 +1,403 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "TempDirectory.h"
+
+#include "core/PulseStatisticsExporter.h"
+
+namespace
+{
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /**
+     * @brief A decoded Thrift compact protocol value: an integer, a binary, a list or a struct.
+     */
+    struct ThriftValue
+    {
+        std::int64_t integer = 0;
+        std::string binary;
+        std::vector<ThriftValue> list;
+        std::map<std::int16_t, ThriftValue> fields;
+
+        const ThriftValue& operator[](std::int16_t id) const
+        {
+            const auto it = fields.find(id);
+            if (it == fields.end()) {
+                throw std::runtime_error("Missing Thrift field " + std::to_string(id));
+            }
+            return it->second;
+        }
+
+        bool has(std::int16_t id) const { return fields.count(id) > 0; }
+    };
+
+    /**
+     * @brief Reads the parts of the Thrift compact protocol that Parquet metadata uses.
+     */
+    class ThriftReader
+    {
+    public:
+        ThriftReader(const std::string& bytes, std::size_t offset) : m_bytes(bytes), m_offset(offset) {}
+
+        ThriftValue readStruct()
+        {
+            ThriftValue value;
+            std::int16_t last = 0;
+            while (true) {
+                const auto header = byte();
+                if (header == 0) {
+                    return value;
+                }
+                const int delta = header >> 4;
+                const std::int16_t id = delta ? static_cast<std::int16_t>(last + delta)
+                                              : static_cast<std::int16_t>(unzigzag(varint()));
+                value.fields[id] = read(header & 0x0F);
+                last = id;
+            }
+        }
+
+        std::size_t getOffset() const { return m_offset; }
+
+    private:
+        ThriftValue read(int type)
+        {
+            ThriftValue value;
+            switch (type) {
+                case 1: value.integer = 1; break;                   // BOOLEAN_TRUE
+                case 2: value.integer = 0; break;                   // BOOLEAN_FALSE
+                case 3: value.integer = static_cast<std::int8_t>(byte()); break;
+                case 4: case 5: case 6: value.integer = unzigzag(varint()); break;
+                case 7: m_offset += 8; break;
+                case 8: {
+                    const auto size = static_cast<std::size_t>(varint());
+                    value.binary = m_bytes.substr(m_offset, size);
+                    m_offset += size;
+                    break;
+                }
+                case 9: case 10: {
+                    const auto header = byte();
+                    std::size_t size = header >> 4;
+                    if (size == 15) {
+                        size = static_cast<std::size_t>(varint());
+                    }
+                    for (std::size_t i = 0; i < size; ++i) {
+                        value.list.push_back(read(header & 0x0F));
+                    }
+                    break;
+                }
+                case 12: value = readStruct(); break;
+                default: throw std::runtime_error("Unsupported Thrift type " + std::to_string(type));
+            }
+            return value;
+        }
+
+        std::uint8_t byte()
+        {
+            if (m_offset >= m_bytes.size()) {
+                throw std::runtime_error("Truncated Thrift data");
+            }
+            return static_cast<std::uint8_t>(m_bytes[m_offset++]);
+        }
+
+        std::uint64_t varint()
+        {
+            std::uint64_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                const auto next = byte();
+                value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+                if (!(next & 0x80)) {
+                    return value;
+                }
+            }
+        }
+
+        static std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        const std::string& m_bytes;
+        std::size_t m_offset;
+    };
+
+    std::string gunzip(const std::string& input, std::size_t size)
+    {
+        std::string output(size, '\0');
+        z_stream stream{};
+        EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+        EXPECT_EQ(stream.total_out, size);
+        inflateEnd(&stream);
+        return output;
+    }
+
+    template <typename T>
+    T readLittleEndian(const std::string& bytes, std::size_t offset)
+    {
+        T value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief A Parquet file decoded independently of the writer; values are kept per column as text.
+     */
+    struct ParquetTable
+    {
+        std::int64_t rows = 0;
+        std::vector<std::string> names;
+        std::vector<std::vector<std::string>> columns;
+        std::vector<std::vector<std::size_t>> dictionary_sizes;    ///< Per column and row group.
+    };
+
+    // Reads the page at the offset and returns its header; the uncompressed page is stored in page
+    ThriftValue readPage(const std::string& bytes, std::int64_t offset, std::string& page)
+    {
+        ThriftReader reader(bytes, static_cast<std::size_t>(offset));
+        ThriftValue header = reader.readStruct();
+        page = gunzip(bytes.substr(reader.getOffset(), static_cast<std::size_t>(header[3].integer)),
+                      static_cast<std::size_t>(header[2].integer));
+        return header;
+    }
+
+    // Decodes the bit-packed runs of the RLE/bit-packing hybrid
+    std::vector<std::uint32_t> readCodes(const std::string& page, std::size_t values)
+    {
+        const int width = static_cast<std::uint8_t>(page[0]);
+        std::vector<std::uint32_t> codes;
+        std::size_t offset = 1;
+        while (codes.size() < values) {
+            std::uint64_t header = 0;
+            for (int shift = 0;; shift += 7) {
+                const auto next = static_cast<std::uint8_t>(page[offset++]);
+                header |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+                if (!(next & 0x80)) {
+                    break;
+                }
+            }
+            EXPECT_EQ(header & 1, 1u) << "only bit-packed runs are written";
+            const std::size_t count = (header >> 1) * 8;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t code = 0;
+                for (int bit = 0; bit < width; ++bit) {
+                    const std::size_t position = i * width + bit;
+                    code |= ((static_cast<std::uint8_t>(page[offset + position / 8]) >> (position % 8)) & 1u) << bit;
+                }
+                if (codes.size() < values) {
+                    codes.push_back(code);
+                }
+            }
+            offset += count * width / 8;
+        }
+        return codes;
+    }
+
+    ParquetTable readParquet(const std::filesystem::path& path)
+    {
+        const std::string bytes = readFile(path);
+        EXPECT_GE(bytes.size(), 12u);
+        EXPECT_EQ(bytes.substr(0, 4), "PAR1");
+        EXPECT_EQ(bytes.substr(bytes.size() - 4), "PAR1");
+        const auto footer_size = readLittleEndian<std::uint32_t>(bytes, bytes.size() - 8);
+        ThriftReader reader(bytes, bytes.size() - 8 - footer_size);
+        const ThriftValue footer = reader.readStruct();
+        EXPECT_EQ(reader.getOffset(), bytes.size() - 8);
+
+        ParquetTable table;
+        table.rows = footer[3].integer;
+        const auto& schema = footer[2].list;
+        EXPECT_EQ(static_cast<std::int64_t>(schema.size()) - 1, schema.front()[5].integer);
+        for (std::size_t column = 1; column < schema.size(); ++column) {
+            table.names.push_back(schema[column][4].binary);
+        }
+        table.columns.resize(table.names.size());
+        table.dictionary_sizes.resize(table.names.size());
+
+        std::int64_t rows = 0;
+        for (const auto& row_group : footer[4].list) {
+            rows += row_group[3].integer;
+            const auto& chunks = row_group[1].list;
+            EXPECT_EQ(chunks.size(), table.names.size());
+            for (std::size_t column = 0; column < chunks.size(); ++column) {
+                const auto& metadata = chunks[column][3];
+                const auto values = static_cast<std::size_t>(metadata[5].integer);
+                auto& out = table.columns[column];
+                std::string page;
+
+                std::vector<std::string> dictionary;
+                if (metadata.has(11)) {
+                    const auto header = readPage(bytes, metadata[11].integer, page);
+                    EXPECT_EQ(header[1].integer, 2);
+                    for (std::size_t offset = 0; offset < page.size();) {
+                        const auto size = readLittleEndian<std::uint32_t>(page, offset);
+                        dictionary.push_back(page.substr(offset + 4, size));
+                        offset += 4 + size;
+                    }
+                    EXPECT_EQ(dictionary.size(), static_cast<std::size_t>(header[7][1].integer));
+                    table.dictionary_sizes[column].push_back(dictionary.size());
+                }
+
+                const auto header = readPage(bytes, metadata[9].integer, page);
+                EXPECT_EQ(header[1].integer, 0);
+                EXPECT_EQ(static_cast<std::size_t>(header[5][1].integer), values);
+                switch (schema[column + 1][1].integer) {
+                    case 2:
+                        for (std::size_t i = 0; i < values; ++i) {
+                            out.push_back(std::to_string(readLittleEndian<std::int64_t>(page, i * 8)));
+                        }
+                        break;
+                    case 5:
+                        for (std::size_t i = 0; i < values; ++i) {
+                            out.push_back(std::to_string(readLittleEndian<double>(page, i * 8)));
+                        }
+                        break;
+                    default:
+                        for (const auto code : readCodes(page, values)) {
+                            EXPECT_LT(code, dictionary.size());
+                            out.push_back(code < dictionary.size() ? dictionary[code] : "");
+                        }
+                        break;
+                }
+            }
+        }
+        EXPECT_EQ(rows, table.rows);
+        return table;
+    }
+}
+
+TEST(PulseStatisticsExporterTest, WritesOneFilePerTable)
+{
+    const auto directory = makeTempDirectory("pulse_export_test");
+    PulseDataManager manager;
+    for (const auto* id : {"A", "B"}) {
+        manager.addIntersection(std::make_unique<PulseIntersection>(id, PulsePosition{}));
+    }
+    manager.addTrafficLight(std::make_unique<PulseTrafficLight>("tl"));
+    manager.addVehicle(std::make_unique<PulseVehicle>("v", PulseVehicleType::BUS, PulseVehicleRole::NORMAL, PulsePosition{}));
+
+    // A single pending batch makes sample() wait for the writer whenever a table fills up
+    PulseStatisticsExporter exporter(PulseExportConfig{directory.string(), 10.0, 4, 1});
+    for (int second = 0; second < 100; ++second) {
+        manager.getIntersection("A")->getStatistics().addVehiclePass(1.0);
+        exporter.sample(manager, second);
+    }
+    EXPECT_EQ(exporter.getSampleCount(), 10u);
+
+    exporter.flush();
+    exporter.close();
+    exporter.close();
+    EXPECT_THROW(exporter.sample(manager, 200.0), std::logic_error);
+
+    const ParquetTable intersections = readParquet(directory / "intersections.parquet");
+    ASSERT_EQ(intersections.rows, 20);
+    EXPECT_EQ(intersections.names, (std::vector<std::string>{"time", "intersection_id", "vehicles_passed",
+                                                              "vehicle_waiting_time", "pedestrians_passed",
+                                                              "pedestrian_waiting_time"}));
+    // Four rows per row group, each with its own dictionary page
+    EXPECT_EQ(intersections.dictionary_sizes[1], std::vector<std::size_t>(5, 2));
+    for (std::size_t row = 0; row < 20; ++row) {
+        const int second = static_cast<int>(row / 2) * 10;
+        const bool a = intersections.columns[1][row] == "A";
+        EXPECT_TRUE(a || intersections.columns[1][row] == "B");
+        EXPECT_EQ(intersections.columns[0][row], std::to_string(static_cast<double>(second)));
+        EXPECT_EQ(intersections.columns[2][row], std::to_string(a ? second + 1 : 0));
+        EXPECT_EQ(intersections.columns[3][row], std::to_string(a ? second + 1.0 : 0.0));
+    }
+
+    const ParquetTable traffic_lights = readParquet(directory / "traffic_lights.parquet");
+    ASSERT_EQ(traffic_lights.rows, 10);
+    EXPECT_EQ(traffic_lights.columns[1], std::vector<std::string>(10, "tl"));
+    EXPECT_EQ(traffic_lights.columns[2], std::vector<std::string>(10, toString(manager.getTrafficLight("tl")->getState())));
+
+    const ParquetTable vehicle_types = readParquet(directory / "vehicle_types.parquet");
+    ASSERT_GT(vehicle_types.rows, 0);
+    EXPECT_EQ(vehicle_types.rows % 10, 0);
+    for (std::size_t row = 0; row < vehicle_types.columns[1].size(); ++row) {
+        const bool bus = vehicle_types.columns[1][row] == toString(PulseVehicleType::BUS);
+        EXPECT_EQ(vehicle_types.columns[2][row], bus ? "1" : "0");
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseStatisticsExporterTest, SamplesOnlyAfterTheInterval)
+{
+    const auto directory = makeTempDirectory("pulse_export_interval_test");
+    PulseDataManager manager;
+    PulseStatisticsExporter exporter(PulseExportConfig{directory.string(), 5.0});
+
+    EXPECT_TRUE(exporter.sample(manager, 1.0));
+    EXPECT_FALSE(exporter.sample(manager, 5.9));
+    EXPECT_TRUE(exporter.sample(manager, 6.0));
+    EXPECT_EQ(exporter.getSampleCount(), 2u);
+
+    EXPECT_THROW(PulseStatisticsExporter(PulseExportConfig{""}), std::invalid_argument);
+    EXPECT_THROW(PulseStatisticsExporter(PulseExportConfig{directory.string(), -1.0}), std::invalid_argument);
+    EXPECT_THROW(PulseStatisticsExporter(PulseExportConfig{directory.string(), 1.0, 0}), std::invalid_argument);
+    EXPECT_THROW(PulseStatisticsExporter(PulseExportConfig{directory.string(), 1.0, 16, 0}), std::invalid_argument);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PulseParquetWriterTest, RejectsMismatchedBatches)
+{
+    const auto directory = makeTempDirectory("pulse_parquet_test");
+    std::filesystem::create_directories(directory);
+    const auto path = (directory / "table.parquet").string();
+
+    PulseParquetWriter writer(path, {{"id", PulseColumnType::STRING}, {"value", PulseColumnType::INT64}});
+    PulseColumnBatch batch;
+    batch.columns.resize(2);
+    batch.columns[0].dictionary_additions = {"x", "y"};
+    batch.columns[0].codes = {0, 1, 1};
+    batch.columns[1].int64_values = {1, 2, 3};
+    batch.rows = 3;
+    writer.writeRowGroup(batch);
+    EXPECT_EQ(writer.getRowCount(), 3);
+
+    // Dictionary entries carry over to later row groups, unknown codes do not
+    batch.clear();
+    batch.columns[0].codes = {1};
+    batch.columns[1].int64_values = {4};
+    batch.rows = 1;
+    writer.writeRowGroup(batch);
+    batch.columns[0].codes = {2};
+    EXPECT_THROW(writer.writeRowGroup(batch), std::invalid_argument);
+    batch.columns[0].codes = {0, 0};
+    EXPECT_THROW(writer.writeRowGroup(batch), std::invalid_argument);
+    EXPECT_EQ(writer.getRowCount(), 4);
+
+    writer.close();
+    EXPECT_THROW(writer.writeRowGroup(batch), std::logic_error);
+
+    // The second row group only uses "y", so its dictionary page holds just that entry
+    const ParquetTable table = readParquet(path);
+    EXPECT_EQ(table.rows, 4);
+    EXPECT_EQ(table.names, (std::vector<std::string>{"id", "value"}));
+    EXPECT_EQ(table.dictionary_sizes[0], (std::vector<std::size_t>{2, 1}));
+    EXPECT_TRUE(table.dictionary_sizes[1].empty());
+    EXPECT_EQ(table.columns[0], (std::vector<std::string>{"x", "y", "y", "y"}));
+    EXPECT_EQ(table.columns[1], (std::vector<std::string>{"1", "2", "3", "4"}));
+
+    EXPECT_THROW(PulseParquetWriter(path, {}), std::invalid_argument);
+    EXPECT_THROW(PulseParquetWriter(path, {{"id", PulseColumnType::STRING}}, 10), std::invalid_argument);
+    std::filesystem::remove_all(directory);
+}
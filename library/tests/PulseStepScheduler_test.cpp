@@ -0,0 +1,180 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseStepScheduler.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    class IdleMockSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllVehicles() const override { return {"veh0"}; }
+        std::vector<std::string> getAllTrafficLights() const override { return {"tl1"}; }
+        std::string getTrafficLightState(const std::string&) const override { return "Gr"; }
+    };
+
+    const PulseStageReport* findStage(const PulseSchedulerReport& report, const std::string& name)
+    {
+        for (const auto& stage : report.stages) {
+            if (stage.name == name) {
+                return &stage;
+            }
+        }
+        return nullptr;
+    }
+}
+
+TEST(PulseStepSchedulerTest, AsFastAsPossibleDoesNotPace)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    system.initialize();
+
+    PulseStepScheduler scheduler(system, 1.0, PulseStepScheduler::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(scheduler.getStepPeriod().count(), 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(scheduler.run(100), 100u);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    auto report = scheduler.getReport();
+    EXPECT_EQ(report.steps, 100u);
+    EXPECT_EQ(report.overruns, 0u);
+    EXPECT_EQ(report.max_jitter_ms, 0.0);
+}
+
+TEST(PulseStepSchedulerTest, RealTimeFactorPacesSteps)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    system.initialize();
+
+    // 0.1 s steps at 10x real time -> 10 ms per step
+    PulseStepScheduler scheduler(system, 0.1, 10.0);
+    EXPECT_EQ(scheduler.getStepPeriod(), std::chrono::milliseconds(10));
+
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.run(6);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    auto report = scheduler.getReport();
+    EXPECT_EQ(report.steps, 6u);
+    ASSERT_NE(findStage(report, "simulation"), nullptr);
+    EXPECT_EQ(findStage(report, "simulation")->runs, 6u);
+}
+
+TEST(PulseStepSchedulerTest, OverrunSkipsNonCriticalConsumers)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    system.initialize();
+
+    std::size_t critical_runs = 0;
+    std::size_t logging_runs = 0;
+    system.addStepConsumer("controller", [&](TrafficSystem&) { ++critical_runs; }, true);
+    system.addStepConsumer("logging", [&](TrafficSystem&) {
+        ++logging_runs;
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    });
+
+    PulseStepScheduler scheduler(system, 0.005, 1.0);
+    scheduler.setRecoveryPolicy(0.8, 1000);
+    scheduler.run(8);
+
+    auto report = scheduler.getReport();
+    EXPECT_EQ(critical_runs, 8u);
+    EXPECT_EQ(logging_runs, 1u);
+    EXPECT_GE(report.overruns, 1u);
+    EXPECT_EQ(report.degraded_steps, 7u);
+
+    const auto* logging = findStage(report, "logging");
+    ASSERT_NE(logging, nullptr);
+    EXPECT_EQ(logging->runs, 1u);
+    EXPECT_EQ(logging->skipped, 7u);
+    EXPECT_GE(logging->max_ms, 15.0);
+}
+
+TEST(PulseStepSchedulerTest, RecoversAfterComfortableSteps)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    system.initialize();
+
+    std::size_t slow_steps = 1;
+    system.addStepConsumer("stats-flush", [&](TrafficSystem&) {
+        if (slow_steps > 0) {
+            --slow_steps;
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+    });
+
+    PulseStepScheduler scheduler(system, 0.01, 1.0);
+    scheduler.setRecoveryPolicy(0.8, 2);
+    scheduler.run(6);
+
+    EXPECT_TRUE(system.areNonCriticalConsumersEnabled());
+    auto report = scheduler.getReport();
+    EXPECT_EQ(report.overruns, 1u);
+    EXPECT_EQ(report.degraded_steps, 2u);
+}
+
+TEST(PulseStepSchedulerTest, StagesRunOnlyOnTheirTicks)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    system.initialize();
+
+    std::vector<std::uint64_t> statistics_steps;
+    system.addStepConsumer("statistics", [&](TrafficSystem& traffic) { statistics_steps.push_back(traffic.getStepCount()); });
+    system.setStageRate("statistics", 5, 2);
+    system.setStageRate("traffic_light_sync", 10, 0);
+
+    PulseStepScheduler scheduler(system, 1.0, PulseStepScheduler::AS_FAST_AS_POSSIBLE);
+    scheduler.run(20);
+
+    // Consumers see the step count after the step, i.e. steps 2, 7, 12 and 17 counted from 0
+    EXPECT_EQ(statistics_steps, (std::vector<std::uint64_t>{3, 8, 13, 18}));
+    const auto report = scheduler.getReport();
+    EXPECT_EQ(findStage(report, "simulation")->runs, 20u);
+    EXPECT_EQ(findStage(report, "vehicle_sync")->runs, 20u);
+    EXPECT_EQ(findStage(report, "traffic_light_sync")->runs, 2u);
+    EXPECT_EQ(findStage(report, "statistics")->runs, 4u);
+    EXPECT_EQ(findStage(report, "statistics")->skipped, 0u);
+
+    EXPECT_THROW(system.setStageRate("simulation", 2), std::invalid_argument);
+    EXPECT_THROW(system.setStageRate("export", 2), std::invalid_argument);
+    EXPECT_THROW(system.setStageRate("statistics", 0), std::invalid_argument);
+    EXPECT_THROW(system.setStageRate("statistics", 4, 4), std::invalid_argument);
+}
+
+TEST(PulseStepSchedulerTest, AutomaticPhasesSpreadPeriodicStages)
+{
+    TrafficSystem system(std::make_unique<IdleMockSource>());
+    for (const char* name : {"controller", "statistics", "export"}) {
+        system.addStepConsumer(name, [](TrafficSystem&) {});
+    }
+
+    const auto phaseOf = [&](const std::string& name) {
+        const auto& names = system.getStageNames();
+        const auto index = static_cast<std::size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+        return system.getStageRates()[index].phase;
+    };
+
+    system.setStageRate("controller", 4);
+    system.setStageRate("statistics", 4);
+    system.setStageRate("export", 2);
+    system.setStageRate("traffic_light_sync", 4);
+    EXPECT_EQ(phaseOf("controller"), 0u);
+    EXPECT_EQ(phaseOf("statistics"), 1u);
+    EXPECT_EQ(phaseOf("export"), 0u);
+    EXPECT_EQ(phaseOf("traffic_light_sync"), 3u);
+
+    // Resetting to every step frees the phase for the others
+    system.setStageRate("export", 1);
+    system.setStageRate("pedestrian_sync", 4);
+    EXPECT_EQ(phaseOf("pedestrian_sync"), 2u);
+}
@@ -0,0 +1,110 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseTransitPriority.h"
+
+namespace
+{
+    /**
+     * @brief Source reporting scripted transit states and recording green extensions.
+     */
+    class PrioritySource : public MockSimulationSource
+    {
+    public:
+        bool fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const override
+        {
+            out = states.at(vehicle_id);
+            return true;
+        }
+
+        bool extendGreen(const std::string& tl_id, double seconds) override
+        {
+            extensions[tl_id] = seconds;
+            return true;
+        }
+
+        /**
+         * @brief A bus whose scheduled departure from its next stop was at t = 0.
+         */
+        void approach(const std::string& vehicle_id, const std::string& tl_id, char signal, double distance, double speed)
+        {
+            states[vehicle_id] = PulseTransitState{"7", "stop", 0.0, false, tl_id, signal, distance, speed};
+        }
+
+        std::map<std::string, PulseTransitState> states;
+        std::map<std::string, double> extensions;
+    };
+}
+
+TEST(PulseTransitPriorityTest, ExtendsGreenForLateVehicles)
+{
+    PrioritySource source;
+    source.approach("late", "tl1", 'G', 100.0, 10.0);
+    source.approach("on_red", "tl2", 'r', 50.0, 10.0);
+    source.approach("far", "tl3", 'g', 500.0, 10.0);
+    source.approach("slow", "tl4", 'g', 20.0, 0.0);
+
+    PulseTransitTable transit;
+    for (const auto& [id, state] : source.states) {
+        transit.add(id);
+    }
+    transit.update(source, 90.0);
+
+    PulseTransitPriority priority;
+    EXPECT_EQ(priority.apply(transit, source, 90.0), 2u);
+    ASSERT_EQ(source.extensions.size(), 2u);
+    EXPECT_DOUBLE_EQ(source.extensions.at("tl1"), 12.0);
+    // A halted vehicle is assumed to approach at the minimum speed
+    EXPECT_DOUBLE_EQ(source.extensions.at("tl4"), 12.0);
+    EXPECT_EQ(priority.getExtensionCount(), 2u);
+}
+
+TEST(PulseTransitPriorityTest, RequiresLatenessAndRecovery)
+{
+    PrioritySource source;
+    source.approach("bus", "tl1", 'G', 50.0, 10.0);
+    PulseTransitTable transit;
+    transit.add("bus");
+
+    PulseTransitPriorityConfig config;
+    config.min_lateness = 60.0;
+    config.recovery_time = 100.0;
+    PulseTransitPriority priority(config);
+
+    // 30 s late: below the threshold
+    transit.update(source, 30.0);
+    EXPECT_EQ(priority.apply(transit, source, 30.0), 0u);
+
+    transit.update(source, 60.0);
+    EXPECT_EQ(priority.apply(transit, source, 60.0), 1u);
+    EXPECT_DOUBLE_EQ(source.extensions.at("tl1"), 7.0);
+
+    // The light recovers until 60 + 7 + 100
+    transit.update(source, 160.0);
+    EXPECT_EQ(priority.apply(transit, source, 160.0), 0u);
+    transit.update(source, 167.0);
+    EXPECT_EQ(priority.apply(transit, source, 167.0), 1u);
+    EXPECT_EQ(priority.getExtensionCount(), 2u);
+}
+
+TEST(PulseTransitPriorityTest, RejectsInvalidConfig)
+{
+    PulseTransitPriorityConfig config;
+    config.max_extension = 0.0;
+    EXPECT_THROW(PulseTransitPriority{config}, std::invalid_argument);
+
+    config = {};
+    config.min_approach_speed = 0.0;
+    EXPECT_THROW(PulseTransitPriority{config}, std::invalid_argument);
+
+    config = {};
+    config.recovery_time = -1.0;
+    EXPECT_THROW(PulseTransitPriority{config}, std::invalid_argument);
+}
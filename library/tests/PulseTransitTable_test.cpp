@@ -0,0 +1,154 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseDataManager.h"
+#include "core/PulseTransitTable.h"
+
+namespace
+{
+    /**
+     * @brief Source with scripted transit states; vehicles whose ID starts with "bus" are buses.
+     */
+    class TransitSource : public MockSimulationSource
+    {
+    public:
+        std::vector<std::string> getAllVehicles() const override { return vehicles; }
+        double getSimulationTime() const override { return now; }
+
+        PulseVehicleType getVehicleType(const std::string& vehicle_id) const override
+        {
+            return vehicle_id.starts_with("bus") ? PulseVehicleType::BUS : PulseVehicleType::CAR;
+        }
+
+        bool fillTransitState(const std::string& vehicle_id, PulseTransitState& out) const override
+        {
+            ++queries;
+            auto it = states.find(vehicle_id);
+            if (it == states.end()) {
+                return false;
+            }
+            out = it->second;
+            return true;
+        }
+
+        /**
+         * @brief Sets the line, next stop and scheduled departure of a vehicle.
+         */
+        void schedule(const std::string& vehicle_id, const std::string& stop_id, double until)
+        {
+            auto& state = states[vehicle_id];
+            state.line = "12";
+            state.next_stop_id = stop_id;
+            state.next_stop_until = until;
+        }
+
+        std::vector<std::string> vehicles;
+        std::map<std::string, PulseTransitState> states;
+        double now = 0.0;
+        mutable std::size_t queries = 0;
+    };
+}
+
+TEST(PulseTransitTableTest, ComputesLatenessAtStops)
+{
+    PulseTransitTable table;
+    TransitSource source;
+    table.add("bus.0");
+    table.add("bus.0");
+    ASSERT_EQ(table.size(), 1u);
+    const auto slot = table.find("bus.0").value();
+
+    source.schedule("bus.0", "stop_a", 100.0);
+    table.update(source, 90.0);
+    EXPECT_DOUBLE_EQ(table.getLateness(slot), 0.0);
+    EXPECT_EQ(table.getState(slot).next_stop_id, "stop_a");
+
+    // Still heading to stop_a after its scheduled departure: at least 20 s late
+    table.update(source, 120.0);
+    EXPECT_DOUBLE_EQ(table.getLateness(slot), 20.0);
+    EXPECT_TRUE(table.getStopEvents().empty());
+
+    // Leaves stop_a at 130
+    source.schedule("bus.0", "stop_b", 200.0);
+    table.update(source, 130.0);
+    auto events = table.getStopEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].vehicle_id, "bus.0");
+    EXPECT_EQ(events[0].line, "12");
+    EXPECT_EQ(events[0].stop_id, "stop_a");
+    EXPECT_DOUBLE_EQ(events[0].lateness, 30.0);
+    EXPECT_DOUBLE_EQ(table.getLateness(slot), 30.0);
+
+    // Catches up: leaves stop_b 10 s early, after its last stop there is nothing left to be late for
+    source.schedule("bus.0", "", -1.0);
+    table.update(source, 190.0);
+    events = table.getStopEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_DOUBLE_EQ(events[0].lateness, -10.0);
+    table.update(source, 400.0);
+    EXPECT_DOUBLE_EQ(table.getLateness(slot), -10.0);
+}
+
+TEST(PulseTransitTableTest, QueriesOnlyTrackedVehicles)
+{
+    PulseTransitTable table;
+    TransitSource source;
+    source.schedule("bus.0", "stop_a", 100.0);
+    table.add("bus.0");
+    table.add("bus.1");
+    table.update(source, 0.0);
+    EXPECT_EQ(source.queries, 2u);
+
+    // bus.1 reports no schedule and keeps an empty state
+    EXPECT_TRUE(table.getState(table.find("bus.1").value()).next_stop_id.empty());
+
+    const auto freed = table.find("bus.0").value();
+    table.remove("bus.0");
+    table.remove("bus.0");
+    EXPECT_EQ(table.size(), 1u);
+    table.add("bus.2");
+    EXPECT_EQ(table.find("bus.2"), freed);
+    EXPECT_TRUE(table.getState(freed).next_stop_id.empty());
+
+    std::size_t visited = 0;
+    table.forEach([&](std::size_t) { ++visited; });
+    EXPECT_EQ(visited, 2u);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+    source.queries = 0;
+    table.update(source, 1.0);
+    EXPECT_EQ(source.queries, 0u);
+}
+
+TEST(PulseTransitTableTest, DataManagerTracksBusesOnly)
+{
+    PulseDataManager manager;
+    TransitSource source;
+    source.vehicles = {"car.0", "bus.0", "car.1"};
+    source.schedule("bus.0", "stop_a", 50.0);
+
+    source.now = 40.0;
+    manager.updateFromSumo(source);
+    EXPECT_EQ(manager.getTransit().size(), 1u);
+    EXPECT_EQ(source.queries, 1u);
+
+    source.schedule("bus.0", "stop_b", 150.0);
+    source.now = 75.0;
+    manager.updateFromSumo(source);
+    const auto& transit = manager.getTransit();
+    ASSERT_EQ(transit.getStopEvents().size(), 1u);
+    EXPECT_DOUBLE_EQ(transit.getStopEvents()[0].lateness, 25.0);
+    EXPECT_DOUBLE_EQ(transit.getLateness(transit.find("bus.0").value()), 25.0);
+
+    source.vehicles = {"car.0"};
+    manager.updateFromSumo(source);
+    EXPECT_EQ(manager.getTransit().size(), 0u);
+}
@@ -0,0 +1,229 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <thread>
+
+#include "MockSimulationSource.h"
+
+#include "core/PulseTravelTimeEstimator.h"
+#include "core/TrafficSystem.h"
+
+namespace
+{
+    /**
+     * @brief Source replaying a scripted road per vehicle and step; an empty road means absent.
+     *        Steps are one second long.
+     */
+    class ScriptedRoadSource : public MockSimulationSource
+    {
+    public:
+        explicit ScriptedRoadSource(std::map<std::string, std::vector<std::string>> script)
+            : m_script(std::move(script)) {}
+
+        void stepSimulation() override { ++m_step; }
+
+        std::vector<std::string> getAllVehicles() const override
+        {
+            std::vector<std::string> ids;
+            for (const auto& [id, roads] : m_script) {
+                if (m_step < roads.size() && !roads[m_step].empty()) {
+                    ids.push_back(id);
+                }
+            }
+            return ids;
+        }
+
+        double getSimulationTime() const override { return static_cast<double>(m_step); }
+
+        bool fillVehicleKinematics(const std::string& vehicle_id, PulseVehicleKinematics& out) const override
+        {
+            out.road_id.assign(m_script.at(vehicle_id)[m_step]);
+            out.lane_index = 0;
+            out.lane_position = 0.0;
+            out.speed = 10.0;
+            return true;
+        }
+
+    private:
+        std::map<std::string, std::vector<std::string>> m_script;
+        std::size_t m_step = 0;
+    };
+
+    struct Network
+    {
+        std::vector<std::unique_ptr<PulseIntersection>> intersections;
+        std::unique_ptr<PulseTrafficLight> traffic_light = std::make_unique<PulseTrafficLight>("tl");
+
+        // A -(1, 100 m)-> B -(1, 50 m)-> C
+        Network()
+        {
+            for (const auto* id : {"A", "B", "C"}) {
+                intersections.push_back(std::make_unique<PulseIntersection>(id, PulsePosition{}));
+            }
+            intersections[0]->addRoadConnection(1, intersections[1].get(), traffic_light.get(), 100.0);
+            intersections[1]->addRoadConnection(1, intersections[2].get(), traffic_light.get(), 50.0);
+        }
+
+        std::vector<PulseIntersection*> nodes() const
+        {
+            return {intersections[0].get(), intersections[1].get(), intersections[2].get()};
+        }
+    };
+}
+
+TEST(PulseTravelTimeEstimatorTest, DataManagerRecordsCompleteTraversals)
+{
+    // veh0 is first seen mid-road, so its first traversal is unknown; veh1 enters e1 at t=1 and leaves at t=4
+    ScriptedRoadSource source({
+        {"veh0", {"e1", "e1", "e2", "e2", "e2"}},
+        {"veh1", {"e0", "e1", "e1", "e1", "e2"}},
+    });
+    source.startSimulation();
+
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+    manager.syncFromSumo(source);
+
+    for (int step = 0; step < 5; ++step) {
+        manager.updateFromSumo(source);
+        const auto transitions = manager.getRoadTransitions();
+        if (step < 4) {
+            EXPECT_TRUE(transitions.empty()) << "step " << step;
+        }
+        else {
+            ASSERT_EQ(transitions.size(), 1u);
+            EXPECT_EQ(transitions[0].road_id, "e1");
+            EXPECT_DOUBLE_EQ(transitions[0].entered_at, 1.0);
+            EXPECT_DOUBLE_EQ(transitions[0].exited_at, 4.0);
+        }
+        source.stepSimulation();
+    }
+
+    auto* vehicle = manager.getVehicle("veh1");
+    ASSERT_NE(vehicle, nullptr);
+    EXPECT_EQ(vehicle->getKinematics().road_id, "e2");
+    EXPECT_DOUBLE_EQ(vehicle->getKinematics().speed, 10.0);
+    EXPECT_DOUBLE_EQ(vehicle->getRoadEntryTime(), 4.0);
+}
+
+TEST(PulseTravelTimeEstimatorTest, TrackingIsOptIn)
+{
+    ScriptedRoadSource source({{"veh0", {"e0", "e1"}}});
+    source.startSimulation();
+
+    PulseDataManager manager;
+    manager.syncFromSumo(source);
+    manager.updateFromSumo(source);
+    source.stepSimulation();
+    manager.updateFromSumo(source);
+
+    EXPECT_FALSE(manager.isKinematicsTrackingEnabled());
+    EXPECT_TRUE(manager.getVehicle("veh0")->getKinematics().road_id.empty());
+    EXPECT_TRUE(manager.getRoadTransitions().empty());
+}
+
+TEST(PulseTravelTimeEstimatorTest, SmoothsBoundRoads)
+{
+    Network network;
+    PulseTravelTimeEstimator estimator(network.nodes(), {{"e1", "A", 1}, {"e2", "B", 1}}, 0.5, 10.0);
+    ASSERT_EQ(estimator.getEdgeCount(), 2u);
+
+    const auto e1 = estimator.findSourceRoad("e1");
+    ASSERT_TRUE(e1);
+    EXPECT_EQ(e1, estimator.findEdge("A", 1));
+    EXPECT_FALSE(estimator.findSourceRoad("e0"));
+
+    // Free flow until measured
+    auto estimate = estimator.getEstimate(*e1);
+    EXPECT_DOUBLE_EQ(estimate.travel_time, 10.0);
+    EXPECT_DOUBLE_EQ(estimate.speed, 10.0);
+    EXPECT_EQ(estimate.samples, 0u);
+
+    // veh1 crosses e1 in 1 s, veh0 in 5 s
+    ScriptedRoadSource source({
+        {"veh0", {"e0", "e1", "e1", "e1", "e1", "e1", "e2"}},
+        {"veh1", {"e0", "e0", "e1", "e2", "", "", ""}},
+    });
+    source.startSimulation();
+    PulseDataManager manager;
+    manager.setKinematicsTracking(true);
+    for (int step = 0; step < 7; ++step) {
+        manager.updateFromSumo(source);
+        estimator.update(manager);
+        source.stepSimulation();
+    }
+    estimator.recordTraversal(*e1, 20.0);
+
+    // 1 s (first sample), then 5 s and 20 s folded in with weight 0.5
+    estimate = estimator.getEstimate(*e1);
+    EXPECT_EQ(estimate.samples, 3u);
+    EXPECT_DOUBLE_EQ(estimate.travel_time, 11.5);
+    EXPECT_DOUBLE_EQ(estimate.speed, 32.5);
+
+    // Measured roads feed the router
+    PulseRouter router(network.nodes());
+    estimator.applyTo(router);
+    EXPECT_DOUBLE_EQ(router.getTravelTime("A", 1), 11.5);
+    EXPECT_DOUBLE_EQ(router.getTravelTime("B", 1), 50.0 / PulseRouter::kDefaultFreeFlowSpeed);
+}
+
+TEST(PulseTravelTimeEstimatorTest, PeriodicVehicleSyncReportsEachTraversalOnce)
+{
+    Network network;
+    PulseTravelTimeEstimator estimator(network.nodes(), {{"e1", "A", 1}}, 0.5, 10.0);
+    const auto e1 = estimator.findSourceRoad("e1");
+    ASSERT_TRUE(e1);
+
+    // Vehicles are synced at t=1, 4 and 7, seeing veh0 on e0, then entering e1, then on e2
+    TrafficSystem system(std::make_unique<ScriptedRoadSource>(std::map<std::string, std::vector<std::string>>{
+        {"veh0", {"e0", "e0", "e0", "e0", "e1", "e1", "e1", "e2", "e2", "e2"}},
+    }));
+    system.getDataManager().setKinematicsTracking(true);
+    system.setStageRate("vehicle_sync", 3, 0);
+    system.addStepConsumer("travel_times", [&](TrafficSystem& traffic) { estimator.update(traffic.getDataManager()); });
+    system.initialize();
+
+    std::size_t transitions = 0;
+    for (int step = 0; step < 8; ++step) {
+        system.stepSimulation();
+        transitions += system.getDataManager().getRoadTransitions().size();
+    }
+
+    EXPECT_EQ(transitions, 1u);
+    const auto estimate = estimator.getEstimate(*e1);
+    EXPECT_EQ(estimate.samples, 1u);
+    EXPECT_DOUBLE_EQ(estimate.travel_time, 3.0);
+}
+
+TEST(PulseTravelTimeEstimatorTest, RejectsInvalidBindings)
+{
+    Network network;
+    EXPECT_THROW(PulseTravelTimeEstimator(network.nodes(), {{"e1", "A", 7}}), std::invalid_argument);
+    EXPECT_THROW(PulseTravelTimeEstimator(network.nodes(), {{"e1", "A", 1}, {"e1", "B", 1}}), std::invalid_argument);
+    EXPECT_THROW(PulseTravelTimeEstimator(network.nodes(), {}, 0.0), std::invalid_argument);
+}
+
+TEST(PulseTravelTimeEstimatorTest, ReadersNeverBlockTheWriter)
+{
+    Network network;
+    PulseTravelTimeEstimator estimator(network.nodes(), {});
+
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            const auto estimate = estimator.getEstimate(0);
+            ASSERT_GT(estimate.travel_time, 0.0);
+        }
+    });
+    for (int i = 0; i < 10000; ++i) {
+        estimator.recordTraversal(0, 5.0 + i % 10);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(estimator.getEstimate(0).samples, 10000u);
+}
@@ -0,0 +1,30 @@
+//
+// Created by andrii on 10/19/26.
+//
+
+#ifndef TEMPDIRECTORY_H
+#define TEMPDIRECTORY_H
+
+#pragma once
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+/**
+ * @brief Creates an empty directory under the system temp path, named after @p name plus a random
+ *        suffix. create_directory() fails on an existing path, so concurrent test processes never
+ *        share one. The caller removes it.
+ */
+inline std::filesystem::path makeTempDirectory(const std::string& name)
+{
+    std::random_device random;
+    for (;;) {
+        auto directory = std::filesystem::temp_directory_path() / (name + "_" + std::to_string(random()));
+        if (std::filesystem::create_directory(directory)) {
+            return directory;
+        }
+    }
+}
+
+#endif //TEMPDIRECTORY_H